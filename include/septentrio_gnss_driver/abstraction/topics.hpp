@@ -0,0 +1,437 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// std includes
+#include <array>
+#include <cstddef>
+#include <utility>
+
+/**
+ * @file topics.hpp
+ * @brief Compile-time table of the topics published by the driver
+ *
+ * Each topic has an ID which indexes the publisher table of the node, so
+ * publishing does not need to look up the topic by name. This header is
+ * included by the typedefs headers after the message typedefs it refers to.
+ */
+
+namespace topic {
+    //! IDs of all published topics, index into the publisher table
+    enum Id : std::size_t
+    {
+        POSE,
+        AIM_PLUS_STATUS,
+        RF_STATUS,
+        IMU,
+        TWIST_INS,
+        TWIST_GNSS,
+        GEOPOSE,
+        GEOPOSE_COV,
+        TWIST_FLU,
+        LOCALIZATION,
+        LOCALIZATION_ECEF,
+        NAVSATFIX,
+        GPSFIX,
+        GPST,
+        PVT_CARTESIAN,
+        PVT_GEODETIC,
+        BASE_VECTOR_CART,
+        BASE_VECTOR_GEOD,
+        POS_COV_CARTESIAN,
+        POS_COV_GEODETIC,
+        ATT_EULER,
+        ATT_COV_EULER,
+        GAL_AUTH_STATUS,
+        INS_NAV_CART,
+        INS_NAV_GEOD,
+        IMU_SETUP,
+        VEL_SENSOR_SETUP,
+        EXT_EVENT_INS_NAV_CART,
+        EXT_EVENT_INS_NAV_GEOD,
+        EXT_SENSOR_MEAS,
+        MEAS_EPOCH,
+        VEL_COV_CARTESIAN,
+        VEL_COV_GEODETIC,
+        GPGGA,
+        GPRMC,
+        GPGSA,
+        GPGSV,
+        CLOCK,
+        COUNT
+    };
+
+    //! Groups of topics sharing a QoS profile, see Settings::qos
+    enum Group : std::size_t
+    {
+        DEFAULT,
+        HIGH_RATE,
+        STATUS
+    };
+
+    //! Names of the groups in Settings::qos and the parameters
+    inline constexpr std::array<const char*, 3> groupNames = {"default", "high_rate",
+                                                              "status"};
+
+    /**
+     * @brief Message type, name, QoS group and enabling setting of a topic
+     *
+     * Specializations provide type (ROS message), group, name (relative to the
+     * node's namespace) and enabled(), which tells whether the publisher is
+     * created at startup. Topics not enabled at startup are advertised on first
+     * publish.
+     */
+    template <Id id>
+    struct Traits;
+
+    //! Base of the Traits specializations providing message type and group
+    template <typename M, Group g = DEFAULT>
+    struct Message
+    {
+        using type = M;
+        static constexpr Group group = g;
+    };
+
+    template <>
+    struct Traits<POSE> : Message<PoseWithCovarianceStampedMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "pose";
+        static bool enabled(const Settings& s) { return s.publish_pose; }
+    };
+
+    template <>
+    struct Traits<AIM_PLUS_STATUS> : Message<AimPlusStatusMsg, STATUS>
+    {
+        static constexpr const char* name = "aimplusstatus";
+        static bool enabled(const Settings& s) { return s.publish_aimplusstatus; }
+    };
+
+    template <>
+    struct Traits<RF_STATUS> : Message<RfStatusMsg, STATUS>
+    {
+        static constexpr const char* name = "rfstatus";
+        static bool enabled(const Settings& s) { return s.publish_aimplusstatus; }
+    };
+
+    template <>
+    struct Traits<IMU> : Message<ImuMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "imu";
+        static bool enabled(const Settings& s) { return s.publish_imu; }
+    };
+
+    template <>
+    struct Traits<TWIST_INS> : Message<TwistWithCovarianceStampedMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "twist_ins";
+        static bool enabled(const Settings& s) { return s.publish_twist; }
+    };
+
+    template <>
+    struct Traits<TWIST_GNSS> : Message<TwistWithCovarianceStampedMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "twist_gnss";
+        static bool enabled(const Settings& s) { return s.publish_twist; }
+    };
+
+    template <>
+    struct Traits<GEOPOSE> : Message<GeoPoseStampedMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "geopose";
+        static bool enabled(const Settings& s) { return s.publish_geopose_stamped; }
+    };
+
+    template <>
+    struct Traits<GEOPOSE_COV> : Message<GeoPoseWithCovarianceStampedMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "geopose_cov";
+        static bool enabled(const Settings& s)
+        {
+            return s.publish_geopose_covariance_stamped;
+        }
+    };
+
+    template <>
+    struct Traits<TWIST_FLU> : Message<TwistStampedMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "twist_flu";
+        static bool enabled(const Settings& s)
+        {
+            return s.publish_twist_flu_stamped;
+        }
+    };
+
+    template <>
+    struct Traits<LOCALIZATION> : Message<LocalizationMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "localization";
+        static bool enabled(const Settings& s) { return s.publish_localization; }
+    };
+
+    template <>
+    struct Traits<LOCALIZATION_ECEF> : Message<LocalizationMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "localization_ecef";
+        static bool enabled(const Settings& s)
+        {
+            return s.publish_localization_ecef;
+        }
+    };
+
+    template <>
+    struct Traits<NAVSATFIX> : Message<NavSatFixMsg>
+    {
+        static constexpr const char* name = "navsatfix";
+        static bool enabled(const Settings& s) { return s.publish_navsatfix; }
+    };
+
+    template <>
+    struct Traits<GPSFIX> : Message<GpsFixMsg>
+    {
+        static constexpr const char* name = "gpsfix";
+        static bool enabled(const Settings& s) { return s.publish_gpsfix; }
+    };
+
+    template <>
+    struct Traits<GPST> : Message<TimeReferenceMsg>
+    {
+        static constexpr const char* name = "gpst";
+        static bool enabled(const Settings& s) { return s.publish_gpst; }
+    };
+
+    template <>
+    struct Traits<PVT_CARTESIAN> : Message<PVTCartesianMsg>
+    {
+        static constexpr const char* name = "pvtcartesian";
+        static bool enabled(const Settings& s) { return s.publish_pvtcartesian; }
+    };
+
+    template <>
+    struct Traits<PVT_GEODETIC> : Message<PVTGeodeticMsg>
+    {
+        static constexpr const char* name = "pvtgeodetic";
+        static bool enabled(const Settings& s) { return s.publish_pvtgeodetic; }
+    };
+
+    template <>
+    struct Traits<BASE_VECTOR_CART> : Message<BaseVectorCartMsg>
+    {
+        static constexpr const char* name = "basevectorcart";
+        static bool enabled(const Settings& s) { return s.publish_basevectorcart; }
+    };
+
+    template <>
+    struct Traits<BASE_VECTOR_GEOD> : Message<BaseVectorGeodMsg>
+    {
+        static constexpr const char* name = "basevectorgeod";
+        static bool enabled(const Settings& s) { return s.publish_basevectorgeod; }
+    };
+
+    template <>
+    struct Traits<POS_COV_CARTESIAN> : Message<PosCovCartesianMsg>
+    {
+        static constexpr const char* name = "poscovcartesian";
+        static bool enabled(const Settings& s) { return s.publish_poscovcartesian; }
+    };
+
+    template <>
+    struct Traits<POS_COV_GEODETIC> : Message<PosCovGeodeticMsg>
+    {
+        static constexpr const char* name = "poscovgeodetic";
+        static bool enabled(const Settings& s) { return s.publish_poscovgeodetic; }
+    };
+
+    template <>
+    struct Traits<ATT_EULER> : Message<AttEulerMsg>
+    {
+        static constexpr const char* name = "atteuler";
+        static bool enabled(const Settings& s) { return s.publish_atteuler; }
+    };
+
+    template <>
+    struct Traits<ATT_COV_EULER> : Message<AttCovEulerMsg>
+    {
+        static constexpr const char* name = "attcoveuler";
+        static bool enabled(const Settings& s) { return s.publish_attcoveuler; }
+    };
+
+    template <>
+    struct Traits<GAL_AUTH_STATUS> : Message<GalAuthStatusMsg, STATUS>
+    {
+        static constexpr const char* name = "galauthstatus";
+        static bool enabled(const Settings& s) { return s.publish_galauthstatus; }
+    };
+
+    template <>
+    struct Traits<INS_NAV_CART> : Message<INSNavCartMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "insnavcart";
+        static bool enabled(const Settings& s) { return s.publish_insnavcart; }
+    };
+
+    template <>
+    struct Traits<INS_NAV_GEOD> : Message<INSNavGeodMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "insnavgeod";
+        static bool enabled(const Settings& s) { return s.publish_insnavgeod; }
+    };
+
+    template <>
+    struct Traits<IMU_SETUP> : Message<IMUSetupMsg, STATUS>
+    {
+        static constexpr const char* name = "imusetup";
+        static bool enabled(const Settings& s) { return s.publish_imusetup; }
+    };
+
+    template <>
+    struct Traits<VEL_SENSOR_SETUP> : Message<VelSensorSetupMsg, STATUS>
+    {
+        static constexpr const char* name = "velsensorsetup";
+        static bool enabled(const Settings& s) { return s.publish_velsensorsetup; }
+    };
+
+    template <>
+    struct Traits<EXT_EVENT_INS_NAV_CART> : Message<INSNavCartMsg>
+    {
+        static constexpr const char* name = "exteventinsnavcart";
+        static bool enabled(const Settings& s)
+        {
+            return s.publish_exteventinsnavcart;
+        }
+    };
+
+    template <>
+    struct Traits<EXT_EVENT_INS_NAV_GEOD> : Message<INSNavGeodMsg>
+    {
+        static constexpr const char* name = "exteventinsnavgeod";
+        static bool enabled(const Settings& s)
+        {
+            return s.publish_exteventinsnavgeod;
+        }
+    };
+
+    template <>
+    struct Traits<EXT_SENSOR_MEAS> : Message<ExtSensorMeasMsg, HIGH_RATE>
+    {
+        static constexpr const char* name = "extsensormeas";
+        static bool enabled(const Settings& s) { return s.publish_extsensormeas; }
+    };
+
+    template <>
+    struct Traits<MEAS_EPOCH> : Message<MeasEpochMsg>
+    {
+        static constexpr const char* name = "measepoch";
+        static bool enabled(const Settings& s) { return s.publish_measepoch; }
+    };
+
+    template <>
+    struct Traits<VEL_COV_CARTESIAN> : Message<VelCovCartesianMsg>
+    {
+        static constexpr const char* name = "velcovcartesian";
+        static bool enabled(const Settings& s) { return s.publish_velcovcartesian; }
+    };
+
+    template <>
+    struct Traits<VEL_COV_GEODETIC> : Message<VelCovGeodeticMsg>
+    {
+        static constexpr const char* name = "velcovgeodetic";
+        static bool enabled(const Settings& s) { return s.publish_velcovgeodetic; }
+    };
+
+    template <>
+    struct Traits<GPGGA> : Message<GpggaMsg>
+    {
+        static constexpr const char* name = "gpgga";
+        static bool enabled(const Settings& s) { return s.publish_gpgga; }
+    };
+
+    template <>
+    struct Traits<GPRMC> : Message<GprmcMsg>
+    {
+        static constexpr const char* name = "gprmc";
+        static bool enabled(const Settings& s) { return s.publish_gprmc; }
+    };
+
+    template <>
+    struct Traits<GPGSA> : Message<GpgsaMsg>
+    {
+        static constexpr const char* name = "gpgsa";
+        static bool enabled(const Settings& s) { return s.publish_gpgsa; }
+    };
+
+    template <>
+    struct Traits<GPGSV> : Message<GpgsvMsg>
+    {
+        static constexpr const char* name = "gpgsv";
+        static bool enabled(const Settings& s) { return s.publish_gpgsv; }
+    };
+
+    template <>
+    struct Traits<CLOCK> : Message<ClockMsg>
+    {
+        static constexpr const char* name = "/clock";
+        static bool enabled(const Settings& s) { return s.replay.publish_clock; }
+    };
+
+    template <std::size_t... ids>
+    constexpr std::array<const char*, COUNT> namesOf(std::index_sequence<ids...>)
+    {
+        return {Traits<Id(ids)>::name...};
+    }
+
+    //! Names of all topics indexed by ID
+    inline constexpr std::array<const char*, COUNT> names =
+        namesOf(std::make_index_sequence<COUNT>());
+
+    template <std::size_t... ids>
+    constexpr std::array<Group, COUNT> groupsOf(std::index_sequence<ids...>)
+    {
+        return {Traits<Id(ids)>::group...};
+    }
+
+    //! QoS groups of all topics indexed by ID
+    inline constexpr std::array<Group, COUNT> groups =
+        groupsOf(std::make_index_sequence<COUNT>());
+
+    /**
+     * @brief QoS of a topic
+     * @param[in] s Settings
+     * @return QoS configured for the topic, else the one of its group
+     */
+    template <Id id>
+    QosSettings qos(const Settings& s)
+    {
+        auto it = s.qos.find(Traits<id>::name);
+        if (it == s.qos.end())
+            it = s.qos.find(groupNames[Traits<id>::group]);
+        return (it != s.qos.end()) ? it->second : QosSettings();
+    }
+} // namespace topic
@@ -31,10 +31,15 @@
 #pragma once
 
 // std includes
-#include <any>
+#include <array>
+#include <atomic>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 // ROS includes
 #include <rclcpp/rclcpp.hpp>
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -63,9 +68,13 @@
 #include <geographic_msgs/msg/geo_pose_stamped.hpp>
 #include <gps_msgs/msg/gps_fix.hpp>
 #include <nav_msgs/msg/odometry.hpp>
+#include <rosgraph_msgs/msg/clock.hpp>
 #include <sensor_msgs/msg/imu.hpp>
 #include <sensor_msgs/msg/nav_sat_fix.hpp>
 #include <sensor_msgs/msg/time_reference.hpp>
+// Service includes
+#include <std_srvs/srv/set_bool.hpp>
+#include <std_srvs/srv/trigger.hpp>
 // GNSS msg includes
 #include <septentrio_gnss_driver/msg/aim_plus_status.hpp>
 #include <septentrio_gnss_driver/msg/att_cov_euler.hpp>
@@ -127,6 +136,7 @@ typedef sensor_msgs::msg::NavSatStatus NavSatStatusMsg;
 typedef sensor_msgs::msg::TimeReference TimeReferenceMsg;
 typedef sensor_msgs::msg::Imu ImuMsg;
 typedef nav_msgs::msg::Odometry LocalizationMsg;
+typedef rosgraph_msgs::msg::Clock ClockMsg;
 
 // Septentrio GNSS SBF messages
 typedef septentrio_gnss_driver::msg::AIMPlusStatus AimPlusStatusMsg;
@@ -164,6 +174,9 @@ typedef septentrio_gnss_driver::msg::IMUSetup IMUSetupMsg;
 typedef septentrio_gnss_driver::msg::VelSensorSetup VelSensorSetupMsg;
 typedef septentrio_gnss_driver::msg::ExtSensorMeas ExtSensorMeasMsg;
 
+// Topic table referring to the message typedefs above
+#include <septentrio_gnss_driver/abstraction/topics.hpp>
+
 /**
  * @brief Convert nsec timestamp to ROS timestamp
  * @param[in] ts timestamp in nanoseconds (Unix epoch)
@@ -208,17 +221,56 @@ class ROSaicNodeBase : public rclcpp::Node
 {
 public:
     ROSaicNodeBase(const rclcpp::NodeOptions& options) :
-        Node("septentrio_gnss", options), tf2Publisher_(this),
-        tfBuffer_(this->get_clock()), tfListener_(tfBuffer_)
+        Node("septentrio_gnss", options), parameterNode_(this),
+        logger_(this->get_logger()),
+        tf2Publisher_(std::make_shared<tf2_ros::TransformBroadcaster>(this)),
+        tfBuffer_(std::make_shared<tf2_ros::Buffer>(this->get_clock())),
+        tfListener_(std::make_shared<tf2_ros::TransformListener>(*tfBuffer_))
+    {
+    }
+
+    /**
+     * @brief Constructor of an additional receiver hosted by another node
+     *
+     * The receiver is a sub-node of the host, i.e. it shares its DDS entities,
+     * tf buffer and diagnostics. Its topics and services are put into the
+     * namespace of its name and its parameters are read from the host's
+     * parameters prefixed by its name.
+     * @param[in] host Node hosting the receiver
+     * @param[in] name Name of the receiver
+     */
+    ROSaicNodeBase(ROSaicNodeBase& host, const std::string& name) :
+        Node(host, name), diagnostic_updater_(host.diagnostic_updater_),
+        receiverName_(name), parameterNode_(host.parameterNode_),
+        parameterPrefix_(name + "."), logger_(host.logger_.get_child(name)),
+        tf2Publisher_(host.tf2Publisher_), tfBuffer_(host.tfBuffer_),
+        tfListener_(host.tfListener_)
     {
     }
 
-    ~ROSaicNodeBase() {}
+    ~ROSaicNodeBase()
+    {
+        if (subscriptionWatcher_.joinable())
+        {
+            watchingSubscriptions_ = false;
+            this->get_node_graph_interface()->notify_graph_change();
+            subscriptionWatcher_.join();
+        }
+    }
 
     bool ok() { return rclcpp::ok(); }
 
     const Settings* settings() const { return &settings_; }
 
+    //! Name of an additional receiver, empty for the receiver of the host
+    const std::string& receiverName() const { return receiverName_; }
+
+    //! Name of a diagnostics task, distinguishing the receivers of one node
+    std::string diagnosticName(const std::string& task) const
+    {
+        return receiverName_.empty() ? task : receiverName_ + "/" + task;
+    }
+
     void registerSubscriber()
     {
         try
@@ -268,6 +320,19 @@ public:
         return true;
     }
 
+    /**
+     * @brief Whether a parameter is given, e.g. in the parameter file
+     * @param[in] name The key to be used in the parameter server's dictionary
+     */
+    bool hasParam(const std::string& name) const
+    {
+        const std::string fullName = parameterPrefix_ + name;
+        return parameterNode_->has_parameter(fullName) ||
+               (parameterNode_->get_node_parameters_interface()
+                    ->get_parameter_overrides()
+                    .count(fullName) > 0);
+    }
+
     /**
      * @brief Gets parameter of type T from the parameter server
      * @param[in] name The key to be used in the parameter server's dictionary
@@ -279,19 +344,21 @@ public:
     template <typename T>
     bool param(const std::string& name, T& val, const T& defaultVal)
     {
-        if (this->has_parameter(name))
-            this->undeclare_parameter(name);
-        
+        const std::string fullName = parameterPrefix_ + name;
+        if (parameterNode_->has_parameter(fullName))
+            parameterNode_->undeclare_parameter(fullName);
+
         // Create a parameter descriptor to indicate params requiring restart
         rcl_interfaces::msg::ParameterDescriptor descriptor;
         descriptor.description = "REQUIRES RESTART.";
 
         try
         {
-            val = this->declare_parameter<T>(name, defaultVal, descriptor);
+            val = parameterNode_->declare_parameter<T>(fullName, defaultVal,
+                                                       descriptor);
         } catch (std::runtime_error& e)
         {
-            RCLCPP_WARN_STREAM(this->get_logger(), e.what());
+            RCLCPP_WARN_STREAM(logger_, e.what());
             return false;
         }
         return true;
@@ -307,34 +374,34 @@ public:
         switch (logLevel)
         {
         case log_level::DEBUG:
-            RCLCPP_DEBUG_STREAM(this->get_logger(), s);
+            RCLCPP_DEBUG_STREAM(logger_, s);
             break;
         case log_level::DEBUG_THROTTLE:
-            RCLCPP_DEBUG_THROTTLE(this->get_logger(), *this->get_clock(), duration.count(), "%s", s.c_str());
+            RCLCPP_DEBUG_THROTTLE(logger_, *this->get_clock(), duration.count(), "%s", s.c_str());
             break;
         case log_level::INFO:
-            RCLCPP_INFO_STREAM(this->get_logger(), s);
+            RCLCPP_INFO_STREAM(logger_, s);
             break;
         case log_level::INFO_THROTTLE:
-            RCLCPP_INFO_THROTTLE(this->get_logger(), *this->get_clock(), duration.count(), "%s", s.c_str());
+            RCLCPP_INFO_THROTTLE(logger_, *this->get_clock(), duration.count(), "%s", s.c_str());
             break;
         case log_level::WARN:
-            RCLCPP_WARN_STREAM(this->get_logger(), s);
+            RCLCPP_WARN_STREAM(logger_, s);
             break;
         case log_level::WARN_THROTTLE:
-            RCLCPP_WARN_THROTTLE(this->get_logger(), *this->get_clock(), duration.count(), "%s", s.c_str());
+            RCLCPP_WARN_THROTTLE(logger_, *this->get_clock(), duration.count(), "%s", s.c_str());
             break;
         case log_level::ERROR:
-            RCLCPP_ERROR_STREAM(this->get_logger(), s);
+            RCLCPP_ERROR_STREAM(logger_, s);
             break;
         case log_level::ERROR_THROTTLE:
-            RCLCPP_ERROR_THROTTLE(this->get_logger(), *this->get_clock(), duration.count(), "%s", s.c_str());
+            RCLCPP_ERROR_THROTTLE(logger_, *this->get_clock(), duration.count(), "%s", s.c_str());
             break;
         case log_level::FATAL:
-            RCLCPP_FATAL_STREAM(this->get_logger(), s);
+            RCLCPP_FATAL_STREAM(logger_, s);
             break;
         case log_level::FATAL_THROTTLE:
-            RCLCPP_FATAL_THROTTLE(this->get_logger(), *this->get_clock(), duration.count(), "%s", s.c_str());
+            RCLCPP_FATAL_THROTTLE(logger_, *this->get_clock(), duration.count(), "%s", s.c_str());
             break;
         default:
             break;
@@ -347,39 +414,75 @@ public:
      */
     Timestamp getTime() const { return this->now().nanoseconds(); }
 
+    /**
+     * @brief Creates the publishers of all topics enabled by the settings
+     *
+     * Called once the settings are read, so the first message on a topic does
+     * not pay for creating its publisher.
+     */
+    void advertiseTopics()
+    {
+        advertiseTopics(std::make_index_sequence<topic::COUNT>());
+    }
+
+    /**
+     * @brief Keeps track of the subscriptions to the advertised topics
+     *
+     * Only done with lazy decoding, where messages of topics without
+     * subscribers are neither decoded nor assembled. Subscriptions are
+     * refreshed on graph events, so a new subscriber may miss the messages
+     * published until its discovery reaches this node.
+     */
+    void watchSubscriptions()
+    {
+        if (!settings_.lazy_decoding || subscriptionWatcher_.joinable())
+            return;
+
+        refreshSubscriptions();
+        watchingSubscriptions_ = true;
+        subscriptionWatcher_ = std::thread([this]() {
+            rclcpp::Event::SharedPtr event = this->get_graph_event();
+            // Woken by graph changes, shutdown and the destructor
+            while (watchingSubscriptions_ && rclcpp::ok())
+            {
+                this->wait_for_graph_change(event, GRAPH_WAIT_TIMEOUT);
+                if (event->check_and_clear())
+                    refreshSubscriptions();
+            }
+        });
+    }
+
+    /**
+     * @brief Whether messages of a topic are to be assembled
+     * @param[in] id ID of the topic
+     * @return False only if lazy decoding is enabled and nobody subscribed
+     */
+    bool subscribed(topic::Id id) const
+    {
+        return !settings_.lazy_decoding ||
+               !idle_[id].load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Publishing function
-     * @param[in] topic String of topic
+     *
+     * Ownership of the message is handed to rclcpp, so subscribers in the same
+     * process receive it without a copy when intra-process comms are enabled.
+     * @tparam id ID of the topic
      * @param[in] msg ROS message to be published
      */
-    template <typename M>
-    void publishMessage(const std::string& topic, const M& msg)
+    template <topic::Id id>
+    void publishMessage(std::unique_ptr<typename topic::Traits<id>::type> msg)
     {
+        using M = typename topic::Traits<id>::type;
         if constexpr (has_block_header<M>::value)
         {
-            if (settings_.publish_only_valid && !validValue(msg.block_header.tow))
+            if (settings_.publish_only_valid && !validValue(msg->block_header.tow))
                 return;
         }
 
-        auto it = topicMap_.find(topic);
-        if (it != topicMap_.end())
-        {
-            typename rclcpp::Publisher<M>::SharedPtr ptr =
-                std::any_cast<typename rclcpp::Publisher<M>::SharedPtr>(it->second);
-            ptr->publish(msg);
-        } else
-        {
-            if (this->ok())
-            {
-                typename rclcpp::Publisher<M>::SharedPtr pub =
-                    this->create_publisher<M>(
-                        topic, rclcpp::QoS(rclcpp::KeepLast(queueSize_))
-                                   .durability_volatile()
-                                   .reliable());
-                topicMap_.insert(std::make_pair(topic, pub));
-                pub->publish(msg);
-            }
-        }
+        if (rclcpp::Publisher<M>* pub = publisher<id>())
+            pub->publish(std::move(msg));
     }
 
     /**
@@ -416,25 +519,25 @@ public:
             try
             {
                 // try to get tf at timestamp of message
-                T_l_b = tfBuffer_.lookupTransform(
+                T_l_b = tfBuffer_->lookupTransform(
                     loc.child_frame_id, settings_.local_frame_id, loc.header.stamp);
             } catch (const tf2::TransformException& ex)
             {
                 try
                 {
                     RCLCPP_INFO_STREAM_THROTTLE(
-                        this->get_logger(), *this->get_clock(), 10000,
+                        logger_, *this->get_clock(), 10000,
                         ": No transform for insertion of local frame at t="
                             << std::to_string(currentStamp)
                             << ". Exception: " << std::string(ex.what()));
                     // try to get latest tf
-                    T_l_b = tfBuffer_.lookupTransform(loc.child_frame_id,
-                                                      settings_.local_frame_id,
-                                                      rclcpp::Time(0));
+                    T_l_b = tfBuffer_->lookupTransform(loc.child_frame_id,
+                                                       settings_.local_frame_id,
+                                                       rclcpp::Time(0));
                 } catch (const tf2::TransformException& ex)
                 {
                     RCLCPP_WARN_STREAM_THROTTLE(
-                        this->get_logger(), *this->get_clock(), 10000,
+                        logger_, *this->get_clock(), 10000,
                         ": No most recent transform for insertion of local frame. Exception: "
                             << std::string(ex.what()));
                     return;
@@ -450,7 +553,7 @@ public:
             transformStamped.child_frame_id = settings_.local_frame_id;
         }
 
-        tf2Publisher_.sendTransform(transformStamped);
+        tf2Publisher_->sendTransform(transformStamped);
     }
 
     /**
@@ -508,10 +611,12 @@ private:
         if (stamp == 0)
             stamp = getTime();
 
-        thread_local Eigen::Vector3d vel = Eigen::Vector3d::Zero();
-        thread_local Eigen::Vector3d var = Eigen::Vector3d::Zero();
-        thread_local uint64_t ctr = 0;
-        thread_local Timestamp lastStamp = 0;
+        // Accumulated per receiver, the callbacks of all receivers of a node may
+        // run on the same thread
+        Eigen::Vector3d& vel = vsmVel_;
+        Eigen::Vector3d& var = vsmVar_;
+        uint64_t& ctr = vsmCtr_;
+        Timestamp& lastStamp = vsmLastStamp_;
 
         ++ctr;
         vel[0] += twist.twist.linear.x;
@@ -622,18 +727,128 @@ private:
     }
 
 protected:
+    //! tf buffer shared by all receivers of a node
+    tf2_ros::Buffer& tfBuffer() const { return *tfBuffer_; }
+
+    /**
+     * @brief Publisher of a topic, advertised if not done at startup
+     * @tparam id ID of the topic
+     * @return Publisher, null if the node is shutting down
+     */
+    template <topic::Id id>
+    rclcpp::Publisher<typename topic::Traits<id>::type>* publisher()
+    {
+        using M = typename topic::Traits<id>::type;
+        // Advertised publishers are never replaced, so they are read lock-free
+        if (advertised_[id].load(std::memory_order_acquire))
+            return static_cast<rclcpp::Publisher<M>*>(publishers_[id].get());
+
+        std::lock_guard<std::mutex> lock(publishersMutex_);
+        if (!publishers_[id] && this->ok())
+        {
+            const QosSettings qos = topic::qos<id>(settings_);
+            rclcpp::QoS profile(rclcpp::KeepLast(qos.depth));
+            if (qos.reliability == "best_effort")
+                profile.best_effort();
+            else
+                profile.reliable();
+            rclcpp::PublisherOptions options;
+            if (qos.durability == "transient_local")
+            {
+                profile.transient_local();
+                // Intra-process comms only support volatile durability
+                options.use_intra_process_comm =
+                    rclcpp::IntraProcessSetting::Disable;
+            } else
+            {
+                profile.durability_volatile();
+            }
+
+            auto pub = this->create_publisher<M>(topic::Traits<id>::name,
+                                                 profile, options);
+            logQos(pub->get_topic_name(), pub->get_actual_qos());
+            publishers_[id] = pub;
+            advertised_[id].store(true, std::memory_order_release);
+        }
+        // Type is fixed by the ID, so no dynamic cast is needed
+        return static_cast<rclcpp::Publisher<M>*>(publishers_[id].get());
+    }
+
     //! Settings
     Settings settings_;
     //! Send velocity to communication layer (virtual)
     virtual void sendVelocity(const std::string& velNmea) = 0;
 
 private:
-    //! Map of topics and publishers
-    std::unordered_map<std::string, std::any> topicMap_;
-    //! Publisher queue size
-    uint32_t queueSize_ = 1;
+    template <std::size_t... ids>
+    void advertiseTopics(std::index_sequence<ids...>)
+    {
+        (advertiseTopic<topic::Id(ids)>(), ...);
+    }
+
+    template <topic::Id id>
+    void advertiseTopic()
+    {
+        if (topic::Traits<id>::enabled(settings_))
+            publisher<id>();
+    }
+
+    //! Marks advertised topics without subscribers as idle
+    void refreshSubscriptions()
+    {
+        std::lock_guard<std::mutex> lock(publishersMutex_);
+        for (std::size_t id = 0; id < topic::COUNT; ++id)
+        {
+            // Not yet advertised topics are created on their first message
+            idle_[id].store(publishers_[id] &&
+                                (publishers_[id]->get_subscription_count() == 0),
+                            std::memory_order_relaxed);
+        }
+    }
+
+    //! Reports the QoS a publisher was actually created with
+    void logQos(const std::string& topic, const rclcpp::QoS& qos)
+    {
+        const rmw_qos_profile_t& profile = qos.get_rmw_qos_profile();
+        std::string reliability = "system default";
+        if (profile.reliability == RMW_QOS_POLICY_RELIABILITY_RELIABLE)
+            reliability = "reliable";
+        else if (profile.reliability == RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT)
+            reliability = "best_effort";
+        std::string durability = "system default";
+        if (profile.durability == RMW_QOS_POLICY_DURABILITY_VOLATILE)
+            durability = "volatile";
+        else if (profile.durability == RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL)
+            durability = "transient_local";
+        this->log(log_level::INFO, "Publishing " + topic + " with QoS " +
+                                       reliability + ", " + durability +
+                                       ", depth " + std::to_string(profile.depth));
+    }
+
+    //! Name of an additional receiver, empty for the receiver of the host
+    std::string receiverName_;
+    //! Node declaring the parameters, the host for additional receivers
+    rclcpp::Node* parameterNode_;
+    //! Prefix of the parameter names
+    std::string parameterPrefix_;
+    //! Logger, a child of the host's for additional receivers
+    rclcpp::Logger logger_;
+    //! Publishers indexed by topic::Id, null until advertised
+    std::array<rclcpp::PublisherBase::SharedPtr, topic::COUNT> publishers_;
+    //! Set once a publisher is advertised, publishers_ is immutable afterwards
+    std::array<std::atomic<bool>, topic::COUNT> advertised_{};
+    //! Guards advertising publishers and refreshing the subscriptions
+    std::mutex publishersMutex_;
+    //! Topics without subscribers, only tracked with lazy decoding
+    std::array<std::atomic<bool>, topic::COUNT> idle_{};
+    //! Upper bound of a wait for graph changes, only a safeguard for stopping
+    static constexpr std::chrono::seconds GRAPH_WAIT_TIMEOUT{1};
+    //! Thread refreshing the subscriptions on graph changes
+    std::thread subscriptionWatcher_;
+    //! Cleared to stop the subscription watcher
+    std::atomic<bool> watchingSubscriptions_{false};
     //! Transform publisher
-    tf2_ros::TransformBroadcaster tf2Publisher_;
+    std::shared_ptr<tf2_ros::TransformBroadcaster> tf2Publisher_;
     //! Odometry subscriber
     rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr odometrySubscriber_;
     //! Twist subscriber
@@ -641,9 +856,17 @@ private:
     //! Last tf stamp
     Timestamp lastTfStamp_ = 0;
     //! tf buffer
-    tf2_ros::Buffer tfBuffer_;
+    std::shared_ptr<tf2_ros::Buffer> tfBuffer_;
     // tf listener
-    tf2_ros::TransformListener tfListener_;
+    std::shared_ptr<tf2_ros::TransformListener> tfListener_;
+    //! Velocity accumulated for the next VSM message
+    Eigen::Vector3d vsmVel_ = Eigen::Vector3d::Zero();
+    //! Variance accumulated for the next VSM message
+    Eigen::Vector3d vsmVar_ = Eigen::Vector3d::Zero();
+    //! Number of accumulated velocities
+    uint64_t vsmCtr_ = 0;
+    //! Stamp of the last VSM message
+    Timestamp vsmLastStamp_ = 0;
     // Capabilities of Rx
     Capabilities capabilities_;
 };
\ No newline at end of file
@@ -31,8 +31,13 @@
 #pragma once
 
 // std includes
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <unordered_map>
+#include <utility>
 // ROS includes
 #include <ros/ros.h>
 // tf2 includes
@@ -43,14 +48,21 @@
 // ROS msg includes
 #include <diagnostic_msgs/DiagnosticArray.h>
 #include <diagnostic_msgs/DiagnosticStatus.h>
+#include <geographic_msgs/GeoPoseStamped.h>
+#include <geographic_msgs/GeoPoseWithCovarianceStamped.h>
 #include <geometry_msgs/PoseWithCovarianceStamped.h>
 #include <geometry_msgs/Quaternion.h>
+#include <geometry_msgs/TwistStamped.h>
 #include <geometry_msgs/TwistWithCovarianceStamped.h>
 #include <gps_common/GPSFix.h>
 #include <nav_msgs/Odometry.h>
+#include <rosgraph_msgs/Clock.h>
 #include <sensor_msgs/Imu.h>
 #include <sensor_msgs/NavSatFix.h>
 #include <sensor_msgs/TimeReference.h>
+// Service includes
+#include <std_srvs/SetBool.h>
+#include <std_srvs/Trigger.h>
 // GNSS msg includes
 #include <septentrio_gnss_driver/AIMPlusStatus.h>
 #include <septentrio_gnss_driver/AttCovEuler.h>
@@ -100,8 +112,11 @@ typedef diagnostic_msgs::DiagnosticStatus DiagnosticStatusMsg;
 typedef geometry_msgs::Quaternion QuaternionMsg;
 typedef geometry_msgs::PoseWithCovarianceStamped PoseWithCovarianceStampedMsg;
 typedef geometry_msgs::TwistWithCovarianceStamped TwistWithCovarianceStampedMsg;
+typedef geometry_msgs::TwistStamped TwistStampedMsg;
 typedef geometry_msgs::TransformStamped TransformStampedMsg;
 typedef geometry_msgs::Vector3 Vector3Msg;
+typedef geographic_msgs::GeoPoseStamped GeoPoseStampedMsg;
+typedef geographic_msgs::GeoPoseWithCovarianceStamped GeoPoseWithCovarianceStampedMsg;
 typedef gps_common::GPSFix GpsFixMsg;
 typedef gps_common::GPSStatus GpsStatusMsg;
 typedef sensor_msgs::NavSatFix NavSatFixMsg;
@@ -109,6 +124,7 @@ typedef sensor_msgs::NavSatStatus NavSatStatusMsg;
 typedef sensor_msgs::TimeReference TimeReferenceMsg;
 typedef sensor_msgs::Imu ImuMsg;
 typedef nav_msgs::Odometry LocalizationMsg;
+typedef rosgraph_msgs::Clock ClockMsg;
 
 // Septentrio GNSS SBF messages
 typedef septentrio_gnss_driver::AIMPlusStatus AimPlusStatusMsg;
@@ -146,6 +162,9 @@ typedef septentrio_gnss_driver::IMUSetup IMUSetupMsg;
 typedef septentrio_gnss_driver::VelSensorSetup VelSensorSetupMsg;
 typedef septentrio_gnss_driver::ExtSensorMeas ExtSensorMeasMsg;
 
+// Topic table referring to the message typedefs above
+#include <septentrio_gnss_driver/abstraction/topics.hpp>
+
 /**
  * @brief Convert nsec timestamp to ROS timestamp
  * @param[in] ts timestamp in nanoseconds (Unix epoch)
@@ -239,6 +258,12 @@ public:
         return true;
     }
 
+    /**
+     * @brief Whether a parameter is given, e.g. in the parameter file
+     * @param[in] name The key to be used in the parameter server's dictionary
+     */
+    bool hasParam(const std::string& name) const { return pNh_->hasParam(name); }
+
     /**
      * @brief Gets parameter of type T from the parameter server
      * @param[in] name The key to be used in the parameter server's
@@ -289,30 +314,52 @@ public:
      */
     Timestamp getTime() const { return ros::Time::now().toNSec(); }
 
+    /**
+     * @brief Creates the publishers of all topics enabled by the settings
+     *
+     * Called once the settings are read, so the first message on a topic does
+     * not pay for advertising it.
+     */
+    void advertiseTopics()
+    {
+        advertiseTopics(std::make_index_sequence<topic::COUNT>());
+    }
+
+    /**
+     * @brief Whether messages of a topic are to be assembled
+     *
+     * With lazy decoding, messages of topics without subscribers are neither
+     * decoded nor assembled. Subscriptions are tracked by the connect and
+     * disconnect callbacks of the publishers.
+     * @param[in] id ID of the topic
+     * @return False only if lazy decoding is enabled and nobody subscribed
+     */
+    bool subscribed(topic::Id id) const
+    {
+        return !settings_.lazy_decoding ||
+               !idle_[id].load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Publishing function
-     * @param[in] topic String of topic
+     *
+     * The message is published as shared pointer, so nodelets in the same
+     * process receive it without serialization.
+     * @tparam id ID of the topic
      * @param[in] msg ROS message to be published
      */
-    template <typename M>
-    void publishMessage(const std::string& topic, const M& msg)
+    template <topic::Id id>
+    void publishMessage(std::unique_ptr<typename topic::Traits<id>::type> msg)
     {
+        using M = typename topic::Traits<id>::type;
         if constexpr (has_block_header<M>::value)
         {
-            if (settings_.publish_only_valid && !validValue(msg.block_header.tow))
+            if (settings_.publish_only_valid && !validValue(msg->block_header.tow))
                 return;
         }
 
-        auto it = topicMap_.find(topic);
-        if (it != topicMap_.end())
-        {
-            it->second.publish(msg);
-        } else
-        {
-            ros::Publisher pub = pNh_->advertise<M>(topic, queueSize_);
-            topicMap_.insert(std::make_pair(topic, pub));
-            pub.publish(msg);
-        }
+        boost::shared_ptr<const M> shared(msg.release());
+        publisher<id>().publish(shared);
     }
 
     /**
@@ -557,11 +604,76 @@ protected:
     //! Send velocity to communication layer (virtual)
     virtual void sendVelocity(const std::string& velNmea) = 0;
 
+    /**
+     * @brief Publisher of a topic, advertised if not done at startup
+     * @tparam id ID of the topic
+     * @return Publisher
+     */
+    template <topic::Id id>
+    ros::Publisher& publisher()
+    {
+        // Advertised publishers are never replaced, so they are read lock-free
+        if (advertised_[id].load(std::memory_order_acquire))
+            return publishers_[id];
+
+        std::lock_guard<std::mutex> lock(publishersMutex_);
+        if (!publishers_[id])
+        {
+            // ROS 1 transports are reliable, transient local maps to latching
+            const QosSettings qos = topic::qos<id>(settings_);
+            const bool latch = (qos.durability == "transient_local");
+            ros::SubscriberStatusCallback statusCallback;
+            if (settings_.lazy_decoding)
+                statusCallback = [this](const ros::SingleSubscriberPublisher&) {
+                    refreshSubscription(id);
+                };
+            publishers_[id] = pNh_->advertise<typename topic::Traits<id>::type>(
+                topic::Traits<id>::name, qos.depth, statusCallback, statusCallback,
+                ros::VoidConstPtr(), latch);
+            advertised_[id].store(true, std::memory_order_release);
+            // Subscribers that connected before the flag was set are counted here
+            refreshSubscription(id);
+            this->log(log_level::INFO,
+                      "Publishing " + publishers_[id].getTopic() +
+                          " with queue size " + std::to_string(qos.depth) +
+                          (latch ? ", latched" : ""));
+        }
+        return publishers_[id];
+    }
+
 private:
-    //! Map of topics and publishers
-    std::unordered_map<std::string, ros::Publisher> topicMap_;
-    //! Publisher queue size
-    uint32_t queueSize_ = 1;
+    template <std::size_t... ids>
+    void advertiseTopics(std::index_sequence<ids...>)
+    {
+        (advertiseTopic<topic::Id(ids)>(), ...);
+    }
+
+    template <topic::Id id>
+    void advertiseTopic()
+    {
+        if (topic::Traits<id>::enabled(settings_))
+            publisher<id>();
+    }
+
+    /**
+     * @brief Marks a topic without subscribers as idle, called from the spinner
+     * threads, which may already see the topic while it is being advertised
+     */
+    void refreshSubscription(topic::Id id)
+    {
+        if (advertised_[id].load(std::memory_order_acquire))
+            idle_[id].store(publishers_[id].getNumSubscribers() == 0,
+                            std::memory_order_relaxed);
+    }
+
+    //! Publishers indexed by topic::Id, invalid until advertised
+    std::array<ros::Publisher, topic::COUNT> publishers_;
+    //! Set once a publisher is advertised, publishers_ is immutable afterwards
+    std::array<std::atomic<bool>, topic::COUNT> advertised_{};
+    //! Guards advertising publishers
+    std::mutex publishersMutex_;
+    //! Topics without subscribers, only tracked with lazy decoding
+    std::array<std::atomic<bool>, topic::COUNT> idle_{};
     //! Transform publisher
     tf2_ros::TransformBroadcaster tf2Publisher_;
     //! Odometry subscriber
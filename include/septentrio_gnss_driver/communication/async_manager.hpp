@@ -58,6 +58,12 @@
 
 #pragma once
 
+// C++ library includes
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <type_traits>
 // Boost includes
 #include <boost/asio.hpp>
 #include <boost/bind/bind.hpp>
@@ -69,7 +75,10 @@
 
 // local includes
 #include <septentrio_gnss_driver/communication/io.hpp>
+#include <septentrio_gnss_driver/communication/io_context_pool.hpp>
+#include <septentrio_gnss_driver/communication/reconnect_backoff.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
 
 /**
  * @file async_manager.hpp
@@ -82,6 +91,13 @@
 
 namespace io {
 
+    //! Size of the receive buffer of the AsyncManager, one read_some call fills at
+    //! most this many bytes
+    static const std::size_t RECEIVE_BUFFER_SIZE = 16384;
+    //! Time without data after which a command response is handed on even though
+    //! further lines could still continue it
+    static const std::chrono::milliseconds RESPONSE_IDLE_TIMEOUT(50);
+
     /**
      * @class AsyncManagerBase
      * @brief Interface (in C++ terms), that could be used for any I/O manager,
@@ -98,6 +114,18 @@ namespace io {
         //! Sends commands to the receiver
         virtual void send(const std::string& cmd) = 0;
         bool connected() { return false; };
+        //! Outcome of the baudrate negotiation, empty if not a serial connection
+        [[nodiscard]] virtual std::optional<BaudrateNegotiation>
+        baudrateNegotiation() const
+        {
+            return std::nullopt;
+        }
+        //! Outages of the connection, empty if the manager does not reconnect
+        [[nodiscard]] virtual std::optional<ReconnectStatistics>
+        reconnectStatistics() const
+        {
+            return std::nullopt;
+        }
     };
 
     /**
@@ -106,6 +134,10 @@ namespace io {
      * I/O operations such as reading messages and sending commands..
      *
      * IoType is either boost::asio::serial_port or boost::asio::tcp::ip
+     *
+     * The connection is supervised on the shared I/O pool: a fatal read error
+     * closes it and schedules reconnection attempts with exponential backoff on a
+     * timer. All handlers of one manager run on its own strand.
      */
     template <typename IoType>
     class AsyncManager : public AsyncManagerBase
@@ -114,9 +146,13 @@ namespace io {
         /**
          * @brief Class constructor
          * @param[in] node Pointer to node
+         * @param[in] ioPool Thread pool running the I/O
          * @param[in] telegramQueue Telegram queue
+         * @param[in] telegramPool Pool providing the telegrams
          */
-        AsyncManager(ROSaicNodeBase* node, TelegramQueue* telegramQueue);
+        AsyncManager(ROSaicNodeBase* node, std::shared_ptr<IoContextPool> ioPool,
+                     TelegramQueue* telegramQueue,
+                     std::shared_ptr<TelegramPool> telegramPool);
 
         ~AsyncManager();
 
@@ -130,44 +166,76 @@ namespace io {
 
         bool connected();
 
+        [[nodiscard]] std::optional<BaudrateNegotiation>
+        baudrateNegotiation() const override;
+
+        [[nodiscard]] std::optional<ReconnectStatistics>
+        reconnectStatistics() const override;
+
     private:
-        void receive();
-        void runIoService();
-        void runWatchdog();
+        void attemptConnect();
+        void handleConnect(bool success);
+        void handleLoss(const boost::system::error_code& ec);
+        void scheduleReconnect();
         void write(const std::string& cmd);
         void resync();
-        template <uint8_t index>
-        void readSync();
-        void readSbfHeader();
-        void readSbf(std::size_t length);
-        void readUnknown();
-        void readString();
-        void readStringElements();
+        void read();
+        void scheduleFlush();
 
         //! Pointer to the node
         ROSaicNodeBase* node_;
-        std::shared_ptr<boost::asio::io_service> ioService_;
+        //! Declared first to outlive the I/O objects created on it
+        std::shared_ptr<IoContextPool> ioPool_;
+        //! Serializes the handlers of this manager
+        Strand strand_;
+        //! Handlers referring to this manager that have not returned yet
+        PendingOperations pending_;
         IoType ioInterface_;
-        std::atomic<bool> running_;
-        std::thread ioThread_;
-        std::thread watchdogThread_;
-
-        bool connected_ = false;
-
-        std::array<uint8_t, 1> buf_;
+        std::atomic<bool> running_ = false;
+
+        std::atomic<bool> connected_ = false;
+        //! Signals the first successful connection to connect()
+        std::mutex connectMutex_;
+        std::condition_variable connectCv_;
+
+        //! Delays the next connection attempt
+        boost::asio::steady_timer reconnectTimer_;
+        //! Flushes a command response once no more data arrives
+        boost::asio::steady_timer flushTimer_;
+        ReconnectBackoff backoff_;
+        //! Start of the current outage
+        std::optional<std::chrono::steady_clock::time_point> lossTime_;
+        mutable std::mutex statisticsMutex_;
+        ReconnectStatistics statistics_;
+
+        //! Receive buffer, filled by one read_some per handler invocation
+        std::array<uint8_t, RECEIVE_BUFFER_SIZE> buf_;
         //! Timestamp of receiving buffer
         Timestamp recvStamp_;
-        //! Telegram
-        std::shared_ptr<Telegram> telegram_;
         //! TelegramQueue
         TelegramQueue* telegramQueue_;
+        //! Extracts telegrams from the received chunks
+        TelegramFramer framer_;
     };
 
     template <typename IoType>
-    AsyncManager<IoType>::AsyncManager(ROSaicNodeBase* node,
-                                       TelegramQueue* telegramQueue) :
-        node_(node), ioService_(std::make_shared<boost::asio::io_service>()),
-        ioInterface_(node, ioService_), telegramQueue_(telegramQueue)
+    AsyncManager<IoType>::AsyncManager(
+        ROSaicNodeBase* node, std::shared_ptr<IoContextPool> ioPool,
+        TelegramQueue* telegramQueue, std::shared_ptr<TelegramPool> telegramPool) :
+        node_(node), ioPool_(ioPool), strand_(ioPool_->makeStrand()),
+        ioInterface_(node, strand_), reconnectTimer_(strand_), flushTimer_(strand_),
+        backoff_(
+            std::chrono::milliseconds(node->settings()->reconnect_min_interval),
+            std::chrono::milliseconds(node->settings()->reconnect_max_interval)),
+        telegramQueue_(telegramQueue),
+        framer_(
+            [this](const std::shared_ptr<Telegram>& telegram) {
+                telegramQueue_->push(telegram);
+            },
+            [this](const std::string& fault) {
+                node_->log(log_level::DEBUG, "AsyncManager " + fault);
+            },
+            telegramPool)
     {
         node_->log(log_level::DEBUG, "AsyncManager created.");
     }
@@ -175,23 +243,25 @@ namespace io {
     template <typename IoType>
     AsyncManager<IoType>::~AsyncManager()
     {
-        if (connected_)
+        if (running_)
             close();
+        // Handlers of a send() after closing
+        if (!ioPool_->stopped())
+            pending_.wait();
     }
 
     template <typename IoType>
     [[nodiscard]] bool AsyncManager<IoType>::connect()
     {
         running_ = true;
+        boost::asio::post(strand_,
+                          [this, token = pending_.token()]() { attemptConnect(); });
 
-        if (!ioInterface_.connect())
-        {
-            return false;
-        }
-        connected_ = true;
-        receive();
-
-        return true;
+        // Failed attempts are retried until the node is shut down
+        std::unique_lock<std::mutex> lock(connectMutex_);
+        while (!connected_ && running_ && node_->ok())
+            connectCv_.wait_for(lock, std::chrono::milliseconds(100));
+        return connected_;
     }
 
     template <typename IoType>
@@ -199,16 +269,23 @@ namespace io {
     {
         running_ = false;
         connected_ = false;
-        ioInterface_.close();
-        node_->log(log_level::DEBUG, "AsyncManager shutting down threads");
-        if (ioThread_.joinable())
+        node_->log(log_level::DEBUG, "AsyncManager closing");
+        if (ioPool_->stopped() || ioPool_->runningInThisThread())
         {
-            ioService_->stop();
-            ioThread_.join();
+            reconnectTimer_.cancel();
+            flushTimer_.cancel();
+            ioInterface_.close();
+        } else
+        {
+            // Aborted operations complete on the strand, none are started anymore
+            boost::asio::post(strand_, [this, token = pending_.token()]() {
+                reconnectTimer_.cancel();
+                flushTimer_.cancel();
+                ioInterface_.close();
+            });
+            pending_.wait();
         }
-        if (watchdogThread_.joinable())
-            watchdogThread_.join();
-        node_->log(log_level::DEBUG, "AsyncManager threads stopped");
+        node_->log(log_level::DEBUG, "AsyncManager closed");
     }
 
     template <typename IoType>
@@ -227,7 +304,8 @@ namespace io {
             return;
         }
 
-        ioService_->post(boost::bind(&AsyncManager<IoType>::write, this, cmd));
+        boost::asio::post(strand_,
+                          [this, cmd, token = pending_.token()]() { write(cmd); });
     }
 
     template <typename IoType>
@@ -237,50 +315,92 @@ namespace io {
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::receive()
+    std::optional<BaudrateNegotiation>
+    AsyncManager<IoType>::baudrateNegotiation() const
     {
-        resync();
-        ioThread_ =
-            std::thread(std::bind(&AsyncManager<IoType>::runIoService, this));
-        if (!watchdogThread_.joinable())
-            watchdogThread_ =
-                std::thread(std::bind(&AsyncManager::runWatchdog, this));
+        if constexpr (std::is_same_v<IoType, SerialIo>)
+            return ioInterface_.baudrateNegotiation();
+        else
+            return std::nullopt;
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::runIoService()
+    std::optional<ReconnectStatistics>
+    AsyncManager<IoType>::reconnectStatistics() const
     {
-        ioService_->reset();
-        ioService_->run();
-        node_->log(log_level::DEBUG, "AsyncManager ioService terminated.");
+        std::lock_guard<std::mutex> lock(statisticsMutex_);
+        return statistics_;
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::runWatchdog()
+    void AsyncManager<IoType>::attemptConnect()
     {
-        while (running_)
+        if (!running_ || !node_->ok())
+            return;
+        ioInterface_.asyncConnect([this, token = pending_.token()](bool success) {
+            handleConnect(success);
+        });
+    }
+
+    template <typename IoType>
+    void AsyncManager<IoType>::handleConnect(bool success)
+    {
+        if (!running_)
+            return;
+        if (!success)
+        {
+            scheduleReconnect();
+            return;
+        }
+
+        backoff_.reset();
+        if (lossTime_)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-            if (running_ && ioService_->stopped())
+            auto outage = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - *lossTime_);
+            lossTime_.reset();
             {
-                if (node_->settings()->read_from_sbf_log ||
-                    node_->settings()->read_from_pcap)
-                {
-                    node_->log(
-                        log_level::INFO,
-                        "AsyncManager finished reading file. Node will continue to publish queued messages.");
-                    break;
-                } else
-                {
-                    node_->log(log_level::ERROR,
-                               "AsyncManager connection lost. Trying to reconnect.");
-                    ioThread_.join();
-                    connected_ = ioInterface_.connect();
-                    if (connected_)
-                        receive();
-                }
+                std::lock_guard<std::mutex> lock(statisticsMutex_);
+                statistics_.record(outage);
             }
+            node_->log(log_level::INFO, "AsyncManager reconnected after " +
+                                            std::to_string(outage.count()) +
+                                            " ms.");
+        }
+        {
+            std::lock_guard<std::mutex> lock(connectMutex_);
+            connected_ = true;
         }
+        connectCv_.notify_all();
+        resync();
+    }
+
+    template <typename IoType>
+    void AsyncManager<IoType>::handleLoss(const boost::system::error_code& ec)
+    {
+        if (!connected_.exchange(false) || !running_)
+            return;
+        node_->log(log_level::ERROR, "AsyncManager connection lost: " +
+                                         ec.message() + ". Trying to reconnect.");
+        lossTime_ = std::chrono::steady_clock::now();
+        ioInterface_.close();
+        scheduleReconnect();
+    }
+
+    template <typename IoType>
+    void AsyncManager<IoType>::scheduleReconnect()
+    {
+        if (!running_ || !node_->ok())
+            return;
+        std::chrono::milliseconds delay = backoff_.next();
+        node_->log(log_level::DEBUG, "AsyncManager next connection attempt in " +
+                                         std::to_string(delay.count()) + " ms.");
+        reconnectTimer_.expires_after(delay);
+        reconnectTimer_.async_wait(
+            [this, token = pending_.token()](const boost::system::error_code& ec) {
+                if (!ec)
+                    attemptConnect();
+            });
     }
 
     template <typename IoType>
@@ -288,7 +408,8 @@ namespace io {
     {
         boost::asio::async_write(
             *(ioInterface_.stream_), boost::asio::buffer(cmd.data(), cmd.size()),
-            [this, cmd](boost::system::error_code ec, std::size_t /*length*/) {
+            [this, cmd, token = pending_.token()](boost::system::error_code ec,
+                                                  std::size_t /*length*/) {
                 if (!ec)
                 {
                     // Prints the data that was sent
@@ -308,167 +429,33 @@ namespace io {
     template <typename IoType>
     void AsyncManager<IoType>::resync()
     {
-        telegram_ = std::make_shared<Telegram>();
-        readSync<0>();
+        framer_.reset();
+        read();
     }
 
     template <typename IoType>
-    template <uint8_t index>
-    void AsyncManager<IoType>::readSync()
+    void AsyncManager<IoType>::read()
     {
-        static_assert(index < 3);
+        ioInterface_.stream_->async_read_some(
+            boost::asio::buffer(buf_.data(), buf_.size()),
+            [this, token = pending_.token()](boost::system::error_code ec,
+                                             std::size_t numBytes) {
+                recvStamp_ = node_->getTime();
 
-        boost::asio::async_read(
-            *(ioInterface_.stream_),
-            boost::asio::buffer(telegram_->message.data() + index, 1),
-            [this](boost::system::error_code ec, std::size_t numBytes) {
-                Timestamp stamp = node_->getTime();
+                if (numBytes > 0)
+                    framer_.feed(buf_.data(), numBytes, recvStamp_);
 
                 if (!ec)
                 {
-                    if (numBytes == 1)
-                    {
-                        uint8_t& currByte = telegram_->message[index];
-
-                        if (currByte == SYNC_BYTE_1)
-                        {
-                            telegram_->stamp = stamp;
-                            readSync<1>();
-                        } else
-                        {
-                            switch (index)
-                            {
-                            case 0:
-                            {
-                                telegram_->type = telegram_type::UNKNOWN;
-                                readUnknown();
-                                break;
-                            }
-                            case 1:
-                            {
-                                switch (currByte)
-                                {
-                                case SBF_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::SBF;
-                                    readSbfHeader();
-                                    break;
-                                }
-                                case NMEA_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::NMEA;
-                                    readSync<2>();
-                                    break;
-                                }
-                                case NMEA_INS_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::NMEA_INS;
-                                    readSync<2>();
-                                    break;
-                                }
-                                case RESPONSE_SYNC_BYTE_2:
-                                {
-                                    telegram_->type = telegram_type::RESPONSE;
-                                    readSync<2>();
-                                    break;
-                                }
-                                default:
-                                {
-                                    std::stringstream ss;
-                                    ss << std::hex << currByte;
-                                    node_->log(
-                                        log_level::DEBUG,
-                                        "AsyncManager sync byte 2 read fault, should never come here.. Received byte was " +
-                                            ss.str());
-                                    resync();
-                                    break;
-                                }
-                                }
-                                break;
-                            }
-                            case 2:
-                            {
-                                switch (currByte)
-                                {
-                                case NMEA_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::NMEA)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case NMEA_INS_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::NMEA_INS)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case RESPONSE_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::RESPONSE)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case RESPONSE_SYNC_BYTE_3a:
-                                {
-                                    if (telegram_->type == telegram_type::RESPONSE)
-                                        readString();
-                                    else
-                                        resync();
-                                    break;
-                                }
-                                case ERROR_SYNC_BYTE_3:
-                                {
-                                    if (telegram_->type == telegram_type::RESPONSE)
-                                    {
-                                        telegram_->type =
-                                            telegram_type::ERROR_RESPONSE;
-                                        readString();
-                                    } else
-                                        resync();
-                                    break;
-                                }
-                                default:
-                                {
-                                    std::stringstream ss;
-                                    ss << std::hex << currByte;
-                                    node_->log(
-                                        log_level::DEBUG,
-                                        "AsyncManager sync byte 3 read fault, should never come here. Received byte was " +
-                                            ss.str());
-                                    resync();
-                                    break;
-                                }
-                                }
-                                break;
-                            }
-                            default:
-                            {
-                                node_->log(
-                                    log_level::DEBUG,
-                                    "AsyncManager sync read fault, unknown sync byte 2 found.");
-                                resync();
-                                break;
-                            }
-                            }
-                        }
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager sync read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                    }
+                    if (framer_.responsePending())
+                        scheduleFlush();
+                    read();
                 } else
                 {
+                    framer_.flush();
                     if (connected_)
                         node_->log(log_level::DEBUG,
-                                   "AsyncManager sync read error: " + ec.message());
+                                   "AsyncManager read error: " + ec.message());
 
                     if ((boost::asio::error::eof == ec) ||
                         (boost::asio::error::network_unreachable == ec) ||
@@ -476,7 +463,7 @@ namespace io {
                         (boost::asio::error::bad_descriptor == ec) ||
                         (boost::asio::error::connection_reset == ec))
                     {
-                        ioService_->stop();
+                        handleLoss(ec);
                     } else
                     {
                         if (connected_)
@@ -487,173 +474,15 @@ namespace io {
     }
 
     template <typename IoType>
-    void AsyncManager<IoType>::readSbfHeader()
-    {
-        telegram_->message.resize(SBF_HEADER_SIZE);
-
-        boost::asio::async_read(
-            *(ioInterface_.stream_),
-            boost::asio::buffer(telegram_->message.data() + 2, SBF_HEADER_SIZE - 2),
-            [this](boost::system::error_code ec, std::size_t numBytes) {
-                if (!ec)
-                {
-                    if (numBytes == (SBF_HEADER_SIZE - 2))
-                    {
-                        uint16_t length =
-                            parsing_utilities::getLength(telegram_->message);
-                        if (length > MAX_SBF_SIZE)
-                        {
-                            node_->log(
-                                log_level::DEBUG,
-                                "AsyncManager SBF header read fault, length of block exceeds " +
-                                    std::to_string(MAX_SBF_SIZE) + ": " +
-                                    std::to_string(length));
-                        } else
-                            readSbf(length);
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager SBF header read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                        resync();
-                    }
-                } else
-                {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager SBF header read error: " +
-                                   ec.message());
-                    resync();
-                }
-            });
-    }
-
-    template <typename IoType>
-    void AsyncManager<IoType>::readSbf(std::size_t length)
+    void AsyncManager<IoType>::scheduleFlush()
     {
-        telegram_->message.resize(length);
-
-        boost::asio::async_read(
-            *(ioInterface_.stream_),
-            boost::asio::buffer(telegram_->message.data() + SBF_HEADER_SIZE,
-                                length - SBF_HEADER_SIZE),
-            [this, length](boost::system::error_code ec, std::size_t numBytes) {
-                if (!ec)
-                {
-                    if (numBytes == (length - SBF_HEADER_SIZE))
-                    {
-                        if (crc::isValid(telegram_->message))
-                        {
-                            telegramQueue_->push(telegram_);
-                        } else
-                            node_->log(log_level::DEBUG,
-                                       "AsyncManager crc failed for SBF  " +
-                                           std::to_string(parsing_utilities::getId(
-                                               telegram_->message)) +
-                                           ".");
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager SBF read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                    }
-                    resync();
-                } else
-                {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager SBF read error: " + ec.message());
-                    resync();
-                }
-            });
-    }
-
-    template <typename IoType>
-    void AsyncManager<IoType>::readUnknown()
-    {
-        telegram_->message.resize(1);
-        telegram_->message.reserve(256);
-        readStringElements();
-    }
-
-    template <typename IoType>
-    void AsyncManager<IoType>::readString()
-    {
-        telegram_->message.resize(3);
-        telegram_->message.reserve(256);
-        readStringElements();
-    }
-
-    template <typename IoType>
-    void AsyncManager<IoType>::readStringElements()
-    {
-        boost::asio::async_read(
-            *(ioInterface_.stream_), boost::asio::buffer(buf_.data(), 1),
-            [this](boost::system::error_code ec, std::size_t numBytes) {
-                if (!ec)
-                {
-                    if (numBytes == 1)
-                    {
-                        telegram_->message.push_back(buf_[0]);
-                        /*node_->log(log_level::DEBUG,
-                                   "Buffer: " +
-                                       std::string(telegram_->message.begin(),
-                                                   telegram_->message.end()));*/
-
-                        switch (buf_[0])
-                        {
-                        case SYNC_BYTE_1:
-                        {
-                            telegram_ = std::make_shared<Telegram>();
-                            telegram_->message[0] = buf_[0];
-                            telegram_->stamp = node_->getTime();
-                            node_->log(
-                                log_level::DEBUG,
-                                "AsyncManager string read fault, sync 1 found.");
-                            readSync<1>();
-                            break;
-                        }
-                        case LF:
-                        {
-                            if (telegram_->message[telegram_->message.size() - 2] ==
-                                CR)
-                                telegramQueue_->push(telegram_);
-                            else
-                                node_->log(
-                                    log_level::DEBUG,
-                                    "LF wo CR: " +
-                                        std::string(telegram_->message.begin(),
-                                                    telegram_->message.end()));
-                            resync();
-                            break;
-                        }
-                        case CONNECTION_DESCRIPTOR_FOOTER:
-                        {
-                            telegram_->type = telegram_type::CONNECTION_DESCRIPTOR;
-                            telegramQueue_->push(telegram_);
-                            resync();
-                            break;
-                        }
-                        default:
-                        {
-                            readStringElements();
-                            break;
-                        }
-                        }
-                    } else
-                    {
-                        node_->log(
-                            log_level::DEBUG,
-                            "AsyncManager string read fault, wrong number of bytes read: " +
-                                std::to_string(numBytes));
-                        resync();
-                    }
-                } else
-                {
-                    node_->log(log_level::DEBUG,
-                               "AsyncManager string read error: " + ec.message());
-                    resync();
-                }
+        flushTimer_.expires_after(RESPONSE_IDLE_TIMEOUT);
+        flushTimer_.async_wait(
+            [this, token = pending_.token()](const boost::system::error_code& ec) {
+                // Rescheduled by data that arrived after the timer had expired
+                if (!ec &&
+                    (flushTimer_.expiry() <= std::chrono::steady_clock::now()))
+                    framer_.flush();
             });
     }
-} // namespace io
\ No newline at end of file
+} // namespace io
@@ -0,0 +1,255 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+/**
+ * @file command_pipeline.hpp
+ * @brief Keeps several commands to the Rx in flight
+ *
+ * The Rx processes the commands of a connection in order and answers each with a
+ * "$R:" or, on errors, a "$R?" response that echoes the command. Instead of waiting
+ * for each response before sending the next command, up to a fixed number of
+ * commands are sent ahead and the responses are matched to them afterwards.
+ */
+
+namespace io {
+
+    //! Maximum number of commands sent to the Rx without response
+    static const std::size_t COMMAND_PIPELINE_DEPTH = 8;
+    //! Time after which an unanswered command fails the pipeline
+    static const std::chrono::milliseconds COMMAND_RESPONSE_TIMEOUT(10000);
+
+    /**
+     * @class CommandPipeline
+     * @brief Flow control and response matching for commands to the Rx
+     *
+     * The first error response or timeout fails the pipeline, after which no more
+     * commands are admitted until reset() is called.
+     */
+    class CommandPipeline
+    {
+    public:
+        //! Called with the normalized command and the response answering it
+        typedef std::function<void(const std::string&, const std::string&)>
+            ResponseCallback;
+
+        /**
+         * @brief Constructor
+         * @param[in] depth Maximum number of commands in flight
+         * @param[in] timeout Time after which an unanswered command fails
+         */
+        explicit CommandPipeline(
+            std::size_t depth = COMMAND_PIPELINE_DEPTH,
+            std::chrono::milliseconds timeout = COMMAND_RESPONSE_TIMEOUT) :
+            depth_(depth ? depth : 1), timeout_(timeout)
+        {
+        }
+
+        /**
+         * @brief Waits until a command may be sent and registers it as in flight
+         * @param[in] cmd The command, to be sent by the caller on success
+         * @return False if the pipeline has failed or was cancelled, in which case
+         * the command must not be sent
+         */
+        [[nodiscard]] bool admit(const std::string& cmd)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!waitUntil(lock, [this]() { return inFlight_.size() < depth_; }))
+                return false;
+            inFlight_.push_back(
+                Command{normalize(cmd), std::chrono::steady_clock::now()});
+            ++commands_;
+            return true;
+        }
+
+        /**
+         * @brief Matches a response of the Rx to the command it answers
+         *
+         * The response is matched to the oldest command in flight whose text it
+         * echoes. If there is none, e.g. because the Rx echoes the long form of the
+         * command name, it answers the oldest command in flight.
+         * @param[in] response The response, starting with "$R"
+         * @param[in] failure Whether the response fails the pipeline
+         */
+        void respond(const std::string& response, bool failure)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (inFlight_.empty())
+                return;
+
+            std::string echo = normalize(
+                response.substr(std::min<std::size_t>(4, response.size())));
+            auto command = inFlight_.begin();
+            for (auto it = inFlight_.begin(); it != inFlight_.end(); ++it)
+            {
+                if (!it->text.empty() && (echo.compare(0, it->text.size(),
+                                                       it->text) == 0))
+                {
+                    command = it;
+                    break;
+                }
+            }
+            std::string text = std::move(command->text);
+            inFlight_.erase(command);
+
+            if (failure && !failed_)
+            {
+                failed_ = true;
+                failure_ = normalize(response);
+            }
+            if (onResponse_)
+                onResponse_(text, response);
+            cv_.notify_all();
+        }
+
+        /**
+         * @brief Sets the callback every matched response is handed to
+         *
+         * The callback is called from the thread calling respond() with the
+         * pipeline locked and must therefore not call back into the pipeline.
+         * @param[in] onResponse Callback, empty to remove it
+         */
+        void setResponseCallback(ResponseCallback onResponse)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            onResponse_ = std::move(onResponse);
+        }
+
+        /**
+         * @brief Waits until all commands in flight are answered
+         * @return False if the pipeline has failed or was cancelled
+         */
+        [[nodiscard]] bool flush()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return waitUntil(lock, [this]() { return inFlight_.empty(); });
+        }
+
+        //! Releases all waiting threads and admits no more commands
+        void cancel()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_ = true;
+            cv_.notify_all();
+        }
+
+        //! Clears failure and statistics for a new series of commands
+        void reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inFlight_.clear();
+            failed_ = false;
+            failure_.clear();
+            commands_ = 0;
+        }
+
+        //! Whether a command failed or was not answered in time
+        [[nodiscard]] bool failed() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return failed_;
+        }
+
+        //! Response or reason that failed the pipeline
+        [[nodiscard]] std::string failure() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return failure_;
+        }
+
+        //! Number of commands admitted since the last reset
+        [[nodiscard]] std::size_t commands() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return commands_;
+        }
+
+        //! First line without trailing whitespace
+        static std::string normalize(const std::string& text)
+        {
+            std::size_t end = text.find_first_of("\r\n");
+            if (end == std::string::npos)
+                end = text.size();
+            while ((end > 0) && (text[end - 1] == ' '))
+                --end;
+            return text.substr(0, end);
+        }
+
+    private:
+        struct Command
+        {
+            //! Normalized command text
+            std::string text;
+            std::chrono::steady_clock::time_point sent;
+        };
+
+        //! Waits for the predicate unless the pipeline fails or is cancelled
+        template <typename Predicate>
+        bool waitUntil(std::unique_lock<std::mutex>& lock, Predicate predicate)
+        {
+            while (!cancelled_ && !failed_ && !predicate())
+            {
+                auto deadline = inFlight_.front().sent + timeout_;
+                if ((cv_.wait_until(lock, deadline) == std::cv_status::timeout) &&
+                    !inFlight_.empty() && (inFlight_.front().sent + timeout_ <=
+                                           std::chrono::steady_clock::now()))
+                {
+                    failed_ = true;
+                    // Only the command name, arguments may contain credentials
+                    const std::string& text = inFlight_.front().text;
+                    failure_ = "no response to " + text.substr(0, text.find(','));
+                }
+            }
+            return !cancelled_ && !failed_;
+        }
+
+        const std::size_t depth_;
+        const std::chrono::milliseconds timeout_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::deque<Command> inFlight_;
+        bool failed_ = false;
+        bool cancelled_ = false;
+        std::string failure_;
+        std::size_t commands_ = 0;
+        ResponseCallback onResponse_;
+    };
+} // namespace io
@@ -67,6 +67,9 @@
 #include <sstream>
 // ROSaic includes
 #include <septentrio_gnss_driver/communication/async_manager.hpp>
+#include <septentrio_gnss_driver/communication/mapped_sbf_reader.hpp>
+#include <septentrio_gnss_driver/communication/pcap_reader.hpp>
+#include <septentrio_gnss_driver/communication/rx_config_diff.hpp>
 #include <septentrio_gnss_driver/communication/telegram_handler.hpp>
 
 /**
@@ -108,6 +111,24 @@ namespace io {
 
         void close();
 
+        /**
+         * @brief Thread pool running the I/O, created from the settings if none
+         * has been set, to be called before connect()
+         */
+        [[nodiscard]] std::shared_ptr<IoContextPool> ioContextPool();
+
+        /**
+         * @brief Shares the thread pool of another receiver, to be called before
+         * connect()
+         * @param[in] ioPool Thread pool running the I/O
+         */
+        void setIoContextPool(std::shared_ptr<IoContextPool> ioPool);
+
+        /**
+         * @brief Registers the communication statistics with the diagnostic updater
+         */
+        void addDiagnostics();
+
         /**
          * @brief Connects the data stream
          */
@@ -154,26 +175,80 @@ namespace io {
          */
         std::string resetMainConnection();
 
+        /**
+         * @brief Epoch timeout in effect, 0 if epochs must not time out
+         *
+         * Telegrams of a replay are stamped when they are pushed, so pauses and
+         * pacing of the replay would split epochs. Replays therefore only end
+         * epochs by the time of the receiver.
+         */
+        [[nodiscard]] std::chrono::milliseconds epochTimeout() const;
+
         void processTelegrams();
 
         /**
-         * @brief Hands over to the send() method of manager_
+         * @brief Reports telegram pool and telegram queue statistics
+         * @param[out] status Diagnostic status to be filled
+         */
+        void communicationDiagnostics(
+            diagnostic_updater::DiagnosticStatusWrapper& status);
+
+        /**
+         * @brief Creates the telegram queue from the settings and starts the
+         * processing thread
+         */
+        void initializeTelegramQueue();
+
+        /**
+         * @brief Hands over to sendCommand() unless the configuration diff skips
+         * the command
          * @param cmd The command to hand over
          */
         void send(const std::string& cmd);
 
+        /**
+         * @brief Hands over to the send() method of manager_ once the command
+         * pipeline admits the command
+         * @param cmd The command to hand over
+         */
+        void sendCommand(const std::string& cmd);
+
+        /**
+         * @brief Reads back the settings of the cached Rx configuration and
+         * enables skipping the commands that would not change them
+         */
+        void startConfigDiff();
+
+        /**
+         * @brief Reads back the configured settings and caches them
+         */
+        void saveConfigDiff();
+
+        //! Disables skipping commands
+        void endConfigDiff();
+
+        //! Path of the Rx configuration cache
+        [[nodiscard]] std::string configCachePath() const;
+
         //! Pointer to Node
         ROSaicNodeBase* node_;
         //! Settings
         const Settings* settings_;
-        //! TelegramQueue
-        TelegramQueue telegramQueue_;
+        //! Pool of recycled telegrams shared by all connections
+        std::shared_ptr<TelegramPool> telegramPool_;
+        //! TelegramQueue, created on connect() once the settings are known
+        std::unique_ptr<TelegramQueue> telegramQueue_;
+        //! Total queue drops at the last diagnostics report
+        uint64_t lastReportedDrops_ = 0;
         //! TelegramHandler
         TelegramHandler telegramHandler_;
         //! Processing thread
         std::thread processingThread_;
         //! Whether connecting was successful
         bool initializedIo_ = false;
+        //! Threads running the I/O of all connections, declared before them to
+        //! outlive them
+        std::shared_ptr<IoContextPool> ioPool_;
         //! Processes I/O stream data
         //! This declaration is deliberately stream-independent (Serial or TCP).
         std::unique_ptr<AsyncManagerBase> manager_;
@@ -188,6 +263,15 @@ namespace io {
         //! Indicator for threads to run
         std::atomic<bool> running_;
 
+        //! Number of commands sent by the last complete Rx configuration
+        std::atomic<std::size_t> configurationCommands_ = 0;
+        //! Duration of the last complete Rx configuration [ms]
+        std::atomic<uint64_t> configurationTime_ = 0;
+        //! Number of set commands skipped by the last complete Rx configuration
+        std::atomic<std::size_t> configurationSkipped_ = 0;
+        //! Decides which commands are sent while configuring with diffing
+        std::unique_ptr<RxConfigDiff> configDiff_;
+
         //! Main communication port
         std::string mainConnectionPort_;
         // Port for receiving data streams
@@ -0,0 +1,290 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file epoch_aggregator.hpp
+ * @brief Collects the SBF blocks of an epoch for messages derived from several
+ */
+
+namespace io {
+
+    //! Default time the blocks of an epoch may take to arrive
+    static const std::chrono::milliseconds EPOCH_TIMEOUT(500);
+
+    /**
+     * @class EpochAggregator
+     * @brief Decides once per epoch when a derived message can be assembled
+     *
+     * Messages such as NavSatFix or GPSFix combine several SBF blocks, which the
+     * Rx outputs one after another with the same WNc and TOW. Every block of an
+     * epoch is added, and a message is reported exactly once, as soon as all the
+     * blocks it needs have arrived. Only blocks the Rx is configured to output
+     * are waited for. An epoch ends once all enabled messages were reported, with
+     * the first block of a later epoch, or when its timeout expires. Messages not
+     * reported by then are returned as partial, to be assembled from the blocks
+     * received, and the epoch is counted as incomplete. Blocks of an ended or
+     * earlier epoch are ignored.
+     */
+    class EpochAggregator
+    {
+    public:
+        //! Blocks contributing to derived messages
+        enum Block : uint16_t
+        {
+            PVT_GEODETIC = 1 << 0,
+            POS_COV_GEODETIC = 1 << 1,
+            VEL_COV_GEODETIC = 1 << 2,
+            ATT_EULER = 1 << 3,
+            ATT_COV_EULER = 1 << 4,
+            MEAS_EPOCH = 1 << 5,
+            CHANNEL_STATUS = 1 << 6,
+            DOP = 1 << 7
+        };
+        typedef uint16_t Blocks;
+        static constexpr Blocks ALL_BLOCKS = (DOP << 1) - 1;
+
+        //! Derived messages
+        enum Output : std::size_t
+        {
+            NAVSATFIX,
+            POSE,
+            TWIST,
+            GPSFIX,
+            OUTPUT_COUNT
+        };
+        typedef uint8_t Outputs;
+
+        //! Blocks a derived message is assembled from, PVTGeodetic is mandatory
+        static constexpr std::array<Blocks, OUTPUT_COUNT> NEEDS = {
+            PVT_GEODETIC | POS_COV_GEODETIC,
+            PVT_GEODETIC | POS_COV_GEODETIC | ATT_EULER | ATT_COV_EULER,
+            PVT_GEODETIC | VEL_COV_GEODETIC,
+            PVT_GEODETIC | POS_COV_GEODETIC | VEL_COV_GEODETIC | ATT_EULER |
+                ATT_COV_EULER | MEAS_EPOCH | CHANNEL_STATUS | DOP};
+
+        //! Messages of an epoch that ended before they were complete
+        struct Partial
+        {
+            Outputs outputs = 0;
+            //! Blocks of the epoch that did arrive
+            Blocks received = 0;
+        };
+
+        static constexpr Outputs bit(Output output)
+        {
+            return static_cast<Outputs>(1 << output);
+        }
+
+        /**
+         * @brief Constructor
+         * @param[in] timeout Time the blocks of an epoch may take to arrive, 0 to
+         * end epochs only with the next epoch or close()
+         */
+        explicit EpochAggregator(std::chrono::milliseconds timeout = EPOCH_TIMEOUT) :
+            timeout_(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)
+                         .count())
+        {
+        }
+
+        //! Sets the timeout, 0 disables it
+        void setTimeout(std::chrono::milliseconds timeout)
+        {
+            timeout_ = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)
+                           .count();
+        }
+
+        /**
+         * @brief Sets the blocks the Rx outputs, all by default. Messages do not
+         * wait for blocks that are not output.
+         */
+        void setBlocks(Blocks blocks) { blocks_ = blocks; }
+
+        //! Blocks the messages wait for
+        [[nodiscard]] Blocks needs(Outputs outputs) const
+        {
+            Blocks blocks = 0;
+            for (std::size_t output = 0; output < OUTPUT_COUNT; ++output)
+            {
+                if (outputs & bit(static_cast<Output>(output)))
+                    blocks |= needsOf(static_cast<Output>(output));
+            }
+            return blocks;
+        }
+
+        /**
+         * @brief Ends the current epoch if a block of the given time belongs to a
+         * later epoch or the timeout has expired. To be called before the block is
+         * parsed, so that the partial messages can still be assembled.
+         * @param[in] wnc Week number of the block
+         * @param[in] tow Time of week of the block [ms]
+         * @param[in] stamp Arrival time of the block [ns]
+         * @return Messages of the ended epoch that were not reported yet
+         */
+        Partial end(uint16_t wnc, uint32_t tow, uint64_t stamp)
+        {
+            if (!open_ || !(later(wnc * WEEK + tow) || expired(stamp)))
+                return Partial();
+            return close();
+        }
+
+        /**
+         * @brief Ends the current epoch if its timeout has expired, also to be
+         * called while no blocks arrive
+         * @param[in] stamp Current time [ns]
+         * @return Messages of the ended epoch that were not reported yet
+         */
+        Partial expire(uint64_t stamp)
+        {
+            if (!open_ || !expired(stamp))
+                return Partial();
+            return close();
+        }
+
+        /**
+         * @brief Ends the current epoch, e.g. at the end of the stream
+         * @return Messages of the ended epoch that were not reported yet
+         */
+        Partial close()
+        {
+            if (!open_)
+                return Partial();
+            open_ = false;
+            Partial partial;
+            partial.outputs = enabled_ & ~reported_;
+            partial.received = received_;
+            if (partial.outputs == 0)
+                ++complete_;
+            else
+                ++incomplete_;
+            return partial;
+        }
+
+        /**
+         * @brief Adds a block of an epoch. end() has to be called first, otherwise
+         * the partial messages of an epoch ended by the block are lost.
+         * @param[in] wnc Week number of the block
+         * @param[in] tow Time of week of the block [ms]
+         * @param[in] block Type of the block
+         * @param[in] stamp Arrival time of the block [ns]
+         * @param[in] enabled Messages to be assembled
+         * @return Messages which have become complete with this block
+         */
+        Outputs add(uint16_t wnc, uint32_t tow, Block block, uint64_t stamp,
+                    Outputs enabled)
+        {
+            if (enabled == 0)
+                return 0;
+
+            const uint64_t time = wnc * WEEK + tow;
+            const bool next = later(time);
+            if (open_ && (next || expired(stamp)))
+                close();
+            if (next)
+            {
+                time_ = time;
+                start_ = stamp;
+                received_ = 0;
+                reported_ = 0;
+                open_ = true;
+            } else if (!open_ || (time < time_))
+            {
+                return 0;
+            }
+
+            enabled_ = enabled;
+            received_ |= block;
+            Outputs complete = 0;
+            for (std::size_t output = 0; output < OUTPUT_COUNT; ++output)
+            {
+                const Outputs b = bit(static_cast<Output>(output));
+                if ((enabled & b) && !(reported_ & b) &&
+                    ((needsOf(static_cast<Output>(output)) & ~received_) == 0))
+                    complete |= b;
+            }
+            reported_ |= complete;
+            if ((enabled_ & ~reported_) == 0)
+                close();
+            return complete;
+        }
+
+        //! Epochs of which all enabled messages were reported
+        [[nodiscard]] uint64_t completeEpochs() const { return complete_; }
+
+        //! Epochs that ended before all enabled messages could be reported
+        [[nodiscard]] uint64_t incompleteEpochs() const { return incomplete_; }
+
+    private:
+        //! Duration of a week [ms]
+        static constexpr uint64_t WEEK = 604800000;
+        //! Backward jump of the time treated as restart [ms]
+        static constexpr uint64_t RESTART = 60000;
+
+        [[nodiscard]] Blocks needsOf(Output output) const
+        {
+            return NEEDS[output] & (blocks_ | PVT_GEODETIC);
+        }
+
+        //! Whether a time starts a new epoch
+        [[nodiscard]] bool later(uint64_t time) const
+        {
+            // Time jumping back, e.g. with concatenated logs, starts anew
+            return (time > time_) || (time + RESTART < time_);
+        }
+
+        [[nodiscard]] bool expired(uint64_t stamp) const
+        {
+            return (timeout_ != 0) && (stamp > start_ + timeout_);
+        }
+
+        //! Timeout [ns], 0 if disabled
+        uint64_t timeout_;
+        Blocks blocks_ = ALL_BLOCKS;
+        //! Time of the current epoch since the start of GPS time [ms]
+        uint64_t time_ = 0;
+        //! Arrival time of the first block of the current epoch [ns]
+        uint64_t start_ = 0;
+        bool open_ = false;
+        Blocks received_ = 0;
+        Outputs enabled_ = 0;
+        Outputs reported_ = 0;
+        // Read by the diagnostics
+        std::atomic<uint64_t> complete_{0};
+        std::atomic<uint64_t> incomplete_{0};
+    };
+} // namespace io
@@ -31,6 +31,11 @@
 #pragma once
 
 // C++
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <mutex>
+#include <optional>
 #include <thread>
 
 // Linux
@@ -39,12 +44,7 @@
 
 // Boost
 #include <boost/asio.hpp>
-#include <boost/asio/deadline_timer.hpp>
-#include <boost/lambda/bind.hpp>
-#include <boost/lambda/lambda.hpp>
-
-// pcap
-#include <pcap.h>
+#include <boost/asio/steady_timer.hpp>
 
 // ROSaic
 #ifdef ROS2
@@ -53,7 +53,12 @@
 #ifdef ROS1
 #include <septentrio_gnss_driver/abstraction/typedefs_ros1.hpp>
 #endif
+#include <septentrio_gnss_driver/communication/io_context_pool.hpp>
+#include <septentrio_gnss_driver/communication/reconnect_backoff.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+#include <septentrio_gnss_driver/communication/telegram_pool.hpp>
+#include <septentrio_gnss_driver/communication/telegram_queue.hpp>
 
 //! Possible baudrates for the Rx
 const static std::array<uint32_t, 21> baudrates = {
@@ -63,51 +68,138 @@ const static std::array<uint32_t, 21> baudrates = {
 
 namespace io {
 
+    //! Time after which a TCP connection attempt is aborted
+    static const std::chrono::seconds TCP_CONNECT_TIMEOUT(10);
+    //! Time the Rx has to answer the probe verifying a serial link
+    static const std::chrono::milliseconds BAUDRATE_VERIFICATION_TIMEOUT(300);
+    //! Probe verifying a serial link, escapes to command mode and is answered with
+    //! the connection descriptor
+    static const std::string BAUDRATE_VERIFICATION_PROBE = "\x0DSSSSSSSSSS\x0D";
+    //! Time the Rx is given to follow a step of the baudrate ramp
+    static const std::chrono::milliseconds BAUDRATE_STEP_DELAY(500);
+
+    //! Outcome of the baudrate negotiation of a serial connection
+    struct BaudrateNegotiation
+    {
+        //! Whether the link was verified at the targeted baudrate right away
+        bool direct = false;
+        //! Whether the link was verified at all
+        bool verified = false;
+        //! Duration of the negotiation [ms]
+        uint64_t time = 0;
+    };
+
+    /**
+     * @class UdpClient
+     * @brief Receives SBF blocks and NMEA sentences on a UDP port, its handlers run
+     * on its own strand of the shared I/O pool
+     */
     class UdpClient
     {
     public:
-        UdpClient(ROSaicNodeBase* node, int16_t port, TelegramQueue* telegramQueue) :
-            node_(node), running_(true), port_(port), telegramQueue_(telegramQueue)
+        UdpClient(ROSaicNodeBase* node, std::shared_ptr<IoContextPool> ioPool,
+                  int16_t port, TelegramQueue* telegramQueue,
+                  std::shared_ptr<TelegramPool> telegramPool) :
+            node_(node), ioPool_(ioPool), strand_(ioPool_->makeStrand()),
+            running_(true), port_(port), reconnectTimer_(strand_),
+            backoff_(
+                std::chrono::milliseconds(node->settings()->reconnect_min_interval),
+                std::chrono::milliseconds(node->settings()->reconnect_max_interval)),
+            telegramQueue_(telegramQueue), telegramPool_(telegramPool)
         {
-            connect();
-            watchdogThread_ =
-                std::thread(boost::bind(&UdpClient::runWatchdog, this));
+            boost::asio::post(strand_,
+                              [this, token = pending_.token()]() { connect(); });
         }
 
         ~UdpClient()
         {
             running_ = false;
 
-            node_->log(log_level::INFO, "UDP client shutting down threads");
-            ioService_.stop();
-            ioThread_.join();
-            watchdogThread_.join();
-            node_->log(log_level::INFO, " UDP client threads stopped");
+            node_->log(log_level::INFO, "UDP client closing");
+            if (ioPool_->stopped() || ioPool_->runningInThisThread())
+            {
+                close();
+            } else
+            {
+                boost::asio::post(strand_,
+                                  [this, token = pending_.token()]() { close(); });
+                pending_.wait();
+            }
+            node_->log(log_level::INFO, "UDP client closed");
+        }
+
+        //! Outages of the socket
+        [[nodiscard]] ReconnectStatistics reconnectStatistics() const
+        {
+            std::lock_guard<std::mutex> lock(statisticsMutex_);
+            return statistics_;
         }
 
     private:
         void connect()
         {
-            socket_ = std::make_unique<boost::asio::ip::udp::socket>(
-                ioService_,
-                boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port_));
+            try
+            {
+                socket_ = std::make_unique<boost::asio::ip::udp::socket>(
+                    strand_, boost::asio::ip::udp::endpoint(
+                                 boost::asio::ip::udp::v4(), port_));
+            } catch (const boost::system::system_error& e)
+            {
+                node_->log(log_level::ERROR_THROTTLE,
+                           "Could not listen on UDP port " + std::to_string(port_) +
+                               ": " + e.what(),
+                           std::chrono::milliseconds(5000));
+                scheduleReconnect();
+                return;
+            }
 
-            asyncReceive();
+            backoff_.reset();
+            if (lossTime_)
+            {
+                auto outage = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - *lossTime_);
+                lossTime_.reset();
+                std::lock_guard<std::mutex> lock(statisticsMutex_);
+                statistics_.record(outage);
+            }
 
-            ioThread_ = std::thread(boost::bind(&UdpClient::runIoService, this));
+            asyncReceive();
 
             node_->log(log_level::INFO,
                        "Listening on UDP port " + std::to_string(port_));
         }
 
+        void close()
+        {
+            reconnectTimer_.cancel();
+            if (socket_)
+            {
+                boost::system::error_code ignored_ec;
+                socket_->close(ignored_ec);
+            }
+        }
+
+        void scheduleReconnect()
+        {
+            if (!running_)
+                return;
+            reconnectTimer_.expires_after(backoff_.next());
+            reconnectTimer_.async_wait([this, token = pending_.token()](
+                                           const boost::system::error_code& ec) {
+                if (!ec)
+                    connect();
+            });
+        }
+
         void asyncReceive()
 
         {
             socket_->async_receive_from(
                 boost::asio::buffer(buffer_, MAX_UDP_PACKET_SIZE), eP_,
-                boost::bind(&UdpClient::handleReceive, this,
-                            boost::asio::placeholders::error,
-                            boost::asio::placeholders::bytes_transferred));
+                [this, token = pending_.token()](const boost::system::error_code& ec,
+                                                 size_t bytes_recvd) {
+                    handleReceive(ec, bytes_recvd);
+                });
         }
 
         void handleReceive(const boost::system::error_code& error,
@@ -120,7 +212,7 @@ namespace io {
             {
                 while ((bytes_recvd - idx) > 2)
                 {
-                    auto telegram = std::make_shared<Telegram>();
+                    auto telegram = telegramPool_->acquire();
                     telegram->stamp = stamp;
                     /*node_->log(log_level::DEBUG,
                                "Buffer: " + std::string(telegram->message.begin(),
@@ -133,6 +225,9 @@ namespace io {
                             {
                                 uint16_t length = parsing_utilities::parseUInt16(
                                     &buffer_[idx + 6]);
+                                if (length > telegram->message.capacity())
+                                    telegram = telegramPool_->acquire(length);
+                                telegram->stamp = stamp;
                                 telegram->message.assign(&buffer_[idx],
                                                          &buffer_[idx + length]);
                                 if (crc::isValid(telegram->message))
@@ -185,36 +280,21 @@ namespace io {
                 }
             } else
             {
-                node_->log(log_level::ERROR,
-                           "UDP client receive error: " + error.message());
+                if ((error == boost::asio::error::operation_aborted) || !running_)
+                    return;
+                node_->log(log_level::ERROR, "UDP client receive error: " +
+                                                 error.message() +
+                                                 ". Trying to reconnect.");
+                lossTime_ = std::chrono::steady_clock::now();
+                boost::system::error_code ignored_ec;
+                socket_->close(ignored_ec);
+                scheduleReconnect();
+                return;
             }
 
             asyncReceive();
         }
 
-        void runIoService()
-        {
-            ioService_.run();
-            node_->log(log_level::INFO, "UDP client ioService terminated.");
-        }
-
-        void runWatchdog()
-        {
-            while (running_)
-            {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-
-                if (running_ && ioService_.stopped())
-                {
-                    node_->log(log_level::ERROR,
-                               "UDP client connection lost. Trying to reconnect.");
-                    ioService_.reset();
-                    ioThread_.join();
-                    connect();
-                }
-            }
-        }
-
     private:
         size_t findNmeaEnd(size_t idx, size_t bytes_recvd)
         {
@@ -231,132 +311,130 @@ namespace io {
         }
         //! Pointer to the node
         ROSaicNodeBase* node_;
+        //! Declared first to outlive the I/O objects created on it
+        std::shared_ptr<IoContextPool> ioPool_;
+        //! Serializes the handlers of this client
+        Strand strand_;
+        //! Handlers referring to this client that have not returned yet
+        PendingOperations pending_;
         std::atomic<bool> running_;
         int16_t port_;
-        boost::asio::io_service ioService_;
-        std::thread ioThread_;
-        std::thread watchdogThread_;
+        //! Delays reopening the socket after an error
+        boost::asio::steady_timer reconnectTimer_;
+        ReconnectBackoff backoff_;
+        //! Start of the current outage
+        std::optional<std::chrono::steady_clock::time_point> lossTime_;
+        mutable std::mutex statisticsMutex_;
+        ReconnectStatistics statistics_;
         boost::asio::ip::udp::endpoint eP_;
         std::unique_ptr<boost::asio::ip::udp::socket> socket_;
         std::array<uint8_t, MAX_UDP_PACKET_SIZE> buffer_;
         TelegramQueue* telegramQueue_;
+        std::shared_ptr<TelegramPool> telegramPool_;
     };
 
     class TcpIo
     {
     public:
-        TcpIo(ROSaicNodeBase* node,
-              std::shared_ptr<boost::asio::io_service> ioService) :
-            node_(node), ioService_(ioService), deadline_(*ioService_)
+        TcpIo(ROSaicNodeBase* node, const Strand& strand) :
+            node_(node), strand_(strand), resolver_(strand_), connectTimer_(strand_)
         {
             port_ = node_->settings()->device_tcp_port;
-
-            deadline_.expires_at(boost::posix_time::pos_infin);
-            checkDeadline();
         }
 
-        ~TcpIo() { stream_->close(); }
+        ~TcpIo() { close(); }
 
         void close()
         {
-            deadline_.cancel();
-            stream_->close();
+            resolver_.cancel();
+            connectTimer_.cancel();
+            if (stream_)
+            {
+                boost::system::error_code ignored_ec;
+                stream_->close(ignored_ec);
+            }
         }
 
         void setPort(const std::string& port) { port_ = port; }
 
-        [[nodiscard]] bool connect()
+        /**
+         * @brief Starts a single connection attempt, to be called from the strand
+         * @param[in] handler Called with the outcome of the attempt on the strand
+         */
+        void asyncConnect(std::function<void(bool)> handler)
         {
-            boost::asio::ip::tcp::resolver::iterator endpointIterator;
-
-            try
-            {
-                boost::asio::ip::tcp::resolver resolver(*ioService_);
-                boost::asio::ip::tcp::resolver::query query(
-                    node_->settings()->device_tcp_ip, port_);
-                endpointIterator = resolver.resolve(query);
-            } catch (const std::runtime_error& e)
-            {
-                node_->log(log_level::ERROR,
-                           "Could not resolve " + node_->settings()->device_tcp_ip +
-                               " on port " + port_ + ": " + e.what());
-                return false;
-            }
-
-            stream_ = std::make_unique<boost::asio::ip::tcp::socket>(*ioService_);
-
-            node_->log(log_level::INFO, "Connecting to tcp://" +
-                                            node_->settings()->device_tcp_ip + ":" +
-                                            port_ + "...");
-
-            try
-            {
-                boost::system::error_code ec = connectInternal(endpointIterator);
-                while (node_->ok() && ec)
-                {
-                    node_->log(
-                        log_level::ERROR_THROTTLE,
-                        "TCP connection to " +
-                            endpointIterator->endpoint().address().to_string() +
-                            " on port " +
-                            std::to_string(endpointIterator->endpoint().port()) +
-                            " failed: " + ec.message() + ". Retrying ...",
-                        std::chrono::milliseconds(5000));
-                    using namespace std::chrono_literals;
-                    std::this_thread::sleep_for(1s);
-                    ec = connectInternal(endpointIterator);
-                }
-                if (ec)
-                    return false;
-
-            } catch (const std::runtime_error& e)
-            {
-                node_->log(log_level::ERROR,
-                           "Could not connect to " + endpointIterator->host_name() +
-                               ": " + endpointIterator->service_name() + ": " +
-                               e.what());
-                return false;
-            }
-
-            deadline_.expires_at(boost::posix_time::pos_infin);
-            stream_->set_option(boost::asio::ip::tcp::no_delay(true));
-            node_->log(log_level::INFO, "Connected to " +
-                                            endpointIterator->host_name() + ":" +
-                                            endpointIterator->service_name() + ".");
-            return true;
+            // Resolving a host name may take long, which must not hold a thread of
+            // the pool
+            resolver_.async_resolve(
+                node_->settings()->device_tcp_ip, port_,
+                [this, handler](
+                    const boost::system::error_code& ec,
+                    const boost::asio::ip::tcp::resolver::results_type& endpoints) {
+                    if (ec)
+                    {
+                        if (ec != boost::asio::error::operation_aborted)
+                            node_->log(log_level::ERROR,
+                                       "Could not resolve " +
+                                           node_->settings()->device_tcp_ip +
+                                           " on port " + port_ + ": " +
+                                           ec.message());
+                        handler(false);
+                        return;
+                    }
+                    connectTo(endpoints, handler);
+                });
         }
 
     private:
-        boost::system::error_code connectInternal(
-            const boost::asio::ip::tcp::resolver::iterator& endpointIterator)
-        {
-            boost::system::error_code ec;
-            deadline_.expires_from_now(boost::posix_time::seconds(10));
-            ec = boost::asio::error::would_block;
-            boost::asio::async_connect(*stream_, endpointIterator,
-                                       boost::lambda::var(ec) = boost::lambda::_1);
-            do
-                ioService_->run_one();
-            while (node_->ok() && (ec == boost::asio::error::would_block));
-            return ec;
-        }
-
-        void checkDeadline()
+        void connectTo(const boost::asio::ip::tcp::resolver::results_type& endpoints,
+                       const std::function<void(bool)>& handler)
         {
-            if (deadline_.expires_at() <=
-                boost::asio::deadline_timer::traits_type::now())
-            {
-                boost::system::error_code ignored_ec;
-                stream_->close(ignored_ec);
-
-                deadline_.expires_at(boost::posix_time::pos_infin);
-            }
-            deadline_.async_wait(boost::lambda::bind(&TcpIo::checkDeadline, this));
+            stream_ = std::make_unique<boost::asio::ip::tcp::socket>(strand_);
+
+            node_->log(log_level::DEBUG, "Connecting to tcp://" +
+                                             node_->settings()->device_tcp_ip + ":" +
+                                             port_ + "...");
+
+            // Aborts the attempt by closing the socket, holding on to the handler
+            // keeps the caller from being destroyed while waiting
+            connectTimer_.expires_after(TCP_CONNECT_TIMEOUT);
+            connectTimer_.async_wait(
+                [this, handler](const boost::system::error_code& ec) {
+                    if (!ec)
+                    {
+                        boost::system::error_code ignored_ec;
+                        stream_->close(ignored_ec);
+                    }
+                });
+
+            boost::asio::async_connect(
+                *stream_, endpoints,
+                [this, handler](const boost::system::error_code& ec,
+                                const boost::asio::ip::tcp::endpoint& endpoint) {
+                    connectTimer_.cancel();
+                    if (ec)
+                    {
+                        node_->log(log_level::ERROR_THROTTLE,
+                                   "TCP connection to " +
+                                       node_->settings()->device_tcp_ip +
+                                       " on port " + port_ +
+                                       " failed: " + ec.message(),
+                                   std::chrono::milliseconds(5000));
+                        handler(false);
+                        return;
+                    }
+                    stream_->set_option(boost::asio::ip::tcp::no_delay(true));
+                    node_->log(log_level::INFO,
+                               "Connected to " + endpoint.address().to_string() +
+                                   ":" + std::to_string(endpoint.port()) + ".");
+                    handler(true);
+                });
         }
 
         ROSaicNodeBase* node_;
-        std::shared_ptr<boost::asio::io_service> ioService_;
-        boost::asio::deadline_timer deadline_;
+        Strand strand_;
+        boost::asio::ip::tcp::resolver resolver_;
+        boost::asio::steady_timer connectTimer_;
 
         std::string port_;
 
@@ -367,52 +445,118 @@ namespace io {
     class SerialIo
     {
     public:
-        SerialIo(ROSaicNodeBase* node,
-                 std::shared_ptr<boost::asio::io_service> ioService) :
-            node_(node), ioService_(ioService),
+        SerialIo(ROSaicNodeBase* node, const Strand& strand) :
+            node_(node), strand_(strand),
             flowcontrol_(node->settings()->hw_flow_control),
-            baudrate_(node->settings()->baudrate)
+            baudrate_(node->settings()->baudrate), timer_(strand_),
+            probeFramer_([this](const std::shared_ptr<Telegram>& telegram) {
+                if (telegram->type == telegram_type::CONNECTION_DESCRIPTOR)
+                    verified_ |= isConnectionDescriptor(telegram->message);
+                else
+                    verified_ |= (telegram->type != telegram_type::UNKNOWN);
+            })
         {
-            stream_ = std::make_unique<boost::asio::serial_port>(*ioService_);
+            stream_ = std::make_unique<boost::asio::serial_port>(strand_);
         }
 
         ~SerialIo() { stream_->close(); }
 
-        void close() { stream_->close(); }
+        void close()
+        {
+            timer_.cancel();
+            boost::system::error_code ignored_ec;
+            stream_->close(ignored_ec);
+        }
 
-        [[nodiscard]] bool connect()
+        /**
+         * @brief Starts a single connection attempt, to be called from the strand
+         *
+         * The baudrate is negotiated by asynchronous operations on the strand, so
+         * that the other connections on the pool are served in the meantime.
+         * @param[in] handler Called with the outcome of the attempt on the strand
+         */
+        void asyncConnect(std::function<void(bool)> handler)
         {
-            if (stream_->is_open())
+            if (!open())
             {
-                stream_->close();
+                handler(false);
+                return;
             }
 
-            bool opened = false;
-
-            while (!opened && node_->ok())
-            {
-                try
+            // Jumping to the targeted baudrate directly, the ramp is only needed if
+            // the Rx does not answer at that rate
+            negotiationStart_ = std::chrono::steady_clock::now();
+            verifyLink([this, handler](bool direct) {
+                if (!stream_->is_open())
                 {
-                    node_->log(log_level::INFO,
-                               "Connecting serially to device " +
-                                   node_->settings()->device +
-                                   ", targeted baudrate: " +
-                                   std::to_string(node_->settings()->baudrate));
-                    stream_->open(node_->settings()->device);
-                    opened = true;
-                } catch (const boost::system::system_error& err)
+                    handler(false);
+                    return;
+                }
+                if (direct)
                 {
-                    node_->log(log_level::ERROR, "Could not open serial port " +
-                                                     node_->settings()->device +
-                                                     ". Error: " + err.what() +
-                                                     ". Will retry every second.");
+                    finishNegotiation(true, true, handler);
+                    return;
+                }
 
-                    using namespace std::chrono_literals;
-                    std::this_thread::sleep_for(1s);
+                node_->log(log_level::WARN,
+                           "No answer from the Rx at " + std::to_string(baudrate_) +
+                               " baud, increasing the baudrate gradually from " +
+                               std::to_string(initialBaudrate_.value()) + " baud.");
+                boost::system::error_code ec;
+                stream_->set_option(initialBaudrate_, ec);
+                if (ec)
+                {
+                    handler(false);
+                    return;
                 }
-            }
-            if (!opened)
+                setBaudrate(0, [this, handler](bool success) {
+                    if (!success)
+                    {
+                        handler(false);
+                        return;
+                    }
+                    verifyLink([this, handler](bool verified) {
+                        if (!stream_->is_open())
+                        {
+                            handler(false);
+                            return;
+                        }
+                        if (!verified)
+                            node_->log(log_level::WARN,
+                                       "No answer from the Rx at " +
+                                           std::to_string(baudrate_) +
+                                           " baud after increasing the baudrate "
+                                           "gradually.");
+                        finishNegotiation(false, verified, handler);
+                    });
+                });
+            });
+        }
+
+    private:
+        //! Opens the port with the targeted baudrate, which is yet to be verified
+        [[nodiscard]] bool open()
+        {
+            close();
+
+            try
+            {
+                node_->log(log_level::INFO,
+                           "Connecting serially to device " +
+                               node_->settings()->device + ", targeted baudrate: " +
+                               std::to_string(node_->settings()->baudrate));
+                stream_->open(node_->settings()->device);
+            } catch (const boost::system::system_error& err)
+            {
+                node_->log(log_level::ERROR_THROTTLE,
+                           "Could not open serial port " +
+                               node_->settings()->device + ". Error: " + err.what(),
+                           std::chrono::milliseconds(5000));
                 return false;
+            }
+
+            // Baudrate the port was left at, the starting point of the ramp
+            stream_->get_option(initialBaudrate_);
 
             // No Parity, 8bits data, 1 stop Bit
             stream_->set_option(boost::asio::serial_port_base::baud_rate(baudrate_));
@@ -440,221 +584,190 @@ namespace io {
             serialInfo.flags |= ASYNC_LOW_LATENCY;
             ioctl(fd, TIOCSSERIAL, &serialInfo);
 
-            return setBaudrate();
+            return true;
         }
 
-        [[nodiscard]] bool setBaudrate()
+        void finishNegotiation(bool direct, bool verified,
+                               const std::function<void(bool)>& handler)
         {
-            // Setting the baudrate, incrementally..
-            node_->log(log_level::DEBUG,
-                       "Gradually increasing the baudrate to the desired value...");
-            boost::asio::serial_port_base::baud_rate current_baudrate;
-            node_->log(log_level::DEBUG, "Initiated current_baudrate object...");
-            try
-            {
-                stream_->get_option(current_baudrate); // Note that this sets
-                                                       // current_baudrate.value()
-                                                       // often to 115200, since by
-                                                       // default, all Rx COM ports,
-                // at least for mosaic Rxs, are set to a baudrate of 115200 baud,
-                // using 8 data-bits, no parity and 1 stop-bit.
-            } catch (boost::system::system_error& e)
-            {
-
-                node_->log(log_level::ERROR, "get_option failed due to " +
-                                                 static_cast<std::string>(e.what()));
-                node_->log(log_level::INFO, "Additional info about error is " +
-                                                static_cast<std::string>(e.what()));
-                /*
-                boost::system::error_code e_loop;
-                do // Caution: Might cause infinite loop..
-                {
-                    stream_->get_option(current_baudrate, e_loop);
-                } while(e_loop);
-                */
-                return false;
-            }
-            // Gradually increase the baudrate to the desired value
-            // The desired baudrate can be lower or larger than the
-            // current baudrate; the for loop takes care of both scenarios.
-            node_->log(log_level::DEBUG,
-                       "Current baudrate is " +
-                           std::to_string(current_baudrate.value()));
-            for (uint8_t i = 0; i < baudrates.size(); i++)
-            {
-                if (current_baudrate.value() == baudrate_)
-                {
-                    break; // Break if the desired baudrate has been reached.
-                }
-                if (current_baudrate.value() >= baudrates[i] &&
-                    baudrate_ > baudrates[i])
-                {
-                    continue;
-                }
-                // Increment until Baudrate[i] matches current_baudrate.
-                try
-                {
-                    stream_->set_option(
-                        boost::asio::serial_port_base::baud_rate(baudrates[i]));
-                } catch (boost::system::system_error& e)
-                {
-
-                    node_->log(log_level::ERROR,
-                               "set_option failed due to " +
-                                   static_cast<std::string>(e.what()));
-                    node_->log(log_level::INFO,
-                               "Additional info about error is " +
-                                   static_cast<std::string>(e.what()));
-                    return false;
-                }
-                using namespace std::chrono_literals;
-                std::this_thread::sleep_for(500ms);
-
-                try
-                {
-                    stream_->get_option(current_baudrate);
-                } catch (boost::system::system_error& e)
-                {
-
-                    node_->log(log_level::ERROR,
-                               "get_option failed due to " +
-                                   static_cast<std::string>(e.what()));
-                    node_->log(log_level::INFO,
-                               "Additional info about error is " +
-                                   static_cast<std::string>(e.what()));
-                    /*
-                    boost::system::error_code e_loop;
-                    do // Caution: Might cause infinite loop..
-                    {
-                        stream_->get_option(current_baudrate, e_loop);
-                    } while(e_loop);
-                    */
-                    return false;
-                }
-                node_->log(log_level::DEBUG,
-                           "Set ASIO baudrate to " +
-                               std::to_string(current_baudrate.value()));
-            }
+            negotiationDirect_ = direct;
+            negotiationVerified_ = verified;
+            negotiationTime_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() -
+                                   negotiationStart_)
+                                   .count();
             node_->log(log_level::INFO,
-                       "Set ASIO baudrate to " +
-                           std::to_string(current_baudrate.value()) +
-                           ", leaving InitializeSerial() method");
+                       "Serial link at " + std::to_string(baudrate_) +
+                           " baud set up in " +
+                           std::to_string(negotiationTime_.load()) + " ms.");
 
             // clear io
             ::tcflush(stream_->native_handle(), TCIOFLUSH);
 
-            return true;
+            handler(true);
         }
 
-    private:
-        ROSaicNodeBase* node_;
-        std::shared_ptr<boost::asio::io_service> ioService_;
-        std::string flowcontrol_;
-        uint32_t baudrate_;
-
     public:
-        std::unique_ptr<boost::asio::serial_port> stream_;
-    };
-
-    class SbfFileIo
-    {
-    public:
-        SbfFileIo(ROSaicNodeBase* node,
-                  std::shared_ptr<boost::asio::io_service> ioService) :
-            node_(node), ioService_(ioService)
+        //! Outcome of the baudrate negotiation on the last connect
+        [[nodiscard]] BaudrateNegotiation baudrateNegotiation() const
         {
+            return BaudrateNegotiation{negotiationDirect_, negotiationVerified_,
+                                       negotiationTime_};
         }
 
-        ~SbfFileIo() { stream_->close(); }
-
-        void close() { stream_->close(); }
-
-        [[nodiscard]] bool connect()
+        //! Whether a message is a connection descriptor such as "COM1>" or "USB2>"
+        static bool isConnectionDescriptor(const std::vector<uint8_t>& message)
         {
-            node_->log(log_level::INFO, "Opening SBF file stream" +
-                                            node_->settings()->device + "...");
-
-            int fd = open(node_->settings()->device.c_str(), O_RDONLY);
-            if (fd == -1)
-            {
-                node_->log(log_level::ERROR, "open SBF file failed.");
+            if ((message.size() < 5) || (message.size() > 6))
                 return false;
-            }
-
-            try
+            for (std::size_t i = 0; i < message.size() - 1; ++i)
             {
-                stream_ = std::make_unique<boost::asio::posix::stream_descriptor>(
-                    *ioService_);
-                stream_->assign(fd);
-
-            } catch (std::runtime_error& e)
-            {
-                node_->log(log_level::ERROR, "assigning SBF file failed due to " +
-                                                 static_cast<std::string>(e.what()));
-                return false;
+                bool valid = (i < 3) ? std::isupper(message[i])
+                                     : std::isdigit(message[i]);
+                if (!valid)
+                    return false;
             }
             return true;
         }
 
     private:
-        ROSaicNodeBase* node_;
-        std::shared_ptr<boost::asio::io_service> ioService_;
-
-    public:
-        std::unique_ptr<boost::asio::posix::stream_descriptor> stream_;
-    };
-
-    class PcapFileIo
-    {
-    public:
-        PcapFileIo(ROSaicNodeBase* node,
-                   std::shared_ptr<boost::asio::io_service> ioService) :
-            node_(node), ioService_(ioService)
-        {
-        }
-
-        ~PcapFileIo()
+        /**
+         * @brief Checks whether the Rx can be understood at the current baudrate
+         *
+         * Sends the probe and waits for a telegram that cannot result from reading
+         * at a wrong baudrate, i.e. an SBF block with valid CRC, an NMEA sentence,
+         * a command response or a connection descriptor such as "COM1>".
+         * @param[in] handler Called on the strand with whether such a telegram was
+         * received within the timeout
+         */
+        void verifyLink(std::function<void(bool)> handler)
         {
-            pcap_close(pcap_);
-            stream_->close();
+            ::tcflush(stream_->native_handle(), TCIOFLUSH);
+            verified_ = false;
+            probeFramer_.reset();
+            boost::asio::async_write(
+                *stream_, boost::asio::buffer(BAUDRATE_VERIFICATION_PROBE),
+                [this, handler](const boost::system::error_code& ec, std::size_t) {
+                    if (ec)
+                    {
+                        handler(false);
+                        return;
+                    }
+                    probing_ = true;
+                    timer_.expires_after(BAUDRATE_VERIFICATION_TIMEOUT);
+                    timer_.async_wait([this](const boost::system::error_code& ec) {
+                        // An expiry that raced with the answer must neither abort
+                        // the next probe nor the reads after connecting
+                        if (!ec && probing_ &&
+                            (timer_.expiry() <= std::chrono::steady_clock::now()))
+                        {
+                            boost::system::error_code ignored_ec;
+                            stream_->cancel(ignored_ec);
+                        }
+                    });
+                    readProbeAnswer(handler);
+                });
         }
 
-        void close()
+        void readProbeAnswer(std::function<void(bool)> handler)
         {
-            pcap_close(pcap_);
-            stream_->close();
+            stream_->async_read_some(
+                boost::asio::buffer(probeBuffer_),
+                [this, handler](const boost::system::error_code& ec,
+                                std::size_t numBytes) {
+                    if (numBytes > 0)
+                        probeFramer_.feed(probeBuffer_.data(), numBytes, 0);
+                    // A response waiting for its continuation is complete as well
+                    verified_ |= probeFramer_.responsePending();
+                    if (!verified_ && !ec)
+                    {
+                        readProbeAnswer(handler);
+                        return;
+                    }
+                    probing_ = false;
+                    timer_.cancel();
+                    handler(verified_);
+                });
         }
 
-        [[nodiscard]] bool connect()
+        /**
+         * @brief Steps through the baudrates towards the targeted one, giving the Rx
+         * BAUDRATE_STEP_DELAY to follow each step
+         * @param[in] i Index of the next baudrate to consider
+         * @param[in] handler Called on the strand with whether all steps were set
+         */
+        void setBaudrate(std::size_t i, std::function<void(bool)> handler)
         {
-            try
+            boost::asio::serial_port_base::baud_rate current_baudrate;
+            boost::system::error_code ec;
+            stream_->get_option(current_baudrate, ec);
+            if (ec)
             {
-                node_->log(log_level::INFO, "Opening pcap file stream" +
-                                                node_->settings()->device + "...");
-
-                stream_ = std::make_unique<boost::asio::posix::stream_descriptor>(
-                    *ioService_);
+                node_->log(log_level::ERROR,
+                           "get_option failed due to " + ec.message());
+                handler(false);
+                return;
+            }
 
-                pcap_ = pcap_open_offline(node_->settings()->device.c_str(),
-                                          errBuff_.data());
-                stream_->assign(pcap_get_selectable_fd(pcap_));
+            // The desired baudrate can be lower or larger than the current
+            // baudrate, the ramp takes care of both scenarios
+            const uint32_t current = current_baudrate.value();
+            while ((i < baudrates.size()) && (current != baudrate_) &&
+                   (current >= baudrates[i]) && (baudrate_ > baudrates[i]))
+                ++i;
+            if ((i == baudrates.size()) || (current == baudrate_))
+            {
+                node_->log(log_level::INFO,
+                           "Set ASIO baudrate to " + std::to_string(current));
+                // clear io
+                ::tcflush(stream_->native_handle(), TCIOFLUSH);
+                handler(true);
+                return;
+            }
 
-            } catch (std::runtime_error& e)
+            stream_->set_option(
+                boost::asio::serial_port_base::baud_rate(baudrates[i]), ec);
+            if (ec)
             {
-                node_->log(log_level::ERROR, "assigning PCAP file failed due to " +
-                                                 static_cast<std::string>(e.what()));
-                return false;
+                node_->log(log_level::ERROR,
+                           "set_option failed due to " + ec.message());
+                handler(false);
+                return;
             }
-            return true;
+            node_->log(log_level::DEBUG,
+                       "Set ASIO baudrate to " + std::to_string(baudrates[i]));
+
+            timer_.expires_after(BAUDRATE_STEP_DELAY);
+            timer_.async_wait(
+                [this, i, handler](const boost::system::error_code& ec) {
+                    if (ec)
+                        handler(false);
+                    else
+                        setBaudrate(i + 1, handler);
+                });
         }
 
-    private:
         ROSaicNodeBase* node_;
-        std::shared_ptr<boost::asio::io_service> ioService_;
-        std::array<char, 100> errBuff_;
-        pcap_t* pcap_;
+        Strand strand_;
+        std::string flowcontrol_;
+        uint32_t baudrate_;
+        //! Times the verification of the link and the steps of the ramp
+        boost::asio::steady_timer timer_;
+        //! Frames the answer to the probe
+        TelegramFramer probeFramer_;
+        std::array<uint8_t, 512> probeBuffer_;
+        //! Whether the answer to the probe has been received
+        bool verified_ = false;
+        //! Whether a probe is being answered, guards the verification timeout
+        bool probing_ = false;
+        boost::asio::serial_port_base::baud_rate initialBaudrate_;
+        std::chrono::steady_clock::time_point negotiationStart_;
+        std::atomic<bool> negotiationDirect_ = false;
+        std::atomic<bool> negotiationVerified_ = false;
+        //! Duration of the last baudrate negotiation [ms]
+        std::atomic<uint64_t> negotiationTime_ = 0;
 
     public:
-        std::unique_ptr<boost::asio::posix::stream_descriptor> stream_;
+        std::unique_ptr<boost::asio::serial_port> stream_;
     };
 } // namespace io
\ No newline at end of file
@@ -0,0 +1,224 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Linux
+#include <pthread.h>
+#include <sched.h>
+
+// Boost
+#include <boost/asio.hpp>
+
+/**
+ * @file io_context_pool.hpp
+ * @brief Thread pool running the asynchronous I/O of all connections to the Rx
+ */
+
+namespace io {
+
+    //! Default number of threads running the I/O of all connections
+    static const uint32_t IO_POOL_THREADS = 2;
+
+    //! Executor serializing the handlers of one connection
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    /**
+     * @class IoContextPool
+     * @brief One io_context run by a fixed number of threads
+     *
+     * Every connection creates its I/O objects on its own strand, so its handlers
+     * never run concurrently while the number of threads does not depend on the
+     * number of connections. The threads may be pinned to a set of CPUs.
+     */
+    class IoContextPool
+    {
+    public:
+        /**
+         * @brief Starts the threads
+         * @param[in] threads Number of threads, at least one is started
+         * @param[in] cpuAffinity CPUs the threads may run on, any if empty
+         */
+        IoContextPool(uint32_t threads = IO_POOL_THREADS,
+                      const std::vector<uint16_t>& cpuAffinity = {}) :
+            work_(ioContext_.get_executor())
+        {
+            threads = std::max(threads, 1u);
+            affinityApplied_ = true;
+            for (uint32_t i = 0; i < threads; ++i)
+            {
+                threads_.emplace_back([this]() { ioContext_.run(); });
+                std::string name = "rosaic_io_" + std::to_string(i);
+                pthread_setname_np(threads_.back().native_handle(), name.c_str());
+                if (!cpuAffinity.empty())
+                    affinityApplied_ &=
+                        setAffinity(threads_.back().native_handle(), cpuAffinity);
+            }
+        }
+
+        ~IoContextPool() { stop(); }
+
+        IoContextPool(const IoContextPool&) = delete;
+        IoContextPool& operator=(const IoContextPool&) = delete;
+
+        //! io_context run by the pool
+        boost::asio::io_context& context() { return ioContext_; }
+
+        //! New strand for the handlers of one connection
+        Strand makeStrand() { return boost::asio::make_strand(ioContext_); }
+
+        //! Number of threads running the io_context
+        [[nodiscard]] std::size_t threads() const { return threads_.size(); }
+
+        //! Whether all threads could be pinned to the requested CPUs
+        [[nodiscard]] bool affinityApplied() const { return affinityApplied_; }
+
+        //! Whether the threads have been joined, handlers no longer run
+        [[nodiscard]] bool stopped() const { return stopped_; }
+
+        //! Whether the calling thread is one of the pool
+        [[nodiscard]] bool runningInThisThread() const
+        {
+            for (const auto& thread : threads_)
+                if (thread.get_id() == std::this_thread::get_id())
+                    return true;
+            return false;
+        }
+
+        /**
+         * @brief Stops the io_context and joins the threads, pending handlers are
+         * not invoked anymore
+         */
+        void stop()
+        {
+            if (stopped_.exchange(true))
+                return;
+            work_.reset();
+            ioContext_.stop();
+            for (auto& thread : threads_)
+            {
+                if (thread.get_id() == std::this_thread::get_id())
+                    thread.detach();
+                else if (thread.joinable())
+                    thread.join();
+            }
+        }
+
+    private:
+        static bool setAffinity(pthread_t thread,
+                                const std::vector<uint16_t>& cpuAffinity)
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (uint16_t cpu : cpuAffinity)
+            {
+                if (cpu >= CPU_SETSIZE)
+                    return false;
+                CPU_SET(cpu, &cpus);
+            }
+            return pthread_setaffinity_np(thread, sizeof(cpus), &cpus) == 0;
+        }
+
+        boost::asio::io_context ioContext_;
+        std::optional<boost::asio::executor_work_guard<
+            boost::asio::io_context::executor_type>>
+            work_;
+        std::vector<std::thread> threads_;
+        bool affinityApplied_ = true;
+        std::atomic<bool> stopped_ = false;
+    };
+
+    /**
+     * @class PendingOperations
+     * @brief Counts the asynchronous operations of a connection whose handlers
+     * still refer to it
+     *
+     * Each operation keeps a token until its handler returns. As the pool outlives
+     * the connection, closing waits until all tokens are gone before the
+     * connection may be destroyed. Tokens of handlers that are never invoked
+     * because the pool was stopped may outlive the counter.
+     */
+    class PendingOperations
+    {
+    public:
+        using Token = std::shared_ptr<void>;
+
+        PendingOperations() : state_(std::make_shared<State>()) {}
+
+        //! Token to be kept by the handler of one operation
+        [[nodiscard]] Token token()
+        {
+            {
+                std::lock_guard<std::mutex> lock(state_->mutex);
+                ++state_->count;
+            }
+            return Token(nullptr, [state = state_](void*) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (--state->count == 0)
+                    state->cv.notify_all();
+            });
+        }
+
+        //! Number of operations whose handlers have not returned yet
+        [[nodiscard]] std::size_t count() const
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->count;
+        }
+
+        //! Blocks until the handlers of all operations have returned
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            state_->cv.wait(lock, [this]() { return state_->count == 0; });
+        }
+
+    private:
+        struct State
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::size_t count = 0;
+        };
+        std::shared_ptr<State> state_;
+    };
+} // namespace io
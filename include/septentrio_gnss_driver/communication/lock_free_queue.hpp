@@ -0,0 +1,357 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @file lock_free_queue.hpp
+ * @brief Bounded lock-free queue for one or several producers and one consumer
+ *
+ * The ring buffer follows the bounded queue by D. Vyukov: every slot carries a
+ * sequence number telling producers and consumers whether it is free or filled,
+ * so neither side ever takes a lock. The consumer waits adaptively, it first
+ * spins, then yields and finally parks on a condition variable until a producer
+ * signals new data.
+ */
+
+namespace queue_utilities {
+    //! Hint to the CPU that the thread is busy waiting
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    /**
+     * @class ConsumerSignal
+     * @brief Adaptive wait of a single consumer for data from several producers
+     *
+     * The consumer first spins, then yields and finally parks on a condition
+     * variable until a producer calls notify(). Producers only take the mutex
+     * if the consumer is parked. One signal may be shared by several queues so that
+     * the consumer can wait on all of them at once.
+     */
+    class ConsumerSignal
+    {
+    public:
+        static const uint32_t SPIN_ITERATIONS = 2000;
+        static const uint32_t YIELD_ITERATIONS = 50;
+
+        ConsumerSignal() :
+            // Spinning only steals time from the producers on a single core
+            spinIterations_(std::thread::hardware_concurrency() > 1 ? SPIN_ITERATIONS
+                                                                    : 0)
+        {
+        }
+
+        ConsumerSignal(const ConsumerSignal&) = delete;
+        ConsumerSignal& operator=(const ConsumerSignal&) = delete;
+
+        /**
+         * @brief Waits until tryConsume succeeds
+         * @param[in] tryConsume Callable returning true once data was consumed
+         */
+        template <typename TryConsume>
+        void wait(TryConsume&& tryConsume) noexcept
+        {
+            waitUntil(tryConsume, std::chrono::steady_clock::time_point::max());
+        }
+
+        /**
+         * @brief Waits until tryConsume succeeds or the deadline has passed
+         * @param[in] tryConsume Callable returning true once data was consumed
+         * @param[in] deadline Time after which to give up
+         * @return False if nothing was consumed before the deadline
+         */
+        template <typename TryConsume>
+        bool waitUntil(TryConsume&& tryConsume,
+                       std::chrono::steady_clock::time_point deadline) noexcept
+        {
+            for (uint32_t i = 0; i < spinIterations_; ++i)
+            {
+                if (tryConsume())
+                    return true;
+                cpuRelax();
+            }
+            for (uint32_t i = 0; i < YIELD_ITERATIONS; ++i)
+            {
+                if (tryConsume())
+                    return true;
+                std::this_thread::yield();
+            }
+
+            const bool forever =
+                (deadline == std::chrono::steady_clock::time_point::max());
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                parked_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (tryConsume())
+                {
+                    parked_.store(false, std::memory_order_relaxed);
+                    return true;
+                }
+                // The mutex is held from the check until waiting, so a producer
+                // seeing the consumer parked cannot notify in between
+                bool expired = false;
+                if (forever)
+                    condition_.wait(lock);
+                else
+                    expired = (condition_.wait_until(lock, deadline) ==
+                               std::cv_status::timeout);
+                parked_.store(false, std::memory_order_relaxed);
+                lock.unlock();
+                if (tryConsume())
+                    return true;
+                if (expired)
+                    return false;
+            }
+        }
+
+        //! To be called by producers after publishing data
+        void notify() noexcept
+        {
+            // Pairs with the fence in wait: either the consumer sees the new data
+            // or the producer sees that the consumer is parked
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked_.load(std::memory_order_relaxed))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                }
+                condition_.notify_one();
+            }
+        }
+
+        //! Wait strategy of producers on a full queue
+        void backoff(uint32_t iteration) const noexcept
+        {
+            iteration += SPIN_ITERATIONS - spinIterations_;
+            if (iteration < SPIN_ITERATIONS)
+                cpuRelax();
+            else if (iteration < SPIN_ITERATIONS + YIELD_ITERATIONS)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+    private:
+        const uint32_t spinIterations_;
+        alignas(64) std::atomic<bool> parked_ = false;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+    };
+} // namespace queue_utilities
+
+/**
+ * @class LockFreeQueue
+ * @brief Bounded lock-free FIFO queue
+ *
+ * Multiple producers are supported if MultiProducer is true, otherwise push may
+ * only be called from one thread. pop must only be called from one thread, while
+ * tryPop may also be used by producers, e.g. to evict the oldest element. If a
+ * ConsumerSignal is given, the consumer may wait on it for several queues.
+ */
+template <typename T, bool MultiProducer = true>
+class LockFreeQueue
+{
+public:
+    //! Default capacity of the queue
+    static const std::size_t DEFAULT_CAPACITY = 4096;
+
+    /**
+     * @brief Constructor
+     * @param[in] capacity Capacity, rounded up to the next power of two
+     * @param[in] signal Signal shared with other queues, owned by the queue if null
+     */
+    explicit LockFreeQueue(std::size_t capacity = DEFAULT_CAPACITY,
+                           queue_utilities::ConsumerSignal* signal = nullptr) :
+        capacity_(roundUpToPowerOfTwo(capacity)), mask_(capacity_ - 1),
+        slots_(std::make_unique<Slot[]>(capacity_)),
+        ownSignal_(signal ? nullptr
+                          : std::make_unique<queue_utilities::ConsumerSignal>()),
+        signal_(signal ? signal : ownSignal_.get())
+    {
+        for (std::size_t i = 0; i < capacity_; ++i)
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        std::size_t dequeuePos = dequeuePos_.load(std::memory_order_acquire);
+        std::size_t enqueuePos = enqueuePos_.load(std::memory_order_acquire);
+        // Both positions may move between the loads, the result is approximate
+        if (enqueuePos <= dequeuePos)
+            return 0;
+        return std::min(enqueuePos - dequeuePos, capacity_);
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    /**
+     * @brief Pushes an element, waits for free space if the queue is full
+     * @param[in] input Element to be pushed
+     */
+    void push(const T& input) noexcept
+    {
+        for (uint32_t i = 0; !tryPush(input); ++i)
+            signal_->backoff(i);
+    }
+
+    /**
+     * @brief Pushes an element if there is free space
+     * @param[in] input Element to be pushed
+     * @return False if the queue was full
+     */
+    [[nodiscard]] bool tryPush(const T& input) noexcept
+    {
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if constexpr (MultiProducer)
+                {
+                    if (enqueuePos_.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else
+                {
+                    enqueuePos_.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+            } else if (diff < 0)
+            {
+                return false;
+            } else
+            {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data = input;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        signal_->notify();
+        return true;
+    }
+
+    /**
+     * @brief Pops the oldest element, waits until one is available
+     * @param[out] output Popped element
+     */
+    void pop(T& output) noexcept
+    {
+        signal_->wait([this, &output]() { return tryPop(output); });
+    }
+
+    /**
+     * @brief Pops the oldest element if there is one
+     * @param[out] output Popped element
+     * @return False if the queue was empty
+     */
+    [[nodiscard]] bool tryPop(T& output) noexcept
+    {
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true)
+        {
+            slot = &slots_[pos & mask_];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff =
+                static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0)
+            {
+                return false;
+            } else
+            {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Moving leaves no reference behind in the slot
+        output = std::move(slot->data);
+        slot->sequence.store(pos + capacity_, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value)
+    {
+        std::size_t result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<queue_utilities::ConsumerSignal> ownSignal_;
+    queue_utilities::ConsumerSignal* signal_;
+
+    //! Producer and consumer positions on separate cache lines
+    alignas(64) std::atomic<std::size_t> enqueuePos_ = 0;
+    alignas(64) std::atomic<std::size_t> dequeuePos_ = 0;
+};
@@ -0,0 +1,270 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+// Linux
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ROSaic
+#include <septentrio_gnss_driver/communication/async_manager.hpp>
+#include <septentrio_gnss_driver/communication/sbf_chunk_decoder.hpp>
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+
+/**
+ * @file mapped_sbf_reader.hpp
+ * @brief Reads SBF logs via a memory mapping, framing them on worker threads
+ */
+
+namespace io {
+
+    /**
+     * @class MappedSbfReader
+     * @brief I/O manager for SBF logs
+     *
+     * The log is mapped into memory and framed by an SbfChunkDecoder. The decoded
+     * telegrams are pushed into the telegram queue in file order, reading ahead by
+     * at most half the queue such that replay pacing is left to the consumer.
+     *
+     * If replay is to start or end at a GNSS time or only selected blocks are to
+     * be replayed, the SBF blocks are indexed in a sidecar file "<log>.idx" first,
+     * which allows to do so without framing the whole log. A full replay is
+     * framed in parallel right away.
+     */
+    class MappedSbfReader : public AsyncManagerBase
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[in] node Pointer to node
+         * @param[in] telegramQueue Telegram queue
+         * @param[in] telegramPool Pool providing the telegrams
+         */
+        MappedSbfReader(ROSaicNodeBase* node, TelegramQueue* telegramQueue,
+                        std::shared_ptr<TelegramPool> telegramPool) :
+            node_(node), telegramQueue_(telegramQueue),
+            telegramPool_(telegramPool ? std::move(telegramPool)
+                                       : std::make_shared<TelegramPool>()),
+            decoder_(node->settings()->replay.decode_threads, SBF_CHUNK_SIZE,
+                     telegramPool_),
+            replayWindow_(std::max<std::size_t>(telegramQueue->capacity() / 2, 1))
+        {
+        }
+
+        ~MappedSbfReader() { close(); }
+
+        [[nodiscard]] bool connect() override
+        {
+            node_->log(log_level::INFO, "Opening SBF file " +
+                                            node_->settings()->device + "...");
+
+            fd_ = ::open(node_->settings()->device.c_str(), O_RDONLY);
+            if (fd_ == -1)
+            {
+                node_->log(log_level::ERROR, "open SBF file failed.");
+                return false;
+            }
+
+            struct stat status;
+            if (fstat(fd_, &status) == -1)
+            {
+                node_->log(log_level::ERROR, "stat of SBF file failed.");
+                close();
+                return false;
+            }
+            size_ = static_cast<std::size_t>(status.st_size);
+
+            if (size_ > 0)
+            {
+                void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+                if (data == MAP_FAILED)
+                {
+                    node_->log(log_level::ERROR, "mapping SBF file failed.");
+                    close();
+                    return false;
+                }
+                data_ = static_cast<const uint8_t*>(data);
+                madvise(data, size_, MADV_SEQUENTIAL);
+            }
+
+            running_ = true;
+            readerThread_ = std::thread(&MappedSbfReader::run, this);
+            return true;
+        }
+
+        void close() override
+        {
+            running_ = false;
+            telegramQueue_->wakeProducers();
+            if (readerThread_.joinable())
+                readerThread_.join();
+            if (data_)
+            {
+                munmap(const_cast<uint8_t*>(data_), size_);
+                data_ = nullptr;
+            }
+            if (fd_ != -1)
+            {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        void send(const std::string& cmd) override
+        {
+            node_->log(log_level::DEBUG,
+                       "MappedSbfReader cannot send to a file, dropping: " + cmd);
+        }
+
+    private:
+        void run()
+        {
+            const ReplaySettings& replay = node_->settings()->replay;
+
+            // The index is scanned sequentially, so it is only built if needed
+            SbfIndex index;
+            if ((replay.start_time > 0.0) || (replay.end_time > 0.0) ||
+                !replay.block_ids.empty())
+            {
+                if (!index.update(node_->settings()->device + ".idx", data_,
+                                  size_))
+                    node_->log(log_level::WARN,
+                               "MappedSbfReader could not write SBF index sidecar.");
+                node_->log(log_level::DEBUG,
+                           "MappedSbfReader indexed " +
+                               std::to_string(index.entries().size()) +
+                               " SBF blocks, " + std::to_string(index.loaded()) +
+                               " of them cached.");
+            }
+
+            const std::vector<SbfIndex::Entry>& entries = index.entries();
+            std::size_t first = 0;
+            std::size_t last = entries.size();
+            if (replay.start_time > 0.0)
+                first = index.seek(toGnssTime(replay.start_time));
+            if (replay.end_time > 0.0)
+                last = std::max(first, index.seek(toGnssTime(replay.end_time) + 1));
+
+            uint64_t telegrams = 0;
+            auto deliver = [this,
+                            &telegrams](const std::shared_ptr<Telegram>& telegram) {
+                if (!telegramQueue_->waitBelow(replayWindow_, running_))
+                    return false;
+                telegram->stamp = node_->getTime();
+                telegramQueue_->push(telegram);
+                ++telegrams;
+                return true;
+            };
+
+            bool completed = true;
+            if (replay.block_ids.empty())
+            {
+                // Strings preceding the first block are kept when starting at it
+                std::size_t begin = 0;
+                if ((first == entries.size()) && (replay.start_time > 0.0))
+                    begin = size_;
+                else if (first > 0)
+                    begin = entries[first].offset;
+                std::size_t end =
+                    (last < entries.size()) ? entries[last].offset : size_;
+                completed = decoder_.decode(data_ + begin, end - begin, deliver);
+            } else
+            {
+                std::vector<bool> selected(8192, false);
+                for (uint16_t id : replay.block_ids)
+                    selected[id] = true;
+
+                uint64_t stale = 0;
+                for (std::size_t i = first; completed && (i < last); ++i)
+                {
+                    if (!selected[entries[i].id])
+                        continue;
+                    // Entries loaded from the sidecar may not match the log
+                    const std::size_t offset = entries[i].offset;
+                    const uint8_t* block = data_ + offset;
+                    if ((offset + 8 > size_) ||
+                        !crc::isValid(block, size_ - offset) ||
+                        ((parsing_utilities::parseUInt16(block + 4) & 8191) !=
+                         entries[i].id))
+                    {
+                        ++stale;
+                        continue;
+                    }
+                    uint16_t length = parsing_utilities::parseUInt16(block + 6);
+                    std::shared_ptr<Telegram> telegram =
+                        telegramPool_->acquire(length);
+                    telegram->type = telegram_type::SBF;
+                    telegram->message.assign(block, block + length);
+                    completed = deliver(telegram);
+                }
+                if (stale > 0)
+                    node_->log(log_level::WARN,
+                               "MappedSbfReader skipped " + std::to_string(stale) +
+                                   " blocks not matching the SBF index sidecar.");
+            }
+
+            if (completed)
+                node_->log(log_level::INFO,
+                           "MappedSbfReader finished reading file (" +
+                               std::to_string(telegrams) + " telegrams, " +
+                               std::to_string(decoder_.faults()) +
+                               " framing faults). Node will continue to publish "
+                               "queued messages.");
+        }
+
+        //! Converts GNSS time [s] to GNSS time [ms] as used by the index
+        static uint64_t toGnssTime(double seconds)
+        {
+            return static_cast<uint64_t>(std::llround(seconds * 1000.0));
+        }
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+        TelegramQueue* telegramQueue_;
+        std::shared_ptr<TelegramPool> telegramPool_;
+        SbfChunkDecoder decoder_;
+        //! Maximum number of queued telegrams before reading pauses
+        const std::size_t replayWindow_;
+        std::atomic<bool> running_ = false;
+        std::thread readerThread_;
+
+        int fd_ = -1;
+        const uint8_t* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+} // namespace io
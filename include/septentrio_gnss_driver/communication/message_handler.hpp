@@ -75,12 +75,15 @@
 #ifdef ROS1
 #include <septentrio_gnss_driver/abstraction/typedefs_ros1.hpp>
 #endif
+#include <septentrio_gnss_driver/communication/epoch_aggregator.hpp>
+#include <septentrio_gnss_driver/communication/replay_clock.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
 #include <septentrio_gnss_driver/crc/crc.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgga.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsa.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gpgsv.hpp>
 #include <septentrio_gnss_driver/parsers/nmea_parsers/gprmc.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_schema.hpp>
 #include <septentrio_gnss_driver/parsers/string_utilities.hpp>
 
 /**
@@ -148,26 +151,68 @@ namespace io {
          * @param[in] node Pointer to the node)
          */
         MessageHandler(ROSaicNodeBase* node) :
-            node_(node), settings_(node->settings()), unix_time_(0) {};
+            node_(node), settings_(node->settings()) {};
 
         void add_message_handler_diagnostics()
         {
-            node_->diagnostic_updater_->add("GNSS", this,
+            node_->diagnostic_updater_->add(node_->diagnosticName("GNSS"), this,
                                      &MessageHandler::assembleGNSSDiagnosticArray);
-            node_->diagnostic_updater_->add("Covariance", this,
+            node_->diagnostic_updater_->add(node_->diagnosticName("Covariance"), this,
                                      &MessageHandler::assembleCovarianceDiagnosticArray);
-            node_->diagnostic_updater_->add("Receiver", this,
+            node_->diagnostic_updater_->add(node_->diagnosticName("Receiver"), this,
                                      &MessageHandler::assembleReceiverDiagnosticArray);
             if (settings_->publish_galauthstatus) {
-                node_->diagnostic_updater_->add("OSNMA", this,
+                node_->diagnostic_updater_->add(node_->diagnosticName("OSNMA"), this,
                                         &MessageHandler::assembleOsnmaDiagnosticArray);
             }
             if (settings_->publish_aimplusstatus) {
-                node_->diagnostic_updater_->add("Aim", this,
+                node_->diagnostic_updater_->add(node_->diagnosticName("Aim"), this,
                                         &MessageHandler::assembleAimAndDiagnosticArray);
             }
+            if (settings_->publish_twist ||
+                ((settings_->septentrio_receiver_type == "gnss") &&
+                 (settings_->publish_navsatfix || settings_->publish_pose ||
+                  settings_->publish_gpsfix)))
+            {
+                node_->diagnostic_updater_->add(
+                    node_->diagnosticName("Epochs"), this,
+                    &MessageHandler::assembleEpochDiagnosticArray);
+            }
         }
 
+        /**
+         * @brief Clock pacing the replay of files
+         */
+        ReplayClock& replayClock() { return replayClock_; }
+
+        /**
+         * @brief Collects the blocks of an epoch for NavSatFix, Pose, Twist and
+         * GPSFix
+         */
+        EpochAggregator& epochAggregator() { return epochAggregator_; }
+
+        /**
+         * @brief Messages derived from several blocks that are enabled
+         * @param[in] subscribedOnly Only count messages that are subscribed to
+         */
+        EpochAggregator::Outputs derivedOutputs(bool subscribedOnly) const;
+
+        /**
+         * @brief Blocks of derived messages the Rx outputs according to the
+         * settings, reduced to the filter of a replayed SBF log
+         */
+        EpochAggregator::Blocks outputBlocks() const;
+
+        //! Block of derived messages an SBF ID stands for, 0 for other blocks
+        static EpochAggregator::Blocks epochBlock(uint16_t sbfId);
+
+        /**
+         * @brief Ends the current epoch if its timeout has expired and assembles
+         * its messages from the blocks received
+         * @param[in] stamp Current time [ns]
+         */
+        void expireEpoch(uint64_t stamp);
+
         void setLeapSeconds()
         {
             // set leap seconds to paramter if reading from file
@@ -204,13 +249,28 @@ namespace io {
         template <typename T>
         void assembleHeader(const std::string& frameId,
                             const std::shared_ptr<Telegram>& telegram, T& msg) const;
+
+        /**
+         * @brief Whether a topic is enabled and, with lazy decoding, subscribed
+         * @param[in] enabled Publish setting of the topic
+         * @param[in] id ID of the topic
+         * @return True if the message has to be assembled
+         */
+        bool publishes(bool enabled, topic::Id id) const
+        {
+            return enabled && node_->subscribed(id);
+        }
+
         /**
          * @brief Publishing function
-         * @param[in] topic String of topic
+         *
+         * Messages that are not needed afterwards should be moved in, they are
+         * handed on to the node without a copy.
+         * @tparam id ID of the topic
          * @param[in] msg ROS message to be published
          */
-        template <typename M>
-        void publish(const std::string& topic, const M& msg);
+        template <topic::Id id>
+        void publish(typename topic::Traits<id>::type msg);
 
         /**
          * @brief Publishing function
@@ -288,7 +348,7 @@ namespace io {
          * @brief Since GPSFix needs MeasEpoch (for SNRs), incoming MeasEpoch blocks
          * need to be stored
          */
-        MeasEpochMsg last_measepoch_;
+        MeasEpoch last_measepoch_;
 
         /**
          * @brief Since GPSFix needs DOP, incoming DOP blocks need to be stored
@@ -336,7 +396,13 @@ namespace io {
 
         //! When reading from an SBF file, the ROS publishing frequency is governed
         //! by the time stamps found in the SBF blocks therein.
-        Timestamp unix_time_;
+        ReplayClock replayClock_;
+
+        //! Blocks of the current epoch for messages derived from several
+        EpochAggregator epochAggregator_;
+
+        //! Incomplete epochs at the last diagnostics report
+        uint64_t last_incomplete_epochs_ = 0;
 
         //! Last reported PVT processing latency
         mutable uint64_t last_pvt_latency_ = 0;
@@ -406,6 +472,49 @@ namespace io {
          */
         void assembleAimAndDiagnosticArray(diagnostic_updater::DiagnosticStatusWrapper &aim_status);
 
+        /**
+         * @brief "Callback" function reporting the completeness of epochs
+         */
+        void assembleEpochDiagnosticArray(
+            diagnostic_updater::DiagnosticStatusWrapper& epoch_status);
+
+        /**
+         * @brief Adds a block to its epoch and assembles the messages completed
+         * by it, i.e. NavSatFix, Pose and GPSFix of a GNSS Rx and Twist
+         * @param[in] block Type of the block
+         * @param[in] header Header of the block
+         * @param[in] telegram telegram of the block
+         */
+        void aggregateEpoch(EpochAggregator::Block block,
+                            const BlockHeaderMsg& header,
+                            const std::shared_ptr<Telegram>& telegram);
+
+        /**
+         * @brief Ends the current epoch if the telegram belongs to a later one
+         * or the timeout has expired. Called before the block is parsed, which
+         * would overwrite the blocks of the ended epoch.
+         * @param[in] telegram telegram of an SBF block of an epoch
+         */
+        void endEpoch(const std::shared_ptr<Telegram>& telegram);
+
+        /**
+         * @brief Assembles the messages of an epoch that ended with blocks
+         * missing, provided that PVTGeodetic is in
+         */
+        void assemblePartialEpoch(const EpochAggregator::Partial& partial);
+
+        void assembleEpoch(EpochAggregator::Outputs outputs);
+
+        /**
+         * @brief Whether a block belongs to the epoch of the last PVTGeodetic,
+         * otherwise it is missing from that epoch
+         */
+        bool inEpoch(const BlockHeaderMsg& header) const
+        {
+            return (header.tow == last_pvtgeodetic_.block_header.tow) &&
+                   (header.wnc == last_pvtgeodetic_.block_header.wnc);
+        }
+
         /**
          * @brief "Callback" function when constructing
          * ImuMsg messages
@@ -449,7 +558,8 @@ namespace io {
         void assembleTimeReference(const std::shared_ptr<Telegram>& telegram);
 
         /**
-         * @brief Waits according to time when reading from file
+         * @brief Waits according to time when reading from file, publishes /clock
+         * if requested
          * @param[in] time_obj wait until time
          */
         void wait(Timestamp time_obj);
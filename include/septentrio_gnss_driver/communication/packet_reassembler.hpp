@@ -0,0 +1,350 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// pcap
+#include <pcap.h>
+
+// ROSaic
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+
+/**
+ * @file packet_reassembler.hpp
+ * @brief Extraction of telegrams from captured IPv4 packets
+ *
+ * TCP segments are reassembled per connection in sequence number order, dropping
+ * retransmitted bytes and buffering segments that arrive out of order. UDP
+ * datagrams are framed in order of arrival per flow, so that SBF blocks split
+ * across datagrams are reassembled. A datagram starting with an SBF sync resyncs
+ * the framer of its flow, discarding a block left incomplete by a lost datagram.
+ * Each telegram is stamped with the capture time of the packet its first byte was
+ * received in.
+ */
+
+namespace io {
+
+    //! Maximum number of out-of-order bytes buffered per TCP connection before the
+    //! missing bytes are given up
+    static const std::size_t MAX_TCP_REORDER_BYTES = 1 << 20;
+
+    /**
+     * @class PacketReassembler
+     * @brief Turns captured packets into telegrams
+     */
+    class PacketReassembler
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[in] onTelegram Called for every complete and valid telegram
+         * @param[in] pool Optional, pool telegrams are taken from
+         */
+        explicit PacketReassembler(TelegramFramer::TelegramCallback onTelegram,
+                                   std::shared_ptr<TelegramPool> pool = nullptr) :
+            onTelegram_(std::move(onTelegram)),
+            pool_(pool ? std::move(pool) : std::make_shared<TelegramPool>())
+        {
+        }
+
+        //! Whether packets with the link-layer header type can be processed
+        [[nodiscard]] static bool supportsLinkType(int linkType)
+        {
+            return (linkType == DLT_NULL) || (linkType == DLT_EN10MB) ||
+                   (linkType == DLT_RAW) || (linkType == DLT_LINUX_SLL);
+        }
+
+        /**
+         * @brief Processes a captured packet
+         * @param[in] linkType Link-layer header type as returned by pcap_datalink
+         * @param[in] packet Start of the captured packet
+         * @param[in] size Captured length of the packet
+         * @param[in] stamp Capture time of the packet
+         * @return False if the packet is no complete IPv4 TCP or UDP packet
+         */
+        bool process(int linkType, const uint8_t* packet, std::size_t size,
+                     Timestamp stamp)
+        {
+            std::size_t offset;
+            if (!ipOffset(linkType, packet, size, offset) ||
+                (size < offset + 20) || ((packet[offset] >> 4) != 4))
+                return false;
+
+            const uint8_t* ip = packet + offset;
+            std::size_t ipHeaderSize = (ip[0] & 0x0F) * 4;
+            std::size_t ipSize = std::min<std::size_t>(be16(ip + 2), size - offset);
+            // Fragments are not reassembled
+            if ((ipHeaderSize < 20) || (ipSize < ipHeaderSize) ||
+                ((be16(ip + 6) & 0x3FFF) != 0))
+                return false;
+
+            Flow flow{ip[9], be32(ip + 12), be32(ip + 16), 0, 0};
+            const uint8_t* transport = ip + ipHeaderSize;
+            std::size_t transportSize = ipSize - ipHeaderSize;
+            switch (std::get<0>(flow))
+            {
+            case IP_PROTOCOL_UDP:
+            {
+                if (transportSize < 8)
+                    return false;
+                std::get<3>(flow) = be16(transport);
+                std::get<4>(flow) = be16(transport + 2);
+                std::size_t udpSize =
+                    std::min<std::size_t>(be16(transport + 4), transportSize);
+                if (udpSize < 8)
+                    return false;
+
+                const uint8_t* payload = transport + 8;
+                Stream& stream = this->stream(flow);
+                if ((udpSize >= 10) && (payload[0] == SYNC_BYTE_1) &&
+                    (payload[1] == SBF_SYNC_BYTE_2))
+                    stream.framer.reset();
+                stream.framer.feed(payload, udpSize - 8, stamp);
+                return true;
+            }
+            case IP_PROTOCOL_TCP:
+            {
+                if (transportSize < 20)
+                    return false;
+                std::get<3>(flow) = be16(transport);
+                std::get<4>(flow) = be16(transport + 2);
+                std::size_t tcpHeaderSize = (transport[12] >> 4) * 4;
+                if ((tcpHeaderSize < 20) || (tcpHeaderSize > transportSize))
+                    return false;
+                processTcp(flow, be32(transport + 4), transport[13],
+                           transport + tcpHeaderSize,
+                           transportSize - tcpHeaderSize, stamp);
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        //! Emits the command responses held back by the framers, at end of capture
+        void flush()
+        {
+            for (auto& [flow, stream] : streams_)
+                stream.framer.flush();
+        }
+
+        //! Number of TCP sequence gaps that were skipped
+        [[nodiscard]] uint64_t gaps() const { return gaps_; }
+
+    private:
+        static const uint8_t IP_PROTOCOL_TCP = 6;
+        static const uint8_t IP_PROTOCOL_UDP = 17;
+        static const uint8_t TCP_FIN = 0x01;
+        static const uint8_t TCP_SYN = 0x02;
+        static const uint8_t TCP_RST = 0x04;
+
+        //! Protocol, source and destination address, source and destination port
+        typedef std::tuple<uint8_t, uint32_t, uint32_t, uint16_t, uint16_t> Flow;
+
+        struct Segment
+        {
+            std::vector<uint8_t> payload;
+            Timestamp stamp;
+        };
+
+        struct Stream
+        {
+            Stream(const TelegramFramer::TelegramCallback& onTelegram,
+                   const std::shared_ptr<TelegramPool>& pool) :
+                framer(onTelegram, TelegramFramer::FaultCallback(), pool)
+            {
+            }
+
+            TelegramFramer framer;
+            //! Whether the initial sequence number is known
+            bool synced = false;
+            //! Sequence number of the next byte to be framed
+            uint32_t nextSeq = 0;
+            //! Segments received ahead of nextSeq by their sequence number
+            std::map<uint32_t, Segment> pending;
+            std::size_t pendingBytes = 0;
+        };
+
+        static uint16_t be16(const uint8_t* data)
+        {
+            return static_cast<uint16_t>((data[0] << 8) | data[1]);
+        }
+
+        static uint32_t be32(const uint8_t* data)
+        {
+            return (static_cast<uint32_t>(be16(data)) << 16) | be16(data + 2);
+        }
+
+        static bool ipOffset(int linkType, const uint8_t* packet, std::size_t size,
+                             std::size_t& offset)
+        {
+            switch (linkType)
+            {
+            case DLT_NULL:
+            {
+                offset = 4;
+                return true;
+            }
+            case DLT_RAW:
+            {
+                offset = 0;
+                return true;
+            }
+            case DLT_LINUX_SLL:
+            {
+                offset = 16;
+                return (size >= offset) && (be16(packet + 14) == 0x0800);
+            }
+            case DLT_EN10MB:
+            {
+                // Skips VLAN tags
+                offset = 12;
+                while ((size >= offset + 2) && ((be16(packet + offset) == 0x8100) ||
+                                                (be16(packet + offset) == 0x88A8)))
+                    offset += 4;
+                offset += 2;
+                return (size >= offset) && (be16(packet + offset - 2) == 0x0800);
+            }
+            default:
+                return false;
+            }
+        }
+
+        Stream& stream(const Flow& flow)
+        {
+            return streams_.try_emplace(flow, onTelegram_, pool_).first->second;
+        }
+
+        void processTcp(const Flow& flow, uint32_t seq, uint8_t flags,
+                        const uint8_t* payload, std::size_t size, Timestamp stamp)
+        {
+            Stream& stream = this->stream(flow);
+            if (flags & TCP_SYN)
+            {
+                stream.synced = true;
+                stream.nextSeq = seq + 1;
+                stream.pending.clear();
+                stream.pendingBytes = 0;
+                stream.framer.reset();
+            } else if (!stream.synced && (size > 0))
+            {
+                // Capture started within the connection
+                stream.synced = true;
+                stream.nextSeq = seq;
+            }
+
+            if (stream.synced && (size > 0))
+            {
+                if (static_cast<int32_t>(seq - stream.nextSeq) > 0)
+                {
+                    auto [it, inserted] = stream.pending.try_emplace(
+                        seq, Segment{std::vector<uint8_t>(payload, payload + size),
+                                     stamp});
+                    if (inserted)
+                        stream.pendingBytes += size;
+                    if (stream.pendingBytes > MAX_TCP_REORDER_BYTES)
+                        skipGap(stream);
+                } else
+                {
+                    deliver(stream, seq, payload, size, stamp);
+                }
+                drain(stream);
+            }
+
+            if (flags & (TCP_FIN | TCP_RST))
+            {
+                stream.framer.flush();
+                streams_.erase(flow);
+            }
+        }
+
+        //! Frames the part of a segment beyond the bytes already framed
+        static void deliver(Stream& stream, uint32_t seq, const uint8_t* payload,
+                            std::size_t size, Timestamp stamp)
+        {
+            std::size_t framed = static_cast<uint32_t>(stream.nextSeq - seq);
+            if (framed >= size)
+                return;
+            stream.framer.feed(payload + framed, size - framed, stamp);
+            stream.nextSeq += static_cast<uint32_t>(size - framed);
+        }
+
+        static void drain(Stream& stream)
+        {
+            bool progress = true;
+            while (progress)
+            {
+                progress = false;
+                for (auto it = stream.pending.begin(); it != stream.pending.end();
+                     ++it)
+                {
+                    if (static_cast<int32_t>(it->first - stream.nextSeq) <= 0)
+                    {
+                        const Segment& segment = it->second;
+                        deliver(stream, it->first, segment.payload.data(),
+                                segment.payload.size(), segment.stamp);
+                        stream.pendingBytes -= segment.payload.size();
+                        stream.pending.erase(it);
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        //! Continues with the earliest buffered segment if too much data is missing
+        void skipGap(Stream& stream)
+        {
+            auto earliest = std::min_element(
+                stream.pending.begin(), stream.pending.end(),
+                [&stream](const auto& lhs, const auto& rhs) {
+                    return static_cast<int32_t>(lhs.first - stream.nextSeq) <
+                           static_cast<int32_t>(rhs.first - stream.nextSeq);
+                });
+            stream.nextSeq = earliest->first;
+            stream.framer.reset();
+            ++gaps_;
+        }
+
+        TelegramFramer::TelegramCallback onTelegram_;
+        //! Source of the telegrams
+        std::shared_ptr<TelegramPool> pool_;
+        std::map<Flow, Stream> streams_;
+        uint64_t gaps_ = 0;
+    };
+} // namespace io
@@ -0,0 +1,213 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <thread>
+
+// pcap
+#include <pcap.h>
+
+// ROSaic
+#include <septentrio_gnss_driver/communication/async_manager.hpp>
+#include <septentrio_gnss_driver/communication/packet_reassembler.hpp>
+
+/**
+ * @file pcap_reader.hpp
+ * @brief Reads telegrams from PCAP captures of the receiver traffic
+ */
+
+namespace io {
+
+    /**
+     * @class PcapReader
+     * @brief I/O manager for PCAP captures
+     *
+     * Packets are read with pcap_next_ex, restricted to TCP and UDP traffic of the
+     * configured host and port by a BPF filter, and passed to a PacketReassembler.
+     * The telegrams carry the capture time and are pushed into the telegram queue,
+     * reading ahead by at most half the queue such that replay pacing is left to
+     * the consumer.
+     */
+    class PcapReader : public AsyncManagerBase
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[in] node Pointer to node
+         * @param[in] telegramQueue Telegram queue
+         * @param[in] telegramPool Pool providing the telegrams
+         */
+        PcapReader(ROSaicNodeBase* node, TelegramQueue* telegramQueue,
+                   std::shared_ptr<TelegramPool> telegramPool) :
+            node_(node), telegramQueue_(telegramQueue),
+            reassembler_(
+                [this](const std::shared_ptr<Telegram>& telegram) {
+                    deliver(telegram);
+                },
+                telegramPool),
+            replayWindow_(std::max<std::size_t>(telegramQueue->capacity() / 2, 1))
+        {
+        }
+
+        ~PcapReader() { close(); }
+
+        [[nodiscard]] bool connect() override
+        {
+            node_->log(log_level::INFO, "Opening pcap file " +
+                                            node_->settings()->device + "...");
+
+            pcap_ = pcap_open_offline_with_tstamp_precision(
+                node_->settings()->device.c_str(), PCAP_TSTAMP_PRECISION_NANO,
+                errBuff_.data());
+            if (!pcap_)
+            {
+                node_->log(log_level::ERROR, "open pcap file failed due to " +
+                                                 std::string(errBuff_.data()));
+                return false;
+            }
+
+            linkType_ = pcap_datalink(pcap_);
+            if (!PacketReassembler::supportsLinkType(linkType_))
+            {
+                node_->log(log_level::ERROR, "pcap link-layer header type " +
+                                                 std::to_string(linkType_) +
+                                                 " is not supported.");
+                close();
+                return false;
+            }
+
+            std::string filter = "(tcp or udp)";
+            if (!node_->settings()->replay.pcap_host.empty())
+                filter += " and host " + node_->settings()->replay.pcap_host;
+            if (node_->settings()->replay.pcap_port != 0)
+                filter += " and port " +
+                          std::to_string(node_->settings()->replay.pcap_port);
+
+            bpf_program program;
+            if (pcap_compile(pcap_, &program, filter.c_str(), 1,
+                             PCAP_NETMASK_UNKNOWN) == -1)
+            {
+                node_->log(log_level::ERROR, "invalid pcap filter '" + filter +
+                                                 "': " + pcap_geterr(pcap_));
+                close();
+                return false;
+            }
+            int result = pcap_setfilter(pcap_, &program);
+            pcap_freecode(&program);
+            if (result == -1)
+            {
+                node_->log(log_level::ERROR, "setting pcap filter '" + filter +
+                                                 "' failed: " + pcap_geterr(pcap_));
+                close();
+                return false;
+            }
+            node_->log(log_level::DEBUG, "pcap filter: " + filter);
+
+            running_ = true;
+            readerThread_ = std::thread(&PcapReader::run, this);
+            return true;
+        }
+
+        void close() override
+        {
+            running_ = false;
+            telegramQueue_->wakeProducers();
+            if (readerThread_.joinable())
+                readerThread_.join();
+            if (pcap_)
+            {
+                pcap_close(pcap_);
+                pcap_ = nullptr;
+            }
+        }
+
+        void send(const std::string& cmd) override
+        {
+            node_->log(log_level::DEBUG,
+                       "PcapReader cannot send to a file, dropping: " + cmd);
+        }
+
+    private:
+        void run()
+        {
+            pcap_pkthdr* header;
+            const u_char* packet;
+            int result;
+            uint64_t packets = 0;
+            while (running_ &&
+                   ((result = pcap_next_ex(pcap_, &header, &packet)) >= 0))
+            {
+                // With nanosecond precision, tv_usec holds nanoseconds
+                Timestamp stamp =
+                    static_cast<Timestamp>(header->ts.tv_sec) * 1000000000ull +
+                    static_cast<Timestamp>(header->ts.tv_usec);
+                if (reassembler_.process(linkType_, packet, header->caplen, stamp))
+                    ++packets;
+            }
+
+            if (!running_)
+                return;
+            reassembler_.flush();
+            if (result == PCAP_ERROR_BREAK)
+                node_->log(log_level::INFO,
+                           "PcapReader finished reading file (" +
+                               std::to_string(packets) + " packets, " +
+                               std::to_string(reassembler_.gaps()) +
+                               " TCP gaps). Node will continue to publish "
+                               "queued messages.");
+            else
+                node_->log(log_level::ERROR, "PcapReader read error: " +
+                                                 std::string(pcap_geterr(pcap_)));
+        }
+
+        void deliver(const std::shared_ptr<Telegram>& telegram)
+        {
+            if (telegramQueue_->waitBelow(replayWindow_, running_))
+                telegramQueue_->push(telegram);
+        }
+
+        //! Pointer to the node
+        ROSaicNodeBase* node_;
+        TelegramQueue* telegramQueue_;
+        PacketReassembler reassembler_;
+        //! Maximum number of queued telegrams before reading pauses
+        const std::size_t replayWindow_;
+        std::atomic<bool> running_ = false;
+        std::thread readerThread_;
+
+        std::array<char, PCAP_ERRBUF_SIZE> errBuff_;
+        pcap_t* pcap_ = nullptr;
+        int linkType_ = 0;
+    };
+} // namespace io
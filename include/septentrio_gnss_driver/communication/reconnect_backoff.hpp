@@ -0,0 +1,127 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+/**
+ * @file reconnect_backoff.hpp
+ * @brief Retry delays and outage statistics of connections to the Rx
+ */
+
+namespace io {
+
+    //! Default delay before the first reconnection attempt
+    static const std::chrono::milliseconds RECONNECT_MIN_INTERVAL(100);
+    //! Default upper bound of the delay between reconnection attempts
+    static const std::chrono::milliseconds RECONNECT_MAX_INTERVAL(5000);
+
+    /**
+     * @class ReconnectBackoff
+     * @brief Exponential backoff with jitter
+     *
+     * The n-th delay after a successful connection is drawn uniformly from
+     * [d/2, d] with d = min(max, min * 2^n), but is never shorter than the minimum
+     * interval. The jitter keeps several drivers from hammering a Rx or network
+     * that comes back in lock-step.
+     */
+    class ReconnectBackoff
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[in] minInterval Delay before the first attempt after a loss
+         * @param[in] maxInterval Upper bound of the delay
+         * @param[in] seed Seed of the jitter
+         */
+        ReconnectBackoff(std::chrono::milliseconds minInterval =
+                             RECONNECT_MIN_INTERVAL,
+                         std::chrono::milliseconds maxInterval =
+                             RECONNECT_MAX_INTERVAL,
+                         uint32_t seed = std::random_device()()) :
+            minInterval_(minInterval),
+            maxInterval_(std::max(minInterval, maxInterval)), random_(seed)
+        {
+        }
+
+        //! Delay before the next attempt
+        std::chrono::milliseconds next()
+        {
+            std::chrono::milliseconds ceiling = maxInterval_;
+            if (attempts_ < 32)
+                ceiling =
+                    std::min(maxInterval_, minInterval_ * (int64_t(1) << attempts_));
+            ++attempts_;
+
+            std::uniform_int_distribution<int64_t> jitter(ceiling.count() / 2,
+                                                          ceiling.count());
+            return std::max(minInterval_,
+                            std::chrono::milliseconds(jitter(random_)));
+        }
+
+        //! Restarts at the minimum interval, to be called on success
+        void reset() { attempts_ = 0; }
+
+        //! Number of delays handed out since the last reset
+        [[nodiscard]] uint32_t attempts() const { return attempts_; }
+
+    private:
+        std::chrono::milliseconds minInterval_;
+        std::chrono::milliseconds maxInterval_;
+        std::mt19937 random_;
+        uint32_t attempts_ = 0;
+    };
+
+    //! Outages of a connection, from the loss until it is connected again
+    struct ReconnectStatistics
+    {
+        //! Number of outages ended by a reconnection
+        uint64_t reconnects = 0;
+        //! Duration of the last outage [ms]
+        uint64_t lastOutage = 0;
+        //! Duration of the longest outage [ms]
+        uint64_t maxOutage = 0;
+        //! Summed duration of all outages [ms]
+        uint64_t totalOutage = 0;
+
+        void record(std::chrono::milliseconds outage)
+        {
+            ++reconnects;
+            lastOutage = static_cast<uint64_t>(outage.count());
+            maxOutage = std::max(maxOutage, lastOutage);
+            totalOutage += lastOutage;
+        }
+    };
+} // namespace io
@@ -0,0 +1,244 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @file replay_clock.hpp
+ * @brief Clock pacing the replay of SBF and PCAP files
+ */
+
+//! Nanoseconds since the unix epoch, identical to Timestamp of the node
+typedef uint64_t ReplayTime;
+
+/**
+ * @class ReplayClock
+ * @brief Paces the replay of a file by the GNSS time of its messages
+ *
+ * advance() is called by the processing thread with the time of every message to
+ * be published and blocks until the message is due. The rate relates replay time
+ * to wall time: 1 is real time, 10 is ten times faster and 0 is as fast as
+ * possible. Due times refer to an anchor, so that processing time does not add up
+ * to drift. The clock may be paused and stepped epoch by epoch from any thread.
+ */
+class ReplayClock
+{
+public:
+    typedef std::chrono::steady_clock WallClock;
+
+    /**
+     * @brief Constructor
+     * @param[in] rate Replay rate, 0 for unthrottled
+     * @param[in] paused Whether to start paused
+     */
+    explicit ReplayClock(double rate = 1.0, bool paused = false) :
+        rate_(rate), paused_(paused)
+    {
+    }
+
+    ReplayClock(const ReplayClock&) = delete;
+    ReplayClock& operator=(const ReplayClock&) = delete;
+
+    /**
+     * @brief Waits until a message of the given time is due
+     *
+     * Messages of the current time pass immediately. A message of a later time
+     * starts a new epoch, which has to wait for its due time or, if paused, for a
+     * step. A time earlier than the current one, e.g. from concatenated logs,
+     * restarts the pacing without waiting.
+     * @param[in] time Time of the message
+     * @return Whether the clock moved forward
+     */
+    bool advance(ReplayTime time)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (time == now_)
+            return false;
+        if (time < now_)
+        {
+            now_ = time;
+            anchored_ = false;
+            return false;
+        }
+
+        while (!stopped_)
+        {
+            if (paused_)
+            {
+                if (steps_ > 0)
+                {
+                    --steps_;
+                    break;
+                }
+                block([this, &lock]() { condition_.wait(lock); });
+                continue;
+            }
+            if ((rate_ <= 0.0) || !anchored_)
+                break;
+
+            const WallClock::time_point due =
+                wallAnchor_ + std::chrono::duration_cast<WallClock::duration>(
+                                  std::chrono::duration<double, std::nano>(
+                                      (time - timeAnchor_) / rate_));
+            if (WallClock::now() >= due)
+                break;
+            const uint64_t generation = generation_;
+            block([this, &lock, due, generation]() {
+                condition_.wait_until(lock, due, [this, generation]() {
+                    return stopped_ || (generation != generation_);
+                });
+            });
+            if (generation == generation_)
+                break;
+        }
+
+        if (!anchored_ || paused_)
+        {
+            wallAnchor_ = WallClock::now();
+            timeAnchor_ = time;
+            anchored_ = !paused_;
+        }
+        now_ = time;
+        return true;
+    }
+
+    //! Current replay time, 0 before the first message
+    [[nodiscard]] ReplayTime now() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return now_;
+    }
+
+    void setRate(double rate)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rate_ = rate;
+        reanchor();
+    }
+
+    [[nodiscard]] double rate() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rate_;
+    }
+
+    void pause()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_ = true;
+        reanchor();
+    }
+
+    void resume()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        paused_ = false;
+        steps_ = 0;
+        reanchor();
+    }
+
+    [[nodiscard]] bool paused() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return paused_;
+    }
+
+    /**
+     * @brief Lets a paused clock advance by epochs
+     * @param[in] epochs Number of epochs
+     */
+    void step(uint32_t epochs = 1)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        steps_ += epochs;
+        reanchor();
+    }
+
+    /**
+     * @brief Waits until advance() blocks for a due time, a step or a resume, so
+     * that other threads can act on a replay at a defined point
+     * @return False if the clock has been stopped
+     */
+    bool awaitBlocked()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return stopped_ || blocked_; });
+        return !stopped_;
+    }
+
+    //! Releases all waits for shutdown, advance() does not block anymore
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        reanchor();
+    }
+
+private:
+    //! Runs a wait of advance(), announcing it to awaitBlocked
+    template <typename Wait>
+    void block(Wait&& wait)
+    {
+        blocked_ = true;
+        condition_.notify_all();
+        wait();
+        blocked_ = false;
+    }
+
+    //! Due times are measured from the next epoch on, wakes up the waiting thread
+    void reanchor()
+    {
+        anchored_ = false;
+        blocked_ = false;
+        ++generation_;
+        condition_.notify_all();
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    double rate_;
+    bool paused_;
+    bool stopped_ = false;
+    //! Whether advance() waits and nothing has released it yet
+    bool blocked_ = false;
+    uint32_t steps_ = 0;
+    //! Incremented on every change of the configuration
+    uint64_t generation_ = 0;
+    ReplayTime now_ = 0;
+    bool anchored_ = false;
+    WallClock::time_point wallAnchor_;
+    ReplayTime timeAnchor_ = 0;
+};
@@ -0,0 +1,430 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <septentrio_gnss_driver/communication/command_pipeline.hpp>
+
+/**
+ * @file rx_config_diff.hpp
+ * @brief Sends only the configuration commands that change the Rx settings
+ *
+ * The Rx answers a set command with the settings it changed, e.g. "sso, Stream1,
+ * ..." with the line "  SBFOutput, Stream1, ...", and a get command such as
+ * "getSBFOutput" with all lines of that setting. After a configuration, the set
+ * commands, the settings each of them changes and the state of these settings are
+ * cached on disk, protected by a hash of all cached lines. On the next
+ * configuration the cached settings are read back first. A set command is
+ * skipped if it was part of the cached configuration and all settings it changes
+ * are still in the cached state.
+ */
+
+namespace io {
+
+    /**
+     * @class RxConfigDiff
+     * @brief Decides which configuration commands have to be sent to the Rx
+     *
+     * Commands that do not start with "s", e.g. login, grc or eccf, are always
+     * sent and never cached. The response callback of the command pipeline hands
+     * the responses to respond(), the other methods are called from the thread
+     * configuring the Rx.
+     */
+    class RxConfigDiff
+    {
+    public:
+        /**
+         * @brief Loads the configuration applied last
+         * @param[in] path Path of the cache file
+         * @return False if there is no valid cache, nothing is skipped then
+         */
+        bool load(const std::string& path)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            clear();
+
+            std::ifstream file(path);
+            std::string line;
+            if (!std::getline(file, line) || (line.rfind(MAGIC, 0) != 0))
+                return false;
+            uint64_t hash = std::strtoull(line.c_str() + MAGIC.size(), nullptr, 16);
+
+            std::vector<std::string> commands;
+            std::string payload;
+            while (std::getline(file, line))
+            {
+                payload += line + "\n";
+                std::size_t tab = line.find('\t');
+                if (tab == std::string::npos)
+                    continue;
+                std::string value = line.substr(tab + 1);
+                if (line.compare(0, tab, "command") == 0)
+                {
+                    commands.push_back(value);
+                    cachedCommands_[value];
+                } else if ((line.compare(0, tab, "setting") == 0) &&
+                           !commands.empty())
+                {
+                    cachedCommands_[commands.back()].insert(value);
+                } else if (line.compare(0, tab, "state") == 0)
+                {
+                    cachedStates_[settingName(value)].push_back(value);
+                }
+            }
+            // Discards truncated or edited files
+            if (hash != fnv1a(payload))
+            {
+                clear();
+                return false;
+            }
+            cachedHash_ = hash;
+            return true;
+        }
+
+        /**
+         * @brief Saves the configuration applied in this session, to be called
+         * once the queries returned by finalQueries() are answered
+         * @param[in] path Path of the cache file
+         * @return False if the file could not be written
+         */
+        bool save(const std::string& path) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::ostringstream ss;
+            for (const auto& command : issued_)
+            {
+                ss << "command\t" << command.text << "\n";
+                for (const auto& setting : settings(command.text))
+                    ss << "setting\t" << setting << "\n";
+            }
+            for (const auto& [setting, state] : states_)
+                for (const auto& line : state)
+                    ss << "state\t" << line << "\n";
+            const std::string payload = ss.str();
+
+            // Replaced atomically, a crash must not leave a partial cache behind
+            std::string tmp = path + ".tmp";
+            {
+                std::ofstream file(tmp, std::ios::trunc);
+                if (!(file << MAGIC << std::hex << fnv1a(payload) << "\n"
+                           << payload) ||
+                    !file.flush())
+                    return false;
+            }
+            return std::rename(tmp.c_str(), path.c_str()) == 0;
+        }
+
+        /**
+         * @brief Get commands reading the current state of the cached settings,
+         * to be answered before compare() is called
+         */
+        [[nodiscard]] std::vector<std::string> queries() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<std::string> queries;
+            for (const auto& [setting, state] : cachedStates_)
+                queries.push_back("get" + setting);
+            return queries;
+        }
+
+        /**
+         * @brief Records the response to a command
+         * @param[in] command The normalized command
+         * @param[in] response The response of the Rx including all its lines
+         */
+        void respond(const std::string& command, const std::string& response)
+        {
+            std::vector<std::string> lines = body(response);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (command.rfind("get", 0) == 0)
+            {
+                std::string setting = settingName(command.substr(3));
+                states_[setting] = lines;
+            } else if (isSetting(command))
+            {
+                std::set<std::string>& changed = sessionCommands_[command];
+                for (const auto& line : lines)
+                    changed.insert(settingName(line));
+            }
+        }
+
+        /**
+         * @brief Compares the current state of the cached settings to the cached
+         * state
+         * @return Number of settings that were changed since the last configuration
+         */
+        std::size_t compare()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::size_t changed = 0;
+            for (const auto& [setting, state] : cachedStates_)
+            {
+                auto current = states_.find(setting);
+                if ((current != states_.end()) && (current->second == state))
+                    unchanged_.insert(setting);
+                else
+                    ++changed;
+            }
+            states_.clear();
+            return changed;
+        }
+
+        /**
+         * @brief Registers a command of the configuration
+         * @param[in] cmd The command
+         * @return True if the command does not have to be sent
+         */
+        [[nodiscard]] bool skip(const std::string& cmd)
+        {
+            std::string text = CommandPipeline::normalize(cmd);
+            if (!isSetting(text))
+                return false;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto cached = cachedCommands_.find(text);
+            bool skip = (cached != cachedCommands_.end()) &&
+                        !cached->second.empty() &&
+                        std::all_of(cached->second.begin(), cached->second.end(),
+                                    [this](const std::string& setting) {
+                                        return unchanged_.count(setting) > 0;
+                                    });
+            issued_.push_back(Command{text, cmd, skip});
+            if (skip)
+                ++skipped_;
+            return skip;
+        }
+
+        /**
+         * @brief Commands to be sent after all, because a cached command is no
+         * longer part of the configuration
+         *
+         * Undoing a setting is only possible by sending all commands changing it
+         * again, in their original order. To be called once all sent commands are
+         * answered.
+         * @return Commands to be sent, as passed to skip()
+         */
+        [[nodiscard]] std::vector<std::string> finish()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::set<std::string> outdated;
+            for (const auto& [text, changed] : cachedCommands_)
+            {
+                if (std::none_of(issued_.begin(), issued_.end(),
+                                 [&text](const Command& command) {
+                                     return command.text == text;
+                                 }))
+                    outdated.insert(changed.begin(), changed.end());
+            }
+
+            // A command changing several settings outdates all of them
+            std::vector<bool> resend(issued_.size(), false);
+            bool grown = true;
+            while (grown)
+            {
+                grown = false;
+                for (std::size_t i = 0; i < issued_.size(); ++i)
+                {
+                    std::set<std::string> changed = settings(issued_[i].text);
+                    if (resend[i] ||
+                        std::none_of(changed.begin(), changed.end(),
+                                     [&outdated](const std::string& setting) {
+                                         return outdated.count(setting) > 0;
+                                     }))
+                        continue;
+                    resend[i] = true;
+                    for (const auto& setting : changed)
+                        grown |= outdated.insert(setting).second;
+                }
+            }
+
+            std::vector<std::string> commands;
+            for (std::size_t i = 0; i < issued_.size(); ++i)
+            {
+                if (!resend[i])
+                    continue;
+                commands.push_back(issued_[i].cmd);
+                if (issued_[i].skipped)
+                {
+                    issued_[i].skipped = false;
+                    --skipped_;
+                }
+            }
+            return commands;
+        }
+
+        /**
+         * @brief Get commands reading the state of all settings changed by this
+         * configuration, to be answered before save() is called
+         */
+        [[nodiscard]] std::vector<std::string> finalQueries() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::set<std::string> changed;
+            for (const auto& command : issued_)
+            {
+                std::set<std::string> s = settings(command.text);
+                changed.insert(s.begin(), s.end());
+            }
+            std::vector<std::string> queries;
+            for (const auto& setting : changed)
+                queries.push_back("get" + setting);
+            return queries;
+        }
+
+        //! Whether no set command had to be sent
+        [[nodiscard]] bool unchanged() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return skipped_ == issued_.size();
+        }
+
+        //! Number of set commands skipped
+        [[nodiscard]] std::size_t skipped() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return skipped_;
+        }
+
+        //! Hash of the cached configuration, 0 if none was loaded
+        [[nodiscard]] uint64_t cachedHash() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return cachedHash_;
+        }
+
+        //! Whether a command changes settings of the Rx
+        static bool isSetting(const std::string& text)
+        {
+            return !text.empty() && (text[0] == 's');
+        }
+
+        //! Name of the setting a response line or get command refers to
+        static std::string settingName(const std::string& line)
+        {
+            std::size_t begin = line.find_first_not_of(' ');
+            if (begin == std::string::npos)
+                return std::string();
+            std::size_t end = line.find_first_of(", \r", begin);
+            return line.substr(begin, end == std::string::npos ? std::string::npos
+                                                              : end - begin);
+        }
+
+        //! Lines following the first line of a response, without indentation
+        static std::vector<std::string> body(const std::string& response)
+        {
+            std::vector<std::string> lines;
+            std::istringstream ss(response);
+            std::string line;
+            std::getline(ss, line);
+            while (std::getline(ss, line))
+            {
+                if (!line.empty() && (line.back() == '\r'))
+                    line.pop_back();
+                std::size_t begin = line.find_first_not_of(' ');
+                if ((begin != 0) && (begin != std::string::npos))
+                    lines.push_back(line.substr(begin));
+            }
+            return lines;
+        }
+
+    private:
+        struct Command
+        {
+            //! Normalized command text
+            std::string text;
+            //! Command as passed to skip()
+            std::string cmd;
+            bool skipped;
+        };
+
+        //! FNV-1a hash of the cached lines
+        static uint64_t fnv1a(const std::string& payload)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : payload)
+            {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        //! Settings a command changes, as answered in this session or cached
+        std::set<std::string> settings(const std::string& text) const
+        {
+            auto session = sessionCommands_.find(text);
+            if (session != sessionCommands_.end())
+                return session->second;
+            auto cached = cachedCommands_.find(text);
+            if (cached != cachedCommands_.end())
+                return cached->second;
+            return std::set<std::string>();
+        }
+
+        void clear()
+        {
+            cachedHash_ = 0;
+            cachedCommands_.clear();
+            cachedStates_.clear();
+            unchanged_.clear();
+        }
+
+        inline static const std::string MAGIC = "RXCFG01 ";
+
+        mutable std::mutex mutex_;
+        uint64_t cachedHash_ = 0;
+        //! Settings changed by each cached command
+        std::map<std::string, std::set<std::string>> cachedCommands_;
+        //! Cached lines of each setting
+        std::map<std::string, std::vector<std::string>> cachedStates_;
+        //! Cached settings the Rx still holds
+        std::set<std::string> unchanged_;
+        //! Settings changed by each command answered in this session
+        std::map<std::string, std::set<std::string>> sessionCommands_;
+        //! Current lines of each queried setting
+        std::map<std::string, std::vector<std::string>> states_;
+        //! Set commands of this session in order
+        std::vector<Command> issued_;
+        std::size_t skipped_ = 0;
+    };
+} // namespace io
@@ -0,0 +1,255 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/crc/crc.hpp>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+#include <septentrio_gnss_driver/communication/telegram_pool.hpp>
+
+/**
+ * @file sbf_chunk_decoder.hpp
+ * @brief Parallel framing of SBF logs that are available in memory as a whole
+ *
+ * The log is split into chunks of fixed size. Each chunk is resynchronized on the
+ * first SBF block boundary within it, i.e. on the first "$@" that starts a block
+ * of valid length and CRC, and framed up to the boundary of the next chunk. Since
+ * adjacent chunks agree on their common boundary, every byte is framed exactly
+ * once and, for intact logs, the telegrams are identical to those of sequential
+ * framing.
+ */
+
+namespace io {
+
+    //! Size of the chunks an SBF log is split into for parallel framing
+    static const std::size_t SBF_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * @brief Searches for the next SBF block boundary
+     * @param[in] data Start of the log
+     * @param[in] size Size of the log in bytes
+     * @param[in] from Offset the search starts at
+     * @return Offset of the first SBF block with valid CRC at or after from, size if
+     * there is none
+     */
+    inline std::size_t findSbfBlock(const uint8_t* data, std::size_t size,
+                                    std::size_t from)
+    {
+        while (from + SBF_HEADER_SIZE <= size)
+        {
+            const void* sync = std::memchr(data + from, SYNC_BYTE_1,
+                                           size - from - SBF_HEADER_SIZE + 1);
+            if (!sync)
+                break;
+            from = static_cast<std::size_t>(static_cast<const uint8_t*>(sync) -
+                                            data);
+            if ((data[from + 1] == SBF_SYNC_BYTE_2) &&
+                crc::isValid(data + from, size - from))
+                return from;
+            ++from;
+        }
+        return size;
+    }
+
+    /**
+     * @class SbfChunkDecoder
+     * @brief Frames an SBF log on several worker threads and delivers the telegrams
+     * in file order
+     */
+    class SbfChunkDecoder
+    {
+    public:
+        //! Called for every telegram in file order, returning false aborts decoding
+        typedef std::function<bool(const std::shared_ptr<Telegram>&)>
+            TelegramCallback;
+
+        /**
+         * @brief Constructor
+         * @param[in] threads Number of worker threads, 0 for one per hardware thread
+         * @param[in] chunkSize Size of the chunks in bytes
+         * @param[in] pool Optional, pool telegrams are taken from
+         */
+        explicit SbfChunkDecoder(std::size_t threads,
+                                 std::size_t chunkSize = SBF_CHUNK_SIZE,
+                                 std::shared_ptr<TelegramPool> pool = nullptr) :
+            threads_(threads ? threads
+                             : std::max(std::thread::hardware_concurrency(), 1u)),
+            chunkSize_(std::max<std::size_t>(chunkSize, SBF_HEADER_SIZE)),
+            pool_(pool ? std::move(pool) : std::make_shared<TelegramPool>())
+        {
+        }
+
+        /**
+         * @brief Decodes a log
+         *
+         * Chunks are framed ahead of delivery by at most two chunks per worker, such
+         * that memory stays bounded if the callback is slow.
+         * @param[in] data Start of the log
+         * @param[in] size Size of the log in bytes
+         * @param[in] onTelegram Called from the calling thread for every telegram in
+         * file order
+         * @return False if decoding was aborted by the callback, true otherwise
+         */
+        bool decode(const uint8_t* data, std::size_t size,
+                    const TelegramCallback& onTelegram)
+        {
+            const std::size_t chunks = (size + chunkSize_ - 1) / chunkSize_;
+            const std::size_t window = 2 * threads_;
+            std::vector<Chunk> slots(window);
+            std::size_t next = 0;
+            std::size_t delivered = 0;
+            bool abort = false;
+            std::mutex mutex;
+            std::condition_variable cv;
+
+            auto work = [&]() {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (true)
+                {
+                    cv.wait(lock, [&]() {
+                        return abort || (next >= chunks) ||
+                               (next < delivered + window);
+                    });
+                    if (abort || (next >= chunks))
+                        return;
+                    std::size_t index = next++;
+                    lock.unlock();
+
+                    Chunk chunk;
+                    frame(data, size, index, chunks, chunk);
+
+                    lock.lock();
+                    slots[index % window] = std::move(chunk);
+                    cv.notify_all();
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (std::size_t i = 0; i < std::min(threads_, chunks); ++i)
+                workers.emplace_back(work);
+
+            bool completed = true;
+            for (std::size_t index = 0; completed && (index < chunks); ++index)
+            {
+                Chunk chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    Chunk& slot = slots[index % window];
+                    cv.wait(lock, [&slot]() { return slot.done; });
+                    chunk = std::move(slot);
+                    slot = Chunk();
+                    ++delivered;
+                }
+                cv.notify_all();
+
+                faults_ += chunk.faults;
+                for (const auto& telegram : chunk.telegrams)
+                {
+                    ++telegrams_;
+                    if (!onTelegram(telegram))
+                    {
+                        completed = false;
+                        break;
+                    }
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                abort = true;
+            }
+            cv.notify_all();
+            for (auto& worker : workers)
+                worker.join();
+            return completed;
+        }
+
+        //! Number of telegrams delivered
+        [[nodiscard]] uint64_t telegrams() const { return telegrams_; }
+        //! Number of SBF blocks and strings discarded due to framing errors
+        [[nodiscard]] uint64_t faults() const { return faults_; }
+
+    private:
+        struct Chunk
+        {
+            std::vector<std::shared_ptr<Telegram>> telegrams;
+            uint64_t faults = 0;
+            bool done = false;
+        };
+
+        void frame(const uint8_t* data, std::size_t size, std::size_t index,
+                   std::size_t chunks, Chunk& chunk) const
+        {
+            // The first chunk is framed from the very start, to keep leading strings
+            std::size_t begin =
+                (index == 0) ? 0 : findSbfBlock(data, size, index * chunkSize_);
+            std::size_t end =
+                (index + 1 == chunks)
+                    ? size
+                    : findSbfBlock(data, size, (index + 1) * chunkSize_);
+
+            if (begin < end)
+            {
+                TelegramFramer framer(
+                    [&chunk](const std::shared_ptr<Telegram>& telegram) {
+                        chunk.telegrams.push_back(telegram);
+                    },
+                    TelegramFramer::FaultCallback(), pool_);
+                framer.feed(data + begin, end - begin, 0);
+                // Chunks end before an SBF block or at the end of the log
+                framer.flush();
+                chunk.faults = framer.sbfFaults() + framer.stringFaults();
+            }
+            chunk.done = true;
+        }
+
+        //! Number of worker threads
+        const std::size_t threads_;
+        //! Nominal size of the chunks in bytes
+        const std::size_t chunkSize_;
+        //! Source of the telegrams
+        std::shared_ptr<TelegramPool> pool_;
+
+        uint64_t telegrams_ = 0;
+        uint64_t faults_ = 0;
+    };
+} // namespace io
@@ -0,0 +1,267 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/communication/sbf_chunk_decoder.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+/**
+ * @file sbf_index.hpp
+ * @brief Index of the SBF blocks of a log by GNSS time and block ID
+ *
+ * The index is cached in a sidecar file next to the log, consisting of a header
+ * with a magic number and the offset up to which the log has been indexed,
+ * followed by one fixed-size entry per block. Updating the index only scans the
+ * part of the log appended since the last update, so it may be repeated while the
+ * log is still being recorded.
+ */
+
+namespace io {
+
+    /**
+     * @class SbfIndex
+     * @brief Maps (WNc, TOW, block ID) of every SBF block of a log to its offset
+     */
+    class SbfIndex
+    {
+    public:
+        struct Entry
+        {
+            //! Offset of the block in the log
+            uint64_t offset;
+            //! Time of week [ms]
+            uint32_t tow;
+            //! Week number
+            uint16_t wnc;
+            //! Block number, i.e. ID without revision
+            uint16_t id;
+
+            //! Whether the block carries a valid GNSS time
+            [[nodiscard]] bool hasTime() const
+            {
+                return (tow != 4294967295u) && (wnc != 65535);
+            }
+
+            //! GNSS time [ms] since the GPS epoch
+            [[nodiscard]] uint64_t time() const
+            {
+                return static_cast<uint64_t>(wnc) * 604800000 + tow;
+            }
+        };
+        static_assert(sizeof(Entry) == 16, "SBF index entries must be packed");
+
+        /**
+         * @brief Brings the index up to date with the log
+         *
+         * Loads the sidecar file if it matches the log, indexes the blocks appended
+         * since and writes the new entries back to the sidecar.
+         * @param[in] sidecar Path of the sidecar file
+         * @param[in] data Start of the log
+         * @param[in] size Size of the log in bytes
+         * @return False if the sidecar could not be written, the index in memory is
+         * valid nevertheless
+         */
+        bool update(const std::string& sidecar, const uint8_t* data,
+                    std::size_t size)
+        {
+            bool valid = (indexedSize_ == 0) ? load(sidecar, data, size)
+                                             : matches(data, size);
+            if (!valid)
+            {
+                entries_.clear();
+                indexedSize_ = 0;
+            }
+            loaded_ = entries_.size();
+
+            scan(data, size);
+            return save(sidecar, valid);
+        }
+
+        /**
+         * @brief Indexes the blocks appended to the log since the last call
+         * @param[in] data Start of the log
+         * @param[in] size Size of the log in bytes
+         */
+        void scan(const uint8_t* data, std::size_t size)
+        {
+            std::size_t pos = indexedSize_;
+            while (true)
+            {
+                pos = findSbfBlock(data, size, pos);
+                if (pos == size)
+                    break;
+
+                const uint8_t* block = data + pos;
+                uint16_t length = parsing_utilities::parseUInt16(block + 6);
+                Entry entry;
+                entry.offset = pos;
+                entry.tow = 4294967295u;
+                entry.wnc = 65535;
+                entry.id = parsing_utilities::parseUInt16(block + 4) & 8191;
+                if (length >= 14)
+                {
+                    entry.tow = parsing_utilities::parseUInt32(block + 8);
+                    entry.wnc = parsing_utilities::parseUInt16(block + 12);
+                }
+                entries_.push_back(entry);
+
+                pos += length;
+                indexedSize_ = pos;
+            }
+        }
+
+        /**
+         * @brief Searches for the first block at or after a GNSS time
+         * @param[in] time GNSS time [ms] since the GPS epoch
+         * @return Index of the first entry with a valid time not before time, number
+         * of entries if there is none
+         */
+        [[nodiscard]] std::size_t seek(uint64_t time) const
+        {
+            return static_cast<std::size_t>(
+                std::find_if(entries_.begin(), entries_.end(),
+                             [time](const Entry& entry) {
+                                 return entry.hasTime() && (entry.time() >= time);
+                             }) -
+                entries_.begin());
+        }
+
+        [[nodiscard]] const std::vector<Entry>& entries() const { return entries_; }
+        //! Offset up to which the log is indexed
+        [[nodiscard]] std::size_t indexedSize() const { return indexedSize_; }
+        //! Number of entries known before the last update, e.g. from the sidecar
+        [[nodiscard]] std::size_t loaded() const { return loaded_; }
+
+    private:
+        static constexpr std::array<char, 8> MAGIC = {'S', 'B', 'F', 'I',
+                                                      'D', 'X', '0', '1'};
+        static constexpr std::size_t HEADER_SIZE = 16;
+
+        //! Whether the last indexed block is still found in the log
+        [[nodiscard]] bool matches(const uint8_t* data, std::size_t size) const
+        {
+            if (indexedSize_ > size)
+                return false;
+            if (entries_.empty())
+                return true;
+            const Entry& last = entries_.back();
+            return (last.offset < size) &&
+                   crc::isValid(data + last.offset, size - last.offset) &&
+                   ((parsing_utilities::parseUInt16(data + last.offset + 4) &
+                     8191) == last.id);
+        }
+
+        bool load(const std::string& sidecar, const uint8_t* data,
+                  std::size_t size)
+        {
+            entries_.clear();
+            std::ifstream file(sidecar, std::ios::binary);
+            if (!file)
+                return false;
+
+            std::array<char, 8> magic;
+            uint64_t indexedSize;
+            if (!file.read(magic.data(), magic.size()) || (magic != MAGIC) ||
+                !file.read(reinterpret_cast<char*>(&indexedSize),
+                           sizeof(indexedSize)))
+                return false;
+
+            Entry entry;
+            while (file.read(reinterpret_cast<char*>(&entry), sizeof(entry)))
+            {
+                // Entries beyond the header offset stem from an interrupted update
+                if (entry.offset >= indexedSize)
+                    break;
+                // Blocks are at least 8 bytes long and indexed in file order
+                if (!entries_.empty() && (entry.offset < entries_.back().offset + 8))
+                {
+                    entries_.clear();
+                    return false;
+                }
+                entries_.push_back(entry);
+            }
+            indexedSize_ = indexedSize;
+            return matches(data, size);
+        }
+
+        bool save(const std::string& sidecar, bool append) const
+        {
+            std::error_code ec;
+            if (append)
+            {
+                std::filesystem::resize_file(
+                    sidecar, HEADER_SIZE + loaded_ * sizeof(Entry), ec);
+                if (ec)
+                    append = false;
+            }
+
+            std::fstream file(sidecar, append ? (std::ios::in | std::ios::out |
+                                                 std::ios::binary)
+                                              : (std::ios::out | std::ios::trunc |
+                                                 std::ios::binary));
+            if (!file)
+                return false;
+
+            uint64_t indexedSize = indexedSize_;
+            if (!append)
+            {
+                // Invalid until all entries are written
+                uint64_t none = 0;
+                file.write(MAGIC.data(), MAGIC.size());
+                file.write(reinterpret_cast<const char*>(&none), sizeof(none));
+            }
+            std::size_t first = append ? loaded_ : 0;
+            file.seekp(HEADER_SIZE + first * sizeof(Entry));
+            file.write(reinterpret_cast<const char*>(entries_.data() + first),
+                       (entries_.size() - first) * sizeof(Entry));
+            // The header is updated last, so that an interrupted update only loses
+            // the new entries
+            file.seekp(MAGIC.size());
+            file.write(reinterpret_cast<const char*>(&indexedSize),
+                       sizeof(indexedSize));
+            return static_cast<bool>(file);
+        }
+
+        std::vector<Entry> entries_;
+        std::size_t indexedSize_ = 0;
+        std::size_t loaded_ = 0;
+    };
+} // namespace io
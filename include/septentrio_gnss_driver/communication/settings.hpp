@@ -32,6 +32,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 struct Osnma
@@ -145,6 +146,77 @@ namespace device_type {
     };
 } // namespace device_type
 
+namespace overflow_policy {
+    enum OverflowPolicy
+    {
+        //! Producer waits until there is free space
+        BLOCK,
+        //! Oldest queued telegram is dropped
+        DROP_OLDEST,
+        //! Incoming telegram is dropped
+        DROP_NEWEST,
+        //! Drop oldest, and while an overflow is drained only the latest telegram
+        //! per SBF ID is kept
+        KEEP_LATEST
+    };
+} // namespace overflow_policy
+
+struct TelegramQueueSettings
+{
+    //! Maximum number of queued telegrams
+    uint32_t capacity = 4096;
+    //! Overflow policy for SBF blocks
+    overflow_policy::OverflowPolicy policy_sbf = overflow_policy::KEEP_LATEST;
+    //! Overflow policy for NMEA sentences
+    overflow_policy::OverflowPolicy policy_nmea = overflow_policy::DROP_OLDEST;
+    //! Overflow policy for unknown telegrams
+    overflow_policy::OverflowPolicy policy_unknown = overflow_policy::DROP_NEWEST;
+    //! SBF IDs handled before all other telegrams
+    std::vector<uint16_t> priority_high;
+    //! SBF IDs handled after all other telegrams
+    std::vector<uint16_t> priority_low;
+};
+
+struct ReplaySettings
+{
+    //! Replay speed relative to real time, 0 for as fast as possible
+    double rate = 1.0;
+    //! Whether replay starts paused, waiting for steps
+    bool start_paused = false;
+    //! Whether to publish /clock from the replayed GNSS time
+    bool publish_clock = false;
+    //! Number of threads framing SBF logs, 0 for one per hardware thread
+    uint32_t decode_threads = 0;
+    //! GNSS time [s] since the GPS epoch to start SBF replay at, 0 for the start
+    double start_time = 0.0;
+    //! GNSS time [s] since the GPS epoch to end SBF replay at, 0 for the end
+    double end_time = 0.0;
+    //! SBF IDs to replay, all if empty
+    std::vector<uint16_t> block_ids;
+    //! Host whose traffic is replayed from PCAP files, any if empty
+    std::string pcap_host;
+    //! Port whose traffic is replayed from PCAP files, any if 0
+    uint32_t pcap_port = 0;
+};
+
+struct IoPoolSettings
+{
+    //! Number of threads running the I/O of all connections
+    uint32_t threads = 2;
+    //! CPUs the I/O threads may run on, any if empty
+    std::vector<uint16_t> cpu_affinity;
+};
+
+struct QosSettings
+{
+    //! Reliability, reliable or best_effort
+    std::string reliability = "reliable";
+    //! Durability, volatile or transient_local
+    std::string durability = "volatile";
+    //! History depth
+    uint32_t depth = 1;
+};
+
 //! Settings struct
 struct Settings
 {
@@ -184,21 +256,32 @@ struct Settings
     std::string login_password;
     //! Custom commands file
     std::string custom_commands_file;
-    //! Delay in seconds between reconnection attempts to the connection type
-    //! specified in the parameter connection_type
-    float reconnect_delay_s;
+    //! Delay before the first reconnection attempt after a connection loss [ms],
+    //! doubled with every failed attempt
+    uint32_t reconnect_min_interval;
+    //! Upper bound of the delay between reconnection attempts [ms]
+    uint32_t reconnect_max_interval;
+    //! Thread pool running the I/O of all connections
+    IoPoolSettings io_pool;
     //! Baudrate
     uint32_t baudrate;
     //! HW flow control
     std::string hw_flow_control;
     // Wether to configure Rx
     bool configure_rx;
+    //! Whether to read back the Rx configuration and only send the changes
+    bool configure_rx_diff;
+    //! File caching the Rx configuration applied last, empty for a file in the
+    //! temporary directory
+    std::string configure_rx_cache;
     //! Datum to be used
     std::string datum;
     //! Polling period for PVT-related SBF blocks
     uint32_t polling_period_pvt;
     //! Polling period for all other SBF blocks and NMEA messages
     uint32_t polling_period_rest;
+    //! Time the SBF blocks of an epoch may take to arrive [ms]
+    uint32_t epoch_timeout;
     //! Marker-to-ARP offset in the eastward direction
     float delta_e;
     //! Marker-to-ARP offset in the northward direction
@@ -346,6 +429,13 @@ struct Settings
     bool publish_tf;
     //! Whether or not to publish the tf of the localization
     bool publish_tf_ecef;
+    //! Whether messages are only decoded and assembled for subscribed topics
+    bool lazy_decoding = false;
+    //! QoS by topic group (default, high_rate, status) or by single topic name
+    std::unordered_map<std::string, QosSettings> qos = {
+        {"default", {"reliable", "volatile", 1}},
+        {"high_rate", {"best_effort", "volatile", 5}},
+        {"status", {"reliable", "volatile", 10}}};
     //! Wether local frame should be inserted into tf
     bool insert_local_frame = false;
     //! Frame id of the local frame to be inserted
@@ -387,6 +477,10 @@ struct Settings
     InsVsm ins_vsm;
     //! Rate to publish diagnostics
     double diagnostic_updater_rate;
+    //! Telegram queue settings
+    TelegramQueueSettings telegram_queue;
+    //! Replay of SBF and PCAP files
+    ReplaySettings replay;
 };
 
 //! Capabilities struct
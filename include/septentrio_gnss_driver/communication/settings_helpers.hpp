@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <sched.h>
+
 #include "settings.hpp"
 #ifdef ROS1
 #include <septentrio_gnss_driver/abstraction/typedefs_ros1.hpp>
@@ -216,4 +218,97 @@ namespace settings {
         }
     }
 
+    // Parse telegram queue overflow policy
+    bool parseOverflowPolicy(ROSaicNodeBase* node, const std::string& name,
+                             const std::string& value,
+                             overflow_policy::OverflowPolicy& policy)
+    {
+        if (value == "block")
+            policy = overflow_policy::BLOCK;
+        else if (value == "drop_oldest")
+            policy = overflow_policy::DROP_OLDEST;
+        else if (value == "drop_newest")
+            policy = overflow_policy::DROP_NEWEST;
+        else if (value == "keep_latest")
+            policy = overflow_policy::KEEP_LATEST;
+        else
+        {
+            node->log(
+                log_level::ERROR,
+                "Unknown " + name + " " + value +
+                    ", use either block, drop_oldest, drop_newest or keep_latest.");
+            return false;
+        }
+        return true;
+    }
+
+    // Parse list of SBF IDs
+    template <typename T>
+    bool parseSbfIds(ROSaicNodeBase* node, const std::string& name,
+                     const std::vector<T>& values, std::vector<uint16_t>& ids)
+    {
+        ids.clear();
+        for (const auto value : values)
+        {
+            if ((value < 0) || (value > 8191))
+            {
+                node->log(log_level::ERROR, "Invalid SBF ID " +
+                                                std::to_string(value) + " in " +
+                                                name + ".");
+                return false;
+            }
+            ids.push_back(static_cast<uint16_t>(value));
+        }
+        return true;
+    }
+
+    // Parse list of CPU IDs
+    template <typename T>
+    bool parseCpuIds(ROSaicNodeBase* node, const std::string& name,
+                     const std::vector<T>& values, std::vector<uint16_t>& ids)
+    {
+        ids.clear();
+        for (const auto value : values)
+        {
+            if ((value < 0) || (value >= CPU_SETSIZE))
+            {
+                node->log(log_level::ERROR, "Invalid CPU " + std::to_string(value) +
+                                                " in " + name + ".");
+                return false;
+            }
+            ids.push_back(static_cast<uint16_t>(value));
+        }
+        return true;
+    }
+
+    // Read QoS profile from parameters prefix + reliability/durability/depth,
+    // values already set in qos are the defaults
+    void getQosParams(ROSaicNodeBase* node, const std::string& prefix,
+                      QosSettings& qos)
+    {
+        QosSettings defaults = qos;
+        node->param(prefix + "reliability", qos.reliability, defaults.reliability);
+        node->param(prefix + "durability", qos.durability, defaults.durability);
+        node->getUint32Param(prefix + "depth", qos.depth, defaults.depth);
+        if ((qos.reliability != "reliable") && (qos.reliability != "best_effort"))
+        {
+            node->log(log_level::ERROR, "Invalid " + prefix + "reliability " +
+                                            qos.reliability +
+                                            ", use either reliable or best_effort.");
+            qos.reliability = defaults.reliability;
+        }
+        if ((qos.durability != "volatile") && (qos.durability != "transient_local"))
+        {
+            node->log(log_level::ERROR,
+                      "Invalid " + prefix + "durability " + qos.durability +
+                          ", use either volatile or transient_local.");
+            qos.durability = defaults.durability;
+        }
+        if (qos.depth == 0)
+        {
+            node->log(log_level::ERROR, prefix + "depth must be positive.");
+            qos.depth = defaults.depth;
+        }
+    }
+
 } // namespace settings
\ No newline at end of file
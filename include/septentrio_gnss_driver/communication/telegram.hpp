@@ -200,5 +200,3 @@ void ConcurrentQueue<T>::pop(T& output) noexcept
     output = queue_.front();
     queue_.pop();
 }
-
-typedef ConcurrentQueue<std::shared_ptr<Telegram>> TelegramQueue;
\ No newline at end of file
@@ -0,0 +1,463 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <functional>
+#include <memory>
+#include <string>
+
+// ROSaic
+#include <septentrio_gnss_driver/crc/crc.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/communication/telegram_pool.hpp>
+
+/**
+ * @file telegram_framer.hpp
+ * @brief Incremental extraction of telegrams from a byte stream
+ *
+ * The framer is fed with arbitrarily sized chunks of the receiver byte stream, as
+ * delivered by a single read_some call, and emits complete telegrams. It
+ * classifies telegrams exactly like the former byte-wise read state machine of the
+ * AsyncManager and checks the CRC of SBF blocks. The lines following the first
+ * line of a command response, which are indented by two spaces, are kept in the
+ * response telegram. Hence a response is emitted with the first byte after it
+ * that does not continue it, or by flush().
+ */
+
+namespace io {
+
+    /**
+     * @class TelegramFramer
+     * @brief Splits a byte stream into SBF blocks, NMEA sentences, command
+     * responses, connection descriptors and unknown strings
+     */
+    class TelegramFramer
+    {
+    public:
+        typedef std::function<void(const std::shared_ptr<Telegram>&)>
+            TelegramCallback;
+        typedef std::function<void(const std::string&)> FaultCallback;
+
+        /**
+         * @brief Constructor
+         * @param[in] onTelegram Called for every complete and valid telegram
+         * @param[in] onFault Optional, called with a description of framing faults
+         * @param[in] pool Optional, pool telegrams are taken from. If not provided,
+         * the framer uses a pool of its own.
+         */
+        TelegramFramer(TelegramCallback onTelegram,
+                       FaultCallback onFault = FaultCallback(),
+                       std::shared_ptr<TelegramPool> pool = nullptr) :
+            onTelegram_(std::move(onTelegram)), onFault_(std::move(onFault)),
+            pool_(pool ? std::move(pool) : std::make_shared<TelegramPool>())
+        {
+        }
+
+        /**
+         * @brief Feeds a chunk of the byte stream into the framer
+         * @param[in] data Pointer to the received bytes
+         * @param[in] size Number of received bytes
+         * @param[in] stamp Time of reception of the chunk
+         */
+        void feed(const uint8_t* data, std::size_t size, Timestamp stamp)
+        {
+            const uint8_t* it = data;
+            const uint8_t* end = data + size;
+
+            while (it != end)
+            {
+                switch (state_)
+                {
+                case state::SYNC_1:
+                {
+                    startTelegram(stamp);
+                    if (*it == SYNC_BYTE_1)
+                    {
+                        state_ = state::SYNC_2;
+                    } else
+                    {
+                        telegram_->type = telegram_type::UNKNOWN;
+                        state_ = state::STRING;
+                    }
+                    telegram_->message.push_back(*it);
+                    ++it;
+                    break;
+                }
+                case state::SYNC_2:
+                {
+                    processSync2(*it, stamp);
+                    ++it;
+                    break;
+                }
+                case state::SYNC_3:
+                {
+                    processSync3(*it, stamp);
+                    ++it;
+                    break;
+                }
+                case state::SBF_HEADER:
+                {
+                    it = append(it, end, SBF_HEADER_SIZE);
+                    if (telegram_->message.size() == SBF_HEADER_SIZE)
+                        processSbfHeader();
+                    break;
+                }
+                case state::SBF_BODY:
+                {
+                    it = append(it, end, sbfLength_);
+                    if (telegram_->message.size() == sbfLength_)
+                        processSbf();
+                    break;
+                }
+                case state::STRING:
+                {
+                    it = processString(it, end, stamp);
+                    break;
+                }
+                case state::RESPONSE_LINE:
+                {
+                    if (*it == ' ')
+                    {
+                        telegram_->message.push_back(*it);
+                        state_ = state::STRING;
+                        ++it;
+                    } else
+                    {
+                        // The byte is processed again as start of a telegram
+                        emit();
+                        state_ = state::SYNC_1;
+                    }
+                    break;
+                }
+                }
+            }
+        }
+
+        /**
+         * @brief Emits a command response that is complete but might still be
+         * continued by an indented line. To be called when no data has arrived
+         * for a while or the stream has ended, as the receiver does not
+         * necessarily follow a response with a prompt.
+         */
+        void flush()
+        {
+            if (state_ == state::RESPONSE_LINE)
+            {
+                emit();
+                state_ = state::SYNC_1;
+            }
+        }
+
+        //! Whether a complete command response waits for the next byte or flush()
+        [[nodiscard]] bool responsePending() const
+        {
+            return state_ == state::RESPONSE_LINE;
+        }
+
+        /**
+         * @brief Discards a partially received telegram, e.g. after reconnection.
+         * A complete command response is emitted.
+         */
+        void reset()
+        {
+            flush();
+            state_ = state::SYNC_1;
+            telegram_.reset();
+        }
+
+        //! Number of telegrams emitted
+        [[nodiscard]] uint64_t telegrams() const { return telegrams_; }
+        //! Number of SBF blocks discarded due to CRC or length errors
+        [[nodiscard]] uint64_t sbfFaults() const { return sbfFaults_; }
+        //! Number of strings discarded due to framing errors
+        [[nodiscard]] uint64_t stringFaults() const { return stringFaults_; }
+
+    private:
+        enum class state
+        {
+            SYNC_1,
+            SYNC_2,
+            SYNC_3,
+            SBF_HEADER,
+            SBF_BODY,
+            STRING,
+            //! Response complete unless the next line continues it
+            RESPONSE_LINE
+        };
+
+        void startTelegram(Timestamp stamp)
+        {
+            telegram_ = pool_->acquire();
+            telegram_->stamp = stamp;
+        }
+
+        void restartAtSync1(Timestamp stamp)
+        {
+            startTelegram(stamp);
+            telegram_->message.push_back(SYNC_BYTE_1);
+            state_ = state::SYNC_2;
+        }
+
+        void processSync2(uint8_t byte, Timestamp stamp)
+        {
+            switch (byte)
+            {
+            case SYNC_BYTE_1:
+            {
+                restartAtSync1(stamp);
+                return;
+            }
+            case SBF_SYNC_BYTE_2:
+            {
+                telegram_->type = telegram_type::SBF;
+                state_ = state::SBF_HEADER;
+                break;
+            }
+            case NMEA_SYNC_BYTE_2:
+            {
+                telegram_->type = telegram_type::NMEA;
+                state_ = state::SYNC_3;
+                break;
+            }
+            case NMEA_INS_SYNC_BYTE_2:
+            {
+                telegram_->type = telegram_type::NMEA_INS;
+                state_ = state::SYNC_3;
+                break;
+            }
+            case RESPONSE_SYNC_BYTE_2:
+            {
+                telegram_->type = telegram_type::RESPONSE;
+                state_ = state::SYNC_3;
+                break;
+            }
+            default:
+            {
+                fault("sync byte 2 read fault, received byte was " +
+                      std::to_string(byte));
+                state_ = state::SYNC_1;
+                return;
+            }
+            }
+            telegram_->message.push_back(byte);
+        }
+
+        void processSync3(uint8_t byte, Timestamp stamp)
+        {
+            bool valid = false;
+            switch (byte)
+            {
+            case SYNC_BYTE_1:
+            {
+                restartAtSync1(stamp);
+                return;
+            }
+            case NMEA_SYNC_BYTE_3:
+            {
+                valid = (telegram_->type == telegram_type::NMEA);
+                break;
+            }
+            case NMEA_INS_SYNC_BYTE_3:
+            {
+                valid = (telegram_->type == telegram_type::NMEA_INS);
+                break;
+            }
+            case RESPONSE_SYNC_BYTE_3:
+            case RESPONSE_SYNC_BYTE_3a:
+            {
+                valid = (telegram_->type == telegram_type::RESPONSE);
+                break;
+            }
+            case ERROR_SYNC_BYTE_3:
+            {
+                valid = (telegram_->type == telegram_type::RESPONSE);
+                if (valid)
+                    telegram_->type = telegram_type::ERROR_RESPONSE;
+                break;
+            }
+            default:
+            {
+                fault("sync byte 3 read fault, received byte was " +
+                      std::to_string(byte));
+                break;
+            }
+            }
+
+            if (valid)
+            {
+                telegram_->message.push_back(byte);
+                state_ = state::STRING;
+            } else
+                state_ = state::SYNC_1;
+        }
+
+        void processSbfHeader()
+        {
+            sbfLength_ = parsing_utilities::getLength(telegram_->message);
+            if (sbfLength_ < SBF_HEADER_SIZE)
+            {
+                ++sbfFaults_;
+                fault("SBF header read fault, invalid block length " +
+                      std::to_string(sbfLength_));
+                state_ = state::SYNC_1;
+                return;
+            }
+            if (sbfLength_ > telegram_->message.capacity())
+            {
+                // Move the header to a telegram of the matching size class
+                std::shared_ptr<Telegram> telegram = pool_->acquire(sbfLength_);
+                telegram->stamp = telegram_->stamp;
+                telegram->type = telegram_->type;
+                telegram->message.assign(telegram_->message.begin(),
+                                         telegram_->message.end());
+                telegram_ = std::move(telegram);
+            }
+            state_ = state::SBF_BODY;
+            if (sbfLength_ == SBF_HEADER_SIZE)
+                processSbf();
+        }
+
+        void processSbf()
+        {
+            if (crc::isValid(telegram_->message))
+            {
+                emit();
+            } else
+            {
+                ++sbfFaults_;
+                fault("crc failed for SBF " +
+                      std::to_string(parsing_utilities::getId(telegram_->message)) +
+                      ".");
+            }
+            state_ = state::SYNC_1;
+        }
+
+        const uint8_t* processString(const uint8_t* it, const uint8_t* end,
+                                     Timestamp stamp)
+        {
+            const uint8_t* start = it;
+            while ((it != end) && (*it != SYNC_BYTE_1) && (*it != LF) &&
+                   (*it != CONNECTION_DESCRIPTOR_FOOTER))
+                ++it;
+
+            std::vector<uint8_t>& message = telegram_->message;
+            message.insert(message.end(), start, it);
+
+            if (it == end)
+            {
+                if (message.size() > MAX_SBF_SIZE)
+                {
+                    ++stringFaults_;
+                    fault("string read fault, no termination found within " +
+                          std::to_string(MAX_SBF_SIZE) + " bytes.");
+                    state_ = state::SYNC_1;
+                }
+                return it;
+            }
+
+            switch (*it)
+            {
+            case SYNC_BYTE_1:
+            {
+                ++stringFaults_;
+                fault("string read fault, sync 1 found.");
+                restartAtSync1(stamp);
+                break;
+            }
+            case LF:
+            {
+                message.push_back(LF);
+                state_ = state::SYNC_1;
+                if (message[message.size() - 2] != CR)
+                {
+                    ++stringFaults_;
+                    fault("LF wo CR: " +
+                          std::string(message.begin(), message.end()));
+                } else if (telegram_->type == telegram_type::RESPONSE)
+                    state_ = state::RESPONSE_LINE;
+                else
+                    emit();
+                break;
+            }
+            case CONNECTION_DESCRIPTOR_FOOTER:
+            {
+                message.push_back(CONNECTION_DESCRIPTOR_FOOTER);
+                telegram_->type = telegram_type::CONNECTION_DESCRIPTOR;
+                emit();
+                state_ = state::SYNC_1;
+                break;
+            }
+            }
+            return ++it;
+        }
+
+        const uint8_t* append(const uint8_t* it, const uint8_t* end,
+                              std::size_t targetSize)
+        {
+            std::vector<uint8_t>& message = telegram_->message;
+            std::size_t missing = targetSize - message.size();
+            std::size_t available = static_cast<std::size_t>(end - it);
+            std::size_t count = (missing < available) ? missing : available;
+            message.insert(message.end(), it, it + count);
+            return it + count;
+        }
+
+        void emit()
+        {
+            ++telegrams_;
+            onTelegram_(telegram_);
+            telegram_.reset();
+        }
+
+        void fault(const std::string& msg)
+        {
+            if (onFault_)
+                onFault_(msg);
+        }
+
+        TelegramCallback onTelegram_;
+        FaultCallback onFault_;
+        //! Source of the telegrams
+        std::shared_ptr<TelegramPool> pool_;
+
+        state state_ = state::SYNC_1;
+        //! Telegram currently being assembled
+        std::shared_ptr<Telegram> telegram_;
+        //! Length of the SBF block currently being assembled
+        uint16_t sbfLength_ = 0;
+
+        uint64_t telegrams_ = 0;
+        uint64_t sbfFaults_ = 0;
+        uint64_t stringFaults_ = 0;
+    };
+} // namespace io
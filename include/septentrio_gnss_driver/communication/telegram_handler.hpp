@@ -68,6 +68,7 @@
 #ifdef ROS1
 #include <septentrio_gnss_driver/abstraction/typedefs_ros1.hpp>
 #endif
+#include <septentrio_gnss_driver/communication/command_pipeline.hpp>
 #include <septentrio_gnss_driver/communication/message_handler.hpp>
 #include <septentrio_gnss_driver/communication/telegram.hpp>
 
@@ -120,13 +121,15 @@ namespace io {
         ~TelegramHandler()
         {
             cdSemaphore_.notify();
-            responseSemaphore_.notify();
+            capabilitiesSemaphore_.notify();
+            commandPipeline_.cancel();
         }
 
         void clearSemaphores()
         {
             cdSemaphore_.notify();
-            responseSemaphore_.notify();
+            capabilitiesSemaphore_.notify();
+            commandPipeline_.cancel();
         }
 
         /**
@@ -144,8 +147,8 @@ namespace io {
             return mainConnectionDescriptor_;
         }
 
-        //! Waits for response
-        void waitForResponse() { responseSemaphore_.wait(); }
+        //! Returns the pipeline the responses of the Rx are matched in
+        CommandPipeline& commandPipeline() { return commandPipeline_; }
 
         //! Waits for capabilities
         void waitForCapabilities() { capabilitiesSemaphore_.wait(); }
@@ -159,6 +162,8 @@ namespace io {
         void handleResponse(const std::shared_ptr<Telegram>& telegram);
         void handleError(const std::shared_ptr<Telegram>& telegram);
         void handleCd(const std::shared_ptr<Telegram>& telegram);
+        //! Detects the capabilities in the response to "grc"
+        void handleCapabilities(const std::string& block_in_string);
         //! Pointer to Node
         ROSaicNodeBase* node_;
 
@@ -166,8 +171,8 @@ namespace io {
         MessageHandler messageHandler_;
 
         Semaphore cdSemaphore_;
-        Semaphore responseSemaphore_;
         Semaphore capabilitiesSemaphore_;
+        CommandPipeline commandPipeline_;
         std::string mainConnectionDescriptor_ = std::string();
     };
 
@@ -0,0 +1,274 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+
+/**
+ * @file telegram_pool.hpp
+ * @brief Pool of recycled telegrams to avoid heap allocations per message
+ *
+ * Telegrams handed out by the pool are regular std::shared_ptr<Telegram>. When the
+ * last owner releases a telegram, it is cleared and put back into the free list of
+ * its size class, keeping the capacity of its message buffer. The control blocks of
+ * the shared pointers are recycled as well, such that in steady state neither
+ * acquiring nor releasing a telegram allocates.
+ */
+
+/**
+ * @class TelegramPool
+ * @brief Thread-safe pool of telegrams with size classes up to MAX_SBF_SIZE
+ *
+ * Must be owned by a std::shared_ptr, outstanding telegrams keep the pool alive.
+ */
+class TelegramPool : public std::enable_shared_from_this<TelegramPool>
+{
+public:
+    //! Message capacities of the size classes in bytes
+    static constexpr std::array<std::size_t, 5> SIZE_CLASSES = {
+        256, 1024, 4096, 16384, static_cast<std::size_t>(MAX_SBF_SIZE) + 1};
+
+    /**
+     * @brief Constructor
+     * @param[in] maxCachedPerClass Maximum number of idle telegrams kept per size
+     * class, surplus telegrams are freed on release
+     */
+    explicit TelegramPool(std::size_t maxCachedPerClass = 64) :
+        maxCachedPerClass_(maxCachedPerClass)
+    {
+        for (auto& sizeClass : classes_)
+            sizeClass.free.reserve(maxCachedPerClass_);
+        controlBlocks_.reserve(maxCachedPerClass_ * SIZE_CLASSES.size());
+    }
+
+    ~TelegramPool()
+    {
+        for (auto& sizeClass : classes_)
+            for (Telegram* telegram : sizeClass.free)
+                delete telegram;
+        for (void* block : controlBlocks_)
+            ::operator delete(block);
+    }
+
+    TelegramPool(const TelegramPool&) = delete;
+    TelegramPool& operator=(const TelegramPool&) = delete;
+
+    /**
+     * @brief Hands out an empty telegram whose message can hold at least size
+     * bytes without reallocation
+     * @param[in] size Expected size of the message in bytes
+     * @return Telegram, returned to the pool when its last owner releases it
+     */
+    [[nodiscard]] std::shared_ptr<Telegram> acquire(std::size_t size = 0)
+    {
+        const std::size_t idx = classIndex(size);
+        Telegram* telegram = nullptr;
+        {
+            SizeClass& sizeClass = classes_[idx];
+            std::lock_guard<std::mutex> lck(sizeClass.mtx);
+            if (!sizeClass.free.empty())
+            {
+                telegram = sizeClass.free.back();
+                sizeClass.free.pop_back();
+            }
+        }
+
+        if (telegram)
+        {
+            ++hits_;
+        } else
+        {
+            ++misses_;
+            telegram = new Telegram(0);
+            telegram->message.reserve(std::max(size, SIZE_CLASSES[idx]));
+        }
+
+        // Copying is cheaper than a second lock of the weak self reference
+        std::shared_ptr<TelegramPool> self = shared_from_this();
+        return std::shared_ptr<Telegram>(telegram, Recycler{self},
+                                         ControlBlockAllocator<Telegram>{self});
+    }
+
+    //! Number of acquisitions served from the free lists
+    [[nodiscard]] uint64_t hits() const { return hits_; }
+    //! Number of acquisitions that had to allocate a new telegram
+    [[nodiscard]] uint64_t misses() const { return misses_; }
+    //! Number of idle telegrams currently held by the pool
+    [[nodiscard]] std::size_t cached() const
+    {
+        std::size_t count = 0;
+        for (auto& sizeClass : classes_)
+        {
+            std::lock_guard<std::mutex> lck(sizeClass.mtx);
+            count += sizeClass.free.size();
+        }
+        return count;
+    }
+
+private:
+    struct SizeClass
+    {
+        mutable std::mutex mtx;
+        std::vector<Telegram*> free;
+    };
+
+    //! Deleter putting telegrams back into the pool
+    struct Recycler
+    {
+        std::shared_ptr<TelegramPool> pool;
+
+        void operator()(Telegram* telegram) const { pool->release(telegram); }
+    };
+
+    //! Allocator recycling the control blocks of the handed out shared pointers
+    template <typename T>
+    struct ControlBlockAllocator
+    {
+        typedef T value_type;
+
+        std::shared_ptr<TelegramPool> pool;
+
+        ControlBlockAllocator(std::shared_ptr<TelegramPool> p) : pool(std::move(p))
+        {
+        }
+
+        template <typename U>
+        ControlBlockAllocator(const ControlBlockAllocator<U>& other) :
+            pool(other.pool)
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(pool->allocateControlBlock(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n)
+        {
+            pool->deallocateControlBlock(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        bool operator==(const ControlBlockAllocator<U>& other) const
+        {
+            return pool == other.pool;
+        }
+
+        template <typename U>
+        bool operator!=(const ControlBlockAllocator<U>& other) const
+        {
+            return pool != other.pool;
+        }
+    };
+
+    static std::size_t classIndex(std::size_t size)
+    {
+        for (std::size_t i = 0; i < SIZE_CLASSES.size(); ++i)
+        {
+            if (size <= SIZE_CLASSES[i])
+                return i;
+        }
+        return SIZE_CLASSES.size() - 1;
+    }
+
+    void release(Telegram* telegram)
+    {
+        const std::size_t capacity = telegram->message.capacity();
+        if (capacity >= SIZE_CLASSES[0])
+        {
+            std::size_t idx = SIZE_CLASSES.size() - 1;
+            while (SIZE_CLASSES[idx] > capacity)
+                --idx;
+
+            telegram->stamp = 0;
+            telegram->type = telegram_type::EMPTY;
+            telegram->message.clear();
+
+            SizeClass& sizeClass = classes_[idx];
+            std::lock_guard<std::mutex> lck(sizeClass.mtx);
+            if (sizeClass.free.size() < maxCachedPerClass_)
+            {
+                sizeClass.free.push_back(telegram);
+                return;
+            }
+        }
+        delete telegram;
+    }
+
+    void* allocateControlBlock(std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lck(controlBlockMtx_);
+            if ((size == controlBlockSize_) && !controlBlocks_.empty())
+            {
+                void* block = controlBlocks_.back();
+                controlBlocks_.pop_back();
+                return block;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    void deallocateControlBlock(void* block, std::size_t size)
+    {
+        {
+            std::lock_guard<std::mutex> lck(controlBlockMtx_);
+            if (controlBlocks_.empty())
+                controlBlockSize_ = size;
+            if ((size == controlBlockSize_) &&
+                (controlBlocks_.size() < controlBlocks_.capacity()))
+            {
+                controlBlocks_.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    const std::size_t maxCachedPerClass_;
+    std::array<SizeClass, SIZE_CLASSES.size()> classes_;
+
+    std::mutex controlBlockMtx_;
+    std::size_t controlBlockSize_ = 0;
+    std::vector<void*> controlBlocks_;
+
+    std::atomic<uint64_t> hits_ = 0;
+    std::atomic<uint64_t> misses_ = 0;
+};
@@ -0,0 +1,502 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ROSaic
+#include <septentrio_gnss_driver/communication/lock_free_queue.hpp>
+#include <septentrio_gnss_driver/communication/settings.hpp>
+#include <septentrio_gnss_driver/communication/telegram.hpp>
+#include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+
+/**
+ * @file telegram_queue.hpp
+ * @brief Bounded telegram queue with priority lanes and overflow policies per
+ * telegram type
+ */
+
+namespace telegram_priority {
+    enum TelegramPriority
+    {
+        //! Responses, connection descriptors and shutdown, never shared with
+        //! droppable telegrams
+        CONTROL,
+        HIGH,
+        NORMAL,
+        LOW
+    };
+} // namespace telegram_priority
+
+/**
+ * @class LatencyHistogram
+ * @brief Histogram of queueing latencies with fixed buckets, written by one thread
+ * and readable from any thread
+ */
+class LatencyHistogram
+{
+public:
+    //! Upper bounds of the buckets in microseconds, the last bucket is open
+    static constexpr std::array<uint32_t, 10> BOUNDS_US = {
+        100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000};
+    static const std::size_t NUMBER_OF_BUCKETS = BOUNDS_US.size() + 1;
+
+    LatencyHistogram()
+    {
+        for (auto& count : counts_)
+            count = 0;
+    }
+
+    void add(std::chrono::nanoseconds latency) noexcept
+    {
+        const auto us =
+            std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+        std::size_t bucket = 0;
+        while ((bucket < BOUNDS_US.size()) && (us >= BOUNDS_US[bucket]))
+            ++bucket;
+        counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t count(std::size_t bucket) const noexcept
+    {
+        return counts_[bucket].load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t total() const noexcept
+    {
+        uint64_t total = 0;
+        for (const auto& count : counts_)
+            total += count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    /**
+     * @brief Upper bound of the bucket containing the given percentile
+     * @param[in] percentile Percentile in [0, 1]
+     * @return Bound in microseconds, 0 if empty, UINT32_MAX for the open bucket
+     */
+    [[nodiscard]] uint32_t percentile(double percentile) const noexcept
+    {
+        const uint64_t n = total();
+        if (n == 0)
+            return 0;
+        const uint64_t rank = static_cast<uint64_t>(percentile * (n - 1)) + 1;
+        uint64_t cumulated = 0;
+        for (std::size_t bucket = 0; bucket < BOUNDS_US.size(); ++bucket)
+        {
+            cumulated += count(bucket);
+            if (cumulated >= rank)
+                return BOUNDS_US[bucket];
+        }
+        return UINT32_MAX;
+    }
+
+    //! Non-empty buckets, e.g. "<100us: 12, <250us: 3, >=100000us: 1"
+    [[nodiscard]] std::string toString() const
+    {
+        std::string result;
+        for (std::size_t bucket = 0; bucket < NUMBER_OF_BUCKETS; ++bucket)
+        {
+            const uint64_t n = count(bucket);
+            if (n == 0)
+                continue;
+            if (!result.empty())
+                result += ", ";
+            if (bucket < BOUNDS_US.size())
+                result += "<" + std::to_string(BOUNDS_US[bucket]) + "us: ";
+            else
+                result += ">=" + std::to_string(BOUNDS_US.back()) + "us: ";
+            result += std::to_string(n);
+        }
+        return result;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUMBER_OF_BUCKETS> counts_;
+};
+
+/**
+ * @class TelegramQueue
+ * @brief Bounded queue between the connections and the processing thread
+ *
+ * Telegrams are sorted into priority lanes, SBF blocks by ID and all other
+ * telegrams by type. pop always drains the higher lanes first, so that small
+ * latency-critical blocks do not wait behind large low priority blocks. Within a
+ * lane the order is preserved.
+ *
+ * When a lane is full, the overflow policy of the incoming telegram's type
+ * decides whether the producer waits, the incoming telegram is dropped or the
+ * oldest telegram of the lane is evicted. Responses, connection descriptors and
+ * empty (shutdown) telegrams have a lane of their own, so they are neither
+ * dropped nor reordered. With KEEP_LATEST, once a lane has overflowed, SBF blocks
+ * that have been superseded by a newer block of the same ID while queued are
+ * discarded on pop until the lane has been drained.
+ */
+class TelegramQueue
+{
+public:
+    static const std::size_t NUMBER_OF_TYPES = telegram_type::UNKNOWN + 1;
+    static const std::size_t NUMBER_OF_LANES = telegram_priority::LOW + 1;
+    static const std::size_t NUMBER_OF_SBF_IDS = 8192;
+
+    /**
+     * @brief Constructor
+     * @param[in] capacity Capacity per lane, rounded up to the next power of two
+     */
+    explicit TelegramQueue(std::size_t capacity = 4096)
+    {
+        for (auto& lane : lanes_)
+            lane = std::make_unique<LockFreeQueue<Entry>>(capacity, &signal_);
+        policies_.fill(overflow_policy::BLOCK);
+        sbfPriorities_.fill(telegram_priority::NORMAL);
+        for (auto& drops : drops_)
+            drops = 0;
+        for (auto& generation : latest_)
+            generation = 0;
+        for (auto& overflowed : overflowed_)
+            overflowed = false;
+    }
+
+    /**
+     * @brief Sets the overflow policy of a telegram type, has no effect for types
+     * that must not be dropped
+     */
+    void setPolicy(telegram_type::TelegramType type,
+                   overflow_policy::OverflowPolicy policy)
+    {
+        if (droppable(type))
+            policies_[type] = policy;
+    }
+
+    [[nodiscard]] overflow_policy::OverflowPolicy
+    policy(telegram_type::TelegramType type) const
+    {
+        return policies_[type];
+    }
+
+    /**
+     * @brief Sets the lane of an SBF block, all blocks default to NORMAL. CONTROL
+     * is reserved for telegrams that must not be dropped and is ignored.
+     */
+    void setPriority(uint16_t sbfId, telegram_priority::TelegramPriority priority)
+    {
+        if ((sbfId < NUMBER_OF_SBF_IDS) && (priority != telegram_priority::CONTROL))
+            sbfPriorities_[sbfId] = priority;
+    }
+
+    /**
+     * @brief Moves SBF blocks to the highest lane of any of them, so that they
+     * cannot overtake each other, e.g. the blocks of an epoch
+     */
+    void shareLane(const std::vector<uint16_t>& sbfIds)
+    {
+        telegram_priority::TelegramPriority lane = telegram_priority::LOW;
+        for (auto id : sbfIds)
+        {
+            if (id < NUMBER_OF_SBF_IDS)
+                lane = std::min(lane, sbfPriorities_[id]);
+        }
+        for (auto id : sbfIds)
+            setPriority(id, lane);
+    }
+
+    //! Lane of a telegram
+    [[nodiscard]] telegram_priority::TelegramPriority
+    priority(const Telegram& telegram) const
+    {
+        switch (telegram.type)
+        {
+        case telegram_type::SBF:
+        {
+            return sbfPriorities_[parsing_utilities::getId(telegram.message)];
+        }
+        case telegram_type::NMEA:
+        case telegram_type::NMEA_INS:
+        {
+            return telegram_priority::NORMAL;
+        }
+        case telegram_type::UNKNOWN:
+        {
+            return telegram_priority::LOW;
+        }
+        default:
+        {
+            // Responses are awaited by the configuration and EMPTY is used for
+            // shutdown
+            return telegram_priority::CONTROL;
+        }
+        }
+    }
+
+    /**
+     * @brief Pushes a telegram, applying the overflow policy if its lane is full
+     * @param[in] telegram Telegram to be pushed
+     */
+    void push(const std::shared_ptr<Telegram>& telegram) noexcept
+    {
+        Entry entry{telegram, 0, std::chrono::steady_clock::now()};
+        const overflow_policy::OverflowPolicy policy = policies_[telegram->type];
+        const std::size_t laneIndex = priority(*telegram);
+        LockFreeQueue<Entry>& lane = *lanes_[laneIndex];
+
+        if ((policy == overflow_policy::KEEP_LATEST) &&
+            (telegram->type == telegram_type::SBF))
+            entry.generation =
+                ++latest_[parsing_utilities::getId(telegram->message)];
+
+        if (!lane.tryPush(entry))
+        {
+            switch (policy)
+            {
+            case overflow_policy::BLOCK:
+            {
+                lane.push(entry);
+                break;
+            }
+            case overflow_policy::DROP_NEWEST:
+            {
+                ++drops_[telegram->type];
+                return;
+            }
+            case overflow_policy::KEEP_LATEST:
+            {
+                overflowed_[laneIndex] = true;
+                pushEvictingOldest(lane, entry);
+                break;
+            }
+            case overflow_policy::DROP_OLDEST:
+            {
+                pushEvictingOldest(lane, entry);
+                break;
+            }
+            }
+        }
+
+        std::size_t queued = size();
+        std::size_t highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+        while ((queued > highWaterMark) &&
+               !highWaterMark_.compare_exchange_weak(highWaterMark, queued,
+                                                     std::memory_order_relaxed))
+            ;
+    }
+
+    /**
+     * @brief Pops the oldest valid telegram of the highest non-empty lane, waits
+     * until one is available. Must only be called from one thread.
+     * @param[out] telegram Popped telegram
+     */
+    void pop(std::shared_ptr<Telegram>& telegram) noexcept
+    {
+        popUntil(telegram, std::chrono::steady_clock::time_point::max());
+    }
+
+    /**
+     * @brief Like pop, but waits at most for the given time
+     * @param[out] telegram Popped telegram
+     * @param[in] timeout Maximum time to wait
+     * @return False if no telegram arrived in time
+     */
+    bool pop(std::shared_ptr<Telegram>& telegram,
+             std::chrono::nanoseconds timeout) noexcept
+    {
+        return popUntil(telegram, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Waits until fewer than the given number of telegrams are queued, so
+     * that a file replay reads ahead by a bounded window. Woken by pop.
+     * @param[in] window Number of queued telegrams to fall below
+     * @param[in] running The wait is abandoned once this is false and
+     * wakeProducers has been called
+     * @return False if abandoned
+     */
+    bool waitBelow(std::size_t window, const std::atomic<bool>& running)
+    {
+        if (size() < window)
+            return running;
+        std::unique_lock<std::mutex> lock(spaceMutex_);
+        ++waitingProducers_;
+        // Pairs with the fence in popUntil: either this sees the freed slot or pop
+        // sees the waiting producer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        spaceCondition_.wait(lock, [this, window, &running]() {
+            return !running || (size() < window);
+        });
+        --waitingProducers_;
+        return running;
+    }
+
+    //! Wakes producers waiting in waitBelow, e.g. after clearing their flag
+    void wakeProducers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(spaceMutex_);
+        }
+        spaceCondition_.notify_all();
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    //! Number of queued telegrams in all lanes
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        std::size_t size = 0;
+        for (const auto& lane : lanes_)
+            size += lane->size();
+        return size;
+    }
+    [[nodiscard]] std::size_t
+    size(telegram_priority::TelegramPriority priority) const noexcept
+    {
+        return lanes_[priority]->size();
+    }
+    //! Capacity per lane
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return lanes_[0]->capacity();
+    }
+    //! Maximum number of queued telegrams observed
+    [[nodiscard]] std::size_t highWaterMark() const noexcept
+    {
+        return highWaterMark_;
+    }
+    //! Number of dropped telegrams of a type
+    [[nodiscard]] uint64_t drops(telegram_type::TelegramType type) const noexcept
+    {
+        return drops_[type];
+    }
+    //! Time telegrams of a lane spent in the queue
+    [[nodiscard]] const LatencyHistogram&
+    latency(telegram_priority::TelegramPriority priority) const noexcept
+    {
+        return latencies_[priority];
+    }
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<Telegram> telegram;
+        //! Generation of the SBF ID at push, used for KEEP_LATEST
+        uint32_t generation = 0;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    bool popUntil(std::shared_ptr<Telegram>& telegram,
+                  std::chrono::steady_clock::time_point deadline) noexcept
+    {
+        Entry entry;
+        std::size_t lane = 0;
+        auto tryPopHighest = [this, &entry, &lane]() {
+            for (lane = 0; lane < NUMBER_OF_LANES; ++lane)
+            {
+                if (lanes_[lane]->tryPop(entry))
+                    return true;
+            }
+            return false;
+        };
+
+        while (true)
+        {
+            if (!signal_.waitUntil(tryPopHighest, deadline))
+                return false;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waitingProducers_.load(std::memory_order_relaxed) > 0)
+                wakeProducers();
+            latencies_[lane].add(std::chrono::steady_clock::now() - entry.enqueued);
+            // Conflation only applies while the backlog of an overflow is drained
+            const bool conflate = overflowed_[lane];
+            if (conflate && lanes_[lane]->empty())
+                overflowed_[lane] = false;
+            if (conflate && superseded(entry))
+            {
+                ++drops_[telegram_type::SBF];
+                continue;
+            }
+            telegram = std::move(entry.telegram);
+            return true;
+        }
+    }
+
+    static bool droppable(telegram_type::TelegramType type)
+    {
+        return (type == telegram_type::SBF) || (type == telegram_type::NMEA) ||
+               (type == telegram_type::NMEA_INS) ||
+               (type == telegram_type::UNKNOWN);
+    }
+
+    bool superseded(const Entry& entry) const
+    {
+        return (entry.generation != 0) &&
+               (entry.generation !=
+                latest_[parsing_utilities::getId(entry.telegram->message)]);
+    }
+
+    //! Only called for droppable types, which never share a lane with telegrams
+    //! that must not be dropped
+    void pushEvictingOldest(LockFreeQueue<Entry>& lane, const Entry& entry)
+    {
+        for (std::size_t i = 0; i < lane.capacity(); ++i)
+        {
+            Entry oldest;
+            if (lane.tryPop(oldest))
+                ++drops_[oldest.telegram->type];
+            if (lane.tryPush(entry))
+                return;
+        }
+        lane.push(entry);
+    }
+
+    //! Shared by all lanes, so that the consumer waits on all of them
+    queue_utilities::ConsumerSignal signal_;
+    //! Producers waiting in waitBelow, woken by pop
+    std::mutex spaceMutex_;
+    std::condition_variable spaceCondition_;
+    std::atomic<uint32_t> waitingProducers_ = 0;
+    std::array<std::unique_ptr<LockFreeQueue<Entry>>, NUMBER_OF_LANES> lanes_;
+    std::array<overflow_policy::OverflowPolicy, NUMBER_OF_TYPES> policies_;
+    std::array<telegram_priority::TelegramPriority, NUMBER_OF_SBF_IDS>
+        sbfPriorities_;
+    std::array<std::atomic<uint64_t>, NUMBER_OF_TYPES> drops_;
+    //! Generation of the latest pushed block per SBF ID
+    std::array<std::atomic<uint32_t>, NUMBER_OF_SBF_IDS> latest_;
+    //! Set when a KEEP_LATEST telegram found its lane full, cleared once drained
+    std::array<std::atomic<bool>, NUMBER_OF_LANES> overflowed_;
+    std::array<LatencyHistogram, NUMBER_OF_LANES> latencies_;
+    std::atomic<std::size_t> highWaterMark_ = 0;
+};
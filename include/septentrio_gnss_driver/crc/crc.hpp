@@ -63,4 +63,14 @@ namespace crc {
      */
     bool isValid(const std::vector<uint8_t>& message);
 
+    /**
+     * @brief Validates the CRC of an SBF block within a raw buffer, e.g. a memory
+     * mapped file
+     * @param block Pointer to the sync bytes of the SBF block
+     * @param size Number of bytes available from block on
+     * @return True if the SBF block fits into the buffer and its CRC check has
+     * passed, false otherwise
+     */
+    bool isValid(const uint8_t* block, size_t size);
+
 } // namespace crc
@@ -88,10 +88,33 @@ namespace rosaic_node {
         //! messages, and publishes requested ROS messages...
         ROSaicNode(const rclcpp::NodeOptions& options);
 
+        /**
+         * @brief Constructor of an additional receiver hosted by the node
+         *
+         * It shares the I/O threads, tf buffer and diagnostics of the host.
+         * @param[in] host Node hosting the receiver
+         * @param[in] name Name of the receiver, namespacing its parameters, topics
+         * and services
+         */
+        ROSaicNode(ROSaicNode& host, const std::string& name);
+
         ~ROSaicNode();
 
     private:
+        /**
+         * @brief Registers the services of the receiver and connects to it in the
+         * background
+         */
+        void start();
         void setup();
+        /**
+         * @brief Creates the additional receivers listed in parameter receivers
+         */
+        void addReceivers();
+        /**
+         * @brief Registers the diagnostics tasks of the receiver
+         */
+        void addDiagnostics();
         /**
          * @brief Gets the node parameters from the ROS Parameter Server, parts of
          * which are specified in a YAML file
@@ -129,14 +152,23 @@ namespace rosaic_node {
 
         void diagnosticsStatusCallback(diagnostic_updater::DiagnosticStatusWrapper &status);
 
+        /**
+         * @brief Registers the services controlling the replay of files
+         */
+        void registerReplayServices();
+
         //! Handles communication with the Rx
         io::CommunicationCore IO_;
-        //! tf2 buffer and listener
-        tf2_ros::Buffer tfBuffer_;
-        std::unique_ptr<tf2_ros::TransformListener> tfListener_;
+        //! Additional receivers hosted by the node
+        std::vector<std::unique_ptr<ROSaicNode>> receivers_;
 
         std::thread setupThread_;
 
         bool connectedToINS_ = false;
+
+        //! Pauses (true) or resumes (false) the replay of files
+        rclcpp::Service<std_srvs::srv::SetBool>::SharedPtr replayPauseService_;
+        //! Advances a paused replay by one epoch
+        rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr replayStepService_;
     };
 } // namespace rosaic_node
\ No newline at end of file
@@ -129,6 +129,11 @@ namespace rosaic_node {
 
         void sendVelocity(const std::string& velNmea);
 
+        /**
+         * @brief Registers the services controlling the replay of files
+         */
+        void registerReplayServices();
+
         //! Handles communication with the Rx
         io::CommunicationCore IO_;
         //! tf2 buffer and listener
@@ -136,5 +141,10 @@ namespace rosaic_node {
         std::unique_ptr<tf2_ros::TransformListener> tfListener_;
 
         std::thread setupThread_;
+
+        //! Pauses (true) or resumes (false) the replay of files
+        ros::ServiceServer replayPauseService_;
+        //! Advances a paused replay by one epoch
+        ros::ServiceServer replayStepService_;
     };
 } // namespace rosaic_node
\ No newline at end of file
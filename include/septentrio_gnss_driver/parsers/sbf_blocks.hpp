@@ -65,9 +65,11 @@ static const uint8_t SBF_SYNC_2 = 0x40;
 
 // C++
 #include <algorithm>
+#include <bitset>
+#include <iterator>
+#include <string>
 #include <type_traits>
-// Boost
-#include <boost/spirit/include/qi.hpp>
+#include <vector>
 // ROSaic
 #ifdef ROS2
 #include <septentrio_gnss_driver/abstraction/typedefs.hpp>
@@ -76,6 +78,7 @@ static const uint8_t SBF_SYNC_2 = 0x40;
 #include <septentrio_gnss_driver/abstraction/typedefs_ros1.hpp>
 #endif
 #include <septentrio_gnss_driver/parsers/parsing_utilities.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_layout.hpp>
 
 /**
  * @file sbf_structs.hpp
@@ -86,36 +89,66 @@ static const uint8_t SBF_SYNC_2 = 0x40;
 
 /**
  * @class ChannelStateInfo
- * @brief Struct for the SBF sub-block "ChannelStateInfo"
+ * @brief Struct for the SBF sub-blocks "ChannelStateInfo" of a block, stored as
+ * structure of arrays
  */
 struct ChannelStateInfo
 {
-    uint8_t antenna;
-    uint16_t tracking_status;
-    uint16_t pvt_status;
-    uint16_t pvt_info;
+    std::vector<uint8_t> antenna;
+    std::vector<uint16_t> tracking_status;
+    std::vector<uint16_t> pvt_status;
+    std::vector<uint16_t> pvt_info;
+
+    //! Keeps the capacity of the arrays
+    void resize(size_t n)
+    {
+        antenna.resize(n);
+        tracking_status.resize(n);
+        pvt_status.resize(n);
+        pvt_info.resize(n);
+    }
 };
 
 /**
  * @class ChannelSatInfo
- * @brief Struct for the SBF sub-block "ChannelSatInfo"
+ * @brief Struct for the SBF sub-blocks "ChannelSatInfo" of a block, stored as
+ * structure of arrays
+ *
+ * The ChannelStateInfo sub-blocks of ChannelSatInfo i are found at indices
+ * state_info_begin[i] to state_info_begin[i] + n2[i] of the ChannelStateInfo
+ * arrays.
  */
 struct ChannelSatInfo
 {
-    uint8_t sv_id;
-    uint8_t freq_nr;
-    uint16_t az_rise_set;
-    uint16_t health_status;
-    int8_t elev;
-    uint8_t n2;
-    uint8_t rx_channel;
-
-    std::vector<ChannelStateInfo> stateInfo;
+    std::vector<uint8_t> sv_id;
+    std::vector<uint8_t> freq_nr;
+    std::vector<uint16_t> az_rise_set;
+    std::vector<uint16_t> health_status;
+    std::vector<int8_t> elev;
+    std::vector<uint8_t> n2;
+    std::vector<uint8_t> rx_channel;
+    std::vector<uint16_t> state_info_begin;
+
+    //! Keeps the capacity of the arrays
+    void resize(size_t n)
+    {
+        sv_id.resize(n);
+        freq_nr.resize(n);
+        az_rise_set.resize(n);
+        health_status.resize(n);
+        elev.resize(n);
+        n2.resize(n);
+        rx_channel.resize(n);
+        state_info_begin.resize(n);
+    }
 };
 
 /**
  * @class ChannelStatus
  * @brief Struct for the SBF block "ChannelStatus"
+ *
+ * The sub-blocks are stored as flat arrays which keep their capacity from block
+ * to block.
  */
 struct ChannelStatus
 {
@@ -125,7 +158,105 @@ struct ChannelStatus
     uint8_t sb1_length;
     uint8_t sb2_length;
 
-    std::vector<ChannelSatInfo> satInfo;
+    ChannelSatInfo satInfo;
+    ChannelStateInfo stateInfo;
+};
+
+/**
+ * @class MeasEpochChannelType2
+ * @brief Struct for the SBF sub-blocks "MeasEpochChannelType2" of a block,
+ * stored as structure of arrays
+ */
+struct MeasEpochChannelType2
+{
+    std::vector<uint8_t> type;
+    std::vector<uint8_t> lock_time;
+    std::vector<uint8_t> cn0;
+    std::vector<uint8_t> offsets_msb;
+    std::vector<int8_t> carrier_msb;
+    std::vector<uint8_t> obs_info;
+    std::vector<uint16_t> code_offset_lsb;
+    std::vector<uint16_t> carrier_lsb;
+    std::vector<uint16_t> doppler_offset_lsb;
+
+    //! Keeps the capacity of the arrays
+    void resize(size_t n)
+    {
+        type.resize(n);
+        lock_time.resize(n);
+        cn0.resize(n);
+        offsets_msb.resize(n);
+        carrier_msb.resize(n);
+        obs_info.resize(n);
+        code_offset_lsb.resize(n);
+        carrier_lsb.resize(n);
+        doppler_offset_lsb.resize(n);
+    }
+};
+
+/**
+ * @class MeasEpochChannelType1
+ * @brief Struct for the SBF sub-blocks "MeasEpochChannelType1" of a block,
+ * stored as structure of arrays
+ *
+ * The MeasEpochChannelType2 sub-blocks of MeasEpochChannelType1 i are found at
+ * indices type2_begin[i] to type2_begin[i] + n2[i] of the MeasEpochChannelType2
+ * arrays.
+ */
+struct MeasEpochChannelType1
+{
+    std::vector<uint8_t> rx_channel;
+    std::vector<uint8_t> type;
+    std::vector<uint8_t> sv_id;
+    std::vector<uint8_t> misc;
+    std::vector<uint32_t> code_lsb;
+    std::vector<int32_t> doppler;
+    std::vector<uint16_t> carrier_lsb;
+    std::vector<int8_t> carrier_msb;
+    std::vector<uint8_t> cn0;
+    std::vector<uint16_t> lock_time;
+    std::vector<uint8_t> obs_info;
+    std::vector<uint8_t> n2;
+    std::vector<uint16_t> type2_begin;
+
+    //! Keeps the capacity of the arrays
+    void resize(size_t n)
+    {
+        rx_channel.resize(n);
+        type.resize(n);
+        sv_id.resize(n);
+        misc.resize(n);
+        code_lsb.resize(n);
+        doppler.resize(n);
+        carrier_lsb.resize(n);
+        carrier_msb.resize(n);
+        cn0.resize(n);
+        lock_time.resize(n);
+        obs_info.resize(n);
+        n2.resize(n);
+        type2_begin.resize(n);
+    }
+};
+
+/**
+ * @class MeasEpoch
+ * @brief Struct for the SBF block "MeasEpoch"
+ *
+ * The sub-blocks are stored as flat arrays which keep their capacity from block
+ * to block. The ROS message is only assembled by measEpochToMsg() if published.
+ */
+struct MeasEpoch
+{
+    BlockHeaderMsg block_header;
+
+    uint8_t n = 0;
+    uint8_t sb1_length = 0;
+    uint8_t sb2_length = 0;
+    uint8_t common_flags = 0;
+    uint8_t cum_clk_jumps = 0;
+
+    MeasEpochChannelType1 type1;
+    MeasEpochChannelType2 type2;
 };
 
 /**
@@ -255,8 +386,6 @@ static const std::array<uint16_t, 256> CRC_LOOK_UP = {
     0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36,
     0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0};
 
-namespace qi = boost::spirit::qi;
-
 /**
  * setDoNotUse
  * @brief Sets scalar to Do-Not-Use value
@@ -286,169 +415,192 @@ void setDoNotUse(Val& s)
 }
 
 /**
- * doNotUseToNaN
- * @brief Sets scalar to Do-Not-Use value to NaN
+ * charsToString
+ * @brief Copies char array of SBF block to string
  */
-template <typename Val>
-void doNotUseToNaN(Val& s)
+inline void charsToString(const uint8_t* data, std::string& val, std::size_t num)
 {
-    static_assert(std::is_same<float, Val>::value ||
-                  std::is_same<double, Val>::value);
+    val.assign(reinterpret_cast<const char*>(data), num);
+    // remove string termination characters '\0'
+    val.erase(std::remove(val.begin(), val.end(), '\0'), val.end());
+}
 
-    if constexpr (std::is_same<float, Val>::value)
-    {
-        if (s == -2e10f)
-            s = std::numeric_limits<float>::quiet_NaN();
-    } else if constexpr (std::is_same<double, Val>::value)
+/**
+ * validLength
+ * @brief Checks that the telegram holds all bytes to be decoded, so that the
+ * fields can be decoded without further bounds checks
+ */
+template <typename It>
+[[nodiscard]] bool validLength(ROSaicNodeBase* node, It it, It itEnd,
+                               std::size_t length)
+{
+    const auto available = static_cast<std::size_t>(std::distance(it, itEnd));
+    if (available < length)
     {
-        if (s == -2e10)
-            s = std::numeric_limits<double>::quiet_NaN();
+        node->log(log_level::ERROR, "Parse error: Block of " +
+                                        std::to_string(available) +
+                                        " bytes too short, expected at least " +
+                                        std::to_string(length) + " bytes.");
+        return false;
     }
+    return true;
 }
 
 /**
- * qiLittleEndianParser
- * @brief Qi little endian parsers for numeric values
+ * validSubBlockLength
+ * @brief Checks that sub-blocks are long enough for their fields
  */
-template <typename It, typename Val>
-void qiLittleEndianParser(It& it, Val& val)
+[[nodiscard]] inline bool validSubBlockLength(ROSaicNodeBase* node,
+                                              uint8_t sb_length,
+                                              std::size_t minimum)
 {
-    static_assert(
-        std::is_same<int8_t, Val>::value || std::is_same<uint8_t, Val>::value ||
-        std::is_same<int16_t, Val>::value || std::is_same<uint16_t, Val>::value ||
-        std::is_same<int32_t, Val>::value || std::is_same<uint32_t, Val>::value ||
-        std::is_same<int64_t, Val>::value || std::is_same<uint64_t, Val>::value ||
-        std::is_same<float, Val>::value || std::is_same<double, Val>::value);
-
-    if constexpr (std::is_same<int8_t, Val>::value)
-    {
-        qi::parse(it, it + 1, qi::char_, val);
-    } else if constexpr (std::is_same<uint8_t, Val>::value)
-    {
-        qi::parse(it, it + 1, qi::byte_, val);
-    } else if constexpr ((std::is_same<int16_t, Val>::value) ||
-                         (std::is_same<uint16_t, Val>::value))
+    if (sb_length < minimum)
     {
-        qi::parse(it, it + 2, qi::little_word, val);
-    } else if constexpr ((std::is_same<int32_t, Val>::value) ||
-                         (std::is_same<uint32_t, Val>::value))
-    {
-        qi::parse(it, it + 4, qi::little_dword, val);
-    } else if constexpr ((std::is_same<int64_t, Val>::value) ||
-                         (std::is_same<uint64_t, Val>::value))
-    {
-        qi::parse(it, it + 8, qi::little_qword, val);
-    } else if constexpr (std::is_same<float, Val>::value)
-    {
-        qi::parse(it, it + 4, qi::little_bin_float, val);
-        doNotUseToNaN(val);
-    } else if constexpr (std::is_same<double, Val>::value)
-    {
-        qi::parse(it, it + 8, qi::little_bin_double, val);
-        doNotUseToNaN(val);
+        node->log(log_level::ERROR,
+                  "Parse error: Wrong sb_length " + std::to_string(sb_length));
+        return false;
     }
+    return true;
 }
 
 /**
- * qiCharsToStringParser
- * @brief Qi parser for char array to string
+ * validNestedLength
+ * @brief Checks the length of n sub-blocks of type 1, each followed by n2
+ * sub-blocks of type 2
+ *
+ * Only the n2 fields are read, at n2_offset in the sub-blocks of type 1. The
+ * sub-block lengths must have been checked to hold n2. The total number of
+ * sub-blocks of type 2 is returned in n2_total, to size their storage at once.
  */
 template <typename It>
-void qiCharsToStringParser(It& it, std::string& val, std::size_t num)
+[[nodiscard]] bool validNestedLength(ROSaicNodeBase* node, It it, It itEnd,
+                                     std::size_t offset, uint8_t n,
+                                     uint8_t sb1_length, uint8_t sb2_length,
+                                     std::size_t n2_offset, std::size_t& n2_total)
 {
-    val.clear();
-    qi::parse(it, it + num, qi::repeat(num)[qi::char_], val);
-    // remove string termination characters '\0'
-    val.erase(std::remove(val.begin(), val.end(), '\0'), val.end());
+    const auto available = static_cast<std::size_t>(std::distance(it, itEnd));
+    const uint8_t* data = &*it;
+    std::size_t length = offset;
+    n2_total = 0;
+    for (uint8_t i = 0; i < n; ++i)
+    {
+        length += sb1_length;
+        if (length > available)
+            break;
+        uint8_t n2 = data[length - sb1_length + n2_offset];
+        n2_total += n2;
+        length += n2 * sb2_length;
+    }
+    return validLength(node, it, itEnd, length);
 }
 
+//! Layout of the SBF block header plus receiver time stamp
+using BlockHeaderLayout =
+    sbf_layout::Layout<sbf_layout::Field<&BlockHeaderMsg::sync_1, 0>,
+                       sbf_layout::Field<&BlockHeaderMsg::sync_2, 1>,
+                       sbf_layout::Field<&BlockHeaderMsg::crc, 2>,
+                       sbf_layout::Field<&BlockHeaderMsg::length, 6>,
+                       sbf_layout::Field<&BlockHeaderMsg::tow, 8>,
+                       sbf_layout::Field<&BlockHeaderMsg::wnc, 12>>;
+
 /**
  * BlockHeaderParser
- * @brief Qi based parser for the SBF block "BlockHeader" plus receiver time stamp
+ * @brief Parser for the SBF block "BlockHeader" plus receiver time stamp
  */
-template <typename It, typename Hdr>
-[[nodiscard]] bool BlockHeaderParser(ROSaicNodeBase* node, It& it, Hdr& block_header)
+template <typename It>
+[[nodiscard]] bool BlockHeaderParser(ROSaicNodeBase* node, It it, It itEnd,
+                                     BlockHeaderMsg& block_header)
 {
-    qiLittleEndianParser(it, block_header.sync_1);
+    if (!validLength(node, it, itEnd, BlockHeaderLayout::size))
+        return false;
+    const uint8_t* data = &*it;
+    BlockHeaderLayout::decode(data, block_header);
     if (block_header.sync_1 != SBF_SYNC_1)
     {
         node->log(log_level::ERROR, "Parse error: Wrong sync byte 1.");
         return false;
     }
-    qiLittleEndianParser(it, block_header.sync_2);
     if (block_header.sync_2 != SBF_SYNC_2)
     {
         node->log(log_level::ERROR, "Parse error: Wrong sync byte 2.");
         return false;
     }
-    qiLittleEndianParser(it, block_header.crc);
-    uint16_t ID;
-    qiLittleEndianParser(it, ID);
+    uint16_t ID = sbf_layout::load<uint16_t>(data + 4);
     block_header.id = ID & 8191;      // lower 13 bits are id
     block_header.revision = ID >> 13; // upper 3 bits are revision
-    qiLittleEndianParser(it, block_header.length);
-    qiLittleEndianParser(it, block_header.tow);
-    qiLittleEndianParser(it, block_header.wnc);
     return true;
 }
 
+//! Layout of the SBF sub-block "ChannelStateInfo"
+using ChannelStateInfoLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ChannelStateInfo::antenna, 0>,
+                       sbf_layout::Field<&ChannelStateInfo::tracking_status, 2>,
+                       sbf_layout::Field<&ChannelStateInfo::pvt_status, 4>,
+                       sbf_layout::Field<&ChannelStateInfo::pvt_info, 6>>;
+
 /**
  * ChannelStateInfoParser
- * @brief Qi based parser for the SBF sub-block "ChannelStateInfo"
+ * @brief Parser for the SBF sub-block "ChannelStateInfo"
  */
 template <typename It>
-void ChannelStateInfoParser(It& it, ChannelStateInfo& msg, uint8_t sb2_length)
+void ChannelStateInfoParser(It& it, ChannelStateInfo& msg, size_t index,
+                            uint8_t sb2_length)
 {
-    qiLittleEndianParser(it, msg.antenna);
-    ++it; // reserved
-    qiLittleEndianParser(it, msg.tracking_status);
-    qiLittleEndianParser(it, msg.pvt_status);
-    qiLittleEndianParser(it, msg.pvt_info);
-    std::advance(it, sb2_length - 8); // skip padding
+    ChannelStateInfoLayout::decode(&*it, msg, index);
+    std::advance(it, sb2_length);
 };
 
+//! Layout of the SBF sub-block "ChannelSatInfo"
+using ChannelSatInfoLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ChannelSatInfo::sv_id, 0>,
+                       sbf_layout::Field<&ChannelSatInfo::freq_nr, 1>,
+                       sbf_layout::Field<&ChannelSatInfo::az_rise_set, 4>,
+                       sbf_layout::Field<&ChannelSatInfo::health_status, 6>,
+                       sbf_layout::Field<&ChannelSatInfo::elev, 8>,
+                       sbf_layout::Field<&ChannelSatInfo::n2, 9>,
+                       sbf_layout::Field<&ChannelSatInfo::rx_channel, 10>>;
+
 /**
  * ChannelSatInfoParser
- * @brief Qi based parser or the SBF sub-block "ChannelSatInfo"
+ * @brief Parser or the SBF sub-block "ChannelSatInfo"
  */
 template <typename It>
 [[nodiscard]] bool ChannelSatInfoParser(ROSaicNodeBase* node, It& it,
-                                        ChannelSatInfo& msg, uint8_t sb1_length,
-                                        uint8_t sb2_length)
+                                        ChannelStatus& msg, size_t index,
+                                        size_t& state_info_index)
 {
-    qiLittleEndianParser(it, msg.sv_id);
-    qiLittleEndianParser(it, msg.freq_nr);
-    std::advance(it, 2); // reserved
-    qiLittleEndianParser(it, msg.az_rise_set);
-    qiLittleEndianParser(it, msg.health_status);
-    qiLittleEndianParser(it, msg.elev);
-    qiLittleEndianParser(it, msg.n2);
-    if (msg.n2 > MAXSB_CHANNELSTATEINFO)
+    ChannelSatInfoLayout::decode(&*it, msg.satInfo, index);
+    uint8_t n2 = msg.satInfo.n2[index];
+    if (n2 > MAXSB_CHANNELSTATEINFO)
     {
-        node->log(log_level::ERROR, "Parse error: Too many ChannelStateInfo " +
-                                        std::to_string(msg.n2));
+        node->log(log_level::ERROR,
+                  "Parse error: Too many ChannelStateInfo " + std::to_string(n2));
         return false;
     }
-    qiLittleEndianParser(it, msg.rx_channel);
-    ++it;                              // reserved
-    std::advance(it, sb1_length - 12); // skip padding
-    msg.stateInfo.resize(msg.n2);
-    for (auto& stateInfo : msg.stateInfo)
+    std::advance(it, msg.sb1_length);
+    msg.satInfo.state_info_begin[index] = static_cast<uint16_t>(state_info_index);
+    for (uint8_t i = 0; i < n2; ++i, ++state_info_index)
     {
-        ChannelStateInfoParser(it, stateInfo, sb2_length);
+        ChannelStateInfoParser(it, msg.stateInfo, state_info_index, msg.sb2_length);
     }
     return true;
 };
 
+//! Layout of the SBF block "ChannelStatus" without sub-blocks
+using ChannelStatusLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ChannelStatus::n, 14>,
+                       sbf_layout::Field<&ChannelStatus::sb1_length, 15>,
+                       sbf_layout::Field<&ChannelStatus::sb2_length, 16>>;
+
 /**
  * ChannelStatusParser
- * @brief Qi based parser for the SBF block "ChannelStatus"
+ * @brief Parser for the SBF block "ChannelStatus"
  */
 template <typename It>
 [[nodiscard]] bool ChannelStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                        ChannelStatus& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4013)
     {
@@ -456,39 +608,55 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!validLength(node, it, itEnd, 20))
+        return false;
+    const uint8_t* data = &*it;
+    ChannelStatusLayout::decode(data, msg);
     if (msg.n > MAXSB_CHANNELSATINFO)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many ChannelSatInfo " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb1_length);
-    qiLittleEndianParser(it, msg.sb2_length);
-    std::advance(it, 3); // reserved
+    if (!validSubBlockLength(node, msg.sb1_length, ChannelSatInfoLayout::size) ||
+        !validSubBlockLength(node, msg.sb2_length, ChannelStateInfoLayout::size))
+        return false;
+    // n2 at offset 9 of ChannelSatInfo
+    size_t n2_total;
+    if (!validNestedLength(node, it, itEnd, 20, msg.n, msg.sb1_length,
+                           msg.sb2_length, 9, n2_total))
+        return false;
+    const uint8_t* sb = data + 20;
     msg.satInfo.resize(msg.n);
-    for (auto& satInfo : msg.satInfo)
+    msg.stateInfo.resize(n2_total);
+    size_t state_info_index = 0;
+    for (size_t i = 0; i < msg.n; ++i)
     {
-        if (!ChannelSatInfoParser(node, it, satInfo, msg.sb1_length, msg.sb2_length))
+        if (!ChannelSatInfoParser(node, sb, msg, i, state_info_index))
             return false;
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+//! Layout of the SBF block "DOP"
+using DopLayout =
+    sbf_layout::Layout<sbf_layout::Field<&Dop::nr_sv, 14>,
+                       sbf_layout::Field<&Dop::pdop, 16, uint16_t, 100>,
+                       sbf_layout::Field<&Dop::tdop, 18, uint16_t, 100>,
+                       sbf_layout::Field<&Dop::hdop, 20, uint16_t, 100>,
+                       sbf_layout::Field<&Dop::vdop, 22, uint16_t, 100>,
+                       sbf_layout::Field<&Dop::hpl, 24>,
+                       sbf_layout::Field<&Dop::vpl, 28>>;
+
 /**
  * DOPParser
- * @brief Qi based parser for the SBF block "DOP"
+ * @brief Parser for the SBF block "DOP"
  */
 template <typename It>
 [[nodiscard]] bool DOPParser(ROSaicNodeBase* node, It it, It itEnd, Dop& msg)
 {
 
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4001)
     {
@@ -496,93 +664,96 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.nr_sv);
-    ++it; // reserved
-    uint16_t temp;
-    qiLittleEndianParser(it, temp);
-    msg.pdop = temp / 100.0;
-    qiLittleEndianParser(it, temp);
-    msg.tdop = temp / 100.0;
-    qiLittleEndianParser(it, temp);
-    msg.hdop = temp / 100.0;
-    qiLittleEndianParser(it, temp);
-    msg.vdop = temp / 100.0;
-    qiLittleEndianParser(it, msg.hpl);
-    qiLittleEndianParser(it, msg.vpl);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, DopLayout::size))
         return false;
-    }
+    DopLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF sub-block "MeasEpochChannelType2"
+using MeasEpochChannelType2Layout = sbf_layout::Layout<
+    sbf_layout::Field<&MeasEpochChannelType2::type, 0>,
+    sbf_layout::Field<&MeasEpochChannelType2::lock_time, 1>,
+    sbf_layout::Field<&MeasEpochChannelType2::cn0, 2>,
+    sbf_layout::Field<&MeasEpochChannelType2::offsets_msb, 3>,
+    sbf_layout::Field<&MeasEpochChannelType2::carrier_msb, 4>,
+    sbf_layout::Field<&MeasEpochChannelType2::obs_info, 5>,
+    sbf_layout::Field<&MeasEpochChannelType2::code_offset_lsb, 6>,
+    sbf_layout::Field<&MeasEpochChannelType2::carrier_lsb, 8>,
+    sbf_layout::Field<&MeasEpochChannelType2::doppler_offset_lsb, 10>>;
+
 /**
  * MeasEpochChannelType2Parser
- * @brief Qi based parser for the SBF sub-block "MeasEpochChannelType2"
+ * @brief Parser for the SBF sub-block "MeasEpochChannelType2"
  */
 template <typename It>
-void MeasEpochChannelType2Parser(It& it, MeasEpochChannelType2Msg& msg,
+void MeasEpochChannelType2Parser(It& it, MeasEpochChannelType2& msg, size_t index,
                                  uint8_t sb2_length)
 {
-    qiLittleEndianParser(it, msg.type);
-    qiLittleEndianParser(it, msg.lock_time);
-    qiLittleEndianParser(it, msg.cn0);
-    qiLittleEndianParser(it, msg.offsets_msb);
-    qiLittleEndianParser(it, msg.carrier_msb);
-    qiLittleEndianParser(it, msg.obs_info);
-    qiLittleEndianParser(it, msg.code_offset_lsb);
-    qiLittleEndianParser(it, msg.carrier_lsb);
-    qiLittleEndianParser(it, msg.doppler_offset_lsb);
-    std::advance(it, sb2_length - 12); // skip padding
+    MeasEpochChannelType2Layout::decode(&*it, msg, index);
+    std::advance(it, sb2_length);
 };
 
+//! Layout of the SBF sub-block "MeasEpochChannelType1"
+using MeasEpochChannelType1Layout = sbf_layout::Layout<
+    sbf_layout::Field<&MeasEpochChannelType1::rx_channel, 0>,
+    sbf_layout::Field<&MeasEpochChannelType1::type, 1>,
+    sbf_layout::Field<&MeasEpochChannelType1::sv_id, 2>,
+    sbf_layout::Field<&MeasEpochChannelType1::misc, 3>,
+    sbf_layout::Field<&MeasEpochChannelType1::code_lsb, 4>,
+    sbf_layout::Field<&MeasEpochChannelType1::doppler, 8>,
+    sbf_layout::Field<&MeasEpochChannelType1::carrier_lsb, 12>,
+    sbf_layout::Field<&MeasEpochChannelType1::carrier_msb, 14>,
+    sbf_layout::Field<&MeasEpochChannelType1::cn0, 15>,
+    sbf_layout::Field<&MeasEpochChannelType1::lock_time, 16>,
+    sbf_layout::Field<&MeasEpochChannelType1::obs_info, 18>,
+    sbf_layout::Field<&MeasEpochChannelType1::n2, 19>>;
+
 /**
  * MeasEpochChannelType1Parser
- * @brief Qi based parser for the SBF sub-block "MeasEpochChannelType1"
+ * @brief Parser for the SBF sub-block "MeasEpochChannelType1"
  */
 template <typename It>
 [[nodiscard]] bool MeasEpochChannelType1Parser(ROSaicNodeBase* node, It& it,
-                                               MeasEpochChannelType1Msg& msg,
-                                               uint8_t sb1_length,
-                                               uint8_t sb2_length)
+                                               MeasEpoch& msg, size_t index,
+                                               size_t& type2_index)
 {
-    qiLittleEndianParser(it, msg.rx_channel);
-    qiLittleEndianParser(it, msg.type);
-    qiLittleEndianParser(it, msg.sv_id);
-    qiLittleEndianParser(it, msg.misc);
-    qiLittleEndianParser(it, msg.code_lsb);
-    qiLittleEndianParser(it, msg.doppler);
-    qiLittleEndianParser(it, msg.carrier_lsb);
-    qiLittleEndianParser(it, msg.carrier_msb);
-    qiLittleEndianParser(it, msg.cn0);
-    qiLittleEndianParser(it, msg.lock_time);
-    qiLittleEndianParser(it, msg.obs_info);
-    qiLittleEndianParser(it, msg.n2);
-    std::advance(it, sb1_length - 20); // skip padding
-    if (msg.n2 > MAXSB_MEASEPOCH_T2)
+    MeasEpochChannelType1Layout::decode(&*it, msg.type1, index);
+    std::advance(it, msg.sb1_length);
+    uint8_t n2 = msg.type1.n2[index];
+    if (n2 > MAXSB_MEASEPOCH_T2)
     {
         node->log(log_level::ERROR, "Parse error: Too many MeasEpochChannelType2 " +
-                                        std::to_string(msg.n2));
+                                        std::to_string(n2));
         return false;
     }
-    msg.type2.resize(msg.n2);
-    for (auto& type2 : msg.type2)
+    msg.type1.type2_begin[index] = static_cast<uint16_t>(type2_index);
+    for (uint8_t i = 0; i < n2; ++i, ++type2_index)
     {
-        MeasEpochChannelType2Parser(it, type2, sb2_length);
+        MeasEpochChannelType2Parser(it, msg.type2, type2_index, msg.sb2_length);
     }
     return true;
 };
 
+//! Layout of the SBF block "MeasEpoch" without sub-blocks
+using MeasEpochLayout =
+    sbf_layout::Layout<sbf_layout::Field<&MeasEpoch::n, 14>,
+                       sbf_layout::Field<&MeasEpoch::sb1_length, 15>,
+                       sbf_layout::Field<&MeasEpoch::sb2_length, 16>,
+                       sbf_layout::Field<&MeasEpoch::common_flags, 17>>;
+//! Fields of the SBF block "MeasEpoch" added by revision 1
+using MeasEpochRev1Layout =
+    sbf_layout::Layout<sbf_layout::Field<&MeasEpoch::cum_clk_jumps, 18>>;
+
 /**
  * MeasEpochParser
- * @brief Qi based parser for the SBF block "MeasEpoch"
+ * @brief Parser for the SBF block "MeasEpoch"
  */
 template <typename It>
 [[nodiscard]] bool MeasEpochParser(ROSaicNodeBase* node, It it, It itEnd,
-                                   MeasEpochMsg& msg)
+                                   MeasEpoch& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4027)
     {
@@ -590,43 +761,108 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!validLength(node, it, itEnd, 20))
+        return false;
+    const uint8_t* data = &*it;
+    MeasEpochLayout::decode(data, msg);
     if (msg.n > MAXSB_MEASEPOCH_T1)
     {
         node->log(log_level::ERROR, "Parse error: Too many MeasEpochChannelType1 " +
                                         std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb1_length);
-    qiLittleEndianParser(it, msg.sb2_length);
-    qiLittleEndianParser(it, msg.common_flags);
+    if (!validSubBlockLength(node, msg.sb1_length,
+                             MeasEpochChannelType1Layout::size) ||
+        !validSubBlockLength(node, msg.sb2_length,
+                             MeasEpochChannelType2Layout::size))
+        return false;
+    // n2 at offset 19 of MeasEpochChannelType1
+    size_t n2_total;
+    if (!validNestedLength(node, it, itEnd, 20, msg.n, msg.sb1_length,
+                           msg.sb2_length, 19, n2_total))
+        return false;
     if (msg.block_header.revision > 0)
-        qiLittleEndianParser(it, msg.cum_clk_jumps);
-    ++it; // reserved
+        MeasEpochRev1Layout::decode(data, msg);
+    const uint8_t* sb = data + 20;
     msg.type1.resize(msg.n);
-    for (auto& type1 : msg.type1)
+    msg.type2.resize(n2_total);
+    size_t type2_index = 0;
+    for (size_t i = 0; i < msg.n; ++i)
     {
-        if (!MeasEpochChannelType1Parser(node, it, type1, msg.sb1_length,
-                                         msg.sb2_length))
+        if (!MeasEpochChannelType1Parser(node, sb, msg, i, type2_index))
             return false;
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+/**
+ * @brief Assembles the ROS message from the flat storage of a MeasEpoch block
+ * @param[in] meas The parsed block
+ * @param[out] msg The message, its header is left untouched
+ */
+inline void measEpochToMsg(const MeasEpoch& meas, MeasEpochMsg& msg)
+{
+    msg.block_header = meas.block_header;
+    msg.n = meas.n;
+    msg.sb1_length = meas.sb1_length;
+    msg.sb2_length = meas.sb2_length;
+    msg.common_flags = meas.common_flags;
+    msg.cum_clk_jumps = meas.cum_clk_jumps;
+
+    const MeasEpochChannelType1& t1 = meas.type1;
+    const MeasEpochChannelType2& t2 = meas.type2;
+    msg.type1.resize(t1.sv_id.size());
+    for (size_t i = 0; i < msg.type1.size(); ++i)
+    {
+        MeasEpochChannelType1Msg& type1 = msg.type1[i];
+        type1.rx_channel = t1.rx_channel[i];
+        type1.type = t1.type[i];
+        type1.sv_id = t1.sv_id[i];
+        type1.misc = t1.misc[i];
+        type1.code_lsb = t1.code_lsb[i];
+        type1.doppler = t1.doppler[i];
+        type1.carrier_lsb = t1.carrier_lsb[i];
+        type1.carrier_msb = t1.carrier_msb[i];
+        type1.cn0 = t1.cn0[i];
+        type1.lock_time = t1.lock_time[i];
+        type1.obs_info = t1.obs_info[i];
+        type1.n2 = t1.n2[i];
+        type1.type2.resize(t1.n2[i]);
+        for (size_t j = 0; j < type1.type2.size(); ++j)
+        {
+            size_t k = t1.type2_begin[i] + j;
+            MeasEpochChannelType2Msg& type2 = type1.type2[j];
+            type2.type = t2.type[k];
+            type2.lock_time = t2.lock_time[k];
+            type2.cn0 = t2.cn0[k];
+            type2.offsets_msb = t2.offsets_msb[k];
+            type2.carrier_msb = t2.carrier_msb[k];
+            type2.obs_info = t2.obs_info[k];
+            type2.code_offset_lsb = t2.code_offset_lsb[k];
+            type2.carrier_lsb = t2.carrier_lsb[k];
+            type2.doppler_offset_lsb = t2.doppler_offset_lsb[k];
+        }
+    }
+}
+
+//! Layout of the SBF block "GALAuthStatus"
+using GalAuthStatusLayout = sbf_layout::Layout<
+    sbf_layout::Field<&GalAuthStatusMsg::osnma_status, 14>,
+    sbf_layout::Field<&GalAuthStatusMsg::trusted_time_delta, 16>,
+    sbf_layout::Field<&GalAuthStatusMsg::gal_active_mask, 20>,
+    sbf_layout::Field<&GalAuthStatusMsg::gal_authentic_mask, 28>,
+    sbf_layout::Field<&GalAuthStatusMsg::gps_active_mask, 36>,
+    sbf_layout::Field<&GalAuthStatusMsg::gps_authentic_mask, 44>>;
+
 /**
  * GALAuthStatus
- * @brief Qi based parser for the SBF block "GALAuthStatus"
+ * @brief Parser for the SBF block "GALAuthStatus"
  */
 template <typename It>
 [[nodiscard]] bool GalAuthStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                        GalAuthStatusMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4245)
     {
@@ -634,42 +870,44 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.osnma_status);
-    qiLittleEndianParser(it, msg.trusted_time_delta);
-    qiLittleEndianParser(it, msg.gal_active_mask);
-    qiLittleEndianParser(it, msg.gal_authentic_mask);
-    qiLittleEndianParser(it, msg.gps_active_mask);
-    qiLittleEndianParser(it, msg.gps_authentic_mask);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, GalAuthStatusLayout::size))
         return false;
-    }
+    GalAuthStatusLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF sub-block "RFBand"
+using RfBandLayout =
+    sbf_layout::Layout<sbf_layout::Field<&RfBandMsg::frequency, 0>,
+                       sbf_layout::Field<&RfBandMsg::bandwidth, 4>,
+                       sbf_layout::Field<&RfBandMsg::info, 6>>;
+
 /**
  * RFBandParser
- * @brief Qi based parser for the SBF sub-block "RFBand"
+ * @brief Parser for the SBF sub-block "RFBand"
  */
 template <typename It>
 void RfBandParser(It& it, RfBandMsg& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.frequency);
-    qiLittleEndianParser(it, msg.bandwidth);
-    qiLittleEndianParser(it, msg.info);
-    std::advance(it, sb_length - 7); // skip padding
+    RfBandLayout::decode(&*it, msg);
+    std::advance(it, sb_length);
 };
 
+//! Layout of the SBF block "RFStatus" without sub-blocks
+using RfStatusLayout =
+    sbf_layout::Layout<sbf_layout::Field<&RfStatusMsg::n, 14>,
+                       sbf_layout::Field<&RfStatusMsg::sb_length, 15>,
+                       sbf_layout::Field<&RfStatusMsg::flags, 16>>;
+
 /**
  * RFStatusParser
- * @brief Qi based parser for the SBF block "RFStatus"
+ * @brief Parser for the SBF block "RFStatus"
  */
 template <typename It>
 [[nodiscard]] bool RfStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                   RfStatusMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4092)
     {
@@ -677,32 +915,44 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
-    qiLittleEndianParser(it, msg.sb_length);
-    qiLittleEndianParser(it, msg.flags);
-    std::advance(it, 3); // reserved
+    if (!validLength(node, it, itEnd, 20))
+        return false;
+    const uint8_t* data = &*it;
+    RfStatusLayout::decode(data, msg);
+    if (!validSubBlockLength(node, msg.sb_length, RfBandLayout::size) ||
+        !validLength(node, it, itEnd, 20 + msg.n * msg.sb_length))
+        return false;
+    const uint8_t* sb = data + 20;
     msg.rfband.resize(msg.n);
     for (auto& rfband : msg.rfband)
     {
-        RfBandParser(it, rfband, msg.sb_length);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
+        RfBandParser(sb, rfband, msg.sb_length);
     }
     return true;
 };
 
+//! Layout of the scalars of the SBF block "ReceiverSetup"
+using ReceiverSetupLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ReceiverSetup::delta_h, 256>,
+                       sbf_layout::Field<&ReceiverSetup::delta_e, 260>,
+                       sbf_layout::Field<&ReceiverSetup::delta_n, 264>>;
+//! Scalars of the SBF block "ReceiverSetup" added by revision 4
+using ReceiverSetupRev4Layout =
+    sbf_layout::Layout<sbf_layout::Field<&ReceiverSetup::latitude, 368>,
+                       sbf_layout::Field<&ReceiverSetup::longitude, 376>,
+                       sbf_layout::Field<&ReceiverSetup::height, 384>,
+                       sbf_layout::Field<&ReceiverSetup::monument_idx, 398>,
+                       sbf_layout::Field<&ReceiverSetup::receiver_idx, 399>>;
+
 /**
  * ReceiverSetupParser
- * @brief Qi based parser for the SBF block "ReceiverSetup"
+ * @brief Parser for the SBF block "ReceiverSetup"
  */
 template <typename It>
 [[nodiscard]] bool ReceiverSetupParser(ROSaicNodeBase* node, It it, It itEnd,
                                        ReceiverSetup& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5902)
     {
@@ -710,48 +960,59 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    std::advance(it, 2); // reserved
-    qiCharsToStringParser(it, msg.marker_name, 60);
-    qiCharsToStringParser(it, msg.marker_number, 20);
-    qiCharsToStringParser(it, msg.observer, 20);
-    qiCharsToStringParser(it, msg.agency, 40);
-    qiCharsToStringParser(it, msg.rx_serial_number, 20);
-    qiCharsToStringParser(it, msg.rx_name, 20);
-    qiCharsToStringParser(it, msg.rx_version, 20);
-    qiCharsToStringParser(it, msg.ant_serial_nbr, 20);
-    qiCharsToStringParser(it, msg.ant_type, 20);
-    qiLittleEndianParser(it, msg.delta_h);
-    qiLittleEndianParser(it, msg.delta_e);
-    qiLittleEndianParser(it, msg.delta_n);
+    std::size_t length = ReceiverSetupLayout::size;
+    if (msg.block_header.revision > 3)
+        length = 403;
+    else if (msg.block_header.revision > 2)
+        length = 368;
+    else if (msg.block_header.revision > 1)
+        length = 328;
+    else if (msg.block_header.revision > 0)
+        length = 288;
+    if (!validLength(node, it, itEnd, length))
+        return false;
+    const uint8_t* data = &*it;
+    charsToString(data + 16, msg.marker_name, 60);
+    charsToString(data + 76, msg.marker_number, 20);
+    charsToString(data + 96, msg.observer, 20);
+    charsToString(data + 116, msg.agency, 40);
+    charsToString(data + 156, msg.rx_serial_number, 20);
+    charsToString(data + 176, msg.rx_name, 20);
+    charsToString(data + 196, msg.rx_version, 20);
+    charsToString(data + 216, msg.ant_serial_nbr, 20);
+    charsToString(data + 236, msg.ant_type, 20);
+    ReceiverSetupLayout::decode(data, msg);
     if (msg.block_header.revision > 0)
-        qiCharsToStringParser(it, msg.marker_type, 20);
+        charsToString(data + 268, msg.marker_type, 20);
     if (msg.block_header.revision > 1)
-        qiCharsToStringParser(it, msg.gnss_fw_version, 40);
+        charsToString(data + 288, msg.gnss_fw_version, 40);
     if (msg.block_header.revision > 2)
-        qiCharsToStringParser(it, msg.product_name, 40);
+        charsToString(data + 328, msg.product_name, 40);
     if (msg.block_header.revision > 3)
     {
-        qiLittleEndianParser(it, msg.latitude);
-        qiLittleEndianParser(it, msg.longitude);
-        qiLittleEndianParser(it, msg.height);
-        qiCharsToStringParser(it, msg.station_code, 10);
-        qiLittleEndianParser(it, msg.monument_idx);
-        qiLittleEndianParser(it, msg.receiver_idx);
-        qiCharsToStringParser(it, msg.country_code, 3);
+        ReceiverSetupRev4Layout::decode(data, msg);
+        charsToString(data + 388, msg.station_code, 10);
+        charsToString(data + 400, msg.country_code, 3);
     } else
     {
         setDoNotUse(msg.latitude);
         setDoNotUse(msg.longitude);
         setDoNotUse(msg.height);
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+//! Layout of the SBF block "ReceiverTime"
+using ReceiverTimeLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ReceiverTimeMsg::utc_year, 14>,
+                       sbf_layout::Field<&ReceiverTimeMsg::utc_month, 15>,
+                       sbf_layout::Field<&ReceiverTimeMsg::utc_day, 16>,
+                       sbf_layout::Field<&ReceiverTimeMsg::utc_hour, 17>,
+                       sbf_layout::Field<&ReceiverTimeMsg::utc_min, 18>,
+                       sbf_layout::Field<&ReceiverTimeMsg::utc_second, 19>,
+                       sbf_layout::Field<&ReceiverTimeMsg::delta_ls, 20>,
+                       sbf_layout::Field<&ReceiverTimeMsg::sync_level, 21>>;
+
 /**
  * ReceiverTimeParser
  * @brief Struct for the SBF block "ReceiverTime"
@@ -760,7 +1021,7 @@ template <typename It>
 [[nodiscard]] bool ReceiverTimesParser(ROSaicNodeBase* node, It it, It itEnd,
                                        ReceiverTimeMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5914)
     {
@@ -768,31 +1029,54 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.utc_year);
-    qiLittleEndianParser(it, msg.utc_month);
-    qiLittleEndianParser(it, msg.utc_day);
-    qiLittleEndianParser(it, msg.utc_hour);
-    qiLittleEndianParser(it, msg.utc_min);
-    qiLittleEndianParser(it, msg.utc_second);
-    qiLittleEndianParser(it, msg.delta_ls);
-    qiLittleEndianParser(it, msg.sync_level);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, ReceiverTimeLayout::size))
         return false;
-    }
+    ReceiverTimeLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF block "PVTCartesian"
+using PVTCartesianLayout =
+    sbf_layout::Layout<sbf_layout::Field<&PVTCartesianMsg::mode, 14>,
+                       sbf_layout::Field<&PVTCartesianMsg::error, 15>,
+                       sbf_layout::Field<&PVTCartesianMsg::x, 16>,
+                       sbf_layout::Field<&PVTCartesianMsg::y, 24>,
+                       sbf_layout::Field<&PVTCartesianMsg::z, 32>,
+                       sbf_layout::Field<&PVTCartesianMsg::undulation, 40>,
+                       sbf_layout::Field<&PVTCartesianMsg::vx, 44>,
+                       sbf_layout::Field<&PVTCartesianMsg::vy, 48>,
+                       sbf_layout::Field<&PVTCartesianMsg::vz, 52>,
+                       sbf_layout::Field<&PVTCartesianMsg::cog, 56>,
+                       sbf_layout::Field<&PVTCartesianMsg::rx_clk_bias, 60>,
+                       sbf_layout::Field<&PVTCartesianMsg::rx_clk_drift, 68>,
+                       sbf_layout::Field<&PVTCartesianMsg::time_system, 72>,
+                       sbf_layout::Field<&PVTCartesianMsg::datum, 73>,
+                       sbf_layout::Field<&PVTCartesianMsg::nr_sv, 74>,
+                       sbf_layout::Field<&PVTCartesianMsg::wa_corr_info, 75>,
+                       sbf_layout::Field<&PVTCartesianMsg::reference_id, 76>,
+                       sbf_layout::Field<&PVTCartesianMsg::mean_corr_age, 78>,
+                       sbf_layout::Field<&PVTCartesianMsg::signal_info, 80>,
+                       sbf_layout::Field<&PVTCartesianMsg::alert_flag, 84>>;
+//! Fields of the SBF block "PVTCartesian" added by revision 1
+using PVTCartesianRev1Layout =
+    sbf_layout::Layout<sbf_layout::Field<&PVTCartesianMsg::nr_bases, 85>,
+                       sbf_layout::Field<&PVTCartesianMsg::ppp_info, 86>>;
+//! Fields of the SBF block "PVTCartesian" added by revision 2
+using PVTCartesianRev2Layout =
+    sbf_layout::Layout<sbf_layout::Field<&PVTCartesianMsg::latency, 88>,
+                       sbf_layout::Field<&PVTCartesianMsg::h_accuracy, 90>,
+                       sbf_layout::Field<&PVTCartesianMsg::v_accuracy, 92>,
+                       sbf_layout::Field<&PVTCartesianMsg::misc, 94>>;
+
 /**
  * PVTCartesianParser
- * @brief Qi based parser for the SBF block "PVTCartesian"
+ * @brief Parser for the SBF block "PVTCartesian"
  */
 template <typename It>
 [[nodiscard]] bool PVTCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
                                       PVTCartesianMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4006)
     {
@@ -800,55 +1084,64 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.x);
-    qiLittleEndianParser(it, msg.y);
-    qiLittleEndianParser(it, msg.z);
-    qiLittleEndianParser(it, msg.undulation);
-    qiLittleEndianParser(it, msg.vx);
-    qiLittleEndianParser(it, msg.vy);
-    qiLittleEndianParser(it, msg.vz);
-    qiLittleEndianParser(it, msg.cog);
-    qiLittleEndianParser(it, msg.rx_clk_bias);
-    qiLittleEndianParser(it, msg.rx_clk_drift);
-    qiLittleEndianParser(it, msg.time_system);
-    qiLittleEndianParser(it, msg.datum);
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.wa_corr_info);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.mean_corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
-    qiLittleEndianParser(it, msg.alert_flag);
-    if (msg.block_header.revision > 0)
-    {
-        qiLittleEndianParser(it, msg.nr_bases);
-        qiLittleEndianParser(it, msg.ppp_info);
-    }
+    std::size_t length = PVTCartesianLayout::size;
     if (msg.block_header.revision > 1)
-    {
-        qiLittleEndianParser(it, msg.latency);
-        qiLittleEndianParser(it, msg.h_accuracy);
-        qiLittleEndianParser(it, msg.v_accuracy);
-        qiLittleEndianParser(it, msg.misc);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+        length = PVTCartesianRev2Layout::size;
+    else if (msg.block_header.revision > 0)
+        length = PVTCartesianRev1Layout::size;
+    if (!validLength(node, it, itEnd, length))
         return false;
-    }
+    const uint8_t* data = &*it;
+    PVTCartesianLayout::decode(data, msg);
+    if (msg.block_header.revision > 0)
+        PVTCartesianRev1Layout::decode(data, msg);
+    if (msg.block_header.revision > 1)
+        PVTCartesianRev2Layout::decode(data, msg);
     return true;
 }
 
+//! Layout of the SBF block "PVTGeodetic"
+using PVTGeodeticLayout =
+    sbf_layout::Layout<sbf_layout::Field<&PVTGeodeticMsg::mode, 14>,
+                       sbf_layout::Field<&PVTGeodeticMsg::error, 15>,
+                       sbf_layout::Field<&PVTGeodeticMsg::latitude, 16>,
+                       sbf_layout::Field<&PVTGeodeticMsg::longitude, 24>,
+                       sbf_layout::Field<&PVTGeodeticMsg::height, 32>,
+                       sbf_layout::Field<&PVTGeodeticMsg::undulation, 40>,
+                       sbf_layout::Field<&PVTGeodeticMsg::vn, 44>,
+                       sbf_layout::Field<&PVTGeodeticMsg::ve, 48>,
+                       sbf_layout::Field<&PVTGeodeticMsg::vu, 52>,
+                       sbf_layout::Field<&PVTGeodeticMsg::cog, 56>,
+                       sbf_layout::Field<&PVTGeodeticMsg::rx_clk_bias, 60>,
+                       sbf_layout::Field<&PVTGeodeticMsg::rx_clk_drift, 68>,
+                       sbf_layout::Field<&PVTGeodeticMsg::time_system, 72>,
+                       sbf_layout::Field<&PVTGeodeticMsg::datum, 73>,
+                       sbf_layout::Field<&PVTGeodeticMsg::nr_sv, 74>,
+                       sbf_layout::Field<&PVTGeodeticMsg::wa_corr_info, 75>,
+                       sbf_layout::Field<&PVTGeodeticMsg::reference_id, 76>,
+                       sbf_layout::Field<&PVTGeodeticMsg::mean_corr_age, 78>,
+                       sbf_layout::Field<&PVTGeodeticMsg::signal_info, 80>,
+                       sbf_layout::Field<&PVTGeodeticMsg::alert_flag, 84>>;
+//! Fields of the SBF block "PVTGeodetic" added by revision 1
+using PVTGeodeticRev1Layout =
+    sbf_layout::Layout<sbf_layout::Field<&PVTGeodeticMsg::nr_bases, 85>,
+                       sbf_layout::Field<&PVTGeodeticMsg::ppp_info, 86>>;
+//! Fields of the SBF block "PVTGeodetic" added by revision 2
+using PVTGeodeticRev2Layout =
+    sbf_layout::Layout<sbf_layout::Field<&PVTGeodeticMsg::latency, 88>,
+                       sbf_layout::Field<&PVTGeodeticMsg::h_accuracy, 90>,
+                       sbf_layout::Field<&PVTGeodeticMsg::v_accuracy, 92>,
+                       sbf_layout::Field<&PVTGeodeticMsg::misc, 94>>;
+
 /**
  * PVTGeodeticParser
- * @brief Qi based parser for the SBF block "PVTGeodetic"
+ * @brief Parser for the SBF block "PVTGeodetic"
  */
 template <typename It>
 [[nodiscard]] bool PVTGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
                                      PVTGeodeticMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4007)
     {
@@ -856,55 +1149,43 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.latitude);
-    qiLittleEndianParser(it, msg.longitude);
-    qiLittleEndianParser(it, msg.height);
-    qiLittleEndianParser(it, msg.undulation);
-    qiLittleEndianParser(it, msg.vn);
-    qiLittleEndianParser(it, msg.ve);
-    qiLittleEndianParser(it, msg.vu);
-    qiLittleEndianParser(it, msg.cog);
-    qiLittleEndianParser(it, msg.rx_clk_bias);
-    qiLittleEndianParser(it, msg.rx_clk_drift);
-    qiLittleEndianParser(it, msg.time_system);
-    qiLittleEndianParser(it, msg.datum);
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.wa_corr_info);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.mean_corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
-    qiLittleEndianParser(it, msg.alert_flag);
-    if (msg.block_header.revision > 0)
-    {
-        qiLittleEndianParser(it, msg.nr_bases);
-        qiLittleEndianParser(it, msg.ppp_info);
-    }
+    std::size_t length = PVTGeodeticLayout::size;
     if (msg.block_header.revision > 1)
-    {
-        qiLittleEndianParser(it, msg.latency);
-        qiLittleEndianParser(it, msg.h_accuracy);
-        qiLittleEndianParser(it, msg.v_accuracy);
-        qiLittleEndianParser(it, msg.misc);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+        length = PVTGeodeticRev2Layout::size;
+    else if (msg.block_header.revision > 0)
+        length = PVTGeodeticRev1Layout::size;
+    if (!validLength(node, it, itEnd, length))
         return false;
-    }
+    const uint8_t* data = &*it;
+    PVTGeodeticLayout::decode(data, msg);
+    if (msg.block_header.revision > 0)
+        PVTGeodeticRev1Layout::decode(data, msg);
+    if (msg.block_header.revision > 1)
+        PVTGeodeticRev2Layout::decode(data, msg);
     return true;
 }
 
+//! Layout of the SBF block "AttEuler"
+using AttEulerLayout =
+    sbf_layout::Layout<sbf_layout::Field<&AttEulerMsg::nr_sv, 14>,
+                       sbf_layout::Field<&AttEulerMsg::error, 15>,
+                       sbf_layout::Field<&AttEulerMsg::mode, 16>,
+                       sbf_layout::Field<&AttEulerMsg::heading, 20>,
+                       sbf_layout::Field<&AttEulerMsg::pitch, 24>,
+                       sbf_layout::Field<&AttEulerMsg::roll, 28>,
+                       sbf_layout::Field<&AttEulerMsg::pitch_dot, 32>,
+                       sbf_layout::Field<&AttEulerMsg::roll_dot, 36>,
+                       sbf_layout::Field<&AttEulerMsg::heading_dot, 40>>;
+
 /**
  * AttEulerParser
- * @brief Qi based parser for the SBF block "AttEuler"
+ * @brief Parser for the SBF block "AttEuler"
  */
 template <typename It>
 [[nodiscard]] bool AttEulerParser(ROSaicNodeBase* node, It it, It itEnd,
                                   AttEulerMsg& msg, bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5938)
     {
@@ -912,16 +1193,9 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.mode);
-    std::advance(it, 2); // reserved
-    qiLittleEndianParser(it, msg.heading);
-    qiLittleEndianParser(it, msg.pitch);
-    qiLittleEndianParser(it, msg.roll);
-    qiLittleEndianParser(it, msg.pitch_dot);
-    qiLittleEndianParser(it, msg.roll_dot);
-    qiLittleEndianParser(it, msg.heading_dot);
+    if (!validLength(node, it, itEnd, AttEulerLayout::size))
+        return false;
+    AttEulerLayout::decode(&*it, msg);
     if (use_ros_axis_orientation)
     {
         msg.heading = -msg.heading + 90;
@@ -929,24 +1203,29 @@ template <typename It>
         msg.pitch_dot = -msg.pitch_dot;
         msg.heading_dot = -msg.heading_dot;
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+//! Layout of the SBF block "AttCovEuler"
+using AttCovEulerLayout =
+    sbf_layout::Layout<sbf_layout::Field<&AttCovEulerMsg::error, 15>,
+                       sbf_layout::Field<&AttCovEulerMsg::cov_headhead, 16>,
+                       sbf_layout::Field<&AttCovEulerMsg::cov_pitchpitch, 20>,
+                       sbf_layout::Field<&AttCovEulerMsg::cov_rollroll, 24>,
+                       sbf_layout::Field<&AttCovEulerMsg::cov_headpitch, 28>,
+                       sbf_layout::Field<&AttCovEulerMsg::cov_headroll, 32>,
+                       sbf_layout::Field<&AttCovEulerMsg::cov_pitchroll, 36>>;
+
 /**
  * AttCovEulerParser
- * @brief Qi based parser for the SBF block "AttCovEuler"
+ * @brief Parser for the SBF block "AttCovEuler"
  */
 template <typename It>
 [[nodiscard]] bool AttCovEulerParser(ROSaicNodeBase* node, It it, It itEnd,
                                      AttCovEulerMsg& msg,
                                      bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5939)
     {
@@ -954,61 +1233,60 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    ++it; // reserved
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_headhead);
-    qiLittleEndianParser(it, msg.cov_pitchpitch);
-    qiLittleEndianParser(it, msg.cov_rollroll);
-    qiLittleEndianParser(it, msg.cov_headpitch);
-    qiLittleEndianParser(it, msg.cov_headroll);
-    qiLittleEndianParser(it, msg.cov_pitchroll);
+    if (!validLength(node, it, itEnd, AttCovEulerLayout::size))
+        return false;
+    AttCovEulerLayout::decode(&*it, msg);
     if (use_ros_axis_orientation)
     {
         msg.cov_headroll = -msg.cov_headroll;
         msg.cov_pitchroll = -msg.cov_pitchroll;
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+//! Layout of the SBF sub-block "VectorInfoCart"
+using VectorInfoCartLayout =
+    sbf_layout::Layout<sbf_layout::Field<&VectorInfoCartMsg::nr_sv, 0>,
+                       sbf_layout::Field<&VectorInfoCartMsg::error, 1>,
+                       sbf_layout::Field<&VectorInfoCartMsg::mode, 2>,
+                       sbf_layout::Field<&VectorInfoCartMsg::misc, 3>,
+                       sbf_layout::Field<&VectorInfoCartMsg::delta_x, 4>,
+                       sbf_layout::Field<&VectorInfoCartMsg::delta_y, 12>,
+                       sbf_layout::Field<&VectorInfoCartMsg::delta_z, 20>,
+                       sbf_layout::Field<&VectorInfoCartMsg::delta_vx, 28>,
+                       sbf_layout::Field<&VectorInfoCartMsg::delta_vy, 32>,
+                       sbf_layout::Field<&VectorInfoCartMsg::delta_vz, 36>,
+                       sbf_layout::Field<&VectorInfoCartMsg::azimuth, 40>,
+                       sbf_layout::Field<&VectorInfoCartMsg::elevation, 42>,
+                       sbf_layout::Field<&VectorInfoCartMsg::reference_id, 44>,
+                       sbf_layout::Field<&VectorInfoCartMsg::corr_age, 46>,
+                       sbf_layout::Field<&VectorInfoCartMsg::signal_info, 48>>;
+
 /**
  * VectorInfoCartParser
- * @brief Qi based parser for the SBF sub-block "VectorInfoCart"
+ * @brief Parser for the SBF sub-block "VectorInfoCart"
  */
 template <typename It>
 void VectorInfoCartParser(It& it, VectorInfoCartMsg& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.misc);
-    qiLittleEndianParser(it, msg.delta_x);
-    qiLittleEndianParser(it, msg.delta_y);
-    qiLittleEndianParser(it, msg.delta_z);
-    qiLittleEndianParser(it, msg.delta_vx);
-    qiLittleEndianParser(it, msg.delta_vy);
-    qiLittleEndianParser(it, msg.delta_vz);
-    qiLittleEndianParser(it, msg.azimuth);
-    qiLittleEndianParser(it, msg.elevation);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
-    std::advance(it, sb_length - 52); // skip padding
+    VectorInfoCartLayout::decode(&*it, msg);
+    std::advance(it, sb_length);
 };
 
+//! Layout of the SBF block "BaseVectorCart" without sub-blocks
+using BaseVectorCartLayout =
+    sbf_layout::Layout<sbf_layout::Field<&BaseVectorCartMsg::n, 14>,
+                       sbf_layout::Field<&BaseVectorCartMsg::sb_length, 15>>;
+
 /**
  * BaseVectorCartParser
- * @brief Qi based parser for the SBF block "BaseVectorCart"
+ * @brief Parser for the SBF block "BaseVectorCart"
  */
 template <typename It>
 [[nodiscard]] bool BaseVectorCartParser(ROSaicNodeBase* node, It it, It itEnd,
                                         BaseVectorCartMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4043)
     {
@@ -1016,61 +1294,71 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!validLength(node, it, itEnd, 16))
+        return false;
+    const uint8_t* data = &*it;
+    BaseVectorCartLayout::decode(data, msg);
     if (msg.n > MAXSB_NBVECTORINFO)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many VectorInfoCart " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb_length);
+    if (!validSubBlockLength(node, msg.sb_length, VectorInfoCartLayout::size) ||
+        !validLength(node, it, itEnd, 16 + msg.n * msg.sb_length))
+        return false;
+    const uint8_t* sb = data + 16;
     msg.vector_info_cart.resize(msg.n);
     for (auto& vector_info_cart : msg.vector_info_cart)
     {
-        VectorInfoCartParser(it, vector_info_cart, msg.sb_length);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
+        VectorInfoCartParser(sb, vector_info_cart, msg.sb_length);
     }
     return true;
 };
 
+//! Layout of the SBF sub-block "VectorInfoGeod"
+using VectorInfoGeodLayout =
+    sbf_layout::Layout<sbf_layout::Field<&VectorInfoGeodMsg::nr_sv, 0>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::error, 1>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::mode, 2>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::misc, 3>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::delta_east, 4>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::delta_north, 12>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::delta_up, 20>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::delta_ve, 28>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::delta_vn, 32>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::delta_vu, 36>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::azimuth, 40>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::elevation, 42>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::reference_id, 44>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::corr_age, 46>,
+                       sbf_layout::Field<&VectorInfoGeodMsg::signal_info, 48>>;
+
 /**
  * VectorInfoGeodParser
- * @brief Qi based parser for the SBF sub-block "VectorInfoGeod"
+ * @brief Parser for the SBF sub-block "VectorInfoGeod"
  */
 template <typename It>
 void VectorInfoGeodParser(It& it, VectorInfoGeodMsg& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.nr_sv);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.misc);
-    qiLittleEndianParser(it, msg.delta_east);
-    qiLittleEndianParser(it, msg.delta_north);
-    qiLittleEndianParser(it, msg.delta_up);
-    qiLittleEndianParser(it, msg.delta_ve);
-    qiLittleEndianParser(it, msg.delta_vn);
-    qiLittleEndianParser(it, msg.delta_vu);
-    qiLittleEndianParser(it, msg.azimuth);
-    qiLittleEndianParser(it, msg.elevation);
-    qiLittleEndianParser(it, msg.reference_id);
-    qiLittleEndianParser(it, msg.corr_age);
-    qiLittleEndianParser(it, msg.signal_info);
-    std::advance(it, sb_length - 52); // skip padding
+    VectorInfoGeodLayout::decode(&*it, msg);
+    std::advance(it, sb_length);
 };
 
+//! Layout of the SBF block "BaseVectorGeod" without sub-blocks
+using BaseVectorGeodLayout =
+    sbf_layout::Layout<sbf_layout::Field<&BaseVectorGeodMsg::n, 14>,
+                       sbf_layout::Field<&BaseVectorGeodMsg::sb_length, 15>>;
+
 /**
  * BaseVectorGeodParser
- * @brief Qi based parser for the SBF block "BaseVectorGeod"
+ * @brief Parser for the SBF block "BaseVectorGeod"
  */
 template <typename It>
 [[nodiscard]] bool BaseVectorGeodParser(ROSaicNodeBase* node, It it, It itEnd,
                                         BaseVectorGeodMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4028)
     {
@@ -1078,37 +1366,92 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!validLength(node, it, itEnd, 16))
+        return false;
+    const uint8_t* data = &*it;
+    BaseVectorGeodLayout::decode(data, msg);
     if (msg.n > MAXSB_NBVECTORINFO)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many VectorInfoGeod " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb_length);
+    if (!validSubBlockLength(node, msg.sb_length, VectorInfoGeodLayout::size) ||
+        !validLength(node, it, itEnd, 16 + msg.n * msg.sb_length))
+        return false;
+    const uint8_t* sb = data + 16;
     msg.vector_info_geod.resize(msg.n);
     for (auto& vector_info_geod : msg.vector_info_geod)
     {
-        VectorInfoGeodParser(it, vector_info_geod, msg.sb_length);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
+        VectorInfoGeodParser(sb, vector_info_geod, msg.sb_length);
     }
     return true;
 };
 
+//! Layout of the SBF block "INSNavCart" without sub-blocks
+using INSNavCartLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::gnss_mode, 14>,
+                       sbf_layout::Field<&INSNavCartMsg::error, 15>,
+                       sbf_layout::Field<&INSNavCartMsg::info, 16>,
+                       sbf_layout::Field<&INSNavCartMsg::gnss_age, 18>,
+                       sbf_layout::Field<&INSNavCartMsg::x, 20>,
+                       sbf_layout::Field<&INSNavCartMsg::y, 28>,
+                       sbf_layout::Field<&INSNavCartMsg::z, 36>,
+                       sbf_layout::Field<&INSNavCartMsg::accuracy, 44>,
+                       sbf_layout::Field<&INSNavCartMsg::latency, 46>,
+                       sbf_layout::Field<&INSNavCartMsg::datum, 48>,
+                       sbf_layout::Field<&INSNavCartMsg::sb_list, 50>>;
+//! Layout of the position standard deviation sub-block of "INSNavCart"
+using INSNavCartPosStdDevLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::x_std_dev, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::y_std_dev, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::z_std_dev, 8>>;
+//! Layout of the attitude sub-block of "INSNavCart"
+using INSNavCartAttLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::heading, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::pitch, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::roll, 8>>;
+//! Layout of the attitude standard deviation sub-block of "INSNavCart"
+using INSNavCartAttStdDevLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::heading_std_dev, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::pitch_std_dev, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::roll_std_dev, 8>>;
+//! Layout of the velocity sub-block of "INSNavCart"
+using INSNavCartVelLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::vx, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::vy, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::vz, 8>>;
+//! Layout of the velocity standard deviation sub-block of "INSNavCart"
+using INSNavCartVelStdDevLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::vx_std_dev, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::vy_std_dev, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::vz_std_dev, 8>>;
+//! Layout of the position covariance sub-block of "INSNavCart"
+using INSNavCartPosCovLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::xy_cov, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::xz_cov, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::yz_cov, 8>>;
+//! Layout of the attitude covariance sub-block of "INSNavCart"
+using INSNavCartAttCovLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::heading_pitch_cov, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::heading_roll_cov, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::pitch_roll_cov, 8>>;
+//! Layout of the velocity covariance sub-block of "INSNavCart"
+using INSNavCartVelCovLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavCartMsg::vx_vy_cov, 0>,
+                       sbf_layout::Field<&INSNavCartMsg::vx_vz_cov, 4>,
+                       sbf_layout::Field<&INSNavCartMsg::vy_vz_cov, 8>>;
+
 /**
  * INSNavCartParser
- * @brief Qi based parser for the SBF block "INSNavCart"
+ * @brief Parser for the SBF block "INSNavCart"
  */
 template <typename It>
 [[nodiscard]] bool INSNavCartParser(ROSaicNodeBase* node, It it, It itEnd,
                                     INSNavCartMsg& msg,
                                     bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if ((msg.block_header.id != 4225) && (msg.block_header.id != 4229))
     {
@@ -1116,133 +1459,68 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.gnss_mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.info);
-    qiLittleEndianParser(it, msg.gnss_age);
-    qiLittleEndianParser(it, msg.x);
-    qiLittleEndianParser(it, msg.y);
-    qiLittleEndianParser(it, msg.z);
-    qiLittleEndianParser(it, msg.accuracy);
-    qiLittleEndianParser(it, msg.latency);
-    qiLittleEndianParser(it, msg.datum);
-    ++it; // reserved
-    qiLittleEndianParser(it, msg.sb_list);
-    if ((msg.sb_list & 1) != 0)
-    {
-        qiLittleEndianParser(it, msg.x_std_dev);
-        qiLittleEndianParser(it, msg.y_std_dev);
-        qiLittleEndianParser(it, msg.z_std_dev);
-    } else
-    {
-        setDoNotUse(msg.x_std_dev);
-        setDoNotUse(msg.y_std_dev);
-        setDoNotUse(msg.z_std_dev);
-    }
-    if ((msg.sb_list & 2) != 0)
-    {
-        qiLittleEndianParser(it, msg.heading);
-        qiLittleEndianParser(it, msg.pitch);
-        qiLittleEndianParser(it, msg.roll);
-        if (use_ros_axis_orientation)
-        {
-            msg.heading = -msg.heading + 90;
-            msg.pitch = -msg.pitch;
-        }
-    } else
-    {
-        setDoNotUse(msg.heading);
-        setDoNotUse(msg.pitch);
-        setDoNotUse(msg.roll);
-    }
-    if ((msg.sb_list & 4) != 0)
-    {
-        qiLittleEndianParser(it, msg.heading_std_dev);
-        qiLittleEndianParser(it, msg.pitch_std_dev);
-        qiLittleEndianParser(it, msg.roll_std_dev);
-    } else
-    {
-        setDoNotUse(msg.heading_std_dev);
-        setDoNotUse(msg.pitch_std_dev);
-        setDoNotUse(msg.roll_std_dev);
-    }
-    if ((msg.sb_list & 8) != 0)
-    {
-        qiLittleEndianParser(it, msg.vx);
-        qiLittleEndianParser(it, msg.vy);
-        qiLittleEndianParser(it, msg.vz);
-    } else
-    {
-        setDoNotUse(msg.vx);
-        setDoNotUse(msg.vy);
-        setDoNotUse(msg.vz);
-    }
-    if ((msg.sb_list & 16) != 0)
-    {
-        qiLittleEndianParser(it, msg.vx_std_dev);
-        qiLittleEndianParser(it, msg.vy_std_dev);
-        qiLittleEndianParser(it, msg.vz_std_dev);
-    } else
-    {
-        setDoNotUse(msg.vx_std_dev);
-        setDoNotUse(msg.vy_std_dev);
-        setDoNotUse(msg.vz_std_dev);
-    }
-    if ((msg.sb_list & 32) != 0)
-    {
-        qiLittleEndianParser(it, msg.xy_cov);
-        qiLittleEndianParser(it, msg.xz_cov);
-        qiLittleEndianParser(it, msg.yz_cov);
-    } else
-    {
-        setDoNotUse(msg.xy_cov);
-        setDoNotUse(msg.xz_cov);
-        setDoNotUse(msg.yz_cov);
-    }
-    if ((msg.sb_list & 64) != 0)
-    {
-        qiLittleEndianParser(it, msg.heading_pitch_cov);
-        qiLittleEndianParser(it, msg.heading_roll_cov);
-        qiLittleEndianParser(it, msg.pitch_roll_cov);
-        if (use_ros_axis_orientation)
-        {
-            msg.heading_roll_cov = -msg.heading_roll_cov;
-            msg.pitch_roll_cov = -msg.pitch_roll_cov;
-        }
-    } else
-    {
-        setDoNotUse(msg.heading_pitch_cov);
-        setDoNotUse(msg.heading_roll_cov);
-        setDoNotUse(msg.pitch_roll_cov);
-    }
-    if ((msg.sb_list & 128) != 0)
-    {
-        qiLittleEndianParser(it, msg.vx_vy_cov);
-        qiLittleEndianParser(it, msg.vx_vz_cov);
-        qiLittleEndianParser(it, msg.vy_vz_cov);
-    } else
-    {
-        setDoNotUse(msg.vx_vy_cov);
-        setDoNotUse(msg.vx_vz_cov);
-        setDoNotUse(msg.vy_vz_cov);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, 52))
+        return false;
+    const uint8_t* data = &*it;
+    INSNavCartLayout::decode(data, msg);
+    // Each sub-block present holds three floats
+    if (!validLength(node, it, itEnd,
+                     52 + 12 * std::bitset<8>(msg.sb_list).count()))
         return false;
+    const uint8_t* sb = data + 52;
+    sbf_layout::decodeOptional<INSNavCartPosStdDevLayout>(
+        (msg.sb_list & 1) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavCartAttLayout>(
+        (msg.sb_list & 2) != 0, sb, msg);
+    if (((msg.sb_list & 2) != 0) && use_ros_axis_orientation)
+    {
+        msg.heading = -msg.heading + 90;
+        msg.pitch = -msg.pitch;
     }
+    sbf_layout::decodeOptional<INSNavCartAttStdDevLayout>(
+        (msg.sb_list & 4) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavCartVelLayout>(
+        (msg.sb_list & 8) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavCartVelStdDevLayout>(
+        (msg.sb_list & 16) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavCartPosCovLayout>(
+        (msg.sb_list & 32) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavCartAttCovLayout>(
+        (msg.sb_list & 64) != 0, sb, msg);
+    if (((msg.sb_list & 64) != 0) && use_ros_axis_orientation)
+    {
+        msg.heading_roll_cov = -msg.heading_roll_cov;
+        msg.pitch_roll_cov = -msg.pitch_roll_cov;
+    }
+    sbf_layout::decodeOptional<INSNavCartVelCovLayout>(
+        (msg.sb_list & 128) != 0, sb, msg);
     return true;
 };
 
+//! Layout of the SBF block "PosCovCartesian"
+using PosCovCartesianLayout =
+    sbf_layout::Layout<sbf_layout::Field<&PosCovCartesianMsg::mode, 14>,
+                       sbf_layout::Field<&PosCovCartesianMsg::error, 15>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_xx, 16>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_yy, 20>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_zz, 24>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_bb, 28>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_xy, 32>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_xz, 36>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_xb, 40>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_yz, 44>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_yb, 48>,
+                       sbf_layout::Field<&PosCovCartesianMsg::cov_zb, 52>>;
+
 /**
  * PosCovCartesianParser
- * @brief Qi based parser for the SBF block "PosCovCartesian"
+ * @brief Parser for the SBF block "PosCovCartesian"
  */
 template <typename It>
 [[nodiscard]] bool PosCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
                                          PosCovCartesianMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5905)
     {
@@ -1250,35 +1528,36 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_xx);
-    qiLittleEndianParser(it, msg.cov_yy);
-    qiLittleEndianParser(it, msg.cov_zz);
-    qiLittleEndianParser(it, msg.cov_bb);
-    qiLittleEndianParser(it, msg.cov_xy);
-    qiLittleEndianParser(it, msg.cov_xz);
-    qiLittleEndianParser(it, msg.cov_xb);
-    qiLittleEndianParser(it, msg.cov_yz);
-    qiLittleEndianParser(it, msg.cov_yb);
-    qiLittleEndianParser(it, msg.cov_zb);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, PosCovCartesianLayout::size))
         return false;
-    }
+    PosCovCartesianLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF block "PosCovGeodetic"
+using PosCovGeodeticLayout =
+    sbf_layout::Layout<sbf_layout::Field<&PosCovGeodeticMsg::mode, 14>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::error, 15>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_latlat, 16>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_lonlon, 20>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_hgthgt, 24>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_bb, 28>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_latlon, 32>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_lathgt, 36>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_latb, 40>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_lonhgt, 44>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_lonb, 48>,
+                       sbf_layout::Field<&PosCovGeodeticMsg::cov_hb, 52>>;
+
 /**
  * PosCovGeodeticParser
- * @brief Qi based parser for the SBF block "PosCovGeodetic"
+ * @brief Parser for the SBF block "PosCovGeodetic"
  */
 template <typename It>
 [[nodiscard]] bool PosCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
                                         PosCovGeodeticMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5906)
     {
@@ -1286,35 +1565,36 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_latlat);
-    qiLittleEndianParser(it, msg.cov_lonlon);
-    qiLittleEndianParser(it, msg.cov_hgthgt);
-    qiLittleEndianParser(it, msg.cov_bb);
-    qiLittleEndianParser(it, msg.cov_latlon);
-    qiLittleEndianParser(it, msg.cov_lathgt);
-    qiLittleEndianParser(it, msg.cov_latb);
-    qiLittleEndianParser(it, msg.cov_lonhgt);
-    qiLittleEndianParser(it, msg.cov_lonb);
-    qiLittleEndianParser(it, msg.cov_hb);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, PosCovGeodeticLayout::size))
         return false;
-    }
+    PosCovGeodeticLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF block "VelCovCartesian"
+using VelCovCartesianLayout =
+    sbf_layout::Layout<sbf_layout::Field<&VelCovCartesianMsg::mode, 14>,
+                       sbf_layout::Field<&VelCovCartesianMsg::error, 15>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vxvx, 16>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vyvy, 20>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vzvz, 24>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_dtdt, 28>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vxvy, 32>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vxvz, 36>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vxdt, 40>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vyvz, 44>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vydt, 48>,
+                       sbf_layout::Field<&VelCovCartesianMsg::cov_vzdt, 52>>;
+
 /**
  * VelCovCartesianParser
- * @brief Qi based parser for the SBF block "VelCovCartesian"
+ * @brief Parser for the SBF block "VelCovCartesian"
  */
 template <typename It>
 [[nodiscard]] bool VelCovCartesianParser(ROSaicNodeBase* node, It it, It itEnd,
                                          VelCovCartesianMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5907)
     {
@@ -1322,35 +1602,36 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_vxvx);
-    qiLittleEndianParser(it, msg.cov_vyvy);
-    qiLittleEndianParser(it, msg.cov_vzvz);
-    qiLittleEndianParser(it, msg.cov_dtdt);
-    qiLittleEndianParser(it, msg.cov_vxvy);
-    qiLittleEndianParser(it, msg.cov_vxvz);
-    qiLittleEndianParser(it, msg.cov_vxdt);
-    qiLittleEndianParser(it, msg.cov_vyvz);
-    qiLittleEndianParser(it, msg.cov_vydt);
-    qiLittleEndianParser(it, msg.cov_vzdt);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, VelCovCartesianLayout::size))
         return false;
-    }
+    VelCovCartesianLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF block "VelCovGeodetic"
+using VelCovGeodeticLayout =
+    sbf_layout::Layout<sbf_layout::Field<&VelCovGeodeticMsg::mode, 14>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::error, 15>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vnvn, 16>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_veve, 20>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vuvu, 24>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_dtdt, 28>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vnve, 32>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vnvu, 36>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vndt, 40>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vevu, 44>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vedt, 48>,
+                       sbf_layout::Field<&VelCovGeodeticMsg::cov_vudt, 52>>;
+
 /**
  * VelCovGeodeticParser
- * @brief Qi based parser for the SBF block "VelCovGeodetic"
+ * @brief Parser for the SBF block "VelCovGeodetic"
  */
 template <typename It>
 [[nodiscard]] bool VelCovGeodeticParser(ROSaicNodeBase* node, It it, It itEnd,
                                         VelCovGeodeticMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5908)
     {
@@ -1358,35 +1639,22 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.cov_vnvn);
-    qiLittleEndianParser(it, msg.cov_veve);
-    qiLittleEndianParser(it, msg.cov_vuvu);
-    qiLittleEndianParser(it, msg.cov_dtdt);
-    qiLittleEndianParser(it, msg.cov_vnve);
-    qiLittleEndianParser(it, msg.cov_vnvu);
-    qiLittleEndianParser(it, msg.cov_vndt);
-    qiLittleEndianParser(it, msg.cov_vevu);
-    qiLittleEndianParser(it, msg.cov_vedt);
-    qiLittleEndianParser(it, msg.cov_vudt);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, VelCovGeodeticLayout::size))
         return false;
-    }
+    VelCovGeodeticLayout::decode(&*it, msg);
     return true;
 };
 
+
 /**
  * QualityIndParser
- * @brief @brief Qi based parser for the SBF block "QualityInd"
+ * @brief Parser for the SBF block "QualityInd"
  */
 template <typename It>
 [[nodiscard]] bool QualityIndParser(ROSaicNodeBase* node, It it, It itEnd,
                                     QualityInd& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4082)
     {
@@ -1394,42 +1662,56 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
+    if (!validLength(node, it, itEnd, 16))
+        return false;
+    const uint8_t* data = &*it;
+    msg.n = sbf_layout::load<uint8_t>(data + 14);
     if (msg.n > 40)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many indicators " + std::to_string(msg.n));
         return false;
     }
-    ++it; // reserved
+    if (!validLength(node, it, itEnd, 16 + 2 * msg.n))
+        return false;
     msg.indicators.resize(msg.n);
-    std::vector<uint16_t> indicators;
-    for (auto& indicators : msg.indicators)
+    for (std::size_t i = 0; i < msg.n; ++i)
     {
-        qiLittleEndianParser(it, indicators);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
+        msg.indicators[i] = sbf_layout::load<uint16_t>(data + 16 + 2 * i);
     }
     return true;
 };
 
+//! Layout of the SBF sub-block "AGCState"
+using AgcStateLayout =
+    sbf_layout::Layout<sbf_layout::Field<&AgcState::frontend_id, 0>,
+                       sbf_layout::Field<&AgcState::gain, 1>,
+                       sbf_layout::Field<&AgcState::sample_var, 2>,
+                       sbf_layout::Field<&AgcState::blanking_stat, 3>>;
+
 /**
  * AgcStateParser
  * @brief Struct for the SBF sub-block "AGCState"
  */
 template <typename It>
-void AgcStateParser(It it, AgcState& msg, uint8_t sb_length)
+void AgcStateParser(It& it, AgcState& msg, uint8_t sb_length)
 {
-    qiLittleEndianParser(it, msg.frontend_id);
-    qiLittleEndianParser(it, msg.gain);
-    qiLittleEndianParser(it, msg.sample_var);
-    qiLittleEndianParser(it, msg.blanking_stat);
-    std::advance(it, sb_length - 4); // skip padding
+    AgcStateLayout::decode(&*it, msg);
+    std::advance(it, sb_length);
 };
 
+//! Layout of the SBF block "ReceiverStatus" without sub-blocks
+using ReceiverStatusLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ReceiverStatus::cpu_load, 14>,
+                       sbf_layout::Field<&ReceiverStatus::ext_error, 15>,
+                       sbf_layout::Field<&ReceiverStatus::up_time, 16>,
+                       sbf_layout::Field<&ReceiverStatus::rx_status, 20>,
+                       sbf_layout::Field<&ReceiverStatus::rx_error, 24>,
+                       sbf_layout::Field<&ReceiverStatus::n, 28>,
+                       sbf_layout::Field<&ReceiverStatus::sb_length, 29>,
+                       sbf_layout::Field<&ReceiverStatus::cmd_count, 30>,
+                       sbf_layout::Field<&ReceiverStatus::temperature, 31>>;
+
 /**
  * ReceiverStatusParser
  * @brief Struct for the SBF block "ReceiverStatus"
@@ -1438,7 +1720,7 @@ template <typename It>
 [[nodiscard]] bool ReceiverStatusParser(ROSaicNodeBase* node, It it, It itEnd,
                                         ReceiverStatus& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4014)
     {
@@ -1446,34 +1728,29 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.cpu_load);
-    qiLittleEndianParser(it, msg.ext_error);
-    qiLittleEndianParser(it, msg.up_time);
-    qiLittleEndianParser(it, msg.rx_status);
-    qiLittleEndianParser(it, msg.rx_error);
-    qiLittleEndianParser(it, msg.n);
+    if (!validLength(node, it, itEnd, ReceiverStatusLayout::size))
+        return false;
+    const uint8_t* data = &*it;
+    ReceiverStatusLayout::decode(data, msg);
     if (msg.n > 18)
     {
         node->log(log_level::ERROR,
                   "Parse error: Too many AGCState " + std::to_string(msg.n));
         return false;
     }
-    qiLittleEndianParser(it, msg.sb_length);
-    qiLittleEndianParser(it, msg.cmd_count);
-    qiLittleEndianParser(it, msg.temperature);
+    if (!validSubBlockLength(node, msg.sb_length, AgcStateLayout::size) ||
+        !validLength(node, it, itEnd, 32 + msg.n * msg.sb_length))
+        return false;
+    const uint8_t* sb = data + 32;
     msg.agc_state.resize(msg.n);
     for (auto& agc_state : msg.agc_state)
     {
-        AgcStateParser(it, agc_state, msg.sb_length);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
+        AgcStateParser(sb, agc_state, msg.sb_length);
     }
     return true;
 };
 
+
 /**
  * ReceiverTimeParser
  * @brief Struct for the SBF block "ReceiverTime"
@@ -1482,7 +1759,7 @@ template <typename It>
 [[nodiscard]] bool ReceiverTimeParser(ROSaicNodeBase* node, It it, It itEnd,
                                       ReceiverTimeMsg& msg)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 5914)
     {
@@ -1490,32 +1767,77 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.utc_year);
-    qiLittleEndianParser(it, msg.utc_month);
-    qiLittleEndianParser(it, msg.utc_day);
-    qiLittleEndianParser(it, msg.utc_hour);
-    qiLittleEndianParser(it, msg.utc_min);
-    qiLittleEndianParser(it, msg.utc_second);
-    qiLittleEndianParser(it, msg.delta_ls);
-    qiLittleEndianParser(it, msg.sync_level);
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, ReceiverTimeLayout::size))
         return false;
-    }
+    ReceiverTimeLayout::decode(&*it, msg);
     return true;
 };
 
+//! Layout of the SBF block "INSNavGeod" without sub-blocks
+using INSNavGeodLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::gnss_mode, 14>,
+                       sbf_layout::Field<&INSNavGeodMsg::error, 15>,
+                       sbf_layout::Field<&INSNavGeodMsg::info, 16>,
+                       sbf_layout::Field<&INSNavGeodMsg::gnss_age, 18>,
+                       sbf_layout::Field<&INSNavGeodMsg::latitude, 20>,
+                       sbf_layout::Field<&INSNavGeodMsg::longitude, 28>,
+                       sbf_layout::Field<&INSNavGeodMsg::height, 36>,
+                       sbf_layout::Field<&INSNavGeodMsg::undulation, 44>,
+                       sbf_layout::Field<&INSNavGeodMsg::accuracy, 48>,
+                       sbf_layout::Field<&INSNavGeodMsg::latency, 50>,
+                       sbf_layout::Field<&INSNavGeodMsg::datum, 52>,
+                       sbf_layout::Field<&INSNavGeodMsg::sb_list, 54>>;
+//! Layout of the position standard deviation sub-block of "INSNavGeod"
+using INSNavGeodPosStdDevLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::latitude_std_dev, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::longitude_std_dev, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::height_std_dev, 8>>;
+//! Layout of the attitude sub-block of "INSNavGeod"
+using INSNavGeodAttLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::heading, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::pitch, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::roll, 8>>;
+//! Layout of the attitude standard deviation sub-block of "INSNavGeod"
+using INSNavGeodAttStdDevLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::heading_std_dev, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::pitch_std_dev, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::roll_std_dev, 8>>;
+//! Layout of the velocity sub-block of "INSNavGeod"
+using INSNavGeodVelLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::ve, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::vn, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::vu, 8>>;
+//! Layout of the velocity standard deviation sub-block of "INSNavGeod"
+using INSNavGeodVelStdDevLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::ve_std_dev, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::vn_std_dev, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::vu_std_dev, 8>>;
+//! Layout of the position covariance sub-block of "INSNavGeod"
+using INSNavGeodPosCovLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::latitude_longitude_cov, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::latitude_height_cov, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::longitude_height_cov, 8>>;
+//! Layout of the attitude covariance sub-block of "INSNavGeod"
+using INSNavGeodAttCovLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::heading_pitch_cov, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::heading_roll_cov, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::pitch_roll_cov, 8>>;
+//! Layout of the velocity covariance sub-block of "INSNavGeod"
+using INSNavGeodVelCovLayout =
+    sbf_layout::Layout<sbf_layout::Field<&INSNavGeodMsg::ve_vn_cov, 0>,
+                       sbf_layout::Field<&INSNavGeodMsg::ve_vu_cov, 4>,
+                       sbf_layout::Field<&INSNavGeodMsg::vn_vu_cov, 8>>;
+
 /**
  * INSNavGeodParser
- * @brief Qi based parser for the SBF block "INSNavGeod"
+ * @brief Parser for the SBF block "INSNavGeod"
  */
 template <typename It>
 [[nodiscard]] bool INSNavGeodParser(ROSaicNodeBase* node, It it, It itEnd,
                                     INSNavGeodMsg& msg,
                                     bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if ((msg.block_header.id != 4226) && (msg.block_header.id != 4230))
     {
@@ -1523,134 +1845,63 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.gnss_mode);
-    qiLittleEndianParser(it, msg.error);
-    qiLittleEndianParser(it, msg.info);
-    qiLittleEndianParser(it, msg.gnss_age);
-    qiLittleEndianParser(it, msg.latitude);
-    qiLittleEndianParser(it, msg.longitude);
-    qiLittleEndianParser(it, msg.height);
-    qiLittleEndianParser(it, msg.undulation);
-    qiLittleEndianParser(it, msg.accuracy);
-    qiLittleEndianParser(it, msg.latency);
-    qiLittleEndianParser(it, msg.datum);
-    ++it; // reserved
-    qiLittleEndianParser(it, msg.sb_list);
-    if ((msg.sb_list & 1) != 0)
-    {
-        qiLittleEndianParser(it, msg.latitude_std_dev);
-        qiLittleEndianParser(it, msg.longitude_std_dev);
-        qiLittleEndianParser(it, msg.height_std_dev);
-    } else
-    {
-        setDoNotUse(msg.latitude_std_dev);
-        setDoNotUse(msg.longitude_std_dev);
-        setDoNotUse(msg.height_std_dev);
-    }
-    if ((msg.sb_list & 2) != 0)
-    {
-        qiLittleEndianParser(it, msg.heading);
-        qiLittleEndianParser(it, msg.pitch);
-        qiLittleEndianParser(it, msg.roll);
-        if (use_ros_axis_orientation)
-        {
-            msg.heading = -msg.heading + 90;
-            msg.pitch = -msg.pitch;
-        }
-    } else
-    {
-        setDoNotUse(msg.heading);
-        setDoNotUse(msg.pitch);
-        setDoNotUse(msg.roll);
-    }
-    if ((msg.sb_list & 4) != 0)
-    {
-        qiLittleEndianParser(it, msg.heading_std_dev);
-        qiLittleEndianParser(it, msg.pitch_std_dev);
-        qiLittleEndianParser(it, msg.roll_std_dev);
-    } else
-    {
-        setDoNotUse(msg.heading_std_dev);
-        setDoNotUse(msg.pitch_std_dev);
-        setDoNotUse(msg.roll_std_dev);
-    }
-    if ((msg.sb_list & 8) != 0)
-    {
-        qiLittleEndianParser(it, msg.ve);
-        qiLittleEndianParser(it, msg.vn);
-        qiLittleEndianParser(it, msg.vu);
-    } else
-    {
-        setDoNotUse(msg.ve);
-        setDoNotUse(msg.vn);
-        setDoNotUse(msg.vu);
-    }
-    if ((msg.sb_list & 16) != 0)
-    {
-        qiLittleEndianParser(it, msg.ve_std_dev);
-        qiLittleEndianParser(it, msg.vn_std_dev);
-        qiLittleEndianParser(it, msg.vu_std_dev);
-    } else
-    {
-        setDoNotUse(msg.ve_std_dev);
-        setDoNotUse(msg.vn_std_dev);
-        setDoNotUse(msg.vu_std_dev);
-    }
-    if ((msg.sb_list & 32) != 0)
-    {
-        qiLittleEndianParser(it, msg.latitude_longitude_cov);
-        qiLittleEndianParser(it, msg.latitude_height_cov);
-        qiLittleEndianParser(it, msg.longitude_height_cov);
-    } else
-    {
-        setDoNotUse(msg.latitude_longitude_cov);
-        setDoNotUse(msg.latitude_height_cov);
-        setDoNotUse(msg.longitude_height_cov);
-    }
-    if ((msg.sb_list & 64) != 0)
-    {
-        qiLittleEndianParser(it, msg.heading_pitch_cov);
-        qiLittleEndianParser(it, msg.heading_roll_cov);
-        qiLittleEndianParser(it, msg.pitch_roll_cov);
-        if (use_ros_axis_orientation)
-        {
-            msg.heading_roll_cov = -msg.heading_roll_cov;
-            msg.pitch_roll_cov = -msg.pitch_roll_cov;
-        }
-    } else
-    {
-        setDoNotUse(msg.heading_pitch_cov);
-        setDoNotUse(msg.heading_roll_cov);
-        setDoNotUse(msg.pitch_roll_cov);
-    }
-    if ((msg.sb_list & 128) != 0)
-    {
-        qiLittleEndianParser(it, msg.ve_vn_cov);
-        qiLittleEndianParser(it, msg.ve_vu_cov);
-        qiLittleEndianParser(it, msg.vn_vu_cov);
-    } else
-    {
-        setDoNotUse(msg.ve_vn_cov);
-        setDoNotUse(msg.ve_vu_cov);
-        setDoNotUse(msg.vn_vu_cov);
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
+    if (!validLength(node, it, itEnd, 56))
+        return false;
+    const uint8_t* data = &*it;
+    INSNavGeodLayout::decode(data, msg);
+    // Each sub-block present holds three floats
+    if (!validLength(node, it, itEnd,
+                     56 + 12 * std::bitset<8>(msg.sb_list).count()))
         return false;
+    const uint8_t* sb = data + 56;
+    sbf_layout::decodeOptional<INSNavGeodPosStdDevLayout>(
+        (msg.sb_list & 1) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavGeodAttLayout>(
+        (msg.sb_list & 2) != 0, sb, msg);
+    if (((msg.sb_list & 2) != 0) && use_ros_axis_orientation)
+    {
+        msg.heading = -msg.heading + 90;
+        msg.pitch = -msg.pitch;
     }
+    sbf_layout::decodeOptional<INSNavGeodAttStdDevLayout>(
+        (msg.sb_list & 4) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavGeodVelLayout>(
+        (msg.sb_list & 8) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavGeodVelStdDevLayout>(
+        (msg.sb_list & 16) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavGeodPosCovLayout>(
+        (msg.sb_list & 32) != 0, sb, msg);
+    sbf_layout::decodeOptional<INSNavGeodAttCovLayout>(
+        (msg.sb_list & 64) != 0, sb, msg);
+    if (((msg.sb_list & 64) != 0) && use_ros_axis_orientation)
+    {
+        msg.heading_roll_cov = -msg.heading_roll_cov;
+        msg.pitch_roll_cov = -msg.pitch_roll_cov;
+    }
+    sbf_layout::decodeOptional<INSNavGeodVelCovLayout>(
+        (msg.sb_list & 128) != 0, sb, msg);
     return true;
 };
 
+//! Layout of the SBF block "IMUSetup"
+using IMUSetupLayout =
+    sbf_layout::Layout<sbf_layout::Field<&IMUSetupMsg::serial_port, 15>,
+                       sbf_layout::Field<&IMUSetupMsg::ant_lever_arm_x, 16>,
+                       sbf_layout::Field<&IMUSetupMsg::ant_lever_arm_y, 20>,
+                       sbf_layout::Field<&IMUSetupMsg::ant_lever_arm_z, 24>,
+                       sbf_layout::Field<&IMUSetupMsg::theta_x, 28>,
+                       sbf_layout::Field<&IMUSetupMsg::theta_y, 32>,
+                       sbf_layout::Field<&IMUSetupMsg::theta_z, 36>>;
+
 /**
  * IMUSetupParser
- * @brief Qi based parser for the SBF block "IMUSetup"
+ * @brief Parser for the SBF block "IMUSetup"
  */
 template <typename It>
 [[nodiscard]] bool IMUSetupParser(ROSaicNodeBase* node, It it, It itEnd,
                                   IMUSetupMsg& msg, bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4224)
     {
@@ -1658,38 +1909,35 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    ++it; // reserved
-    qiLittleEndianParser(it, msg.serial_port);
-    qiLittleEndianParser(it, msg.ant_lever_arm_x);
-    qiLittleEndianParser(it, msg.ant_lever_arm_y);
-    qiLittleEndianParser(it, msg.ant_lever_arm_z);
-    qiLittleEndianParser(it, msg.theta_x);
-    qiLittleEndianParser(it, msg.theta_y);
-    qiLittleEndianParser(it, msg.theta_z);
+    if (!validLength(node, it, itEnd, IMUSetupLayout::size))
+        return false;
+    IMUSetupLayout::decode(&*it, msg);
     if (use_ros_axis_orientation)
     {
         msg.ant_lever_arm_y = -msg.ant_lever_arm_y;
         msg.ant_lever_arm_z = -msg.ant_lever_arm_z;
         msg.theta_x = parsing_utilities::wrapAngle180to180(msg.theta_x - 180.0f);
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+//! Layout of the SBF block "VelSensorSetup"
+using VelSensorSetupLayout =
+    sbf_layout::Layout<sbf_layout::Field<&VelSensorSetupMsg::port, 15>,
+                       sbf_layout::Field<&VelSensorSetupMsg::lever_arm_x, 16>,
+                       sbf_layout::Field<&VelSensorSetupMsg::lever_arm_y, 20>,
+                       sbf_layout::Field<&VelSensorSetupMsg::lever_arm_z, 24>>;
+
 /**
  * VelSensorSetupParser
- * @brief Qi based parser for the SBF block "VelSensorSetup"
+ * @brief Parser for the SBF block "VelSensorSetup"
  */
 template <typename It>
 [[nodiscard]] bool VelSensorSetupParser(ROSaicNodeBase* node, It it, It itEnd,
                                         VelSensorSetupMsg& msg,
                                         bool use_ros_axis_orientation)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4244)
     {
@@ -1697,34 +1945,53 @@ template <typename It>
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    ++it; // reserved
-    qiLittleEndianParser(it, msg.port);
-    qiLittleEndianParser(it, msg.lever_arm_x);
-    qiLittleEndianParser(it, msg.lever_arm_y);
-    qiLittleEndianParser(it, msg.lever_arm_z);
+    if (!validLength(node, it, itEnd, VelSensorSetupLayout::size))
+        return false;
+    VelSensorSetupLayout::decode(&*it, msg);
     if (use_ros_axis_orientation)
     {
         msg.lever_arm_y = -msg.lever_arm_y;
         msg.lever_arm_z = -msg.lever_arm_z;
     }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
-    }
     return true;
 };
 
+//! Layout of the acceleration in the SBF sub-block "ExtSensorMeasSet"
+using ExtSensorMeasAccelerationLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ExtSensorMeasMsg::acceleration_x, 4>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::acceleration_y, 12>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::acceleration_z, 20>>;
+//! Layout of the angular rate in the SBF sub-block "ExtSensorMeasSet"
+using ExtSensorMeasAngularRateLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ExtSensorMeasMsg::angular_rate_x, 4>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::angular_rate_y, 12>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::angular_rate_z, 20>>;
+//! Layout of the sensor info in the SBF sub-block "ExtSensorMeasSet"
+using ExtSensorMeasInfoLayout = sbf_layout::Layout<
+    sbf_layout::Field<&ExtSensorMeasMsg::sensor_temperature, 4, int16_t, 100,
+                      static_cast<int16_t>(-32768)>>;
+//! Layout of the velocity in the SBF sub-block "ExtSensorMeasSet"
+using ExtSensorMeasVelocityLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ExtSensorMeasMsg::velocity_x, 4>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::velocity_y, 8>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::velocity_z, 12>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::std_dev_x, 16>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::std_dev_y, 20>,
+                       sbf_layout::Field<&ExtSensorMeasMsg::std_dev_z, 24>>;
+//! Layout of the zero velocity flag in the SBF sub-block "ExtSensorMeasSet"
+using ExtSensorMeasZeroVelocityLayout =
+    sbf_layout::Layout<sbf_layout::Field<&ExtSensorMeasMsg::zero_velocity_flag, 4>>;
+
 /**
  * ExtSensorMeasParser
- * @brief Qi based parser for the SBF block "ExtSensorMeas"
+ * @brief Parser for the SBF block "ExtSensorMeas"
  */
 template <typename It>
 [[nodiscard]] bool
 ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg,
                     bool use_ros_axis_orientation, bool& hasImuMeas)
 {
-    if (!BlockHeaderParser(node, it, msg.block_header))
+    if (!BlockHeaderParser(node, it, itEnd, msg.block_header))
         return false;
     if (msg.block_header.id != 4050)
     {
@@ -1732,33 +1999,25 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
                                         std::to_string(msg.block_header.id));
         return false;
     }
-    qiLittleEndianParser(it, msg.n);
-    qiLittleEndianParser(it, msg.sb_length);
+    if (!validLength(node, it, itEnd, 16))
+        return false;
+    const uint8_t* data = &*it;
+    msg.n = sbf_layout::load<uint8_t>(data + 14);
+    msg.sb_length = sbf_layout::load<uint8_t>(data + 15);
     if (msg.sb_length != 28)
     {
         node->log(log_level::ERROR,
                   "Parse error: Wrong sb_length " + std::to_string(msg.sb_length));
         return false;
     }
+    if (!validLength(node, it, itEnd, 16 + msg.n * msg.sb_length))
+        return false;
 
-    msg.acceleration_x = std::numeric_limits<double>::quiet_NaN();
-    msg.acceleration_y = std::numeric_limits<double>::quiet_NaN();
-    msg.acceleration_z = std::numeric_limits<double>::quiet_NaN();
-
-    msg.angular_rate_x = std::numeric_limits<double>::quiet_NaN();
-    msg.angular_rate_y = std::numeric_limits<double>::quiet_NaN();
-    msg.angular_rate_z = std::numeric_limits<double>::quiet_NaN();
-
-    msg.velocity_x = std::numeric_limits<double>::quiet_NaN();
-    msg.velocity_y = std::numeric_limits<double>::quiet_NaN();
-    msg.velocity_z = std::numeric_limits<double>::quiet_NaN();
-
-    msg.std_dev_x = std::numeric_limits<double>::quiet_NaN();
-    msg.std_dev_y = std::numeric_limits<double>::quiet_NaN();
-    msg.std_dev_z = std::numeric_limits<double>::quiet_NaN();
-
-    msg.sensor_temperature = std::numeric_limits<float>::quiet_NaN();
-    msg.zero_velocity_flag = std::numeric_limits<double>::quiet_NaN();
+    ExtSensorMeasAccelerationLayout::setDoNotUse(msg);
+    ExtSensorMeasAngularRateLayout::setDoNotUse(msg);
+    ExtSensorMeasVelocityLayout::setDoNotUse(msg);
+    ExtSensorMeasInfoLayout::setDoNotUse(msg);
+    ExtSensorMeasZeroVelocityLayout::setDoNotUse(msg);
 
     msg.source.resize(msg.n);
     msg.sensor_model.resize(msg.n);
@@ -1767,50 +2026,36 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
     bool hasAcc = false;
     bool hasOmega = false;
     hasImuMeas = false;
+    const uint8_t* sb = data + 16;
     for (size_t i = 0; i < msg.n; i++)
     {
-        qiLittleEndianParser(it, msg.source[i]);
-        qiLittleEndianParser(it, msg.sensor_model[i]);
-        qiLittleEndianParser(it, msg.type[i]);
-        qiLittleEndianParser(it, msg.obs_info[i]);
+        msg.source[i] = sbf_layout::load<uint8_t>(sb);
+        msg.sensor_model[i] = sbf_layout::load<uint8_t>(sb + 1);
+        msg.type[i] = sbf_layout::load<uint8_t>(sb + 2);
+        msg.obs_info[i] = sbf_layout::load<uint8_t>(sb + 3);
 
         switch (msg.type[i])
         {
         case 0:
         {
-            qiLittleEndianParser(it, msg.acceleration_x);
-            qiLittleEndianParser(it, msg.acceleration_y);
-            qiLittleEndianParser(it, msg.acceleration_z);
+            ExtSensorMeasAccelerationLayout::decode(sb, msg);
             hasAcc = true;
             break;
         }
         case 1:
         {
-            qiLittleEndianParser(it, msg.angular_rate_x);
-            qiLittleEndianParser(it, msg.angular_rate_y);
-            qiLittleEndianParser(it, msg.angular_rate_z);
+            ExtSensorMeasAngularRateLayout::decode(sb, msg);
             hasOmega = true;
             break;
         }
         case 3:
         {
-            int16_t temp;
-            qiLittleEndianParser(it, temp);
-            if (temp != -32768)
-                msg.sensor_temperature = temp / 100.0f;
-            else
-                msg.sensor_temperature = std::numeric_limits<float>::quiet_NaN();
-            std::advance(it, 22); // reserved
+            ExtSensorMeasInfoLayout::decode(sb, msg);
             break;
         }
         case 4:
         {
-            qiLittleEndianParser(it, msg.velocity_x);
-            qiLittleEndianParser(it, msg.velocity_y);
-            qiLittleEndianParser(it, msg.velocity_z);
-            qiLittleEndianParser(it, msg.std_dev_x);
-            qiLittleEndianParser(it, msg.std_dev_y);
-            qiLittleEndianParser(it, msg.std_dev_z);
+            ExtSensorMeasVelocityLayout::decode(sb, msg);
             if (use_ros_axis_orientation)
             {
                 msg.velocity_y = -msg.velocity_y;
@@ -1820,8 +2065,7 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
         }
         case 20:
         {
-            qiLittleEndianParser(it, msg.zero_velocity_flag);
-            std::advance(it, 16); // reserved
+            ExtSensorMeasZeroVelocityLayout::decode(sb, msg);
             break;
         }
         default:
@@ -1830,16 +2074,11 @@ ExtSensorMeasParser(ROSaicNodeBase* node, It it, It itEnd, ExtSensorMeasMsg& msg
                 log_level::DEBUG,
                 "Unknown external sensor measurement type in SBF ExtSensorMeas: " +
                     std::to_string(msg.type[i]));
-            std::advance(it, 24);
             break;
         }
         }
-    }
-    if (it > itEnd)
-    {
-        node->log(log_level::ERROR, "Parse error: iterator past end.");
-        return false;
+        sb += msg.sb_length;
     }
     hasImuMeas = hasAcc && hasOmega;
     return true;
-};
\ No newline at end of file
+};
@@ -0,0 +1,237 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file sbf_layout.hpp
+ * @brief Declares compile-time layouts of SBF blocks, from which the blocks are
+ * decoded by unaligned little endian loads
+ */
+
+namespace sbf_layout {
+
+    /**
+     * @brief Loads a little endian scalar from possibly unaligned memory
+     *
+     * The memcpy is compiled to a plain load on little endian hosts, so that
+     * consecutive fields may be fused by the compiler.
+     */
+    template <typename Val>
+    [[nodiscard]] inline Val load(const uint8_t* data)
+    {
+        static_assert(std::is_arithmetic_v<Val>);
+
+        Val val;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        std::memcpy(&val, data, sizeof(Val));
+#else
+        std::array<uint8_t, sizeof(Val)> bytes;
+        std::reverse_copy(data, data + sizeof(Val), bytes.begin());
+        std::memcpy(&val, bytes.data(), sizeof(Val));
+#endif
+        return val;
+    }
+
+    //! Marks fields without Do-Not-Use value
+    struct NoDoNotUse
+    {
+    };
+
+    //! Do-Not-Use value of the wire type, mapped to NaN when decoded
+    template <typename Wire>
+    inline constexpr auto DO_NOT_USE = NoDoNotUse{};
+    template <>
+    inline constexpr auto DO_NOT_USE<float> = -2e10f;
+    template <>
+    inline constexpr auto DO_NOT_USE<double> = -2e10;
+
+    template <typename T>
+    struct MemberPointer;
+
+    template <typename C, typename M>
+    struct MemberPointer<M C::*>
+    {
+        using Class = C;
+        using Type = M;
+    };
+
+    //! Element type of structure-of-arrays members, the type itself otherwise
+    template <typename T>
+    struct Element
+    {
+        using Type = T;
+    };
+
+    template <typename T, typename A>
+    struct Element<std::vector<T, A>>
+    {
+        using Type = T;
+    };
+
+    /**
+     * @brief Describes a field of an SBF block or sub-block
+     *
+     * Fields of sub-blocks may be decoded into vector members, one element per
+     * sub-block, to store the sub-blocks as structure of arrays.
+     * @tparam Member pointer to the member the field is decoded into
+     * @tparam Offset byte offset of the field in the block or sub-block
+     * @tparam Wire type of the field in the block, defaults to the member type
+     * @tparam Divisor the field is scaled by, e.g. 100 for a unit of 0.01
+     * @tparam DoNotUse value of the field that is decoded to NaN
+     */
+    template <auto Member, size_t Offset,
+              typename Wire = typename Element<
+                  typename MemberPointer<decltype(Member)>::Type>::Type,
+              uint32_t Divisor = 1, auto DoNotUse = DO_NOT_USE<Wire>>
+    struct Field
+    {
+        using Msg = typename MemberPointer<decltype(Member)>::Class;
+        using Stored = typename MemberPointer<decltype(Member)>::Type;
+        using Type = typename Element<Stored>::Type;
+
+        static constexpr size_t offset = Offset;
+        static constexpr size_t size = sizeof(Wire);
+        static constexpr bool hasDoNotUse =
+            !std::is_same_v<std::remove_cv_t<decltype(DoNotUse)>, NoDoNotUse>;
+
+        static_assert(std::is_arithmetic_v<Wire> && std::is_arithmetic_v<Type>);
+        static_assert(!hasDoNotUse || std::is_floating_point_v<Type>,
+                      "Do-Not-Use values are decoded to NaN");
+
+        static Type value(const uint8_t* data)
+        {
+            Wire val = load<Wire>(data + Offset);
+            if constexpr (hasDoNotUse)
+            {
+                if (val == DoNotUse)
+                    return std::numeric_limits<Type>::quiet_NaN();
+            }
+            if constexpr (Divisor == 1)
+                return static_cast<Type>(val);
+            else
+                return static_cast<Type>(val) / static_cast<Type>(Divisor);
+        }
+
+        static void decode(const uint8_t* data, Msg& msg)
+        {
+            static_assert(std::is_same_v<Stored, Type>);
+            msg.*Member = value(data);
+        }
+
+        //! Decodes into the element of a vector member
+        static void decode(const uint8_t* data, Msg& msg, size_t index)
+        {
+            static_assert(!std::is_same_v<Stored, Type>);
+            (msg.*Member)[index] = value(data);
+        }
+
+        static void setDoNotUse(Msg& msg)
+        {
+            static_assert(std::is_floating_point_v<Type>);
+            msg.*Member = std::numeric_limits<Type>::quiet_NaN();
+        }
+    };
+
+    /**
+     * @brief Table of the fields of an SBF block or sub-block
+     *
+     * The fields are listed in order of their offsets. Reserved bytes are
+     * skipped by the offsets.
+     */
+    template <typename... Fields>
+    struct Layout
+    {
+        using Msg = typename std::tuple_element_t<0, std::tuple<Fields...>>::Msg;
+
+        //! Bytes up to and including the last field
+        static constexpr size_t size =
+            std::max({(Fields::offset + Fields::size)...});
+
+        static_assert((std::is_same_v<Msg, typename Fields::Msg> && ...),
+                      "All fields must be decoded into the same message");
+
+        static constexpr bool ordered()
+        {
+            std::array<size_t, sizeof...(Fields)> begin{Fields::offset...};
+            std::array<size_t, sizeof...(Fields)> end{
+                (Fields::offset + Fields::size)...};
+            for (size_t i = 1; i < sizeof...(Fields); ++i)
+            {
+                if (begin[i] < end[i - 1])
+                    return false;
+            }
+            return true;
+        }
+        static_assert(ordered(), "Fields must be in order and must not overlap");
+
+        //! Decodes the fields from the block or sub-block starting at data
+        static void decode(const uint8_t* data, Msg& msg)
+        {
+            (Fields::decode(data, msg), ...);
+        }
+
+        //! Decodes the fields of a sub-block into element index of the arrays
+        static void decode(const uint8_t* data, Msg& msg, size_t index)
+        {
+            (Fields::decode(data, msg, index), ...);
+        }
+
+        //! Sets all fields to Do-Not-Use, for optional sub-blocks not present
+        static void setDoNotUse(Msg& msg) { (Fields::setDoNotUse(msg), ...); }
+    };
+
+    /**
+     * @brief Decodes an optional sub-block if present and advances data past
+     * it, otherwise sets its fields to Do-Not-Use
+     */
+    template <typename L>
+    void decodeOptional(bool present, const uint8_t*& data, typename L::Msg& msg)
+    {
+        if (present)
+        {
+            L::decode(data, msg);
+            data += L::size;
+        } else
+        {
+            L::setDoNotUse(msg);
+        }
+    }
+} // namespace sbf_layout
@@ -0,0 +1,515 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @file sbf_schema.hpp
+ * @brief Declares the schema of SBF blocks without a dedicated parser and a
+ * generic view decoding their fields by the schema
+ *
+ * This is a debug decoder: blocks decoded by the schema are only rendered into
+ * the debug log, they are not published.
+ */
+
+namespace sbf_schema {
+
+    //! Field types as named in the SBF reference guide
+    enum class Type : uint8_t
+    {
+        U1,
+        U2,
+        U4,
+        U8,
+        I1,
+        I2,
+        I4,
+        I8,
+        F4,
+        F8,
+        C1
+    };
+
+    //! Size of a value of the type in bytes
+    [[nodiscard]] constexpr size_t sizeOf(Type type)
+    {
+        switch (type)
+        {
+        case Type::U2:
+        case Type::I2:
+            return 2;
+        case Type::U4:
+        case Type::I4:
+        case Type::F4:
+            return 4;
+        case Type::U8:
+        case Type::I8:
+        case Type::F8:
+            return 8;
+        default:
+            return 1;
+        }
+    }
+
+    /**
+     * @brief Describes a field of an SBF block or sub-block
+     *
+     * Floats equal to the Do-Not-Use value -2e10 are always decoded to NaN,
+     * integers only if doNotUse is set, for all bits set if unsigned or the
+     * minimum value if signed.
+     */
+    struct Field
+    {
+        //! Name as in the SBF reference guide
+        std::string_view name;
+        Type type;
+        //! Byte offset in the block or sub-block
+        uint16_t offset;
+        //! Factor to physical units, e.g. 0.01 for a unit of 0.01 deg
+        double scale = 1.0;
+        bool doNotUse = false;
+        //! First block revision containing the field
+        uint8_t revision = 0;
+        //! Number of characters of C1 fields
+        uint16_t count = 1;
+
+        [[nodiscard]] constexpr size_t size() const { return sizeOf(type) * count; }
+        [[nodiscard]] constexpr size_t end() const { return offset + size(); }
+    };
+
+    //! View of the fields of a block or sub-block, i.e. of one of the arrays below
+    class Fields
+    {
+    public:
+        constexpr Fields() = default;
+
+        template <size_t N>
+        constexpr Fields(const std::array<Field, N>& fields) :
+            data_(fields.data()), size_(N)
+        {
+        }
+
+        constexpr Fields(const Field* data, size_t size) : data_(data), size_(size)
+        {
+        }
+
+        [[nodiscard]] constexpr const Field* begin() const { return data_; }
+        [[nodiscard]] constexpr const Field* end() const { return data_ + size_; }
+        [[nodiscard]] constexpr size_t size() const { return size_; }
+
+        [[nodiscard]] constexpr const Field& operator[](size_t index) const
+        {
+            return data_[index];
+        }
+
+        //! The first count fields
+        [[nodiscard]] constexpr Fields first(size_t count) const
+        {
+            return Fields(data_, count);
+        }
+
+    private:
+        const Field* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    //! Describes the array of sub-blocks of an SBF block
+    struct SubBlocks
+    {
+        std::string_view name;
+        //! Offset of the number of sub-blocks in the block, of type U1 or U2
+        uint16_t nOffset;
+        Type nType;
+        //! Offset of the sub-block length in the block, 0 if of fixed length
+        uint16_t lengthOffset;
+        //! Offset of the first sub-block in the block
+        uint16_t offset;
+        Fields fields;
+    };
+
+    //! Describes an SBF block, the fields start after the block header
+    struct Block
+    {
+        uint16_t id;
+        std::string_view name;
+        Fields fields;
+        std::optional<SubBlocks> subBlocks = std::nullopt;
+    };
+
+    //! Index of the field with the given name, fields.size() if none
+    [[nodiscard]] constexpr size_t fieldIndex(Fields fields,
+                                              std::string_view name)
+    {
+        for (size_t i = 0; i < fields.size(); ++i)
+        {
+            if (fields[i].name == name)
+                return i;
+        }
+        return fields.size();
+    }
+
+    //! Bytes up to and including the last field present in the revision
+    [[nodiscard]] constexpr size_t fieldsEnd(Fields fields,
+                                             uint8_t revision, size_t begin)
+    {
+        size_t end = begin;
+        for (const Field& f : fields)
+        {
+            if (f.revision <= revision)
+                end = std::max(end, f.end());
+        }
+        return end;
+    }
+
+    //! Fields of the SBF blocks "PVTGeodetic" and "ExtEventPVTGeodetic"
+    inline constexpr std::array<Field, 26> PVT_GEODETIC_FIELDS{
+        {{"Mode", Type::U1, 14},
+         {"Error", Type::U1, 15},
+         {"Latitude", Type::F8, 16},
+         {"Longitude", Type::F8, 24},
+         {"Height", Type::F8, 32},
+         {"Undulation", Type::F4, 40},
+         {"Vn", Type::F4, 44},
+         {"Ve", Type::F4, 48},
+         {"Vu", Type::F4, 52},
+         {"COG", Type::F4, 56},
+         {"RxClkBias", Type::F8, 60},
+         {"RxClkDrift", Type::F4, 68},
+         {"TimeSystem", Type::U1, 72, 1.0, true},
+         {"Datum", Type::U1, 73},
+         {"NrSV", Type::U1, 74, 1.0, true},
+         {"WACorrInfo", Type::U1, 75},
+         {"ReferenceID", Type::U2, 76, 1.0, true},
+         {"MeanCorrAge", Type::U2, 78, 0.01, true},
+         {"SignalInfo", Type::U4, 80},
+         {"AlertFlag", Type::U1, 84},
+         {"NrBases", Type::U1, 85, 1.0, false, 1},
+         {"PPPInfo", Type::U2, 86, 1.0, false, 1},
+         {"Latency", Type::U2, 88, 0.0001, false, 2},
+         {"HAccuracy", Type::U2, 90, 0.01, true, 2},
+         {"VAccuracy", Type::U2, 92, 0.01, true, 2},
+         {"Misc", Type::U1, 94, 1.0, false, 2}}};
+
+    //! Fields of the SBF blocks "PVTCartesian" and "ExtEventPVTCartesian"
+    inline constexpr std::array<Field, 26> PVT_CARTESIAN_FIELDS{
+        {{"Mode", Type::U1, 14},
+         {"Error", Type::U1, 15},
+         {"X", Type::F8, 16},
+         {"Y", Type::F8, 24},
+         {"Z", Type::F8, 32},
+         {"Undulation", Type::F4, 40},
+         {"Vx", Type::F4, 44},
+         {"Vy", Type::F4, 48},
+         {"Vz", Type::F4, 52},
+         {"COG", Type::F4, 56},
+         {"RxClkBias", Type::F8, 60},
+         {"RxClkDrift", Type::F4, 68},
+         {"TimeSystem", Type::U1, 72, 1.0, true},
+         {"Datum", Type::U1, 73},
+         {"NrSV", Type::U1, 74, 1.0, true},
+         {"WACorrInfo", Type::U1, 75},
+         {"ReferenceID", Type::U2, 76, 1.0, true},
+         {"MeanCorrAge", Type::U2, 78, 0.01, true},
+         {"SignalInfo", Type::U4, 80},
+         {"AlertFlag", Type::U1, 84},
+         {"NrBases", Type::U1, 85, 1.0, false, 1},
+         {"PPPInfo", Type::U2, 86, 1.0, false, 1},
+         {"Latency", Type::U2, 88, 0.0001, false, 2},
+         {"HAccuracy", Type::U2, 90, 0.01, true, 2},
+         {"VAccuracy", Type::U2, 92, 0.01, true, 2},
+         {"Misc", Type::U1, 94, 1.0, false, 2}}};
+
+    //! Fields of the SBF block "PVTSatCartesian"
+    inline constexpr std::array<Field, 2> PVT_SAT_CARTESIAN_FIELDS{
+        {{"N", Type::U1, 14}, {"SBLength", Type::U1, 15}}};
+    //! Fields of the sub-block "SatPos" of the SBF block "PVTSatCartesian"
+    inline constexpr std::array<Field, 15> SAT_POS_FIELDS{
+        {{"SVID", Type::U1, 0},
+         {"FreqNr", Type::U1, 1},
+         {"IODE", Type::U2, 2},
+         {"X", Type::F8, 4},
+         {"Y", Type::F8, 12},
+         {"Z", Type::F8, 20},
+         {"Vx", Type::F4, 28},
+         {"Vy", Type::F4, 32},
+         {"Vz", Type::F4, 36},
+         {"IonoMSB", Type::I2, 40, 1.0, true},
+         {"TropoMSB", Type::I2, 42, 1.0, true},
+         {"IonoLSB", Type::F4, 44},
+         {"TropoLSB", Type::F4, 48},
+         {"IonoModel", Type::U1, 52, 1.0, false, 1},
+         {"TropoModel", Type::U1, 53, 1.0, false, 1}}};
+    inline constexpr SubBlocks SAT_POS{"SatPos", 14, Type::U1, 15, 16,
+                                       SAT_POS_FIELDS};
+
+    //! Fields of the SBF block "SatVisibility"
+    inline constexpr std::array<Field, 2> SAT_VISIBILITY_FIELDS{
+        {{"N", Type::U1, 14}, {"SBLength", Type::U1, 15}}};
+    //! Fields of the sub-block "SatInfo" of the SBF block "SatVisibility"
+    inline constexpr std::array<Field, 6> SAT_INFO_FIELDS{
+        {{"SVID", Type::U1, 0},
+         {"FreqNr", Type::U1, 1},
+         {"Azimuth", Type::U2, 2, 0.01, true},
+         {"Elevation", Type::I2, 4, 0.01, true},
+         {"RiseSet", Type::U1, 6},
+         {"SatelliteInfo", Type::U1, 7}}};
+    inline constexpr SubBlocks SAT_INFO{"SatInfo", 14, Type::U1, 15, 16,
+                                        SAT_INFO_FIELDS};
+
+    //! Fields of the SBF block "ExtEvent"
+    inline constexpr std::array<Field, 5> EXT_EVENT_FIELDS{
+        {{"Source", Type::U1, 14},
+         {"Polarity", Type::U1, 15},
+         {"Offset", Type::F4, 16},
+         {"RxClkBias", Type::F8, 20},
+         {"PVTAge", Type::U2, 28, 1.0, true, 1}}};
+
+    //! Fields of the SBF block "BBSamples"
+    inline constexpr std::array<Field, 4> BB_SAMPLES_FIELDS{
+        {{"N", Type::U2, 14},
+         {"Info", Type::U1, 16},
+         {"SampleFreq", Type::U4, 20},
+         {"LOFreq", Type::U4, 24}}};
+    //! I/Q sample pairs of the SBF block "BBSamples"
+    inline constexpr std::array<Field, 2> SAMPLE_FIELDS{
+        {{"Q", Type::I1, 0}, {"I", Type::I1, 1}}};
+    inline constexpr SubBlocks SAMPLES{"Samples", 14, Type::U2, 0, 28,
+                                       SAMPLE_FIELDS};
+
+    //! Fields of the SBF block "PosLocal"
+    inline constexpr std::array<Field, 6> POS_LOCAL_FIELDS{
+        {{"Mode", Type::U1, 14},
+         {"Error", Type::U1, 15},
+         {"Lat", Type::F8, 16},
+         {"Lon", Type::F8, 24},
+         {"Alt", Type::F8, 32},
+         {"Datum", Type::U1, 40}}};
+
+    //! Fields of the SBF block "xPPSOffset"
+    inline constexpr std::array<Field, 3> X_PPS_OFFSET_FIELDS{
+        {{"SyncAge", Type::U1, 14},
+         {"TimeScale", Type::U1, 15},
+         {"Offset", Type::F4, 16}}};
+
+    //! Fields of the SBF block "AuxAntPositions"
+    inline constexpr std::array<Field, 2> AUX_ANT_POSITIONS_FIELDS{
+        {{"N", Type::U1, 14}, {"SBLength", Type::U1, 15}}};
+    //! Fields of the sub-block "AuxAntPosition" of "AuxAntPositions"
+    inline constexpr std::array<Field, 10> AUX_ANT_POSITION_FIELDS{
+        {{"NrSV", Type::U1, 0, 1.0, true},
+         {"Error", Type::U1, 1},
+         {"AmbiguityType", Type::U1, 2},
+         {"AuxAntID", Type::U1, 3},
+         {"DeltaEast", Type::F8, 4},
+         {"DeltaNorth", Type::F8, 12},
+         {"DeltaUp", Type::F8, 20},
+         {"EastVel", Type::F8, 28},
+         {"NorthVel", Type::F8, 36},
+         {"UpVel", Type::F8, 44}}};
+    inline constexpr SubBlocks AUX_ANT_POSITION{"AuxAntPosition", 14, Type::U1, 15,
+                                                16, AUX_ANT_POSITION_FIELDS};
+
+    //! Blocks decoded by the schema, blocks with dedicated parsers are not
+    //! listed
+    inline constexpr std::array<Block, 12> SCHEMA{
+        {{4008, "PVTSatCartesian", PVT_SAT_CARTESIAN_FIELDS, SAT_POS},
+         {4012, "SatVisibility", SAT_VISIBILITY_FIELDS, SAT_INFO},
+         {4037, "ExtEventPVTCartesian", PVT_CARTESIAN_FIELDS},
+         {4038, "ExtEventPVTGeodetic", PVT_GEODETIC_FIELDS},
+         {4040, "BBSamples", BB_SAMPLES_FIELDS, SAMPLES},
+         {4052, "PosLocal", POS_LOCAL_FIELDS},
+         {5911, "xPPSOffset", X_PPS_OFFSET_FIELDS},
+         {5921, "EndOfPVT", {}},
+         {5922, "EndOfMeas", {}},
+         {5924, "ExtEvent", EXT_EVENT_FIELDS},
+         {5942, "AuxAntPositions", AUX_ANT_POSITIONS_FIELDS, AUX_ANT_POSITION},
+         {5943, "EndOfAtt", {}}}};
+
+    /**
+     * @brief Checks that the fields are in order, do not overlap, and that
+     * revisions only append fields
+     */
+    [[nodiscard]] constexpr bool ordered(Fields fields,
+                                         size_t begin)
+    {
+        size_t end = begin;
+        uint8_t revision = 0;
+        for (const Field& f : fields)
+        {
+            if ((f.offset < end) || (f.revision < revision) || (f.count == 0))
+                return false;
+            end = f.end();
+            revision = f.revision;
+        }
+        return true;
+    }
+
+    //! Checks the fields of all blocks and sub-blocks of the schema
+    [[nodiscard]] constexpr bool schemaOrdered()
+    {
+        for (const Block& b : SCHEMA)
+        {
+            if (!ordered(b.fields, 14) ||
+                (b.subBlocks && !ordered(b.subBlocks->fields, 0)))
+                return false;
+        }
+        return true;
+    }
+    static_assert(schemaOrdered(), "Fields must be in order and must not overlap");
+
+    //! Checks that the blocks are sorted by ID, as find() relies on
+    [[nodiscard]] constexpr bool schemaSorted()
+    {
+        for (size_t i = 1; i < SCHEMA.size(); ++i)
+        {
+            if (SCHEMA[i - 1].id >= SCHEMA[i].id)
+                return false;
+        }
+        return true;
+    }
+    static_assert(schemaSorted(), "Blocks must be sorted by unique IDs");
+
+    //! Schema of the block with the given ID, nullptr if not in the schema
+    [[nodiscard]] constexpr const Block* find(uint16_t id)
+    {
+        // Binary search, the standard algorithms are not constexpr before C++20
+        size_t first = 0;
+        size_t last = SCHEMA.size();
+        while (first < last)
+        {
+            const size_t middle = first + (last - first) / 2;
+            if (SCHEMA[middle].id < id)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        if ((first == SCHEMA.size()) || (SCHEMA[first].id != id))
+            return nullptr;
+        return &SCHEMA[first];
+    }
+
+    //! Field of a decoded block or sub-block
+    class FieldView
+    {
+    public:
+        FieldView(const Field& field, const uint8_t* data) :
+            field_(&field), data_(data + field.offset)
+        {
+        }
+
+        [[nodiscard]] const Field& field() const { return *field_; }
+
+        [[nodiscard]] std::string_view name() const { return field_->name; }
+
+        //! Scaled value, NaN if Do-Not-Use or a C1 field
+        [[nodiscard]] double value() const;
+
+        //! Characters of a C1 field up to the first NUL
+        [[nodiscard]] std::string_view chars() const;
+
+    private:
+        const Field* field_;
+        const uint8_t* data_;
+    };
+
+    /**
+     * @brief View of an SBF block decoded by its schema
+     *
+     * The view does not copy the block, which has to outlive the view. Fields not
+     * present in the revision of the block are not part of the view.
+     */
+    class BlockView
+    {
+    public:
+        /**
+         * @brief Decodes the block header and sub-block array and validates the
+         * length of the block
+         * @param[in] block Schema of the block
+         * @param[in] data The block, starting with the sync bytes
+         * @param[in] length Number of bytes of the block
+         * @return False if the block is shorter than its fields and sub-blocks
+         */
+        [[nodiscard]] bool parse(const Block& block, const uint8_t* data,
+                                 size_t length);
+
+        [[nodiscard]] const Block& block() const { return *block_; }
+
+        [[nodiscard]] uint8_t revision() const { return revision_; }
+
+        [[nodiscard]] uint32_t tow() const { return tow_; }
+
+        [[nodiscard]] uint16_t wnc() const { return wnc_; }
+
+        [[nodiscard]] size_t fieldCount() const { return fieldCount_; }
+
+        [[nodiscard]] FieldView field(size_t index) const
+        {
+            return FieldView(block_->fields[index], data_);
+        }
+
+        [[nodiscard]] std::optional<FieldView> field(std::string_view name) const;
+
+        [[nodiscard]] size_t subBlockCount() const { return n_; }
+
+        [[nodiscard]] size_t subBlockFieldCount() const { return sbFieldCount_; }
+
+        [[nodiscard]] FieldView subBlockField(size_t subBlock, size_t index) const
+        {
+            return FieldView(block_->subBlocks->fields[index],
+                             data_ + block_->subBlocks->offset +
+                                 subBlock * sbLength_);
+        }
+
+        [[nodiscard]] std::optional<FieldView>
+        subBlockField(size_t subBlock, std::string_view name) const;
+
+        //! Renders the block as "Name TOW WNc: field=value, ..." for logging
+        [[nodiscard]] std::string toString() const;
+
+    private:
+        const Block* block_ = nullptr;
+        const uint8_t* data_ = nullptr;
+        uint8_t revision_ = 0;
+        uint32_t tow_ = 0;
+        uint16_t wnc_ = 0;
+        size_t fieldCount_ = 0;
+        size_t n_ = 0;
+        size_t sbLength_ = 0;
+        size_t sbFieldCount_ = 0;
+    };
+} // namespace sbf_schema
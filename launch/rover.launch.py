@@ -52,7 +52,8 @@ def generate_launch_description():
         package='septentrio_gnss_driver', 
         plugin='rosaic_node::ROSaicNode',
         #emulate_tty=True,
-        parameters=[LaunchConfiguration(name_arg_file_path)])
+        parameters=[LaunchConfiguration(name_arg_file_path)],
+        extra_arguments=[{'use_intra_process_comms': True}])
 
     container = ComposableNodeContainer(
         name='septentrio_gnss_driver_container',
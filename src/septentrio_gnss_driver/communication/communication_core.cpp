@@ -28,7 +28,10 @@
 //
 // *****************************************************************************
 
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <linux/serial.h>
@@ -61,29 +64,186 @@ static const int8_t POSSTD_DEV_MAX = 100;
 namespace io {
 
     CommunicationCore::CommunicationCore(ROSaicNodeBase* node) :
-        node_(node), settings_(node->settings()), telegramHandler_(node),
+        node_(node), settings_(node->settings()),
+        telegramPool_(std::make_shared<TelegramPool>()), telegramHandler_(node),
         running_(true)
     {
         running_ = true;
-
-        processingThread_ =
-            std::thread(std::bind(&CommunicationCore::processTelegrams, this));
     }
 
     CommunicationCore::~CommunicationCore()
     {
         telegramHandler_.clearSemaphores();
+        telegramHandler_.commandPipeline().setResponseCallback(nullptr);
 
         resetSettings();
 
         running_ = false;
-        auto telegram = std::make_shared<Telegram>();
-        telegramQueue_.push(telegram);
-        processingThread_.join();
+        // A paused replay would block the processing thread forever
+        telegramHandler_.getMessageHandler().replayClock().stop();
+        if (processingThread_.joinable())
+        {
+            auto telegram = std::make_shared<Telegram>();
+            telegramQueue_->push(telegram);
+            processingThread_.join();
+        }
     }
 
     void CommunicationCore::close() { manager_->close(); }
 
+    std::shared_ptr<IoContextPool> CommunicationCore::ioContextPool()
+    {
+        if (!ioPool_)
+        {
+            ioPool_ = std::make_shared<IoContextPool>(
+                settings_->io_pool.threads, settings_->io_pool.cpu_affinity);
+            if (!ioPool_->affinityApplied())
+                node_->log(log_level::WARN,
+                           "Could not pin the I/O threads to io_pool.cpu_affinity.");
+        }
+        return ioPool_;
+    }
+
+    void CommunicationCore::setIoContextPool(std::shared_ptr<IoContextPool> ioPool)
+    {
+        ioPool_ = ioPool;
+    }
+
+    void CommunicationCore::addDiagnostics()
+    {
+        node_->diagnostic_updater_->add(
+            node_->diagnosticName("Communication"), this,
+            &CommunicationCore::communicationDiagnostics);
+    }
+
+    void CommunicationCore::communicationDiagnostics(
+        diagnostic_updater::DiagnosticStatusWrapper& status)
+    {
+        status.summary(status.OK, "Communication statistics");
+        status.add("Telegram pool hits", telegramPool_->hits());
+        status.add("Telegram pool misses", telegramPool_->misses());
+        status.add("Telegram pool cached", telegramPool_->cached());
+        if (ioPool_)
+            status.add("I/O threads", ioPool_->threads());
+        if (configurationCommands_ > 0)
+        {
+            status.add("Rx configuration commands", configurationCommands_.load());
+            status.add("Rx configuration time [ms]", configurationTime_.load());
+            if (settings_->configure_rx_diff)
+                status.add("Rx configuration commands skipped",
+                           configurationSkipped_.load());
+        }
+        if (std::optional<BaudrateNegotiation> negotiation =
+                manager_ ? manager_->baudrateNegotiation() : std::nullopt)
+        {
+            status.add("Baudrate negotiation time [ms]", negotiation->time);
+            if (negotiation->direct)
+                status.add("Baudrate negotiation", "direct");
+            else if (negotiation->verified)
+                status.add("Baudrate negotiation", "ramp");
+            else
+                status.add("Baudrate negotiation", "unverified");
+        }
+        auto addOutages = [&status](const std::string& connection,
+                                    const ReconnectStatistics& statistics) {
+            status.add(connection + " reconnects", statistics.reconnects);
+            status.add(connection + " last outage [ms]", statistics.lastOutage);
+            status.add(connection + " longest outage [ms]", statistics.maxOutage);
+            status.add(connection + " total outage [ms]", statistics.totalOutage);
+        };
+        if (std::optional<ReconnectStatistics> statistics =
+                manager_ ? manager_->reconnectStatistics() : std::nullopt)
+            addOutages("Main connection", *statistics);
+        if (tcpClient_)
+            addOutages("TCP stream", *tcpClient_->reconnectStatistics());
+        if (udpClient_)
+            addOutages("UDP stream", udpClient_->reconnectStatistics());
+
+        if (!telegramQueue_)
+            return;
+
+        uint64_t drops = 0;
+        static const std::array<std::pair<telegram_type::TelegramType, const char*>,
+                                4>
+            droppableTypes = {{{telegram_type::SBF, "SBF"},
+                               {telegram_type::NMEA, "NMEA"},
+                               {telegram_type::NMEA_INS, "NMEA INS"},
+                               {telegram_type::UNKNOWN, "unknown"}}};
+        static const std::array<
+            std::pair<telegram_priority::TelegramPriority, const char*>, 4>
+            lanes = {{{telegram_priority::CONTROL, "control"},
+                      {telegram_priority::HIGH, "high"},
+                      {telegram_priority::NORMAL, "normal"},
+                      {telegram_priority::LOW, "low"}}};
+        status.add("Telegram queue size", telegramQueue_->size());
+        status.add("Telegram queue capacity per lane", telegramQueue_->capacity());
+        status.add("Telegram queue high-water mark",
+                   telegramQueue_->highWaterMark());
+        for (const auto& [lane, name] : lanes)
+        {
+            const LatencyHistogram& latency = telegramQueue_->latency(lane);
+            status.add(std::string("Telegram queue latency ") + name + " p99 [us]",
+                       latency.percentile(0.99));
+            status.add(std::string("Telegram queue latency ") + name,
+                       latency.toString());
+        }
+        for (const auto& [type, name] : droppableTypes)
+        {
+            status.add(std::string("Telegram queue drops ") + name,
+                       telegramQueue_->drops(type));
+            drops += telegramQueue_->drops(type);
+        }
+        if (drops > lastReportedDrops_)
+            status.summary(status.WARN,
+                           "Telegram queue overflowed, " +
+                               std::to_string(drops - lastReportedDrops_) +
+                               " telegrams dropped since last report");
+        lastReportedDrops_ = drops;
+    }
+
+    void CommunicationCore::initializeTelegramQueue()
+    {
+        if (telegramQueue_)
+            return;
+
+        telegramQueue_ =
+            std::make_unique<TelegramQueue>(settings_->telegram_queue.capacity);
+        // Replay of files must be lossless and in order, the reader simply waits
+        if (!settings_->read_from_sbf_log && !settings_->read_from_pcap)
+        {
+            for (auto id : settings_->telegram_queue.priority_high)
+                telegramQueue_->setPriority(id, telegram_priority::HIGH);
+            for (auto id : settings_->telegram_queue.priority_low)
+                telegramQueue_->setPriority(id, telegram_priority::LOW);
+            // A block of the next epoch overtaking a block of the current one
+            // would end the epoch before its derived messages are complete
+            MessageHandler& handler = telegramHandler_.getMessageHandler();
+            const EpochAggregator::Blocks needed =
+                handler.epochAggregator().needs(handler.derivedOutputs(false));
+            std::vector<uint16_t> ids;
+            for (uint16_t id = 0; id < TelegramQueue::NUMBER_OF_SBF_IDS; ++id)
+            {
+                if (needed & MessageHandler::epochBlock(id))
+                    ids.push_back(id);
+            }
+            telegramQueue_->shareLane(ids);
+            telegramQueue_->setPolicy(telegram_type::SBF,
+                                      settings_->telegram_queue.policy_sbf);
+            telegramQueue_->setPolicy(telegram_type::NMEA,
+                                      settings_->telegram_queue.policy_nmea);
+            telegramQueue_->setPolicy(telegram_type::NMEA_INS,
+                                      settings_->telegram_queue.policy_nmea);
+            telegramQueue_->setPolicy(telegram_type::UNKNOWN,
+                                      settings_->telegram_queue.policy_unknown);
+        }
+        node_->log(log_level::DEBUG,
+                   "Telegram queue capacity: " +
+                       std::to_string(telegramQueue_->capacity()));
+
+        processingThread_ =
+            std::thread(std::bind(&CommunicationCore::processTelegrams, this));
+    }
+
     void CommunicationCore::resetSettings()
     {
         if (!manager_->connected())
@@ -172,6 +332,20 @@ namespace io {
             log_level::DEBUG,
             "Started timer for calling connect() method until connection succeeds");
 
+        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
+        {
+            ReplayClock& replayClock =
+                telegramHandler_.getMessageHandler().replayClock();
+            replayClock.setRate(settings_->replay.rate);
+            if (settings_->replay.start_paused)
+                replayClock.pause();
+        }
+        telegramHandler_.getMessageHandler().epochAggregator().setTimeout(
+            epochTimeout());
+        telegramHandler_.getMessageHandler().epochAggregator().setBlocks(
+            telegramHandler_.getMessageHandler().outputBlocks());
+        initializeTelegramQueue();
+
         boost::asio::io_service io;
         if (initializeIo())
         {
@@ -205,10 +379,11 @@ namespace io {
     {
         bool client = false;
         node_->log(log_level::DEBUG, "Called initializeIo() method");
+        std::ignore = ioContextPool();
         if ((settings_->tcp_port != 0) && (!settings_->tcp_ip_server.empty()))
         {
-            tcpClient_ =
-                std::make_unique<AsyncManager<TcpIo>>(node_, &telegramQueue_);
+            tcpClient_ = std::make_unique<AsyncManager<TcpIo>>(
+                node_, ioPool_, telegramQueue_.get(), telegramPool_);
             tcpClient_->setPort(std::to_string(settings_->tcp_port));
             if (!settings_->configure_rx)
                 tcpClient_->connect();
@@ -216,8 +391,10 @@ namespace io {
         }
         if ((settings_->udp_port != 0) && (!settings_->udp_ip_server.empty()))
         {
-            udpClient_ = std::make_unique<UdpClient>(node_, settings_->udp_port,
-                                                     &telegramQueue_);
+            udpClient_ = std::make_unique<UdpClient>(node_, ioPool_,
+                                                     settings_->udp_port,
+                                                     telegramQueue_.get(),
+                                                     telegramPool_);
             client = true;
         }
 
@@ -225,25 +402,26 @@ namespace io {
         {
         case device_type::TCP:
         {
-            manager_ = std::make_unique<AsyncManager<TcpIo>>(node_, &telegramQueue_);
+            manager_ = std::make_unique<AsyncManager<TcpIo>>(
+                node_, ioPool_, telegramQueue_.get(), telegramPool_);
             break;
         }
         case device_type::SERIAL:
         {
-            manager_ =
-                std::make_unique<AsyncManager<SerialIo>>(node_, &telegramQueue_);
+            manager_ = std::make_unique<AsyncManager<SerialIo>>(
+                node_, ioPool_, telegramQueue_.get(), telegramPool_);
             break;
         }
         case device_type::SBF_FILE:
         {
-            manager_ =
-                std::make_unique<AsyncManager<SbfFileIo>>(node_, &telegramQueue_);
+            manager_ = std::make_unique<MappedSbfReader>(
+                node_, telegramQueue_.get(), telegramPool_);
             break;
         }
         case device_type::PCAP_FILE:
         {
-            manager_ =
-                std::make_unique<AsyncManager<PcapFileIo>>(node_, &telegramQueue_);
+            manager_ = std::make_unique<PcapReader>(
+                node_, telegramQueue_.get(), telegramPool_);
             break;
         }
         default:
@@ -279,6 +457,11 @@ namespace io {
             return;
         }
 
+        // Commands are pipelined, the first error stops sending further commands
+        CommandPipeline& commands = telegramHandler_.commandPipeline();
+        commands.reset();
+        auto start = std::chrono::steady_clock::now();
+
         uint8_t stream = 1;
         // Determining communication mode: TCP vs USB/Serial
         boost::smatch match;
@@ -308,7 +491,11 @@ namespace io {
                 send("login, " + settings_->login_user + ", " +
                      settings_->login_password + " \x0D");
         }
-        
+
+        // Unchanged settings of the last configuration are not configured again
+        if (settings_->configure_rx_diff)
+            startConfigDiff();
+
         // Turning off all current SBF/NMEA output
         send("sso, all, none, none, off \x0D");
         send("sno, all, none, none, off \x0D");
@@ -352,6 +539,8 @@ namespace io {
             send("siss, " + streamPort_ + ", " +
                  std::to_string(settings_->tcp_port) + ", " + tcp_mode + ", " +
                  "\x0D");
+            // The IP server has to be set up before connecting to it
+            std::ignore = commands.flush();
             tcpClient_->connect();
         } else if (udpClient_)
         {
@@ -368,7 +557,8 @@ namespace io {
 
         // Get Rx capabilities
         send("grc \x0D");
-        telegramHandler_.waitForCapabilities();
+        if (!commands.failed())
+            telegramHandler_.waitForCapabilities();
 
         // Activate NTP server
         if (settings_->ntp_server)
@@ -970,9 +1160,10 @@ namespace io {
 
                     send("sdio, " + settings_->ins_vsm.ip_server +
                          ", NMEA, none\x0D");
+                    std::ignore = commands.flush();
 
-                    tcpVsm_ = std::make_unique<AsyncManager<TcpIo>>(node_,
-                                                                    &telegramQueue_);
+                    tcpVsm_ = std::make_unique<AsyncManager<TcpIo>>(
+                        node_, ioPool_, telegramQueue_.get(), telegramPool_);
                     tcpVsm_->setPort(
                         std::to_string(settings_->ins_vsm.ip_server_port));
                     tcpVsm_->connect();
@@ -981,8 +1172,54 @@ namespace io {
                 nmeaActivated_ = true;
             }
         }
-        // Save config to boot
-        send("eccf, Current, Boot\x0D");
+        // Skipped commands changing settings that are outdated by commands no
+        // longer part of the configuration
+        if (configDiff_ && commands.flush())
+        {
+            for (const auto& cmd : configDiff_->finish())
+                sendCommand(cmd);
+        }
+        // Only a complete configuration is saved to boot
+        if (!commands.flush())
+        {
+            node_->log(log_level::ERROR, "Rx configuration aborted after " +
+                                             std::to_string(commands.commands()) +
+                                             " commands: " + commands.failure());
+            endConfigDiff();
+            return;
+        }
+
+        if (configDiff_ && configDiff_->unchanged())
+        {
+            node_->log(log_level::INFO, "Rx settings unchanged since the last "
+                                        "configuration, saving to boot skipped.");
+        } else
+        {
+            // Save config to boot
+            send("eccf, Current, Boot\x0D");
+            if (!commands.flush())
+            {
+                node_->log(log_level::ERROR,
+                           "Saving Rx configuration failed: " + commands.failure());
+                endConfigDiff();
+                return;
+            }
+            if (configDiff_)
+                saveConfigDiff();
+        }
+
+        configurationCommands_ = commands.commands();
+        configurationSkipped_ = configDiff_ ? configDiff_->skipped() : 0;
+        configurationTime_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        node_->log(log_level::INFO,
+                   "Rx configured with " +
+                       std::to_string(configurationCommands_.load()) +
+                       " commands (" + std::to_string(configurationSkipped_.load()) +
+                       " skipped) in " + std::to_string(configurationTime_.load()) +
+                       " ms.");
+        endConfigDiff();
 
         node_->log(log_level::DEBUG, "Leaving configureRx() method");
     }
@@ -1019,23 +1256,153 @@ namespace io {
         return telegramHandler_.getMainCd();
     }
 
+    std::chrono::milliseconds CommunicationCore::epochTimeout() const
+    {
+        if (settings_->read_from_sbf_log || settings_->read_from_pcap)
+            return std::chrono::milliseconds(0);
+        return std::chrono::milliseconds(settings_->epoch_timeout);
+    }
+
     void CommunicationCore::processTelegrams()
     {
+        MessageHandler& handler = telegramHandler_.getMessageHandler();
+        // Wake up without telegrams as well, so that epochs of a stalled stream
+        // still time out
+        const std::chrono::milliseconds poll = epochTimeout();
+        uint64_t lastStamp = 0;
+        auto lastArrival = std::chrono::steady_clock::now();
         while (running_)
         {
-            timeSinceLastTelegram_ = node_->get_clock()->now();
             std::shared_ptr<Telegram> telegram;
-            telegramQueue_.pop(telegram);
+            if (poll.count() == 0)
+            {
+                // Woken by the EMPTY telegram on shutdown
+                telegramQueue_->pop(telegram);
+            } else if (!telegramQueue_->pop(telegram, poll))
+            {
+                // Continues the time of the telegrams
+                const auto idle = std::chrono::steady_clock::now() - lastArrival;
+                handler.expireEpoch(
+                    lastStamp +
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(idle)
+                        .count());
+                continue;
+            }
+            timeSinceLastTelegram_ = node_->get_clock()->now();
 
             if (telegram->type != telegram_type::EMPTY)
+            {
+                lastStamp = telegram->stamp;
                 telegramHandler_.handleTelegram(telegram);
+                lastArrival = std::chrono::steady_clock::now();
+                handler.expireEpoch(lastStamp);
+            }
         }
     }
 
     void CommunicationCore::send(const std::string& cmd)
     {
-        manager_.get()->send(cmd);
-        telegramHandler_.waitForResponse();
+        if (configDiff_ && configDiff_->skip(cmd))
+            return;
+        sendCommand(cmd);
+    }
+
+    void CommunicationCore::sendCommand(const std::string& cmd)
+    {
+        if (telegramHandler_.commandPipeline().admit(cmd))
+            manager_.get()->send(cmd);
+    }
+
+    void CommunicationCore::startConfigDiff()
+    {
+        CommandPipeline& commands = telegramHandler_.commandPipeline();
+        // Failures of the queries must not be confused with failures of the login
+        if (!commands.flush())
+            return;
+        std::string path = configCachePath();
+
+        auto track = [&commands](RxConfigDiff* diff) {
+            commands.setResponseCallback(
+                [diff](const std::string& command, const std::string& response) {
+                    diff->respond(command, response);
+                });
+        };
+
+        auto diff = std::make_unique<RxConfigDiff>();
+        if (diff->load(path))
+        {
+            track(diff.get());
+            std::vector<std::string> queries = diff->queries();
+            for (const auto& query : queries)
+                sendCommand(query + "\x0D");
+            if (commands.flush())
+            {
+                std::size_t changed = diff->compare();
+                node_->log(log_level::INFO,
+                           std::to_string(changed) + " of " +
+                               std::to_string(queries.size()) +
+                               " Rx settings changed since the last configuration.");
+            } else
+            {
+                node_->log(log_level::WARN,
+                           "Reading back the Rx settings failed, configuring all: " +
+                               commands.failure());
+                commands.reset();
+                diff = std::make_unique<RxConfigDiff>();
+            }
+        } else
+        {
+            node_->log(log_level::INFO, "No valid Rx configuration cache " + path +
+                                            ", configuring all settings.");
+        }
+        track(diff.get());
+        configDiff_ = std::move(diff);
+    }
+
+    void CommunicationCore::saveConfigDiff()
+    {
+        CommandPipeline& commands = telegramHandler_.commandPipeline();
+        for (const auto& query : configDiff_->finalQueries())
+            sendCommand(query + "\x0D");
+
+        std::string path = configCachePath();
+        if (!commands.flush())
+            node_->log(log_level::WARN,
+                       "Reading back the Rx settings failed, configuration not "
+                       "cached: " +
+                           commands.failure());
+        else if (!configDiff_->save(path))
+            node_->log(log_level::WARN,
+                       "Rx configuration could not be cached in " + path);
+    }
+
+    void CommunicationCore::endConfigDiff()
+    {
+        telegramHandler_.commandPipeline().setResponseCallback(nullptr);
+        configDiff_.reset();
+    }
+
+    std::string CommunicationCore::configCachePath() const
+    {
+        if (!settings_->configure_rx_cache.empty())
+            return settings_->configure_rx_cache;
+
+        std::string device = settings_->device;
+        std::replace_if(
+            device.begin(), device.end(),
+            [](char c) { return !std::isalnum(static_cast<unsigned char>(c)); },
+            '_');
+        // The cache has to survive a reboot, so it is kept in the ROS home
+        std::filesystem::path directory;
+        if (const char* rosHome = std::getenv("ROS_HOME"))
+            directory = rosHome;
+        else if (const char* home = std::getenv("HOME"))
+            directory = std::filesystem::path(home) / ".ros";
+        std::error_code ec;
+        if (directory.empty() ||
+            (!std::filesystem::create_directories(directory, ec) && ec))
+            directory = std::filesystem::temp_directory_path();
+        return (directory / ("septentrio_rx_config_" + device + ".cache")).string();
     }
 
 } // namespace io
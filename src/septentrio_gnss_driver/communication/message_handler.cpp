@@ -57,7 +57,7 @@ namespace io {
 
     void MessageHandler::assemblePoseWithCovarianceStamped()
     {
-        if (!settings_->publish_pose)
+        if (!publishes(settings_->publish_pose, topic::POSE))
             return;
 
         thread_local auto last_ins_tow = last_insnavgeod_.block_header.tow;
@@ -155,60 +155,75 @@ namespace io {
             }
         } else
         {
-            if ((!validValue(last_pvtgeodetic_.block_header.tow)) ||
-                (last_pvtgeodetic_.block_header.tow !=
-                 last_atteuler_.block_header.tow) ||
-                (last_pvtgeodetic_.block_header.tow !=
-                 last_poscovgeodetic_.block_header.tow) ||
-                (last_pvtgeodetic_.block_header.tow !=
-                 last_attcoveuler_.block_header.tow))
-                return;
-
+            // Called by aggregateEpoch() once all blocks of the epoch are in or
+            // the epoch has ended
             msg.header = last_pvtgeodetic_.header;
 
             // Filling in the pose data
-            double yaw = last_atteuler_.heading;
-            double pitch = last_atteuler_.pitch;
-            double roll = last_atteuler_.roll;
+            if (inEpoch(last_atteuler_.block_header))
+            {
+                double yaw = last_atteuler_.heading;
+                double pitch = last_atteuler_.pitch;
+                double roll = last_atteuler_.roll;
 
-            roll = std::isnan(roll) ? 0.0 : roll;
-            pitch = std::isnan(pitch) ? 0.0 : pitch;
+                roll = std::isnan(roll) ? 0.0 : roll;
+                pitch = std::isnan(pitch) ? 0.0 : pitch;
 
-            msg.pose.pose.orientation = convertEulerToQuaternionMsg(
-                deg2rad(roll), deg2rad(pitch), deg2rad(yaw));
+                msg.pose.pose.orientation = convertEulerToQuaternionMsg(
+                    deg2rad(roll), deg2rad(pitch), deg2rad(yaw));
+            } else
+            {
+                parsing_utilities::setQuaternionNaN(msg.pose.pose.orientation);
+            }
             msg.pose.pose.position.x = rad2deg(last_pvtgeodetic_.longitude);
             msg.pose.pose.position.y = rad2deg(last_pvtgeodetic_.latitude);
             msg.pose.pose.position.z = last_pvtgeodetic_.height;
             // Filling in the covariance data in row-major order
-            msg.pose.covariance[0] = last_poscovgeodetic_.cov_lonlon;
-            msg.pose.covariance[1] = last_poscovgeodetic_.cov_latlon;
-            msg.pose.covariance[2] = last_poscovgeodetic_.cov_lonhgt;
-            msg.pose.covariance[6] = last_poscovgeodetic_.cov_latlon;
-            msg.pose.covariance[7] = last_poscovgeodetic_.cov_latlat;
-            msg.pose.covariance[8] = last_poscovgeodetic_.cov_lathgt;
-            msg.pose.covariance[12] = last_poscovgeodetic_.cov_lonhgt;
-            msg.pose.covariance[13] = last_poscovgeodetic_.cov_lathgt;
-            msg.pose.covariance[14] = last_poscovgeodetic_.cov_hgthgt;
-            msg.pose.covariance[21] = parsing_utilities::convertAutoCovariance(
-                last_attcoveuler_.cov_rollroll);
-            msg.pose.covariance[22] = parsing_utilities::convertCovariance(
-                last_attcoveuler_.cov_pitchroll);
-            msg.pose.covariance[23] =
-                parsing_utilities::convertCovariance(last_attcoveuler_.cov_headroll);
-            msg.pose.covariance[27] = parsing_utilities::convertCovariance(
-                last_attcoveuler_.cov_pitchroll);
-            msg.pose.covariance[28] = parsing_utilities::convertAutoCovariance(
-                last_attcoveuler_.cov_pitchpitch);
-            msg.pose.covariance[29] = parsing_utilities::convertCovariance(
-                last_attcoveuler_.cov_headpitch);
-            msg.pose.covariance[33] =
-                parsing_utilities::convertCovariance(last_attcoveuler_.cov_headroll);
-            msg.pose.covariance[34] = parsing_utilities::convertCovariance(
-                last_attcoveuler_.cov_headpitch);
-            msg.pose.covariance[35] = parsing_utilities::convertAutoCovariance(
-                last_attcoveuler_.cov_headhead);
+            if (inEpoch(last_poscovgeodetic_.block_header))
+            {
+                msg.pose.covariance[0] = last_poscovgeodetic_.cov_lonlon;
+                msg.pose.covariance[1] = last_poscovgeodetic_.cov_latlon;
+                msg.pose.covariance[2] = last_poscovgeodetic_.cov_lonhgt;
+                msg.pose.covariance[6] = last_poscovgeodetic_.cov_latlon;
+                msg.pose.covariance[7] = last_poscovgeodetic_.cov_latlat;
+                msg.pose.covariance[8] = last_poscovgeodetic_.cov_lathgt;
+                msg.pose.covariance[12] = last_poscovgeodetic_.cov_lonhgt;
+                msg.pose.covariance[13] = last_poscovgeodetic_.cov_lathgt;
+                msg.pose.covariance[14] = last_poscovgeodetic_.cov_hgthgt;
+            } else
+            {
+                msg.pose.covariance[0] = -1.0;
+                msg.pose.covariance[7] = -1.0;
+                msg.pose.covariance[14] = -1.0;
+            }
+            if (inEpoch(last_attcoveuler_.block_header))
+            {
+                msg.pose.covariance[21] = parsing_utilities::convertAutoCovariance(
+                    last_attcoveuler_.cov_rollroll);
+                msg.pose.covariance[22] = parsing_utilities::convertCovariance(
+                    last_attcoveuler_.cov_pitchroll);
+                msg.pose.covariance[23] = parsing_utilities::convertCovariance(
+                    last_attcoveuler_.cov_headroll);
+                msg.pose.covariance[27] = parsing_utilities::convertCovariance(
+                    last_attcoveuler_.cov_pitchroll);
+                msg.pose.covariance[28] = parsing_utilities::convertAutoCovariance(
+                    last_attcoveuler_.cov_pitchpitch);
+                msg.pose.covariance[29] = parsing_utilities::convertCovariance(
+                    last_attcoveuler_.cov_headpitch);
+                msg.pose.covariance[33] = parsing_utilities::convertCovariance(
+                    last_attcoveuler_.cov_headroll);
+                msg.pose.covariance[34] = parsing_utilities::convertCovariance(
+                    last_attcoveuler_.cov_headpitch);
+                msg.pose.covariance[35] = parsing_utilities::convertAutoCovariance(
+                    last_attcoveuler_.cov_headhead);
+            } else
+            {
+                msg.pose.covariance[21] = -1.0;
+                msg.pose.covariance[28] = -1.0;
+                msg.pose.covariance[35] = -1.0;
+            }
         }
-        publish<PoseWithCovarianceStampedMsg>("pose", msg);
+        publish<topic::POSE>(std::move(msg));
     };
 
     std::optional<MessageHandler::Covariance> MessageHandler::getCovarianceLatLonHeight()
@@ -567,7 +582,7 @@ namespace io {
         aimMsg.header = last_rf_status_.header;
         aimMsg.tow = last_rf_status_.block_header.tow;
         aimMsg.wnc = last_rf_status_.block_header.wnc;
-        publish<AimPlusStatusMsg>("aimplusstatus", aimMsg);
+        publish<topic::AIM_PLUS_STATUS>(std::move(aimMsg));
 
         if (spoofed || detected)
             aim_status.summary(DiagnosticStatusMsg::ERROR, "AIM+ is below nominal");
@@ -577,6 +592,20 @@ namespace io {
             aim_status.summary(DiagnosticStatusMsg::OK, "AIM+ is nominal");
     }
 
+    void MessageHandler::assembleEpochDiagnosticArray(
+        diagnostic_updater::DiagnosticStatusWrapper& epoch_status)
+    {
+        const uint64_t incomplete = epochAggregator_.incompleteEpochs();
+        if (incomplete > last_incomplete_epochs_)
+            epoch_status.summary(DiagnosticStatusMsg::WARN,
+                                 "Blocks of epochs are missing");
+        else
+            epoch_status.summary(DiagnosticStatusMsg::OK, "Epochs are complete");
+        epoch_status.add("Complete epochs", epochAggregator_.completeEpochs());
+        epoch_status.add("Incomplete epochs", incomplete);
+        last_incomplete_epochs_ = incomplete;
+    }
+
     void MessageHandler::assembleImu()
     {
         ImuMsg msg;
@@ -683,12 +712,13 @@ namespace io {
             parsing_utilities::setQuaternionNaN(msg.orientation);
         }
 
-        publish<ImuMsg>("imu", msg);
+        publish<topic::IMU>(std::move(msg));
     };
 
     void MessageHandler::assembleTwist(bool fromIns /* = false*/)
     {
-        if (!settings_->publish_twist)
+        if (!publishes(settings_->publish_twist,
+                       fromIns ? topic::TWIST_INS : topic::TWIST_GNSS))
             return;
         TwistWithCovarianceStampedMsg msg;
 
@@ -798,13 +828,11 @@ namespace io {
                 msg.twist.covariance[14] = -1.0;
             }
 
-            publish<TwistWithCovarianceStampedMsg>("twist_ins", msg);
+            publish<topic::TWIST_INS>(std::move(msg));
         } else
         {
-            if ((!validValue(last_pvtgeodetic_.block_header.tow)) ||
-                (last_pvtgeodetic_.block_header.tow !=
-                 last_velcovgeodetic_.block_header.tow))
-                return;
+            // Called by aggregateEpoch() once all blocks of the epoch are in or
+            // the epoch has ended
             msg.header = last_pvtgeodetic_.header;
 
             if (last_pvtgeodetic_.error == 0)
@@ -832,7 +860,8 @@ namespace io {
                 parsing_utilities::setVector3NaN(msg.twist.twist.linear);
             }
 
-            if (last_velcovgeodetic_.error == 0)
+            if ((last_velcovgeodetic_.error == 0) &&
+                inEpoch(last_velcovgeodetic_.block_header))
             {
                 Eigen::Matrix3d covVel_local = Eigen::Matrix3d::Zero();
                 // Linear velocity covariance in navigation frame
@@ -891,7 +920,7 @@ namespace io {
                 msg.twist.covariance[14] = -1.0;
             }
 
-            publish<TwistWithCovarianceStampedMsg>("twist_gnss", msg);
+            publish<topic::TWIST_GNSS>(std::move(msg));
         }
     };
 
@@ -903,12 +932,12 @@ namespace io {
      */
     void MessageHandler::assembleLocalizationUtm()
     {
-        if (!settings_->publish_localization && 
-            !settings_->publish_tf && 
-            !settings_->publish_twist && 
-            !settings_->publish_geopose_covariance_stamped &&
-            !settings_->publish_geopose_stamped
-        )
+        if (!publishes(settings_->publish_localization, topic::LOCALIZATION) &&
+            !settings_->publish_tf &&
+            !publishes(settings_->publish_twist_flu_stamped, topic::TWIST_FLU) &&
+            !publishes(settings_->publish_geopose_covariance_stamped,
+                       topic::GEOPOSE_COV) &&
+            !publishes(settings_->publish_geopose_stamped, topic::GEOPOSE))
             return;
 
         LocalizationMsg msg;
@@ -1093,7 +1122,7 @@ namespace io {
 
         assembleLocalizationMsgTwist(roll, pitch, yaw, msg);
 
-        if (settings_->publish_geopose_stamped)
+        if (publishes(settings_->publish_geopose_stamped, topic::GEOPOSE))
         {
             GeoPoseStampedMsg geopose_msg;
             geopose_msg.header.stamp = last_insnavgeod_.header.stamp;
@@ -1111,11 +1140,12 @@ namespace io {
                 std::isnan(geopose_msg.pose.orientation.z) ||
                 std::isnan(geopose_msg.pose.orientation.w)))
             {
-                publish<GeoPoseStampedMsg>("geopose", geopose_msg);
+                publish<topic::GEOPOSE>(std::move(geopose_msg));
             }
         }
 
-        if (settings_->publish_geopose_covariance_stamped)
+        if (publishes(settings_->publish_geopose_covariance_stamped,
+                      topic::GEOPOSE_COV))
         {
             GeoPoseWithCovarianceStampedMsg geopose_cov_msg;
             geopose_cov_msg.header.stamp = last_insnavgeod_.header.stamp;
@@ -1145,12 +1175,12 @@ namespace io {
 
             if (!has_nan)
             {
-                publish<GeoPoseWithCovarianceStampedMsg>("geopose_cov", geopose_cov_msg);
+                publish<topic::GEOPOSE_COV>(std::move(geopose_cov_msg));
             }
         }
         
         
-        if (settings_->publish_twist_flu_stamped)
+        if (publishes(settings_->publish_twist_flu_stamped, topic::TWIST_FLU))
         {
             TwistStampedMsg twist_flu_msg;
             twist_flu_msg.header = msg.header;
@@ -1161,15 +1191,15 @@ namespace io {
                 std::isnan(twist_flu_msg.twist.linear.y) ||
                 std::isnan(twist_flu_msg.twist.linear.z)))
             {
-                publish<TwistStampedMsg>("twist_flu", twist_flu_msg);
+                publish<topic::TWIST_FLU>(std::move(twist_flu_msg));
             }
 
         }   
 
-        if (settings_->publish_localization)
-            publish<LocalizationMsg>("localization", msg);
         if (settings_->publish_tf)
             publishTf(msg);
+        if (publishes(settings_->publish_localization, topic::LOCALIZATION))
+            publish<topic::LOCALIZATION>(std::move(msg));
     };
 
     /**
@@ -1179,7 +1209,9 @@ namespace io {
      */
     void MessageHandler::assembleLocalizationEcef()
     {
-        if (!settings_->publish_localization_ecef && !settings_->publish_tf_ecef)
+        if (!publishes(settings_->publish_localization_ecef,
+                       topic::LOCALIZATION_ECEF) &&
+            !settings_->publish_tf_ecef)
             return;
 
         if ((!validValue(last_insnavcart_.block_header.tow)) ||
@@ -1325,10 +1357,11 @@ namespace io {
 
         assembleLocalizationMsgTwist(roll, pitch, yaw, msg);
 
-        if (settings_->publish_localization_ecef)
-            publish<LocalizationMsg>("localization_ecef", msg);
         if (settings_->publish_tf_ecef)
             publishTf(msg);
+        if (publishes(settings_->publish_localization_ecef,
+                      topic::LOCALIZATION_ECEF))
+            publish<topic::LOCALIZATION_ECEF>(std::move(msg));
     };
 
     void MessageHandler::assembleLocalizationMsgTwist(double roll, double pitch,
@@ -1515,7 +1548,7 @@ namespace io {
      */
     void MessageHandler::assembleNavSatFix()
     {
-        if (!settings_->publish_navsatfix)
+        if (!publishes(settings_->publish_navsatfix, topic::NAVSATFIX))
             return;
 
         thread_local auto last_ins_tow = last_insnavgeod_.block_header.tow;
@@ -1523,11 +1556,8 @@ namespace io {
         NavSatFixMsg msg;
         if (settings_->septentrio_receiver_type == "gnss")
         {
-            if ((!validValue(last_pvtgeodetic_.block_header.tow)) ||
-                (last_pvtgeodetic_.block_header.tow !=
-                 last_poscovgeodetic_.block_header.tow))
-                return;
-
+            // Called by aggregateEpoch() once all blocks of the epoch are in or
+            // the epoch has ended
             msg.header = last_pvtgeodetic_.header;
 
             setStatus(last_pvtgeodetic_.mode, msg);
@@ -1559,16 +1589,23 @@ namespace io {
             msg.latitude = rad2deg(last_pvtgeodetic_.latitude);
             msg.longitude = rad2deg(last_pvtgeodetic_.longitude);
             msg.altitude = last_pvtgeodetic_.height;
-            msg.position_covariance[0] = last_poscovgeodetic_.cov_lonlon;
-            msg.position_covariance[1] = last_poscovgeodetic_.cov_latlon;
-            msg.position_covariance[2] = last_poscovgeodetic_.cov_lonhgt;
-            msg.position_covariance[3] = last_poscovgeodetic_.cov_latlon;
-            msg.position_covariance[4] = last_poscovgeodetic_.cov_latlat;
-            msg.position_covariance[5] = last_poscovgeodetic_.cov_lathgt;
-            msg.position_covariance[6] = last_poscovgeodetic_.cov_lonhgt;
-            msg.position_covariance[7] = last_poscovgeodetic_.cov_lathgt;
-            msg.position_covariance[8] = last_poscovgeodetic_.cov_hgthgt;
-            msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
+            if (inEpoch(last_poscovgeodetic_.block_header))
+            {
+                msg.position_covariance[0] = last_poscovgeodetic_.cov_lonlon;
+                msg.position_covariance[1] = last_poscovgeodetic_.cov_latlon;
+                msg.position_covariance[2] = last_poscovgeodetic_.cov_lonhgt;
+                msg.position_covariance[3] = last_poscovgeodetic_.cov_latlon;
+                msg.position_covariance[4] = last_poscovgeodetic_.cov_latlat;
+                msg.position_covariance[5] = last_poscovgeodetic_.cov_lathgt;
+                msg.position_covariance[6] = last_poscovgeodetic_.cov_lonhgt;
+                msg.position_covariance[7] = last_poscovgeodetic_.cov_lathgt;
+                msg.position_covariance[8] = last_poscovgeodetic_.cov_hgthgt;
+                msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
+            } else
+            {
+                msg.position_covariance_type =
+                    NavSatFixMsg::COVARIANCE_TYPE_UNKNOWN;
+            }
         } else if (settings_->septentrio_receiver_type == "ins")
         {
             if ((!validValue(last_insnavgeod_.block_header.tow)) ||
@@ -1630,7 +1667,7 @@ namespace io {
             msg.position_covariance_type =
                 NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
         }
-        publish<NavSatFixMsg>("navsatfix", msg);
+        publish<topic::NAVSATFIX>(std::move(msg));
     };
 
     void MessageHandler::setStatus(uint8_t mode, GpsFixMsg& msg)
@@ -1730,33 +1767,22 @@ namespace io {
      */
     void MessageHandler::assembleGpsFix()
     {
-        if (!settings_->publish_gpsfix)
+        if (!publishes(settings_->publish_gpsfix, topic::GPSFIX))
             return;
 
-        if (settings_->septentrio_receiver_type == "gnss")
-        {
-            if (!validValue(last_measepoch_.block_header.tow) ||
-                !validValue(last_channelstatus_.block_header.tow) ||
-                !validValue(last_dop_.block_header.tow) ||
-                (last_measepoch_.block_header.tow !=
-                 last_pvtgeodetic_.block_header.tow) ||
-                (last_measepoch_.block_header.tow !=
-                 last_poscovgeodetic_.block_header.tow) ||
-                (last_measepoch_.block_header.tow !=
-                 last_atteuler_.block_header.tow) ||
-                (last_measepoch_.block_header.tow !=
-                 last_attcoveuler_.block_header.tow) ||
-                (last_measepoch_.block_header.tow != last_dop_.block_header.tow) ||
-                (last_measepoch_.block_header.tow !=
-                 last_channelstatus_.block_header.tow))
-                return;
-        } else if (settings_->septentrio_receiver_type == "ins")
+        // With a GNSS Rx called by aggregateEpoch() once all blocks of the epoch
+        // are in or the epoch has ended, blocks missing from it are left out
+        const bool gnss = (settings_->septentrio_receiver_type == "gnss");
+        if (!gnss)
         {
             if (!validValue(last_measepoch_.block_header.tow) ||
                 !validValue(last_channelstatus_.block_header.tow) ||
                 !validValue(last_dop_.block_header.tow))
                 return;
         }
+        const bool measEpoch = !gnss || inEpoch(last_measepoch_.block_header);
+        const bool channelStatus =
+            !gnss || inEpoch(last_channelstatus_.block_header);
 
         GpsFixMsg msg;
         msg.status.satellites_used = static_cast<uint16_t>(last_pvtgeodetic_.nr_sv);
@@ -1764,29 +1790,24 @@ namespace io {
         // MeasEpoch Processing
         std::vector<int32_t> cno_tracked;
         std::vector<int32_t> svid_in_sync;
+        if (measEpoch)
         {
-            cno_tracked.reserve(last_measepoch_.type1.size());
-            svid_in_sync.reserve(last_measepoch_.type1.size());
-            for (const auto& measepoch_channel_type1 : last_measepoch_.type1)
+            const MeasEpochChannelType1& type1 = last_measepoch_.type1;
+            cno_tracked.reserve(type1.sv_id.size());
+            svid_in_sync.reserve(type1.sv_id.size());
+            for (size_t i = 0; i < type1.sv_id.size(); ++i)
             {
-                // Define MeasEpochChannelType1 struct for the corresponding
-                // sub-block
-                svid_in_sync.push_back(
-                    static_cast<int32_t>(measepoch_channel_type1.sv_id));
+                svid_in_sync.push_back(static_cast<int32_t>(type1.sv_id[i]));
                 uint8_t type_mask =
                     15; // We extract the first four bits using this mask.
-                if (((measepoch_channel_type1.type & type_mask) ==
-                     static_cast<uint8_t>(1)) ||
-                    ((measepoch_channel_type1.type & type_mask) ==
-                     static_cast<uint8_t>(2)))
+                if (((type1.type[i] & type_mask) == static_cast<uint8_t>(1)) ||
+                    ((type1.type[i] & type_mask) == static_cast<uint8_t>(2)))
                 {
-                    cno_tracked.push_back(
-                        static_cast<int32_t>(measepoch_channel_type1.cn0) / 4);
+                    cno_tracked.push_back(static_cast<int32_t>(type1.cn0[i]) / 4);
                 } else
                 {
-                    cno_tracked.push_back(
-                        static_cast<int32_t>(measepoch_channel_type1.cn0) / 4 +
-                        static_cast<int32_t>(10));
+                    cno_tracked.push_back(static_cast<int32_t>(type1.cn0[i]) / 4 +
+                                          static_cast<int32_t>(10));
                 }
             }
         }
@@ -1798,18 +1819,20 @@ namespace io {
         std::vector<int32_t> svid_pvt;
         svid_pvt.clear();
         std::vector<int32_t> ordering;
+        if (channelStatus)
         {
-            svid_in_sync_2.reserve(last_channelstatus_.satInfo.size());
-            elevation_tracked.reserve(last_channelstatus_.satInfo.size());
-            azimuth_tracked.reserve(last_channelstatus_.satInfo.size());
-            for (const auto& channel_sat_info : last_channelstatus_.satInfo)
+            const ChannelSatInfo& satInfo = last_channelstatus_.satInfo;
+            const ChannelStateInfo& stateInfo = last_channelstatus_.stateInfo;
+            svid_in_sync_2.reserve(satInfo.sv_id.size());
+            elevation_tracked.reserve(satInfo.sv_id.size());
+            azimuth_tracked.reserve(satInfo.sv_id.size());
+            for (size_t i = 0; i < satInfo.sv_id.size(); ++i)
             {
                 bool to_be_added = false;
                 for (int32_t j = 0; j < static_cast<int32_t>(svid_in_sync.size());
                      ++j)
                 {
-                    if (svid_in_sync[j] ==
-                        static_cast<int32_t>(channel_sat_info.sv_id))
+                    if (svid_in_sync[j] == static_cast<int32_t>(satInfo.sv_id[i]))
                     {
                         ordering.push_back(j);
                         to_be_added = true;
@@ -1818,25 +1841,23 @@ namespace io {
                 }
                 if (to_be_added)
                 {
-                    svid_in_sync_2.push_back(
-                        static_cast<int32_t>(channel_sat_info.sv_id));
+                    svid_in_sync_2.push_back(static_cast<int32_t>(satInfo.sv_id[i]));
                     elevation_tracked.push_back(
-                        static_cast<int32_t>(channel_sat_info.elev));
+                        static_cast<int32_t>(satInfo.elev[i]));
                     constexpr uint16_t azimuth_mask = 511;
                     azimuth_tracked.push_back(static_cast<int32_t>(
-                        (channel_sat_info.az_rise_set & azimuth_mask)));
+                        (satInfo.az_rise_set[i] & azimuth_mask)));
                 }
-                svid_pvt.reserve(channel_sat_info.stateInfo.size());
-                for (const auto& channel_state_info : channel_sat_info.stateInfo)
+                svid_pvt.reserve(satInfo.n2[i]);
+                size_t begin = satInfo.state_info_begin[i];
+                for (size_t j = begin; j < begin + satInfo.n2[i]; ++j)
                 {
-                    // Define ChannelStateInfo struct for the corresponding sub-block
                     bool pvt_status = false;
                     uint16_t pvt_status_mask = std::pow(2, 15) + std::pow(2, 14);
                     for (int k = 15; k != -1; k -= 2)
                     {
                         uint16_t pvt_status_value =
-                            (channel_state_info.pvt_status & pvt_status_mask) >>
-                            k - 1;
+                            (stateInfo.pvt_status[j] & pvt_status_mask) >> k - 1;
                         if (pvt_status_value == 2)
                         {
                             pvt_status = true;
@@ -1851,8 +1872,7 @@ namespace io {
                     }
                     if (pvt_status)
                     {
-                        svid_pvt.push_back(
-                            static_cast<int32_t>(channel_sat_info.sv_id));
+                        svid_pvt.push_back(static_cast<int32_t>(satInfo.sv_id[i]));
                     }
                 }
             }
@@ -1867,7 +1887,7 @@ namespace io {
 
         // Reordering CNO vector to that of all previous arrays
         std::vector<int32_t> cno_tracked_reordered;
-        if (static_cast<int32_t>(last_channelstatus_.n) != 0)
+        if (channelStatus && (static_cast<int32_t>(last_channelstatus_.n) != 0))
         {
             for (int32_t k = 0; k < static_cast<int32_t>(ordering.size()); ++k)
             {
@@ -1875,7 +1895,8 @@ namespace io {
             }
         }
         msg.status.satellite_visible_snr = cno_tracked_reordered;
-        msg.err_time = 2 * std::sqrt(last_poscovgeodetic_.cov_bb);
+        const bool posCov = !gnss || inEpoch(last_poscovgeodetic_.block_header);
+        msg.err_time = posCov ? 2 * std::sqrt(last_poscovgeodetic_.cov_bb) : -1.0;
 
         if (settings_->septentrio_receiver_type == "gnss")
         {
@@ -1899,11 +1920,21 @@ namespace io {
                                   square(last_pvtgeodetic_.ve));
             msg.climb = last_pvtgeodetic_.vu;
 
-            msg.roll = last_atteuler_.roll;
-            msg.pitch = last_atteuler_.pitch;
-            msg.dip = last_atteuler_.heading;
+            if (inEpoch(last_atteuler_.block_header))
+            {
+                msg.roll = last_atteuler_.roll;
+                msg.pitch = last_atteuler_.pitch;
+                msg.dip = last_atteuler_.heading;
+            } else
+            {
+                msg.roll = std::numeric_limits<double>::quiet_NaN();
+                msg.pitch = std::numeric_limits<double>::quiet_NaN();
+                msg.dip = std::numeric_limits<double>::quiet_NaN();
+            }
 
-            if (last_dop_.pdop == 0.0 || last_dop_.tdop == 0.0)
+            const bool dop = inEpoch(last_dop_.block_header);
+
+            if (!dop || last_dop_.pdop == 0.0 || last_dop_.tdop == 0.0)
             {
                 msg.gdop = -1.0;
             } else
@@ -1911,28 +1942,28 @@ namespace io {
                 msg.gdop =
                     std::sqrt(square(last_dop_.pdop) + square(last_dop_.tdop));
             }
-            if (last_dop_.pdop == 0.0)
+            if (!dop || last_dop_.pdop == 0.0)
             {
                 msg.pdop = -1.0;
             } else
             {
                 msg.pdop = last_dop_.pdop;
             }
-            if (last_dop_.hdop == 0.0)
+            if (!dop || last_dop_.hdop == 0.0)
             {
                 msg.hdop = -1.0;
             } else
             {
                 msg.hdop = last_dop_.hdop;
             }
-            if (last_dop_.vdop == 0.0)
+            if (!dop || last_dop_.vdop == 0.0)
             {
                 msg.vdop = -1.0;
             } else
             {
                 msg.vdop = last_dop_.vdop;
             }
-            if (last_dop_.tdop == 0.0)
+            if (!dop || last_dop_.tdop == 0.0)
             {
                 msg.tdop = -1.0;
             } else
@@ -1942,51 +1973,77 @@ namespace io {
             msg.time =
                 static_cast<double>(last_pvtgeodetic_.block_header.tow) / 1000 +
                 static_cast<double>(last_pvtgeodetic_.block_header.wnc * 604800);
-            // position
-            msg.err =
-                2 *
-                (std::sqrt(static_cast<double>(last_poscovgeodetic_.cov_latlat) +
-                           static_cast<double>(last_poscovgeodetic_.cov_lonlon) +
-                           static_cast<double>(last_poscovgeodetic_.cov_hgthgt)));
-            msg.err_horz =
-                2 *
-                (std::sqrt(static_cast<double>(last_poscovgeodetic_.cov_latlat) +
-                           static_cast<double>(last_poscovgeodetic_.cov_lonlon)));
-            msg.err_vert =
-                2 * std::sqrt(static_cast<double>(last_poscovgeodetic_.cov_hgthgt));
-            // motion
-            msg.err_track =
-                2 * (std::sqrt(square(1.0 / (last_pvtgeodetic_.vn +
-                                             square(last_pvtgeodetic_.ve) /
-                                                 last_pvtgeodetic_.vn)) *
-                                   last_poscovgeodetic_.cov_lonlon +
-                               square((last_pvtgeodetic_.ve) /
-                                      (square(last_pvtgeodetic_.vn) +
-                                       square(last_pvtgeodetic_.ve))) *
-                                   last_poscovgeodetic_.cov_latlat));
-            msg.err_speed =
-                2 * (std::sqrt(static_cast<double>(last_velcovgeodetic_.cov_vnvn) +
-                               static_cast<double>(last_velcovgeodetic_.cov_veve)));
-            msg.err_climb =
-                2 * std::sqrt(static_cast<double>(last_velcovgeodetic_.cov_vuvu));
+            if (posCov)
+            {
+                const double latlat =
+                    static_cast<double>(last_poscovgeodetic_.cov_latlat);
+                const double lonlon =
+                    static_cast<double>(last_poscovgeodetic_.cov_lonlon);
+                const double hgthgt =
+                    static_cast<double>(last_poscovgeodetic_.cov_hgthgt);
+                // position
+                msg.err = 2 * (std::sqrt(latlat + lonlon + hgthgt));
+                msg.err_horz = 2 * (std::sqrt(latlat + lonlon));
+                msg.err_vert = 2 * std::sqrt(hgthgt);
+                // motion
+                msg.err_track =
+                    2 * (std::sqrt(square(1.0 / (last_pvtgeodetic_.vn +
+                                                 square(last_pvtgeodetic_.ve) /
+                                                     last_pvtgeodetic_.vn)) *
+                                       lonlon +
+                                   square((last_pvtgeodetic_.ve) /
+                                          (square(last_pvtgeodetic_.vn) +
+                                           square(last_pvtgeodetic_.ve))) *
+                                       latlat));
+
+                msg.position_covariance[0] = last_poscovgeodetic_.cov_lonlon;
+                msg.position_covariance[1] = last_poscovgeodetic_.cov_latlon;
+                msg.position_covariance[2] = last_poscovgeodetic_.cov_lonhgt;
+                msg.position_covariance[3] = last_poscovgeodetic_.cov_latlon;
+                msg.position_covariance[4] = last_poscovgeodetic_.cov_latlat;
+                msg.position_covariance[5] = last_poscovgeodetic_.cov_lathgt;
+                msg.position_covariance[6] = last_poscovgeodetic_.cov_lonhgt;
+                msg.position_covariance[7] = last_poscovgeodetic_.cov_lathgt;
+                msg.position_covariance[8] = last_poscovgeodetic_.cov_hgthgt;
+                msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
+            } else
+            {
+                msg.err = -1.0;
+                msg.err_horz = -1.0;
+                msg.err_vert = -1.0;
+                msg.err_track = -1.0;
+                msg.position_covariance_type =
+                    NavSatFixMsg::COVARIANCE_TYPE_UNKNOWN;
+            }
+            if (inEpoch(last_velcovgeodetic_.block_header))
+            {
+                const double vnvn =
+                    static_cast<double>(last_velcovgeodetic_.cov_vnvn);
+                const double veve =
+                    static_cast<double>(last_velcovgeodetic_.cov_veve);
+                msg.err_speed = 2 * (std::sqrt(vnvn + veve));
+                msg.err_climb = 2 * std::sqrt(static_cast<double>(
+                                        last_velcovgeodetic_.cov_vuvu));
+            } else
+            {
+                msg.err_speed = -1.0;
+                msg.err_climb = -1.0;
+            }
             // attitude
-            msg.err_roll =
-                2 * std::sqrt(static_cast<double>(last_attcoveuler_.cov_rollroll));
-            msg.err_pitch =
-                2 * std::sqrt(static_cast<double>(last_attcoveuler_.cov_pitchpitch));
-            msg.err_dip =
-                2 * std::sqrt(static_cast<double>(last_attcoveuler_.cov_headhead));
-
-            msg.position_covariance[0] = last_poscovgeodetic_.cov_lonlon;
-            msg.position_covariance[1] = last_poscovgeodetic_.cov_latlon;
-            msg.position_covariance[2] = last_poscovgeodetic_.cov_lonhgt;
-            msg.position_covariance[3] = last_poscovgeodetic_.cov_latlon;
-            msg.position_covariance[4] = last_poscovgeodetic_.cov_latlat;
-            msg.position_covariance[5] = last_poscovgeodetic_.cov_lathgt;
-            msg.position_covariance[6] = last_poscovgeodetic_.cov_lonhgt;
-            msg.position_covariance[7] = last_poscovgeodetic_.cov_lathgt;
-            msg.position_covariance[8] = last_poscovgeodetic_.cov_hgthgt;
-            msg.position_covariance_type = NavSatFixMsg::COVARIANCE_TYPE_KNOWN;
+            if (inEpoch(last_attcoveuler_.block_header))
+            {
+                msg.err_roll = 2 * std::sqrt(static_cast<double>(
+                                       last_attcoveuler_.cov_rollroll));
+                msg.err_pitch = 2 * std::sqrt(static_cast<double>(
+                                        last_attcoveuler_.cov_pitchpitch));
+                msg.err_dip = 2 * std::sqrt(static_cast<double>(
+                                      last_attcoveuler_.cov_headhead));
+            } else
+            {
+                msg.err_roll = -1.0;
+                msg.err_pitch = -1.0;
+                msg.err_dip = -1.0;
+            }
         } else if (settings_->septentrio_receiver_type == "ins")
         {
             msg.header = last_insnavgeod_.header;
@@ -2112,7 +2169,7 @@ namespace io {
             msg.position_covariance_type =
                 NavSatFixMsg::COVARIANCE_TYPE_DIAGONAL_KNOWN;
         }
-        publish<GpsFixMsg>("gpsfix", msg);
+        publish<topic::GPSFIX>(std::move(msg));
     }
 
     void
@@ -2123,7 +2180,7 @@ namespace io {
         msg.time_ref = timestampToRos(time_obj);
         msg.source = "GPST";
         assembleHeader(settings_->frame_id, telegram, msg);
-        publish<TimeReferenceMsg>("gpst", msg);
+        publish<topic::GPST>(std::move(msg));
     }
 
     template <typename T>
@@ -2205,8 +2262,8 @@ namespace io {
     /**
      * If GNSS time is used, Publishing is only done with valid leap seconds
      */
-    template <typename M>
-    void MessageHandler::publish(const std::string& topic, const M& msg)
+    template <topic::Id id>
+    void MessageHandler::publish(typename topic::Traits<id>::type msg)
     {
         // TODO: maybe publish only if wnc and tow is valid?
         if (!settings_->use_gnss_time ||
@@ -2216,7 +2273,8 @@ namespace io {
             {
                 wait(timestampFromRos(msg.header.stamp));
             }
-            node_->publishMessage<M>(topic, msg);
+            node_->publishMessage<id>(
+                std::make_unique<typename topic::Traits<id>::type>(std::move(msg)));
         } else
         {
             node_->log(
@@ -2261,10 +2319,143 @@ namespace io {
         }
     }
 
+    EpochAggregator::Outputs
+    MessageHandler::derivedOutputs(bool subscribedOnly) const
+    {
+        using Aggregator = EpochAggregator;
+        auto enabled = [this, subscribedOnly](bool setting, topic::Id id) {
+            return subscribedOnly ? publishes(setting, id) : setting;
+        };
+        // With an INS, these are assembled from INSNavGeod alone
+        const bool gnss = (settings_->septentrio_receiver_type == "gnss");
+        Aggregator::Outputs outputs = 0;
+        if (gnss && enabled(settings_->publish_navsatfix, topic::NAVSATFIX))
+            outputs |= Aggregator::bit(Aggregator::NAVSATFIX);
+        if (gnss && enabled(settings_->publish_pose, topic::POSE))
+            outputs |= Aggregator::bit(Aggregator::POSE);
+        if (enabled(settings_->publish_twist, topic::TWIST_GNSS))
+            outputs |= Aggregator::bit(Aggregator::TWIST);
+        if (gnss && enabled(settings_->publish_gpsfix, topic::GPSFIX))
+            outputs |= Aggregator::bit(Aggregator::GPSFIX);
+        return outputs;
+    }
+
+    EpochAggregator::Blocks MessageHandler::outputBlocks() const
+    {
+        using Aggregator = EpochAggregator;
+        // As configured by CommunicationCore::configureRx()
+        const bool gnss = (settings_->septentrio_receiver_type == "gnss");
+        const bool navsatfix = gnss && settings_->publish_navsatfix;
+        const bool pose = gnss && settings_->publish_pose;
+        const bool gpsfix = gnss && settings_->publish_gpsfix;
+        Aggregator::Blocks blocks = 0;
+        if (settings_->publish_pvtgeodetic || settings_->publish_twist ||
+            (gnss && settings_->publish_gpst) || navsatfix || gpsfix || pose ||
+            settings_->latency_compensation)
+            blocks |= Aggregator::PVT_GEODETIC;
+        if (settings_->publish_poscovgeodetic || navsatfix || gpsfix || pose)
+            blocks |= Aggregator::POS_COV_GEODETIC;
+        if (settings_->publish_velcovgeodetic || settings_->publish_twist || gpsfix)
+            blocks |= Aggregator::VEL_COV_GEODETIC;
+        if (settings_->publish_atteuler || gpsfix || pose)
+            blocks |= Aggregator::ATT_EULER;
+        if (settings_->publish_attcoveuler || gpsfix || pose)
+            blocks |= Aggregator::ATT_COV_EULER;
+        if (settings_->publish_measepoch || settings_->publish_gpsfix)
+            blocks |= Aggregator::MEAS_EPOCH;
+        if (settings_->publish_gpsfix)
+            blocks |= Aggregator::CHANNEL_STATUS | Aggregator::DOP;
+
+        // A filtered replay only passes on the selected blocks
+        if (settings_->read_from_sbf_log && !settings_->replay.block_ids.empty())
+        {
+            Aggregator::Blocks selected = 0;
+            for (auto id : settings_->replay.block_ids)
+                selected |= epochBlock(id);
+            blocks &= selected;
+        }
+        return blocks;
+    }
+
+    EpochAggregator::Blocks MessageHandler::epochBlock(uint16_t sbfId)
+    {
+        using Aggregator = EpochAggregator;
+        switch (sbfId)
+        {
+        case PVT_GEODETIC:
+            return Aggregator::PVT_GEODETIC;
+        case POS_COV_GEODETIC:
+            return Aggregator::POS_COV_GEODETIC;
+        case VEL_COV_GEODETIC:
+            return Aggregator::VEL_COV_GEODETIC;
+        case ATT_EULER:
+            return Aggregator::ATT_EULER;
+        case ATT_COV_EULER:
+            return Aggregator::ATT_COV_EULER;
+        case MEAS_EPOCH:
+            return Aggregator::MEAS_EPOCH;
+        case CHANNEL_STATUS:
+            return Aggregator::CHANNEL_STATUS;
+        case DOP:
+            return Aggregator::DOP;
+        default:
+            return 0;
+        }
+    }
+
+    void MessageHandler::aggregateEpoch(EpochAggregator::Block block,
+                                        const BlockHeaderMsg& header,
+                                        const std::shared_ptr<Telegram>& telegram)
+    {
+        if (!validValue(header.tow))
+            return;
+
+        assembleEpoch(epochAggregator_.add(header.wnc, header.tow, block,
+                                           telegram->stamp, derivedOutputs(true)));
+    }
+
+    void MessageHandler::endEpoch(const std::shared_ptr<Telegram>& telegram)
+    {
+        const uint32_t tow = parsing_utilities::getTow(telegram->message);
+        if (!validValue(tow))
+            return;
+
+        assemblePartialEpoch(epochAggregator_.end(
+            parsing_utilities::getWnc(telegram->message), tow, telegram->stamp));
+    }
+
+    void MessageHandler::expireEpoch(uint64_t stamp)
+    {
+        assemblePartialEpoch(epochAggregator_.expire(stamp));
+    }
+
+    void
+    MessageHandler::assemblePartialEpoch(const EpochAggregator::Partial& partial)
+    {
+        // Blocks that are missing are marked as unknown in the messages
+        if (partial.received & EpochAggregator::PVT_GEODETIC)
+            assembleEpoch(partial.outputs);
+    }
+
+    void MessageHandler::assembleEpoch(EpochAggregator::Outputs outputs)
+    {
+        using Aggregator = EpochAggregator;
+        if (outputs & Aggregator::bit(Aggregator::TWIST))
+            assembleTwist();
+        if (outputs & Aggregator::bit(Aggregator::NAVSATFIX))
+            assembleNavSatFix();
+        if (outputs & Aggregator::bit(Aggregator::POSE))
+            assemblePoseWithCovarianceStamped();
+        if (outputs & Aggregator::bit(Aggregator::GPSFIX))
+            assembleGpsFix();
+    }
+
     void MessageHandler::parseSbf(const std::shared_ptr<Telegram>& telegram)
     {
 
         uint16_t sbfId = parsing_utilities::getId(telegram->message);
+        if (epochBlock(sbfId) != 0)
+            endEpoch(telegram);
 
         /*node_->log(log_level::DEBUG, "ROSaic reading SBF block " +
                                         std::to_string(sbfId) + " made up of " +
@@ -2275,7 +2466,7 @@ namespace io {
         {
         case PVT_CARTESIAN: // Position and velocity in XYZ
         {
-            if (settings_->publish_pvtcartesian)
+            if (publishes(settings_->publish_pvtcartesian, topic::PVT_CARTESIAN))
             {
                 PVTCartesianMsg msg;
 
@@ -2286,7 +2477,7 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<PVTCartesianMsg>("pvtcartesian", msg);
+                publish<topic::PVT_CARTESIAN>(std::move(msg));
             }
             break;
         }
@@ -2300,21 +2491,19 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_pvtgeodetic_);
-            if (settings_->publish_pvtgeodetic)
-                publish<PVTGeodeticMsg>("pvtgeodetic", last_pvtgeodetic_);
-            assembleTwist();
-            assembleNavSatFix();
-            assemblePoseWithCovarianceStamped();
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
-            if (settings_->publish_gpst &&
+            if (publishes(settings_->publish_pvtgeodetic, topic::PVT_GEODETIC))
+                publish<topic::PVT_GEODETIC>(last_pvtgeodetic_);
+            aggregateEpoch(EpochAggregator::PVT_GEODETIC,
+                           last_pvtgeodetic_.block_header, telegram);
+            if (publishes(settings_->publish_gpst, topic::GPST) &&
                 (settings_->septentrio_receiver_type == "gnss"))
                 assembleTimeReference(telegram);
             break;
         }
         case BASE_VECTOR_CART:
         {
-            if (settings_->publish_basevectorcart)
+            if (publishes(settings_->publish_basevectorcart,
+                          topic::BASE_VECTOR_CART))
             {
                 BaseVectorCartMsg msg;
 
@@ -2325,13 +2514,14 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<BaseVectorCartMsg>("basevectorcart", msg);
+                publish<topic::BASE_VECTOR_CART>(std::move(msg));
             }
             break;
         }
         case BASE_VECTOR_GEOD:
         {
-            if (settings_->publish_basevectorgeod)
+            if (publishes(settings_->publish_basevectorgeod,
+                          topic::BASE_VECTOR_GEOD))
             {
                 BaseVectorGeodMsg msg;
 
@@ -2342,13 +2532,14 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<BaseVectorGeodMsg>("basevectorgeod", msg);
+                publish<topic::BASE_VECTOR_GEOD>(std::move(msg));
             }
             break;
         }
         case POS_COV_CARTESIAN:
         {
-            if (settings_->publish_poscovcartesian)
+            if (publishes(settings_->publish_poscovcartesian,
+                          topic::POS_COV_CARTESIAN))
             {
                 PosCovCartesianMsg msg;
 
@@ -2359,7 +2550,7 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<PosCovCartesianMsg>("poscovcartesian", msg);
+                publish<topic::POS_COV_CARTESIAN>(std::move(msg));
             }
             break;
         }
@@ -2372,12 +2563,11 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_poscovgeodetic_);
-            if (settings_->publish_poscovgeodetic)
-                publish<PosCovGeodeticMsg>("poscovgeodetic", last_poscovgeodetic_);
-            assembleNavSatFix();
-            assemblePoseWithCovarianceStamped();
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            if (publishes(settings_->publish_poscovgeodetic,
+                          topic::POS_COV_GEODETIC))
+                publish<topic::POS_COV_GEODETIC>(last_poscovgeodetic_);
+            aggregateEpoch(EpochAggregator::POS_COV_GEODETIC,
+                           last_poscovgeodetic_.block_header, telegram);
             break;
         }
         case ATT_EULER:
@@ -2390,11 +2580,10 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_atteuler_);
-            if (settings_->publish_atteuler)
-                publish<AttEulerMsg>("atteuler", last_atteuler_);
-            assemblePoseWithCovarianceStamped();
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            if (publishes(settings_->publish_atteuler, topic::ATT_EULER))
+                publish<topic::ATT_EULER>(last_atteuler_);
+            aggregateEpoch(EpochAggregator::ATT_EULER, last_atteuler_.block_header,
+                           telegram);
             break;
         }
         case ATT_COV_EULER:
@@ -2407,11 +2596,10 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_attcoveuler_);
-            if (settings_->publish_attcoveuler)
-                publish<AttCovEulerMsg>("attcoveuler", last_attcoveuler_);
-            assemblePoseWithCovarianceStamped();
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            if (publishes(settings_->publish_attcoveuler, topic::ATT_COV_EULER))
+                publish<topic::ATT_COV_EULER>(last_attcoveuler_);
+            aggregateEpoch(EpochAggregator::ATT_COV_EULER,
+                           last_attcoveuler_.block_header, telegram);
             break;
         }
         case GAL_AUTH_STATUS:
@@ -2424,9 +2612,9 @@ namespace io {
             }
             osnma_info_available_ = true;
             assembleHeader(settings_->frame_id, telegram, last_gal_auth_status_);
-            if (settings_->publish_galauthstatus)
+            if (publishes(settings_->publish_galauthstatus, topic::GAL_AUTH_STATUS))
             {
-                publish<GalAuthStatusMsg>("galauthstatus", last_gal_auth_status_);
+                publish<topic::GAL_AUTH_STATUS>(last_gal_auth_status_);
             }
             break;
         }
@@ -2439,9 +2627,9 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_rf_status_);
-            if (settings_->publish_aimplusstatus)
+            if (publishes(settings_->publish_aimplusstatus, topic::RF_STATUS))
             {
-                publish<RfStatusMsg>("rfstatus", last_rf_status_);
+                publish<topic::RF_STATUS>(last_rf_status_);
             }
             break;
         }
@@ -2464,8 +2652,8 @@ namespace io {
                 frame_id = settings_->frame_id;
             }
             assembleHeader(frame_id, telegram, last_insnavcart_);
-            if (settings_->publish_insnavcart)
-                publish<INSNavCartMsg>("insnavcart", last_insnavcart_);
+            if (publishes(settings_->publish_insnavcart, topic::INS_NAV_CART))
+                publish<topic::INS_NAV_CART>(last_insnavcart_);
             assembleLocalizationEcef();
             break;
         }
@@ -2488,21 +2676,21 @@ namespace io {
                 frame_id = settings_->frame_id;
             }
             assembleHeader(frame_id, telegram, last_insnavgeod_);
-            if (settings_->publish_insnavgeod)
-                publish<INSNavGeodMsg>("insnavgeod", last_insnavgeod_);
+            if (publishes(settings_->publish_insnavgeod, topic::INS_NAV_GEOD))
+                publish<topic::INS_NAV_GEOD>(last_insnavgeod_);
             assembleLocalizationUtm();
             assembleLocalizationEcef();
             assembleTwist(true);
             assemblePoseWithCovarianceStamped();
             assembleNavSatFix();
             assembleGpsFix();
-            if (settings_->publish_gpst)
+            if (publishes(settings_->publish_gpst, topic::GPST))
                 assembleTimeReference(telegram);
             break;
         }
         case IMU_SETUP: // IMU orientation and lever arm
         {
-            if (settings_->publish_imusetup)
+            if (publishes(settings_->publish_imusetup, topic::IMU_SETUP))
             {
                 IMUSetupMsg msg;
 
@@ -2514,13 +2702,14 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->vehicle_frame_id, telegram, msg);
-                publish<IMUSetupMsg>("imusetup", msg);
+                publish<topic::IMU_SETUP>(std::move(msg));
             }
             break;
         }
         case VEL_SENSOR_SETUP: // Velocity sensor lever arm
         {
-            if (settings_->publish_velcovgeodetic)
+            if (publishes(settings_->publish_velcovgeodetic,
+                          topic::VEL_SENSOR_SETUP))
             {
                 VelSensorSetupMsg msg;
 
@@ -2532,14 +2721,15 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->vehicle_frame_id, telegram, msg);
-                publish<VelSensorSetupMsg>("velsensorsetup", msg);
+                publish<topic::VEL_SENSOR_SETUP>(std::move(msg));
             }
             break;
         }
         case EXT_EVENT_INS_NAV_CART: // Position, velocity and orientation in
                                      // cartesian coordinate frame (ENU frame)
         {
-            if (settings_->publish_exteventinsnavcart)
+            if (publishes(settings_->publish_exteventinsnavcart,
+                          topic::EXT_EVENT_INS_NAV_CART))
             {
                 INSNavCartMsg msg;
 
@@ -2560,13 +2750,14 @@ namespace io {
                     frame_id = settings_->frame_id;
                 }
                 assembleHeader(frame_id, telegram, msg);
-                publish<INSNavCartMsg>("exteventinsnavcart", msg);
+                publish<topic::EXT_EVENT_INS_NAV_CART>(std::move(msg));
             }
             break;
         }
         case EXT_EVENT_INS_NAV_GEOD:
         {
-            if (settings_->publish_exteventinsnavgeod)
+            if (publishes(settings_->publish_exteventinsnavgeod,
+                          topic::EXT_EVENT_INS_NAV_GEOD))
             {
                 INSNavGeodMsg msg;
 
@@ -2587,7 +2778,7 @@ namespace io {
                     frame_id = settings_->frame_id;
                 }
                 assembleHeader(frame_id, telegram, msg);
-                publish<INSNavGeodMsg>("exteventinsnavgeod", msg);
+                publish<topic::EXT_EVENT_INS_NAV_GEOD>(std::move(msg));
             }
             break;
         }
@@ -2603,9 +2794,9 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->imu_frame_id, telegram, last_extsensmeas_);
-            if (settings_->publish_extsensormeas)
-                publish<ExtSensorMeasMsg>("extsensormeas", last_extsensmeas_);
-            if (settings_->publish_imu && hasImuMeas)
+            if (publishes(settings_->publish_extsensormeas, topic::EXT_SENSOR_MEAS))
+                publish<topic::EXT_SENSOR_MEAS>(last_extsensmeas_);
+            if (publishes(settings_->publish_imu, topic::IMU) && hasImuMeas)
             {
                 assembleImu();
             }
@@ -2613,29 +2804,39 @@ namespace io {
         }
         case CHANNEL_STATUS:
         {
+            // Only needed for GpsFix
+            if (!publishes(settings_->publish_gpsfix, topic::GPSFIX))
+                break;
             if (!ChannelStatusParser(node_, telegram->message.begin(),
                                      telegram->message.end(), last_channelstatus_))
             {
                 node_->log(log_level::ERROR, "parse error in ChannelStatus");
                 break;
             }
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            aggregateEpoch(EpochAggregator::CHANNEL_STATUS,
+                           last_channelstatus_.block_header, telegram);
             break;
         }
         case MEAS_EPOCH:
         {
+            if (!publishes(settings_->publish_measepoch, topic::MEAS_EPOCH) &&
+                !publishes(settings_->publish_gpsfix, topic::GPSFIX))
+                break;
             if (!MeasEpochParser(node_, telegram->message.begin(),
                                  telegram->message.end(), last_measepoch_))
             {
                 node_->log(log_level::ERROR, "parse error in MeasEpoch");
                 break;
             }
-            assembleHeader(settings_->frame_id, telegram, last_measepoch_);
-            if (settings_->publish_measepoch)
-                publish<MeasEpochMsg>("measepoch", last_measepoch_);
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            if (publishes(settings_->publish_measepoch, topic::MEAS_EPOCH))
+            {
+                MeasEpochMsg msg;
+                measEpochToMsg(last_measepoch_, msg);
+                assembleHeader(settings_->frame_id, telegram, msg);
+                publish<topic::MEAS_EPOCH>(msg);
+            }
+            aggregateEpoch(EpochAggregator::MEAS_EPOCH, last_measepoch_.block_header,
+                           telegram);
             break;
         }
         case DOP:
@@ -2646,13 +2847,14 @@ namespace io {
                 node_->log(log_level::ERROR, "parse error in DOP");
                 break;
             }
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            aggregateEpoch(EpochAggregator::DOP, last_dop_.block_header,
+                           telegram);
             break;
         }
         case VEL_COV_CARTESIAN:
         {
-            if (settings_->publish_velcovcartesian)
+            if (publishes(settings_->publish_velcovcartesian,
+                          topic::VEL_COV_CARTESIAN))
             {
                 VelCovCartesianMsg msg;
                 if (!VelCovCartesianParser(node_, telegram->message.begin(),
@@ -2662,7 +2864,7 @@ namespace io {
                     break;
                 }
                 assembleHeader(settings_->frame_id, telegram, msg);
-                publish<VelCovCartesianMsg>("velcovcartesian", msg);
+                publish<topic::VEL_COV_CARTESIAN>(std::move(msg));
             }
             break;
         }
@@ -2676,11 +2878,11 @@ namespace io {
                 break;
             }
             assembleHeader(settings_->frame_id, telegram, last_velcovgeodetic_);
-            if (settings_->publish_velcovgeodetic)
-                publish<VelCovGeodeticMsg>("velcovgeodetic", last_velcovgeodetic_);
-            assembleTwist();
-            if (settings_->septentrio_receiver_type == "gnss")
-                assembleGpsFix();
+            if (publishes(settings_->publish_velcovgeodetic,
+                          topic::VEL_COV_GEODETIC))
+                publish<topic::VEL_COV_GEODETIC>(last_velcovgeodetic_);
+            aggregateEpoch(EpochAggregator::VEL_COV_GEODETIC,
+                           last_velcovgeodetic_.block_header, telegram);
             break;
         }
         case RECEIVER_STATUS:
@@ -2792,27 +2994,37 @@ namespace io {
         }
         default:
         {
-            node_->log(log_level::DEBUG, "unhandled SBF block " +
-                                             std::to_string(sbfId) + " received.");
+            const sbf_schema::Block* block = sbf_schema::find(sbfId);
+            if (!block)
+            {
+                node_->log(log_level::DEBUG, "unhandled SBF block " +
+                                                 std::to_string(sbfId) +
+                                                 " received.");
+                break;
+            }
+            sbf_schema::BlockView view;
+            if (!view.parse(*block, telegram->message.data(),
+                            telegram->message.size()))
+            {
+                node_->log(log_level::ERROR,
+                           "parse error in " + std::string(block->name));
+                break;
+            }
+            // Schema blocks are not published, only logged for debugging
+            if (settings_->activate_debug_log)
+                node_->log(log_level::DEBUG, view.toString());
             break;
         }
-            // Many more to be implemented...
         }
     }
 
     void MessageHandler::wait(Timestamp time_obj)
     {
-        Timestamp unix_old = unix_time_;
-        unix_time_ = time_obj;
-        if ((unix_old != 0) && (unix_time_ > unix_old))
+        if (replayClock_.advance(time_obj) && settings_->replay.publish_clock)
         {
-            auto sleep_nsec = unix_time_ - unix_old;
-
-            std::stringstream ss;
-            ss << "Waiting for " << sleep_nsec / 1000000 << " milliseconds...";
-            node_->log(log_level::DEBUG, ss.str());
-
-            std::this_thread::sleep_for(std::chrono::nanoseconds(sleep_nsec));
+            auto msg = std::make_unique<ClockMsg>();
+            msg->clock = timestampToRos(time_obj);
+            node_->publishMessage<topic::CLOCK>(std::move(msg));
         }
     }
 
@@ -2843,6 +3055,8 @@ namespace io {
             {
             case 0:
             {
+                if (!node_->subscribed(topic::GPGGA))
+                    break;
                 // Create NmeaSentence struct to pass to GpggaParser::parseASCII
                 NMEASentence gga_message(id, body);
                 GpggaMsg msg;
@@ -2858,11 +3072,13 @@ namespace io {
                                "GpggaMsg: " + std::string(e.what()));
                     break;
                 }
-                publish<GpggaMsg>("gpgga", msg);
+                publish<topic::GPGGA>(std::move(msg));
                 break;
             }
             case 1:
             {
+                if (!node_->subscribed(topic::GPRMC))
+                    break;
                 // Create NmeaSentence struct to pass to GprmcParser::parseASCII
                 NMEASentence rmc_message(id, body);
                 GprmcMsg msg;
@@ -2878,11 +3094,13 @@ namespace io {
                                "GprmcMsg: " + std::string(e.what()));
                     break;
                 }
-                publish<GprmcMsg>("gprmc", msg);
+                publish<topic::GPRMC>(std::move(msg));
                 break;
             }
             case 2:
             {
+                if (!node_->subscribed(topic::GPGSA))
+                    break;
                 // Create NmeaSentence struct to pass to GpgsaParser::parseASCII
                 NMEASentence gsa_message(id, body);
                 GpgsaMsg msg;
@@ -2916,11 +3134,13 @@ namespace io {
                     }
                 } else
                     msg.header.stamp = timestampToRos(telegram->stamp);
-                publish<GpgsaMsg>("gpgsa", msg);
+                publish<topic::GPGSA>(std::move(msg));
                 break;
             }
             case 4:
             {
+                if (!node_->subscribed(topic::GPGSV))
+                    break;
                 // Create NmeaSentence struct to pass to GpgsvParser::parseASCII
                 NMEASentence gsv_message(id, body);
                 GpgsvMsg msg;
@@ -2955,7 +3175,7 @@ namespace io {
                     }
                 } else
                     msg.header.stamp = timestampToRos(telegram->stamp);
-                publish<GpgsvMsg>("gpgsv", msg);
+                publish<topic::GPGSV>(std::move(msg));
                 break;
             }
             }
@@ -78,19 +78,7 @@ namespace io {
                                         telegram->message.end());
 
             node_->log(log_level::DEBUG, "A message received: " + block_in_string);
-            if (block_in_string.find("ReceiverCapabilities") != std::string::npos)
-            {
-                if (block_in_string.find("INS") != std::string::npos)
-                {
-                    node_->setIsIns();
-                }
-
-                if (block_in_string.find("Heading") != std::string::npos)
-                {
-                    node_->setHasHeading();
-                }
-                capabilitiesSemaphore_.notify();
-            }
+            handleCapabilities(block_in_string);
             break;
         }
         default:
@@ -117,6 +105,7 @@ namespace io {
         std::string block_in_string(telegram->message.begin(),
                                     telegram->message.end());
 
+        bool failure = false;
         if (telegram->type == telegram_type::ERROR_RESPONSE)
         {
             if (block_in_string ==
@@ -134,6 +123,7 @@ namespace io {
                     "Rx does not support PTP server clock. GNSS needs firmare >= 4.14., INS does not support it yet.");
             } else
             {
+                failure = true;
                 node_->log(
                     log_level::ERROR,
                     "Invalid command just sent to the Rx! The Rx's response contains " +
@@ -147,7 +137,25 @@ namespace io {
                                              " bytes and reads:\n " +
                                              block_in_string);
         }
-        responseSemaphore_.notify();
+        handleCapabilities(block_in_string);
+        commandPipeline_.respond(block_in_string, failure);
+    }
+
+    void TelegramHandler::handleCapabilities(const std::string& block_in_string)
+    {
+        if (block_in_string.find("ReceiverCapabilities") != std::string::npos)
+        {
+            if (block_in_string.find("INS") != std::string::npos)
+            {
+                node_->setIsIns();
+            }
+
+            if (block_in_string.find("Heading") != std::string::npos)
+            {
+                node_->setHasHeading();
+            }
+            capabilitiesSemaphore_.notify();
+        }
     }
 
     void TelegramHandler::handleCd(const std::shared_ptr<Telegram>& telegram)
@@ -70,13 +70,21 @@ namespace crc {
 
     bool isValid(const std::vector<uint8_t>& message)
     {
+        return isValid(message.data(), message.size());
+    }
+
+    bool isValid(const uint8_t* block, size_t size)
+    {
+        if (size < 8)
+            return false;
+
         // We need all of the message except for the first 4 bytes (Sync and CRC),
         // i.e. we start at the address of ID.
-        uint16_t length = parsing_utilities::getLength(message);
-        if (length > 4)
+        uint16_t length = parsing_utilities::parseUInt16(block + 6);
+        if ((length > 4) && (length <= size))
         {
-            uint16_t crc = compute16CCITT(message.data() + 4, length - 4);
-            return (crc == parsing_utilities::getCrc(message));
+            uint16_t crc = compute16CCITT(block + 4, length - 4);
+            return (crc == parsing_utilities::parseUInt16(block + 2));
         } else
         {
             return false;
@@ -28,6 +28,9 @@
 //
 // ****************************************************************************
 
+// C++ library includes
+#include <algorithm>
+#include <cctype>
 // Eigen include
 #include <Eigen/Geometry>
 #include <septentrio_gnss_driver/communication/settings_helpers.hpp>
@@ -41,7 +44,7 @@ namespace rosaic_node {
      */
 
     ROSaicNode::ROSaicNode(const rclcpp::NodeOptions& options) :
-        ROSaicNodeBase(options), IO_(this), tfBuffer_(this->get_clock())
+        ROSaicNodeBase(options), IO_(this)
     {
         param("activate_debug_log", settings_.activate_debug_log, false);
         if (settings_.activate_debug_log)
@@ -58,32 +61,91 @@ namespace rosaic_node {
 
         this->log(log_level::DEBUG, "Called ROSaicNode() constructor..");
 
-        tfListener_ = std::make_unique<tf2_ros::TransformListener>(tfBuffer_);
-
         // Parameters must be set before initializing IO
         if (!getROSParams())
             return;
 
-        setupThread_ = std::thread(std::bind(&ROSaicNode::setup, this));
-
         // Handle diagnostics
         param("diagnostic_updater_rate", settings_.diagnostic_updater_rate, 1.0);
         diagnostic_updater_ = std::make_shared<diagnostic_updater::Updater>(
             this, static_cast<int>(settings_.diagnostic_updater_rate));
         diagnostic_updater_->setHardwareID("Septentrio");
-        diagnostic_updater_->add("Status", this, &ROSaicNode::diagnosticsStatusCallback);
-        IO_.getTelegramHandler().getMessageHandler().add_message_handler_diagnostics();
+        addDiagnostics();
+
+        // Receivers share the I/O threads, created before any connection is made
+        addReceivers();
+
+        start();
+
+        this->log(log_level::DEBUG, "Leaving ROSaicNode() constructor..");
+    }
+
+    ROSaicNode::ROSaicNode(ROSaicNode& host, const std::string& name) :
+        ROSaicNodeBase(host, name), IO_(this)
+    {
+        this->log(log_level::DEBUG, "Called ROSaicNode() constructor..");
+
+        if (!getROSParams())
+            return;
+
+        addDiagnostics();
+        IO_.setIoContextPool(host.IO_.ioContextPool());
+
+        start();
 
         this->log(log_level::DEBUG, "Leaving ROSaicNode() constructor..");
     }
 
     ROSaicNode::~ROSaicNode()
     {
+        receivers_.clear();
         IO_.close();
         if (setupThread_.joinable())
             setupThread_.join();
     }
 
+    void ROSaicNode::start()
+    {
+        advertiseTopics();
+        watchSubscriptions();
+
+        if (settings_.read_from_sbf_log || settings_.read_from_pcap)
+            registerReplayServices();
+
+        setupThread_ = std::thread(std::bind(&ROSaicNode::setup, this));
+    }
+
+    void ROSaicNode::addReceivers()
+    {
+        std::vector<std::string> names;
+        param("receivers", names, std::vector<std::string>());
+        for (const auto& name : names)
+        {
+            // Names become namespaces of topics and services
+            bool valid = !name.empty() &&
+                         !std::isdigit(static_cast<unsigned char>(name.front()));
+            for (unsigned char c : name)
+                valid &= (std::isalnum(c) || (c == '_'));
+            if (!valid || (std::count(names.begin(), names.end(), name) > 1))
+            {
+                this->log(log_level::ERROR,
+                          "Invalid or duplicate receiver name " + name +
+                              ", only letters, digits and underscores are allowed.");
+                continue;
+            }
+            this->log(log_level::INFO, "Adding receiver " + name + ".");
+            receivers_.push_back(std::make_unique<ROSaicNode>(*this, name));
+        }
+    }
+
+    void ROSaicNode::addDiagnostics()
+    {
+        diagnostic_updater_->add(diagnosticName("Status"), this,
+                                 &ROSaicNode::diagnosticsStatusCallback);
+        IO_.getTelegramHandler().getMessageHandler().add_message_handler_diagnostics();
+        IO_.addDiagnostics();
+    }
+
     void ROSaicNode::setup()
     {
         // Initializes Connection
@@ -91,6 +153,45 @@ namespace rosaic_node {
         connectedToINS_ = true;
     }
 
+    void ROSaicNode::registerReplayServices()
+    {
+        ReplayClock& replayClock =
+            IO_.getTelegramHandler().getMessageHandler().replayClock();
+
+        // Private names are not put into the namespace of additional receivers
+        std::string prefix =
+            receiverName().empty() ? "~/" : "~/" + receiverName() + "/";
+        replayPauseService_ = this->create_service<std_srvs::srv::SetBool>(
+            prefix + "replay/pause",
+            [this, &replayClock](
+                const std::shared_ptr<std_srvs::srv::SetBool::Request> request,
+                std::shared_ptr<std_srvs::srv::SetBool::Response> response) {
+                if (request->data)
+                    replayClock.pause();
+                else
+                    replayClock.resume();
+                response->success = true;
+                response->message =
+                    request->data ? "Replay paused." : "Replay resumed.";
+                this->log(log_level::INFO, response->message);
+            });
+        replayStepService_ = this->create_service<std_srvs::srv::Trigger>(
+            prefix + "replay/step",
+            [&replayClock](
+                const std::shared_ptr<std_srvs::srv::Trigger::Request> /*request*/,
+                std::shared_ptr<std_srvs::srv::Trigger::Response> response) {
+                if (!replayClock.paused())
+                {
+                    response->success = false;
+                    response->message = "Replay is not paused.";
+                    return;
+                }
+                replayClock.step();
+                response->success = true;
+                response->message = "Replay advanced by one epoch.";
+            });
+    }
+
     void ROSaicNode::diagnosticsStatusCallback(diagnostic_updater::DiagnosticStatusWrapper &status) 
     {
         rclcpp::Time now = this->get_clock()->now();
@@ -131,7 +232,34 @@ namespace rosaic_node {
         param("insert_local_frame", settings_.insert_local_frame, false);
         param("lock_utm_zone", settings_.lock_utm_zone, true);
         param("leap_seconds", settings_.leap_seconds, -128);
+
+        // Replay parameters
+        param("replay.rate", settings_.replay.rate, 1.0);
+        if (settings_.replay.rate < 0.0)
+        {
+            this->log(log_level::ERROR,
+                      "replay.rate must not be negative, using real time.");
+            settings_.replay.rate = 1.0;
+        }
+        param("replay.start_paused", settings_.replay.start_paused, false);
+        param("replay.publish_clock", settings_.replay.publish_clock, false);
+        getUint32Param("replay.decode_threads", settings_.replay.decode_threads, 0);
+        param("replay.start_time", settings_.replay.start_time, 0.0);
+        param("replay.end_time", settings_.replay.end_time, 0.0);
+        {
+            std::vector<int64_t> block_ids;
+            param("replay.block_ids", block_ids, std::vector<int64_t>());
+            if (!settings::parseSbfIds(this, "replay.block_ids", block_ids,
+                                       settings_.replay.block_ids))
+                return false;
+        }
+        param("replay.pcap.host", settings_.replay.pcap_host,
+              static_cast<std::string>(""));
+        getUint32Param("replay.pcap.port", settings_.replay.pcap_port, 0);
         param("configure_rx", settings_.configure_rx, true);
+        param("configure_rx_diff", settings_.configure_rx_diff, false);
+        param("configure_rx_cache", settings_.configure_rx_cache,
+              static_cast<std::string>(""));
 
         param("custom_commands_file", settings_.custom_commands_file,
               static_cast<std::string>(""));
@@ -156,7 +284,26 @@ namespace rosaic_node {
         param("login.password", settings_.login_password,
               static_cast<std::string>(""));
 
-        settings_.reconnect_delay_s = 2.0f; // Removed from ROS parameter list.
+        getUint32Param("reconnect.min_interval", settings_.reconnect_min_interval,
+                       static_cast<uint32_t>(100));
+        getUint32Param("reconnect.max_interval", settings_.reconnect_max_interval,
+                       static_cast<uint32_t>(5000));
+        getUint32Param("io_pool.threads", settings_.io_pool.threads,
+                       static_cast<uint32_t>(2));
+        if (settings_.io_pool.threads == 0)
+        {
+            this->log(log_level::ERROR,
+                      "io_pool.threads must be positive, using 2.");
+            settings_.io_pool.threads = 2;
+        }
+        {
+            std::vector<int64_t> cpu_affinity;
+            param("io_pool.cpu_affinity", cpu_affinity, std::vector<int64_t>());
+            if (!settings::parseCpuIds(this, "io_pool.cpu_affinity",
+                                       cpu_affinity, settings_.io_pool.cpu_affinity))
+                return false;
+        }
+
         param("receiver_type", settings_.septentrio_receiver_type,
               static_cast<std::string>("gnss"));
         if (!((settings_.septentrio_receiver_type == "gnss") ||
@@ -176,6 +323,56 @@ namespace rosaic_node {
                 "Both UDP and TCP have been defined to receive data, only TCP will be used. If UDP is intended, leave tcp/ip_server empty.");
         }
 
+        // Telegram queue parameters
+        getUint32Param("telegram_queue.capacity", settings_.telegram_queue.capacity,
+                       static_cast<uint32_t>(4096));
+        if (settings_.telegram_queue.capacity == 0)
+        {
+            this->log(log_level::ERROR,
+                      "telegram_queue.capacity must be positive, using 4096.");
+            settings_.telegram_queue.capacity = 4096;
+        }
+        {
+            std::string policy_sbf;
+            std::string policy_nmea;
+            std::string policy_unknown;
+            param("telegram_queue.policy.sbf", policy_sbf,
+                  static_cast<std::string>("keep_latest"));
+            param("telegram_queue.policy.nmea", policy_nmea,
+                  static_cast<std::string>("drop_oldest"));
+            param("telegram_queue.policy.unknown", policy_unknown,
+                  static_cast<std::string>("drop_newest"));
+            if (!settings::parseOverflowPolicy(
+                    this, "telegram_queue.policy.sbf", policy_sbf,
+                    settings_.telegram_queue.policy_sbf) ||
+                !settings::parseOverflowPolicy(
+                    this, "telegram_queue.policy.nmea", policy_nmea,
+                    settings_.telegram_queue.policy_nmea) ||
+                !settings::parseOverflowPolicy(
+                    this, "telegram_queue.policy.unknown", policy_unknown,
+                    settings_.telegram_queue.policy_unknown))
+                return false;
+
+            std::vector<int64_t> priority_high;
+            std::vector<int64_t> priority_low;
+            param("telegram_queue.priority.high", priority_high,
+                  std::vector<int64_t>{INS_NAV_CART, INS_NAV_GEOD,
+                                       EXT_EVENT_INS_NAV_CART,
+                                       EXT_EVENT_INS_NAV_GEOD, EXT_SENSOR_MEAS,
+                                       PVT_CARTESIAN, PVT_GEODETIC});
+            param("telegram_queue.priority.low", priority_low,
+                  std::vector<int64_t>{MEAS_EPOCH, CHANNEL_STATUS, RECEIVER_STATUS,
+                                       QUALITY_IND, RF_STATUS, GAL_AUTH_STATUS,
+                                       RECEIVER_SETUP});
+            if (!settings::parseSbfIds(this, "telegram_queue.priority.high",
+                                       priority_high,
+                                       settings_.telegram_queue.priority_high) ||
+                !settings::parseSbfIds(this, "telegram_queue.priority.low",
+                                       priority_low,
+                                       settings_.telegram_queue.priority_low))
+                return false;
+        }
+
         // Polling period parameters
         getUint32Param("polling_period.pvt", settings_.polling_period_pvt,
                        static_cast<uint32_t>(1000));
@@ -198,6 +395,8 @@ namespace rosaic_node {
                 "Please specify a valid polling period for PVT-unrelated SBF blocks and NMEA messages.");
             return false;
         }
+        getUint32Param("epoch_timeout", settings_.epoch_timeout,
+                       static_cast<uint32_t>(500));
 
         // OSNMA parameters
         param("osnma.mode", settings_.osnma.mode, std::string("off"));
@@ -249,6 +448,7 @@ namespace rosaic_node {
     param("publish.twist_flu_stamped", settings_.publish_twist_flu_stamped, false);
     param("publish.tf", settings_.publish_tf, false);
     param("publish.tf_ecef", settings_.publish_tf_ecef, false);
+    param("publish.lazy_decoding", settings_.lazy_decoding, false);
 
         if (settings_.publish_tf && settings_.publish_tf_ecef)
         {
@@ -258,6 +458,25 @@ namespace rosaic_node {
             settings_.publish_tf = false;
         }
 
+        // QoS of topic groups and of single topics overriding their group
+        for (const char* group : topic::groupNames)
+            settings::getQosParams(this, std::string("qos.") + group + ".",
+                                   settings_.qos[group]);
+        for (size_t id = 0; id < topic::COUNT; ++id)
+        {
+            const std::string name = topic::names[id];
+            const std::string prefix =
+                "qos." + name.substr(name.front() == '/') + ".";
+            if (hasParam(prefix + "reliability") || hasParam(prefix + "durability") ||
+                hasParam(prefix + "depth"))
+            {
+                QosSettings qos =
+                    settings_.qos[topic::groupNames[topic::groups[id]]];
+                settings::getQosParams(this, prefix, qos);
+                settings_.qos[name] = qos;
+            }
+        }
+
         // Datum and marker-to-ARP offset
         param("datum", settings_.datum, std::string("Default"));
         // WGS84 is equivalent to Default and kept for backwards compatibility
@@ -797,6 +1016,16 @@ namespace rosaic_node {
 
         settings::autoPublish(this, settings_);
 
+        // A replay is to output all messages, also those arriving before
+        // subscribers are discovered
+        if (settings_.lazy_decoding &&
+            (settings_.read_from_sbf_log || settings_.read_from_pcap))
+        {
+            this->log(log_level::INFO,
+                      "Lazy decoding is disabled when replaying a log.");
+            settings_.lazy_decoding = false;
+        }
+
         // To be implemented: RTCM, raw data settings, PPP, SBAS ...
         this->log(log_level::DEBUG, "Finished getROSParams() method");
         return true;
@@ -824,8 +1053,8 @@ namespace rosaic_node {
             try
             {
                 // try to get tf from source frame to target frame
-                T_s_t = tfBuffer_.lookupTransform(targetFrame, sourceFrame,
-                                                  rclcpp::Time(0));
+                T_s_t = tfBuffer().lookupTransform(targetFrame, sourceFrame,
+                                                   rclcpp::Time(0));
                 found = true;
             } catch (const tf2::TransformException& ex)
             {
@@ -60,6 +60,11 @@ namespace rosaic_node {
         if (!getROSParams())
             return;
 
+        advertiseTopics();
+
+        if (settings_.read_from_sbf_log || settings_.read_from_pcap)
+            registerReplayServices();
+
         setupThread_ = std::thread(std::bind(&ROSaicNode::setup, this));
 
         this->log(log_level::DEBUG, "Leaving ROSaicNode() constructor..");
@@ -78,6 +83,46 @@ namespace rosaic_node {
         IO_.connect();
     }
 
+    void ROSaicNode::registerReplayServices()
+    {
+        ReplayClock& replayClock =
+            IO_.getTelegramHandler().getMessageHandler().replayClock();
+        ros::NodeHandle pnh("~");
+
+        replayPauseService_ =
+            pnh.advertiseService<std_srvs::SetBool::Request,
+                                 std_srvs::SetBool::Response>(
+                "replay/pause", [this, &replayClock](
+                                    std_srvs::SetBool::Request& request,
+                                    std_srvs::SetBool::Response& response) {
+                    if (request.data)
+                        replayClock.pause();
+                    else
+                        replayClock.resume();
+                    response.success = true;
+                    response.message =
+                        request.data ? "Replay paused." : "Replay resumed.";
+                    this->log(log_level::INFO, response.message);
+                    return true;
+                });
+        replayStepService_ =
+            pnh.advertiseService<std_srvs::Trigger::Request,
+                                 std_srvs::Trigger::Response>(
+                "replay/step", [&replayClock](std_srvs::Trigger::Request&,
+                                              std_srvs::Trigger::Response& response) {
+                    if (!replayClock.paused())
+                    {
+                        response.success = false;
+                        response.message = "Replay is not paused.";
+                        return true;
+                    }
+                    replayClock.step();
+                    response.success = true;
+                    response.message = "Replay advanced by one epoch.";
+                    return true;
+                });
+    }
+
     [[nodiscard]] bool ROSaicNode::getROSParams()
     {
         param("ntp_server", settings_.ntp_server, false);
@@ -101,7 +146,34 @@ namespace rosaic_node {
         param("lock_utm_zone", settings_.lock_utm_zone, true);
         param("leap_seconds", settings_.leap_seconds, -128);
 
+        // Replay parameters
+        param("replay/rate", settings_.replay.rate, 1.0);
+        if (settings_.replay.rate < 0.0)
+        {
+            this->log(log_level::ERROR,
+                      "replay/rate must not be negative, using real time.");
+            settings_.replay.rate = 1.0;
+        }
+        param("replay/start_paused", settings_.replay.start_paused, false);
+        param("replay/publish_clock", settings_.replay.publish_clock, false);
+        getUint32Param("replay/decode_threads", settings_.replay.decode_threads, 0);
+        param("replay/start_time", settings_.replay.start_time, 0.0);
+        param("replay/end_time", settings_.replay.end_time, 0.0);
+        {
+            std::vector<int32_t> block_ids;
+            param("replay/block_ids", block_ids, std::vector<int32_t>());
+            if (!settings::parseSbfIds(this, "replay/block_ids", block_ids,
+                                       settings_.replay.block_ids))
+                return false;
+        }
+        param("replay/pcap/host", settings_.replay.pcap_host,
+              static_cast<std::string>(""));
+        getUint32Param("replay/pcap/port", settings_.replay.pcap_port, 0);
+
         param("configure_rx", settings_.configure_rx, true);
+        param("configure_rx_diff", settings_.configure_rx_diff, false);
+        param("configure_rx_cache", settings_.configure_rx_cache,
+              static_cast<std::string>(""));
 
         param("custom_commands_file", settings_.custom_commands_file,
               static_cast<std::string>(""));
@@ -125,7 +197,26 @@ namespace rosaic_node {
         param("login/user", settings_.login_user, static_cast<std::string>(""));
         param("login/password", settings_.login_password,
               static_cast<std::string>(""));
-        settings_.reconnect_delay_s = 2.0f; // Removed from ROS parameter list.
+        getUint32Param("reconnect/min_interval", settings_.reconnect_min_interval,
+                       static_cast<uint32_t>(100));
+        getUint32Param("reconnect/max_interval", settings_.reconnect_max_interval,
+                       static_cast<uint32_t>(5000));
+        getUint32Param("io_pool/threads", settings_.io_pool.threads,
+                       static_cast<uint32_t>(2));
+        if (settings_.io_pool.threads == 0)
+        {
+            this->log(log_level::ERROR,
+                      "io_pool/threads must be positive, using 2.");
+            settings_.io_pool.threads = 2;
+        }
+        {
+            std::vector<int32_t> cpu_affinity;
+            param("io_pool/cpu_affinity", cpu_affinity, std::vector<int32_t>());
+            if (!settings::parseCpuIds(this, "io_pool/cpu_affinity",
+                                       cpu_affinity, settings_.io_pool.cpu_affinity))
+                return false;
+        }
+
         param("receiver_type", settings_.septentrio_receiver_type,
               static_cast<std::string>("gnss"));
         if (!((settings_.septentrio_receiver_type == "gnss") ||
@@ -145,6 +236,56 @@ namespace rosaic_node {
                 "Both UDP and TCP have been defined to receive data, only TCP will be used. If UDP is intended, leave tcp/ip_server empty.");
         }
 
+        // Telegram queue parameters
+        getUint32Param("telegram_queue/capacity", settings_.telegram_queue.capacity,
+                       static_cast<uint32_t>(4096));
+        if (settings_.telegram_queue.capacity == 0)
+        {
+            this->log(log_level::ERROR,
+                      "telegram_queue/capacity must be positive, using 4096.");
+            settings_.telegram_queue.capacity = 4096;
+        }
+        {
+            std::string policy_sbf;
+            std::string policy_nmea;
+            std::string policy_unknown;
+            param("telegram_queue/policy/sbf", policy_sbf,
+                  static_cast<std::string>("keep_latest"));
+            param("telegram_queue/policy/nmea", policy_nmea,
+                  static_cast<std::string>("drop_oldest"));
+            param("telegram_queue/policy/unknown", policy_unknown,
+                  static_cast<std::string>("drop_newest"));
+            if (!settings::parseOverflowPolicy(
+                    this, "telegram_queue/policy/sbf", policy_sbf,
+                    settings_.telegram_queue.policy_sbf) ||
+                !settings::parseOverflowPolicy(
+                    this, "telegram_queue/policy/nmea", policy_nmea,
+                    settings_.telegram_queue.policy_nmea) ||
+                !settings::parseOverflowPolicy(
+                    this, "telegram_queue/policy/unknown", policy_unknown,
+                    settings_.telegram_queue.policy_unknown))
+                return false;
+
+            std::vector<int32_t> priority_high;
+            std::vector<int32_t> priority_low;
+            param("telegram_queue/priority/high", priority_high,
+                  std::vector<int32_t>{INS_NAV_CART, INS_NAV_GEOD,
+                                       EXT_EVENT_INS_NAV_CART,
+                                       EXT_EVENT_INS_NAV_GEOD, EXT_SENSOR_MEAS,
+                                       PVT_CARTESIAN, PVT_GEODETIC});
+            param("telegram_queue/priority/low", priority_low,
+                  std::vector<int32_t>{MEAS_EPOCH, CHANNEL_STATUS, RECEIVER_STATUS,
+                                       QUALITY_IND, RF_STATUS, GAL_AUTH_STATUS,
+                                       RECEIVER_SETUP});
+            if (!settings::parseSbfIds(this, "telegram_queue/priority/high",
+                                       priority_high,
+                                       settings_.telegram_queue.priority_high) ||
+                !settings::parseSbfIds(this, "telegram_queue/priority/low",
+                                       priority_low,
+                                       settings_.telegram_queue.priority_low))
+                return false;
+        }
+
         // Polling period parameters
         getUint32Param("polling_period/pvt", settings_.polling_period_pvt,
                        static_cast<uint32_t>(1000));
@@ -166,6 +307,8 @@ namespace rosaic_node {
                 "Please specify a valid polling period for PVT-unrelated SBF blocks and NMEA messages.");
             return false;
         }
+        getUint32Param("epoch_timeout", settings_.epoch_timeout,
+                       static_cast<uint32_t>(500));
 
         // OSNMA parameters
         param("osnma/mode", settings_.osnma.mode, std::string("off"));
@@ -216,6 +359,7 @@ namespace rosaic_node {
         param("publish/twist", settings_.publish_twist, false);
         param("publish/tf", settings_.publish_tf, false);
         param("publish/tf_ecef", settings_.publish_tf_ecef, false);
+        param("publish/lazy_decoding", settings_.lazy_decoding, false);
 
         if (settings_.publish_tf && settings_.publish_tf_ecef)
         {
@@ -225,6 +369,25 @@ namespace rosaic_node {
             settings_.publish_tf = false;
         }
 
+        // QoS of topic groups and of single topics overriding their group
+        for (const char* group : topic::groupNames)
+            settings::getQosParams(this, std::string("qos/") + group + "/",
+                                   settings_.qos[group]);
+        for (size_t id = 0; id < topic::COUNT; ++id)
+        {
+            const std::string name = topic::names[id];
+            const std::string prefix =
+                "qos/" + name.substr(name.front() == '/') + "/";
+            if (hasParam(prefix + "reliability") || hasParam(prefix + "durability") ||
+                hasParam(prefix + "depth"))
+            {
+                QosSettings qos =
+                    settings_.qos[topic::groupNames[topic::groups[id]]];
+                settings::getQosParams(this, prefix, qos);
+                settings_.qos[name] = qos;
+            }
+        }
+
         // Datum and marker-to-ARP offset
         param("datum", settings_.datum, std::string("Default"));
         // WGS84 is equivalent to Default and kept for backwards compatibility
@@ -761,6 +924,16 @@ namespace rosaic_node {
 
         settings::autoPublish(this, settings_);
 
+        // A replay is to output all messages, also those arriving before
+        // subscribers are discovered
+        if (settings_.lazy_decoding &&
+            (settings_.read_from_sbf_log || settings_.read_from_pcap))
+        {
+            this->log(log_level::INFO,
+                      "Lazy decoding is disabled when replaying a log.");
+            settings_.lazy_decoding = false;
+        }
+
         // To be implemented: RTCM, raw data settings, PPP, SBAS ...
         this->log(log_level::DEBUG, "Finished getROSParams() method");
         return true;
@@ -0,0 +1,212 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// *****************************************************************************
+
+// ROSaic includes
+#include <septentrio_gnss_driver/parsers/sbf_layout.hpp>
+#include <septentrio_gnss_driver/parsers/sbf_schema.hpp>
+// C++ library includes
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @file sbf_schema.cpp
+ * @brief Defines the generic view decoding SBF blocks by their schema
+ */
+
+namespace sbf_schema {
+    namespace {
+        template <typename T>
+        double scaled(const Field& field, const uint8_t* data)
+        {
+            T val = sbf_layout::load<T>(data);
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                if (val == sbf_layout::DO_NOT_USE<T>)
+                    return std::numeric_limits<double>::quiet_NaN();
+            } else if constexpr (std::is_unsigned_v<T>)
+            {
+                if (field.doNotUse && (val == std::numeric_limits<T>::max()))
+                    return std::numeric_limits<double>::quiet_NaN();
+            } else
+            {
+                if (field.doNotUse && (val == std::numeric_limits<T>::min()))
+                    return std::numeric_limits<double>::quiet_NaN();
+            }
+            return static_cast<double>(val) * field.scale;
+        }
+
+        //! Number of leading fields present in the revision
+        size_t presentFields(Fields fields, uint8_t revision)
+        {
+            return std::find_if(fields.begin(), fields.end(),
+                                [revision](const Field& f) {
+                                    return f.revision > revision;
+                                }) -
+                   fields.begin();
+        }
+
+        void append(std::string& s, const FieldView& field)
+        {
+            s.append(field.name());
+            s.push_back('=');
+            if (field.field().type == Type::C1)
+            {
+                s.append(field.chars());
+                return;
+            }
+            // Fewest digits that read back as the same value
+            const double value = field.value();
+            std::array<char, 32> buf;
+            int n = 0;
+            for (int precision = 1; precision <= 17; ++precision)
+            {
+                n = std::snprintf(buf.data(), buf.size(), "%.*g", precision, value);
+                if (std::isnan(value) || (std::strtod(buf.data(), nullptr) == value))
+                    break;
+            }
+            s.append(buf.data(), n);
+        }
+    } // namespace
+
+    double FieldView::value() const
+    {
+        switch (field_->type)
+        {
+        case Type::U1:
+            return scaled<uint8_t>(*field_, data_);
+        case Type::U2:
+            return scaled<uint16_t>(*field_, data_);
+        case Type::U4:
+            return scaled<uint32_t>(*field_, data_);
+        case Type::U8:
+            return scaled<uint64_t>(*field_, data_);
+        case Type::I1:
+            return scaled<int8_t>(*field_, data_);
+        case Type::I2:
+            return scaled<int16_t>(*field_, data_);
+        case Type::I4:
+            return scaled<int32_t>(*field_, data_);
+        case Type::I8:
+            return scaled<int64_t>(*field_, data_);
+        case Type::F4:
+            return scaled<float>(*field_, data_);
+        case Type::F8:
+            return scaled<double>(*field_, data_);
+        default:
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    std::string_view FieldView::chars() const
+    {
+        std::string_view s(reinterpret_cast<const char*>(data_), field_->count);
+        return s.substr(0, s.find('\0'));
+    }
+
+    bool BlockView::parse(const Block& block, const uint8_t* data, size_t length)
+    {
+        if (length < 14)
+            return false;
+        block_ = &block;
+        data_ = data;
+        revision_ = static_cast<uint8_t>(sbf_layout::load<uint16_t>(data + 4) >> 13);
+        tow_ = sbf_layout::load<uint32_t>(data + 8);
+        wnc_ = sbf_layout::load<uint16_t>(data + 12);
+        fieldCount_ = presentFields(block.fields, revision_);
+        n_ = 0;
+        sbLength_ = 0;
+        sbFieldCount_ = 0;
+
+        size_t end = fieldsEnd(block.fields, revision_, 14);
+        if (block.subBlocks)
+        {
+            const SubBlocks& sb = *block.subBlocks;
+            if (length < sb.offset)
+                return false;
+            if (sb.nType == Type::U2)
+                n_ = sbf_layout::load<uint16_t>(data + sb.nOffset);
+            else
+                n_ = data[sb.nOffset];
+            size_t minimum = fieldsEnd(sb.fields, revision_, 0);
+            sbLength_ = (sb.lengthOffset != 0) ? data[sb.lengthOffset] : minimum;
+            if (sbLength_ < minimum)
+                return false;
+            sbFieldCount_ = presentFields(sb.fields, revision_);
+            end = std::max(end, sb.offset + n_ * sbLength_);
+        }
+        return length >= end;
+    }
+
+    std::optional<FieldView> BlockView::field(std::string_view name) const
+    {
+        size_t index = fieldIndex(block_->fields.first(fieldCount_), name);
+        if (index == fieldCount_)
+            return std::nullopt;
+        return field(index);
+    }
+
+    std::optional<FieldView> BlockView::subBlockField(size_t subBlock,
+                                                      std::string_view name) const
+    {
+        if (!block_->subBlocks)
+            return std::nullopt;
+        size_t index =
+            fieldIndex(block_->subBlocks->fields.first(sbFieldCount_), name);
+        if (index == sbFieldCount_)
+            return std::nullopt;
+        return subBlockField(subBlock, index);
+    }
+
+    std::string BlockView::toString() const
+    {
+        std::string s(block_->name);
+        s += " TOW " + std::to_string(tow_) + " WNc " + std::to_string(wnc_) + ":";
+        for (size_t i = 0; i < fieldCount_; ++i)
+        {
+            s += (i == 0) ? " " : ", ";
+            append(s, field(i));
+        }
+        for (size_t sb = 0; sb < n_; ++sb)
+        {
+            s += "; ";
+            s.append(block_->subBlocks->name);
+            s += "[" + std::to_string(sb) + "]";
+            for (size_t i = 0; i < sbFieldCount_; ++i)
+            {
+                s += (i == 0) ? " " : ", ";
+                append(s, subBlockField(sb, i));
+            }
+        }
+        return s;
+    }
+} // namespace sbf_schema
@@ -0,0 +1,140 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <iostream>
+#include <queue>
+#include <thread>
+
+#include <septentrio_gnss_driver/communication/command_pipeline.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+    /**
+     * Rx at the end of a link with one-way latency, processing the commands in
+     * order and answering each with a response echoing it
+     */
+    class SimulatedRx
+    {
+    public:
+        SimulatedRx(io::CommandPipeline& pipeline,
+                    std::chrono::microseconds latency,
+                    std::chrono::microseconds processing) :
+            pipeline_(pipeline), latency_(latency), processing_(processing),
+            thread_([this]() { run(); })
+        {
+        }
+
+        ~SimulatedRx()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            cv_.notify_one();
+            thread_.join();
+        }
+
+        void send(const std::string& cmd)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            commands_.push({cmd, std::chrono::steady_clock::now()});
+            cv_.notify_one();
+        }
+
+    private:
+        void run()
+        {
+            auto idle = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                cv_.wait(lock, [this]() { return !running_ || !commands_.empty(); });
+                if (!running_)
+                    return;
+                auto [cmd, sent] = commands_.front();
+                commands_.pop();
+                lock.unlock();
+
+                idle = std::max(idle, sent + latency_) + processing_;
+                std::this_thread::sleep_until(idle + latency_);
+                pipeline_.respond("$R: " + cmd + "\n  Reply\r\n", false);
+                lock.lock();
+            }
+        }
+
+        io::CommandPipeline& pipeline_;
+        std::chrono::microseconds latency_;
+        std::chrono::microseconds processing_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::queue<std::pair<std::string, std::chrono::steady_clock::time_point>>
+            commands_;
+        bool running_ = true;
+        std::thread thread_;
+    };
+} // namespace
+
+TEST(CommandPipelineBenchmark, pipelining)
+{
+    const size_t commands = 60;
+    const auto latency = 2ms;
+    const auto processing = 200us;
+
+    auto configure = [&](size_t depth) {
+        io::CommandPipeline pipeline(depth);
+        SimulatedRx rx(pipeline, latency, processing);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < commands; ++i)
+        {
+            std::string cmd = "sso, Stream" + std::to_string(i) + ", none \x0D";
+            EXPECT_TRUE(pipeline.admit(cmd));
+            rx.send(cmd);
+        }
+        EXPECT_TRUE(pipeline.flush());
+        return std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    double sequential = configure(1);
+    double pipelined = configure(io::COMMAND_PIPELINE_DEPTH);
+
+    std::cout << "[ BENCHMARK] " << commands << " commands, "
+              << std::chrono::duration<double, std::milli>(latency).count()
+              << " ms one-way latency" << std::endl;
+    std::cout << "[ BENCHMARK] one command in flight: " << sequential << " ms"
+              << std::endl;
+    std::cout << "[ BENCHMARK] " << io::COMMAND_PIPELINE_DEPTH
+              << " commands in flight: " << pipelined << " ms" << std::endl;
+    EXPECT_LT(pipelined, sequential);
+}
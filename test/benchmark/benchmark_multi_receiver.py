@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+# *****************************************************************************
+#
+# © Copyright 2020, Septentrio NV/SA.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#    1. Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#    2. Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#    3. Neither the name of the copyright holder nor the names of its
+#       contributors may be used to endorse or promote products derived
+#       from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# *****************************************************************************
+
+"""Compares CPU and memory of N receivers hosted by one node against N nodes.
+
+Every receiver replays the same SBF log, so no hardware is needed:
+
+    python3 test/benchmark/benchmark_multi_receiver.py log.sbf
+
+For N = 1..max_receivers the driver is started once hosting N receivers
+(parameter receivers) and N times with one receiver each. After a warm-up,
+CPU time, resident memory and threads of all driver processes are sampled from
+/proc for the measurement period. The log has to last for warm-up and period.
+--driver runs another command than the installed node, e.g. one of a workspace
+that is not sourced.
+"""
+
+import argparse
+import os
+import shlex
+import signal
+import subprocess
+import tempfile
+import time
+
+CLOCK_TICKS = os.sysconf("SC_CLK_TCK")
+DRIVER = "ros2 run septentrio_gnss_driver septentrio_gnss_driver_node"
+
+
+def receiver_parameters(sbf_log, rate, indent):
+    pad = " " * indent
+    return (
+        f"{pad}device: file_name:{sbf_log}\n"
+        f"{pad}configure_rx: false\n"
+        f"{pad}replay:\n"
+        f"{pad}  rate: {rate}\n"
+        f"{pad}publish:\n"
+        f"{pad}  auto_publish: true\n"
+    )
+
+
+def write_parameters(path, sbf_log, rate, receivers):
+    with open(path, "w") as f:
+        f.write("/**:\n  ros__parameters:\n")
+        f.write(receiver_parameters(sbf_log, rate, 4))
+        if receivers:
+            f.write(f"    receivers: [{', '.join(receivers)}]\n")
+        for name in receivers:
+            f.write(f"    {name}:\n")
+            f.write(receiver_parameters(sbf_log, rate, 6))
+            f.write(f"      frame_id: {name}_gnss\n")
+
+
+def start(driver, parameters, name):
+    return subprocess.Popen(
+        shlex.split(driver) +
+        ["--ros-args", "-r", f"__node:={name}", "--params-file", parameters],
+        stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL,
+        start_new_session=True)
+
+
+def driver_pids(processes):
+    """Driver processes, ros2 run starts the node as a child."""
+    pids = []
+    for process in processes:
+        pids.append(process.pid)
+        try:
+            with open(f"/proc/{process.pid}/task/{process.pid}/children") as f:
+                pids += [int(pid) for pid in f.read().split()]
+        except OSError:
+            pass
+    return pids
+
+
+def sample(pids):
+    """Returns CPU time [s], resident memory [MiB] and threads of pids."""
+    cpu = 0.0
+    rss = 0.0
+    threads = 0
+    for pid in pids:
+        try:
+            with open(f"/proc/{pid}/stat") as f:
+                fields = f.read().rsplit(")", 1)[1].split()
+            cpu += (int(fields[11]) + int(fields[12])) / CLOCK_TICKS
+            threads += int(fields[17])
+            with open(f"/proc/{pid}/status") as f:
+                for line in f:
+                    if line.startswith("VmRSS:"):
+                        rss += int(line.split()[1]) / 1024.0
+        except (OSError, IndexError, ValueError):
+            pass
+    return cpu, rss, threads
+
+
+def measure(processes, warmup, period):
+    time.sleep(warmup)
+    if any(process.poll() is not None for process in processes):
+        for process in processes:
+            if process.poll() is None:
+                os.killpg(process.pid, signal.SIGKILL)
+        raise SystemExit("driver exited during the warm-up, check the command "
+                         "and that the log lasts for warm-up and period")
+    pids = driver_pids(processes)
+    cpu_start, _, _ = sample(pids)
+    time.sleep(period)
+    cpu_end, rss, threads = sample(pids)
+    for process in processes:
+        os.killpg(process.pid, signal.SIGINT)
+    for process in processes:
+        try:
+            process.wait(timeout=20)
+        except subprocess.TimeoutExpired:
+            os.killpg(process.pid, signal.SIGKILL)
+    return 100.0 * (cpu_end - cpu_start) / period, rss, threads
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("sbf_log", help="SBF log replayed by every receiver")
+    parser.add_argument("--max-receivers", type=int, default=8)
+    parser.add_argument("--driver", default=DRIVER,
+                        help="command starting the driver node")
+    parser.add_argument("--rate", type=float, default=1.0,
+                        help="replay rate, 0 for as fast as possible")
+    parser.add_argument("--warmup", type=float, default=5.0, help="[s]")
+    parser.add_argument("--period", type=float, default=20.0, help="[s]")
+    args = parser.parse_args()
+    sbf_log = os.path.abspath(args.sbf_log)
+
+    print(f"{'N':>2} | {'one node':^28} | {'N nodes':^28}")
+    print(f"{'':>2} | {'CPU [%]':>8} {'RSS [MiB]':>10} {'threads':>8} |"
+          f" {'CPU [%]':>8} {'RSS [MiB]':>10} {'threads':>8}")
+    with tempfile.TemporaryDirectory() as directory:
+        for n in range(1, args.max_receivers + 1):
+            hosted = os.path.join(directory, f"hosted_{n}.yaml")
+            write_parameters(hosted, sbf_log, args.rate,
+                             [f"rx{i}" for i in range(1, n)])
+            one = measure([start(args.driver, hosted, "septentrio_gnss")],
+                          args.warmup, args.period)
+
+            single = os.path.join(directory, "single.yaml")
+            write_parameters(single, sbf_log, args.rate, [])
+            many = measure([start(args.driver, single, f"septentrio_gnss_{i}")
+                            for i in range(n)], args.warmup, args.period)
+
+            print(f"{n:>2} | {one[0]:>8.1f} {one[1]:>10.1f} {one[2]:>8} |"
+                  f" {many[0]:>8.1f} {many[1]:>10.1f} {many[2]:>8}",
+                  flush=True)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <gtest/gtest.h>
+
+#include <any>
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+namespace {
+    class TestNode : public ROSaicNodeBase
+    {
+    public:
+        TestNode() : ROSaicNodeBase(rclcpp::NodeOptions())
+        {
+            settings_ = Settings{};
+            settings_.publish_pvtgeodetic = true;
+        }
+
+        using ROSaicNodeBase::publisher;
+
+    private:
+        void sendVelocity(const std::string&) override {}
+    };
+
+    //! Publishing as done before the publisher table, for comparison
+    class TopicMap
+    {
+    public:
+        explicit TopicMap(rclcpp::Node& node) : node_(node) {}
+
+        template <typename M>
+        typename rclcpp::Publisher<M>::SharedPtr publisher(const std::string& topic)
+        {
+            auto it = topicMap_.find(topic);
+            if (it != topicMap_.end())
+                return std::any_cast<typename rclcpp::Publisher<M>::SharedPtr>(
+                    it->second);
+            typename rclcpp::Publisher<M>::SharedPtr pub =
+                node_.create_publisher<M>(topic, rclcpp::QoS(rclcpp::KeepLast(1))
+                                                     .durability_volatile()
+                                                     .reliable());
+            topicMap_.insert(std::make_pair(topic, pub));
+            return pub;
+        }
+
+        template <typename M>
+        void publishMessage(const std::string& topic, std::unique_ptr<M> msg)
+        {
+            publisher<M>(topic)->publish(std::move(msg));
+        }
+
+    private:
+        rclcpp::Node& node_;
+        std::unordered_map<std::string, std::any> topicMap_;
+    };
+
+    template <typename F>
+    double nsPerCall(size_t calls, F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < calls; ++i)
+            f();
+        return std::chrono::duration<double, std::nano>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() /
+               calls;
+    }
+} // namespace
+
+class PublisherTableBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite() { rclcpp::init(0, nullptr); }
+
+    static void TearDownTestSuite() { rclcpp::shutdown(); }
+};
+
+TEST_F(PublisherTableBenchmark, lookupAndPublish)
+{
+    const size_t calls = 100000;
+    auto node = std::make_shared<TestNode>();
+    node->advertiseTopics();
+    TopicMap topicMap(*node);
+    // The map holds as many topics as a typical configuration publishes
+    for (const char* name : {"pose", "imu", "navsatfix", "gpsfix", "localization",
+                             "pvtcartesian", "atteuler", "insnavgeod", "measepoch"})
+        topicMap.publisher<PVTGeodeticMsg>(std::string(name) + "_map");
+
+    size_t found = 0;
+    double lookupMap = nsPerCall(calls, [&]() {
+        found += (topicMap.publisher<PVTGeodeticMsg>("pvtgeodetic_map") != nullptr);
+    });
+    double lookupTable = nsPerCall(calls, [&]() {
+        found += (node->publisher<topic::PVT_GEODETIC>() != nullptr);
+    });
+    EXPECT_EQ(found, 2 * calls);
+
+    double publishMap = nsPerCall(calls, [&]() {
+        auto msg = std::make_unique<PVTGeodeticMsg>();
+        topicMap.publishMessage("pvtgeodetic_map", std::move(msg));
+    });
+    double publishTable = nsPerCall(calls, [&]() {
+        auto msg = std::make_unique<PVTGeodeticMsg>();
+        node->publishMessage<topic::PVT_GEODETIC>(std::move(msg));
+    });
+
+    std::cout << "[ BENCHMARK] publisher lookup by name: " << lookupMap
+              << " ns, by topic ID: " << lookupTable << " ns" << std::endl;
+    std::cout << "[ BENCHMARK] publishMessage by name: " << publishMap
+              << " ns, by topic ID: " << publishTable << " ns" << std::endl;
+    EXPECT_LT(lookupTable, lookupMap);
+}
@@ -0,0 +1,137 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <septentrio_gnss_driver/communication/sbf_chunk_decoder.hpp>
+
+namespace {
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint8_t fill)
+    {
+        std::vector<uint8_t> block(length, fill);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::string& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    //! Typical log: INS at high rate, MeasEpoch with payloads containing "$@" and
+    //! interleaved NMEA
+    std::vector<uint8_t> makeLog(size_t epochs)
+    {
+        std::vector<uint8_t> log;
+        for (size_t i = 0; i < epochs; ++i)
+        {
+            for (size_t j = 0; j < 5; ++j)
+            {
+                append(log, makeSbf(4226, 112, static_cast<uint8_t>(i + j)));
+                append(log, makeSbf(4050, 56, static_cast<uint8_t>(i)));
+            }
+            std::vector<uint8_t> measEpoch = makeSbf(4027, 2096, '$');
+            measEpoch[100] = SBF_SYNC_BYTE_2;
+            measEpoch[1000] = static_cast<uint8_t>(i);
+            uint16_t crc = crc::compute16CCITT(measEpoch.data() + 4, 2096 - 4);
+            measEpoch[2] = crc & 0xFF;
+            measEpoch[3] = crc >> 8;
+            append(log, measEpoch);
+            append(log,
+                   "$GPGGA,121041.00,5050.1233,N,00441.1234,E,4,28,0.5,98.2,M,"
+                   "47.6,M,1.0,0000*47\r\n");
+        }
+        return log;
+    }
+
+    std::vector<std::shared_ptr<Telegram>> frameSequentially(
+        const std::vector<uint8_t>& log)
+    {
+        std::vector<std::shared_ptr<Telegram>> telegrams;
+        io::TelegramFramer framer([&telegrams](
+                                      const std::shared_ptr<Telegram>& telegram) {
+            telegrams.push_back(telegram);
+        });
+        framer.feed(log.data(), log.size(), 0);
+        return telegrams;
+    }
+} // namespace
+
+TEST(SbfChunkDecoderBenchmark, framing)
+{
+    std::vector<uint8_t> log = makeLog(20000);
+    const size_t expected = 20000 * 12;
+    const double megabytes = static_cast<double>(log.size()) / 1e6;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t sequential = frameSequentially(log).size();
+    double sequentialTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+    ASSERT_EQ(sequential, expected);
+
+    io::SbfChunkDecoder decoder(0);
+    size_t parallel = 0;
+    start = std::chrono::steady_clock::now();
+    decoder.decode(log.data(), log.size(),
+                   [&parallel](const std::shared_ptr<Telegram>&) {
+                       ++parallel;
+                       return true;
+                   });
+    double parallelTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+    ASSERT_EQ(parallel, expected);
+
+    std::cout << "[ BENCHMARK] " << expected << " telegrams, " << megabytes
+              << " MB" << std::endl;
+    std::cout << "[ BENCHMARK] sequential framing: " << megabytes / sequentialTime
+              << " MB/s" << std::endl;
+    std::cout << "[ BENCHMARK] chunked framing ("
+              << std::thread::hardware_concurrency()
+              << " threads): " << megabytes / parallelTime << " MB/s" << std::endl;
+}
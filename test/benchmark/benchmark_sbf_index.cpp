@@ -0,0 +1,129 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+// Linux
+#include <unistd.h>
+
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+
+namespace {
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint16_t wnc,
+                                 uint32_t tow)
+    {
+        std::vector<uint8_t> block(length, 0x24);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        for (size_t i = 0; i < 4; ++i)
+            block[8 + i] = (tow >> (8 * i)) & 0xFF;
+        block[12] = wnc & 0xFF;
+        block[13] = wnc >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void append(std::vector<uint8_t>& log, const std::vector<uint8_t>& data)
+    {
+        log.insert(log.end(), data.begin(), data.end());
+    }
+
+    void append(std::vector<uint8_t>& log, const std::string& data)
+    {
+        log.insert(log.end(), data.begin(), data.end());
+    }
+
+    //! Epochs of 100 ms with PVTGeodetic and INSNavGeod each and an NMEA sentence
+    void appendEpochs(std::vector<uint8_t>& log, uint32_t first, uint32_t count)
+    {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            append(log, makeSbf(4007, 96, 2300, i * 100));
+            append(log, makeSbf(4226 | (1 << 13), 112, 2300, i * 100));
+            append(log, "$GPGGA,1*47\r\n");
+        }
+    }
+
+    class SbfIndexBenchmark : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            sidecar_ =
+                (std::filesystem::temp_directory_path() /
+                 ("benchmark_sbf_index_" + std::to_string(getpid()) + ".idx"))
+                    .string();
+            std::filesystem::remove(sidecar_);
+        }
+
+        void TearDown() override { std::filesystem::remove(sidecar_); }
+
+        std::string sidecar_;
+    };
+} // namespace
+
+TEST_F(SbfIndexBenchmark, buildAndLoad)
+{
+    std::vector<uint8_t> log;
+    appendEpochs(log, 0, 200000);
+    const double megabytes = static_cast<double>(log.size()) / 1e6;
+
+    io::SbfIndex index;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+    double buildTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    io::SbfIndex cached;
+    start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(cached.update(sidecar_, log.data(), log.size()));
+    double loadTime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+    EXPECT_EQ(cached.loaded(), 400000u);
+
+    std::cout << "[ BENCHMARK] " << index.entries().size() << " blocks, "
+              << megabytes << " MB" << std::endl;
+    std::cout << "[ BENCHMARK] building index: " << megabytes / buildTime
+              << " MB/s" << std::endl;
+    std::cout << "[ BENCHMARK] loading sidecar: " << loadTime * 1e3 << " ms"
+              << std::endl;
+}
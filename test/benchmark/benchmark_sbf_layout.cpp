@@ -0,0 +1,373 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <gtest/gtest.h>
+
+// C++
+#include <chrono>
+#include <iostream>
+
+// Boost
+#include <boost/spirit/include/qi.hpp>
+
+#include <septentrio_gnss_driver/parsers/sbf_blocks.hpp>
+
+namespace {
+    class TestNode : public ROSaicNodeBase
+    {
+    public:
+        TestNode() : ROSaicNodeBase(rclcpp::NodeOptions()) {}
+
+    private:
+        void sendVelocity(const std::string&) override {}
+    };
+
+    //! Writes little endian fields of an SBF block at given offsets
+    class BlockWriter
+    {
+    public:
+        BlockWriter(uint16_t id, uint8_t revision, uint16_t length) :
+            block_(length, 0)
+        {
+            block_[0] = SBF_SYNC_1;
+            block_[1] = SBF_SYNC_2;
+            set<uint16_t>(4, id | (revision << 13));
+            set<uint16_t>(6, length);
+            set<uint32_t>(8, 345600000);
+            set<uint16_t>(12, 2300);
+        }
+
+        template <typename Val>
+        BlockWriter& set(size_t offset, Val val)
+        {
+            std::memcpy(block_.data() + offset, &val, sizeof(Val));
+            return *this;
+        }
+
+        const std::vector<uint8_t>& block() const { return block_; }
+
+    private:
+        std::vector<uint8_t> block_;
+    };
+
+    std::vector<uint8_t> makePvtGeodetic()
+    {
+        BlockWriter w(4007, 2, 96);
+        w.set<uint8_t>(14, 4).set<uint8_t>(15, 0);
+        w.set(16, 0.8870).set(24, 0.0788).set(32, 104.5);
+        w.set(40, 47.5f).set(44, 0.1f).set(48, -0.2f).set(52, 0.05f);
+        w.set(56, 123.4f).set(60, 0.25).set(68, -2e10f);
+        w.set<uint8_t>(72, 0).set<uint8_t>(73, 0).set<uint8_t>(74, 28);
+        w.set<uint8_t>(75, 2).set<uint16_t>(76, 1234).set<uint16_t>(78, 150);
+        w.set<uint32_t>(80, 0x12345678).set<uint8_t>(84, 1).set<uint8_t>(85, 1);
+        w.set<uint16_t>(86, 300).set<uint16_t>(88, 120).set<uint16_t>(90, 3);
+        w.set<uint16_t>(92, 5).set<uint8_t>(94, 7);
+        return w.block();
+    }
+
+    std::vector<uint8_t> makeInsNavGeod(uint16_t sbList)
+    {
+        size_t groups = 0;
+        for (uint16_t i = 0; i < 8; ++i)
+            groups += (sbList >> i) & 1;
+        BlockWriter w(4226, 0, static_cast<uint16_t>(56 + 12 * groups));
+        w.set<uint8_t>(14, 1).set<uint8_t>(15, 0).set<uint16_t>(16, 0x2f);
+        w.set<uint16_t>(18, 10).set(20, 0.8870).set(28, 0.0788).set(36, 104.5);
+        w.set(44, 47.5f).set<uint16_t>(48, 4).set<uint16_t>(50, 100);
+        w.set<uint8_t>(52, 0).set<uint16_t>(54, sbList);
+        for (size_t i = 0; i < 3 * groups; ++i)
+            w.set(56 + 4 * i, 0.5f + i);
+        return w.block();
+    }
+
+    std::vector<uint8_t> makeMeasEpoch(uint8_t n, uint8_t n2)
+    {
+        const uint8_t sb1Length = 20;
+        const uint8_t sb2Length = 12;
+        BlockWriter w(4027, 1, 20 + n * (sb1Length + n2 * sb2Length));
+        w.set<uint8_t>(14, n).set<uint8_t>(15, sb1Length);
+        w.set<uint8_t>(16, sb2Length).set<uint8_t>(17, 1).set<uint8_t>(18, 2);
+        size_t offset = 20;
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            w.set<uint8_t>(offset, i).set<uint8_t>(offset + 1, 0x20);
+            w.set<uint8_t>(offset + 2, i + 1).set<uint8_t>(offset + 3, 0x11);
+            w.set<uint32_t>(offset + 4, 1000000 + i).set<int32_t>(offset + 8, -5000);
+            w.set<uint16_t>(offset + 12, 777).set<int8_t>(offset + 14, -3);
+            w.set<uint8_t>(offset + 15, 180).set<uint16_t>(offset + 16, 600);
+            w.set<uint8_t>(offset + 18, 4).set<uint8_t>(offset + 19, n2);
+            offset += sb1Length;
+            for (uint8_t j = 0; j < n2; ++j)
+            {
+                w.set<uint8_t>(offset, j).set<uint8_t>(offset + 1, 60);
+                w.set<uint8_t>(offset + 2, 170).set<uint8_t>(offset + 3, 0x12);
+                w.set<int8_t>(offset + 4, -1).set<uint8_t>(offset + 5, 8);
+                w.set<uint16_t>(offset + 6, 1500).set<uint16_t>(offset + 8, 2500);
+                w.set<uint16_t>(offset + 10, 3500);
+                offset += sb2Length;
+            }
+        }
+        return w.block();
+    }
+
+    //! Per-field qi parsing as done before the layout tables, for comparison
+    namespace qi_reference {
+        namespace qi = boost::spirit::qi;
+
+        template <typename It, typename Val>
+        void parse(It& it, Val& val)
+        {
+            if constexpr (std::is_same<int8_t, Val>::value)
+                qi::parse(it, it + 1, qi::char_, val);
+            else if constexpr (std::is_same<uint8_t, Val>::value)
+                qi::parse(it, it + 1, qi::byte_, val);
+            else if constexpr (sizeof(Val) == 2)
+                qi::parse(it, it + 2, qi::little_word, val);
+            else if constexpr (std::is_same<float, Val>::value)
+            {
+                qi::parse(it, it + 4, qi::little_bin_float, val);
+                if (val == -2e10f)
+                    val = std::numeric_limits<float>::quiet_NaN();
+            } else if constexpr (std::is_same<double, Val>::value)
+            {
+                qi::parse(it, it + 8, qi::little_bin_double, val);
+                if (val == -2e10)
+                    val = std::numeric_limits<double>::quiet_NaN();
+            } else if constexpr (sizeof(Val) == 4)
+                qi::parse(it, it + 4, qi::little_dword, val);
+        }
+
+        template <typename It>
+        void header(It& it, BlockHeaderMsg& hdr)
+        {
+            parse(it, hdr.sync_1);
+            parse(it, hdr.sync_2);
+            parse(it, hdr.crc);
+            uint16_t ID;
+            parse(it, ID);
+            hdr.id = ID & 8191;
+            hdr.revision = ID >> 13;
+            parse(it, hdr.length);
+            parse(it, hdr.tow);
+            parse(it, hdr.wnc);
+        }
+
+        template <typename It>
+        bool PVTGeodeticParser(It it, It itEnd, PVTGeodeticMsg& msg)
+        {
+            header(it, msg.block_header);
+            parse(it, msg.mode);
+            parse(it, msg.error);
+            parse(it, msg.latitude);
+            parse(it, msg.longitude);
+            parse(it, msg.height);
+            parse(it, msg.undulation);
+            parse(it, msg.vn);
+            parse(it, msg.ve);
+            parse(it, msg.vu);
+            parse(it, msg.cog);
+            parse(it, msg.rx_clk_bias);
+            parse(it, msg.rx_clk_drift);
+            parse(it, msg.time_system);
+            parse(it, msg.datum);
+            parse(it, msg.nr_sv);
+            parse(it, msg.wa_corr_info);
+            parse(it, msg.reference_id);
+            parse(it, msg.mean_corr_age);
+            parse(it, msg.signal_info);
+            parse(it, msg.alert_flag);
+            parse(it, msg.nr_bases);
+            parse(it, msg.ppp_info);
+            parse(it, msg.latency);
+            parse(it, msg.h_accuracy);
+            parse(it, msg.v_accuracy);
+            parse(it, msg.misc);
+            return it <= itEnd;
+        }
+
+        template <typename It>
+        bool INSNavGeodParser(It it, It itEnd, INSNavGeodMsg& msg)
+        {
+            header(it, msg.block_header);
+            parse(it, msg.gnss_mode);
+            parse(it, msg.error);
+            parse(it, msg.info);
+            parse(it, msg.gnss_age);
+            parse(it, msg.latitude);
+            parse(it, msg.longitude);
+            parse(it, msg.height);
+            parse(it, msg.undulation);
+            parse(it, msg.accuracy);
+            parse(it, msg.latency);
+            parse(it, msg.datum);
+            ++it; // reserved
+            parse(it, msg.sb_list);
+            auto group = [&](uint16_t bit, float& a, float& b, float& c) {
+                if ((msg.sb_list & bit) != 0)
+                {
+                    parse(it, a);
+                    parse(it, b);
+                    parse(it, c);
+                } else
+                {
+                    a = b = c = std::numeric_limits<float>::quiet_NaN();
+                }
+            };
+            group(1, msg.latitude_std_dev, msg.longitude_std_dev,
+                  msg.height_std_dev);
+            group(2, msg.heading, msg.pitch, msg.roll);
+            group(4, msg.heading_std_dev, msg.pitch_std_dev, msg.roll_std_dev);
+            group(8, msg.ve, msg.vn, msg.vu);
+            group(16, msg.ve_std_dev, msg.vn_std_dev, msg.vu_std_dev);
+            group(32, msg.latitude_longitude_cov, msg.latitude_height_cov,
+                  msg.longitude_height_cov);
+            group(64, msg.heading_pitch_cov, msg.heading_roll_cov,
+                  msg.pitch_roll_cov);
+            group(128, msg.ve_vn_cov, msg.ve_vu_cov, msg.vn_vu_cov);
+            return it <= itEnd;
+        }
+
+        template <typename It>
+        bool MeasEpochParser(It it, It itEnd, MeasEpochMsg& msg)
+        {
+            header(it, msg.block_header);
+            parse(it, msg.n);
+            parse(it, msg.sb1_length);
+            parse(it, msg.sb2_length);
+            parse(it, msg.common_flags);
+            parse(it, msg.cum_clk_jumps);
+            ++it; // reserved
+            msg.type1.resize(msg.n);
+            for (auto& type1 : msg.type1)
+            {
+                parse(it, type1.rx_channel);
+                parse(it, type1.type);
+                parse(it, type1.sv_id);
+                parse(it, type1.misc);
+                parse(it, type1.code_lsb);
+                parse(it, type1.doppler);
+                parse(it, type1.carrier_lsb);
+                parse(it, type1.carrier_msb);
+                parse(it, type1.cn0);
+                parse(it, type1.lock_time);
+                parse(it, type1.obs_info);
+                parse(it, type1.n2);
+                std::advance(it, msg.sb1_length - 20);
+                type1.type2.resize(type1.n2);
+                for (auto& type2 : type1.type2)
+                {
+                    parse(it, type2.type);
+                    parse(it, type2.lock_time);
+                    parse(it, type2.cn0);
+                    parse(it, type2.offsets_msb);
+                    parse(it, type2.carrier_msb);
+                    parse(it, type2.obs_info);
+                    parse(it, type2.code_offset_lsb);
+                    parse(it, type2.carrier_lsb);
+                    parse(it, type2.doppler_offset_lsb);
+                    std::advance(it, msg.sb2_length - 12);
+                }
+            }
+            return it <= itEnd;
+        }
+    } // namespace qi_reference
+
+    template <typename F>
+    double nsPerCall(size_t calls, F&& f)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < calls; ++i)
+            f();
+        return std::chrono::duration<double, std::nano>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() /
+               calls;
+    }
+} // namespace
+
+class SbfLayoutBenchmark : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite() { rclcpp::init(0, nullptr); }
+
+    static void TearDownTestSuite() { rclcpp::shutdown(); }
+};
+
+TEST_F(SbfLayoutBenchmark, layoutVersusQi)
+{
+    const size_t calls = 100000;
+    TestNode node;
+
+    std::vector<uint8_t> pvt = makePvtGeodetic();
+    PVTGeodeticMsg pvtMsg;
+    bool ok = true;
+    double pvtQi = nsPerCall(calls, [&]() {
+        ok &= qi_reference::PVTGeodeticParser(pvt.begin(), pvt.end(), pvtMsg);
+    });
+    double pvtLayout = nsPerCall(calls, [&]() {
+        ok &= PVTGeodeticParser(&node, pvt.begin(), pvt.end(), pvtMsg);
+    });
+
+    std::vector<uint8_t> ins = makeInsNavGeod(0xFF);
+    INSNavGeodMsg insMsg;
+    double insQi = nsPerCall(calls, [&]() {
+        ok &= qi_reference::INSNavGeodParser(ins.begin(), ins.end(), insMsg);
+    });
+    double insLayout = nsPerCall(calls, [&]() {
+        ok &= INSNavGeodParser(&node, ins.begin(), ins.end(), insMsg, false);
+    });
+
+    std::vector<uint8_t> meas = makeMeasEpoch(40, 2);
+    MeasEpochMsg measMsg;
+    MeasEpoch measFlat;
+    double measQi = nsPerCall(calls / 10, [&]() {
+        ok &= qi_reference::MeasEpochParser(meas.begin(), meas.end(), measMsg);
+    });
+    double measLayout = nsPerCall(calls / 10, [&]() {
+        ok &= MeasEpochParser(&node, meas.begin(), meas.end(), measFlat);
+    });
+    double measToMsg = nsPerCall(calls / 10, [&]() {
+        MeasEpochMsg msg;
+        measEpochToMsg(measFlat, msg);
+        ok &= (msg.type1.size() == 40);
+    });
+    EXPECT_TRUE(ok);
+
+    std::cout << "[ BENCHMARK] PVTGeodetic qi: " << pvtQi
+              << " ns/block, layout: " << pvtLayout << " ns/block" << std::endl;
+    std::cout << "[ BENCHMARK] INSNavGeod qi: " << insQi
+              << " ns/block, layout: " << insLayout << " ns/block" << std::endl;
+    std::cout << "[ BENCHMARK] MeasEpoch (40x2 channels) qi: " << measQi
+              << " ns/block, layout: " << measLayout
+              << " ns/block, message assembly: " << measToMsg << " ns/block"
+              << std::endl;
+    EXPECT_LT(pvtLayout, pvtQi);
+    EXPECT_LT(insLayout, insQi);
+}
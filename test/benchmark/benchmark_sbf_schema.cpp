@@ -0,0 +1,110 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <septentrio_gnss_driver/parsers/sbf_schema.hpp>
+
+namespace {
+    //! Writes little endian fields of an SBF block at given offsets
+    class BlockWriter
+    {
+    public:
+        BlockWriter(uint16_t id, uint8_t revision, uint16_t length) :
+            block_(length, 0)
+        {
+            block_[0] = '$';
+            block_[1] = '@';
+            set<uint16_t>(4, id | (revision << 13));
+            set<uint16_t>(6, length);
+            set<uint32_t>(8, 345600000);
+            set<uint16_t>(12, 2300);
+        }
+
+        template <typename Val>
+        BlockWriter& set(size_t offset, Val val)
+        {
+            std::memcpy(block_.data() + offset, &val, sizeof(Val));
+            return *this;
+        }
+
+        const std::vector<uint8_t>& block() const { return block_; }
+
+    private:
+        std::vector<uint8_t> block_;
+    };
+
+    std::vector<uint8_t> makeSatVisibility(uint8_t n)
+    {
+        BlockWriter w(4012, 0, static_cast<uint16_t>(16 + 8 * n));
+        w.set<uint8_t>(14, n).set<uint8_t>(15, 8);
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            size_t sb = 16 + 8 * i;
+            w.set<uint8_t>(sb, i + 1).set<uint8_t>(sb + 1, 0);
+            w.set<uint16_t>(sb + 2, 100 * i + 12345).set<int16_t>(sb + 4, 4500);
+            w.set<uint8_t>(sb + 6, 1).set<uint8_t>(sb + 7, 3);
+        }
+        return w.block();
+    }
+} // namespace
+
+TEST(SbfSchemaBenchmark, satVisibility)
+{
+    const size_t blocks = 100000;
+    auto block = makeSatVisibility(40);
+    const sbf_schema::Block& schema = *sbf_schema::find(4012);
+    const size_t azimuth = sbf_schema::fieldIndex(schema.subBlocks->fields,
+                                                  "Azimuth");
+
+    double sum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < blocks; ++i)
+    {
+        sbf_schema::BlockView view;
+        if (!view.parse(schema, block.data(), block.size()))
+            break;
+        for (size_t sb = 0; sb < view.subBlockCount(); ++sb)
+            sum += view.subBlockField(sb, azimuth).value();
+    }
+    double ns = std::chrono::duration<double, std::nano>(
+                    std::chrono::steady_clock::now() - start)
+                    .count() /
+                blocks;
+
+    EXPECT_GT(sum, 0.0);
+    std::cout << "[ BENCHMARK] SatVisibility with 40 satellites: " << ns
+              << " ns per block" << std::endl;
+}
@@ -0,0 +1,287 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+// Boost
+#include <boost/asio.hpp>
+
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+
+namespace {
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint8_t fill)
+    {
+        std::vector<uint8_t> block(length, fill);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::string& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    //! Typical mix of a live stream: INS at high rate, MeasEpoch, NMEA and a
+    //! command response terminated by the connection descriptor prompt
+    std::vector<uint8_t> makeStream(size_t epochs, size_t& telegrams)
+    {
+        std::vector<uint8_t> stream;
+        telegrams = 0;
+        for (size_t i = 0; i < epochs; ++i)
+        {
+            for (size_t j = 0; j < 5; ++j)
+            {
+                append(stream, makeSbf(4226, 112, static_cast<uint8_t>(i + j)));
+                append(stream, makeSbf(4050, 56, static_cast<uint8_t>(i)));
+                telegrams += 2;
+            }
+            append(stream, makeSbf(4027, 2096, static_cast<uint8_t>(i)));
+            append(stream,
+                   "$GPGGA,121041.00,5050.1233,N,00441.1234,E,4,28,0.5,98.2,M,"
+                   "47.6,M,1.0,0000*47\r\n");
+            append(stream,
+                   "$INGGA,121041.00,5050.1233,N,00441.1234,E,4,28,0.5,98.2,M,"
+                   "47.6,M,1.0,0000*47\r\n");
+            // The indented line continues the response
+            append(stream, "$R: grc\r\n  ReceiverCapabilities, ...\r\n");
+            append(stream, "IP10>");
+            telegrams += 5;
+        }
+        return stream;
+    }
+
+    struct Collector
+    {
+        std::vector<std::shared_ptr<Telegram>> telegrams;
+        size_t faults = 0;
+
+        io::TelegramFramer framer()
+        {
+            return io::TelegramFramer(
+                [this](const std::shared_ptr<Telegram>& telegram) {
+                    telegrams.push_back(telegram);
+                },
+                [this](const std::string&) { ++faults; });
+        }
+    };
+
+    /**
+     * @brief Reproduces the read pattern of the former byte-wise AsyncManager
+     * state machine: one async_read per sync byte, one for the SBF header, one for
+     * the SBF body and one per byte of ASCII telegrams
+     */
+    class ByteWiseReader
+    {
+    public:
+        ByteWiseReader(boost::asio::local::stream_protocol::socket& socket,
+                       size_t expected) :
+            socket_(socket), expected_(expected)
+        {
+        }
+
+        void start() { readSync(0); }
+
+        size_t handlerCalls = 0;
+        size_t telegrams = 0;
+
+    private:
+        void next()
+        {
+            if (++telegrams < expected_)
+                readSync(0);
+        }
+
+        void readSync(size_t index)
+        {
+            message_.resize(3);
+            boost::asio::async_read(
+                socket_, boost::asio::buffer(message_.data() + index, 1),
+                [this, index](boost::system::error_code ec, std::size_t) {
+                    ++handlerCalls;
+                    if (ec)
+                        return;
+                    uint8_t byte = message_[index];
+                    if (index == 0 && byte != SYNC_BYTE_1)
+                    {
+                        message_.resize(1);
+                        readString();
+                    } else if (index == 1 && byte == SBF_SYNC_BYTE_2)
+                        readSbf();
+                    else if (index < 2)
+                        readSync(index + 1);
+                    else
+                        readString();
+                });
+        }
+
+        void readSbf()
+        {
+            message_.resize(SBF_HEADER_SIZE);
+            boost::asio::async_read(
+                socket_, boost::asio::buffer(message_.data() + 2, 6),
+                [this](boost::system::error_code ec, std::size_t) {
+                    ++handlerCalls;
+                    if (ec)
+                        return;
+                    uint16_t length = parsing_utilities::getLength(message_);
+                    message_.resize(length);
+                    boost::asio::async_read(
+                        socket_,
+                        boost::asio::buffer(message_.data() + SBF_HEADER_SIZE,
+                                            length - SBF_HEADER_SIZE),
+                        [this](boost::system::error_code ec, std::size_t) {
+                            ++handlerCalls;
+                            if (!ec)
+                                next();
+                        });
+                });
+        }
+
+        void readString()
+        {
+            boost::asio::async_read(
+                socket_, boost::asio::buffer(&byte_, 1),
+                [this](boost::system::error_code ec, std::size_t) {
+                    ++handlerCalls;
+                    if (ec)
+                        return;
+                    message_.push_back(byte_);
+                    if (byte_ == LF || byte_ == CONNECTION_DESCRIPTOR_FOOTER)
+                        next();
+                    else
+                        readString();
+                });
+        }
+
+        boost::asio::local::stream_protocol::socket& socket_;
+        size_t expected_;
+        std::vector<uint8_t> message_;
+        uint8_t byte_;
+    };
+
+    void writeStream(boost::asio::local::stream_protocol::socket& socket,
+                     const std::vector<uint8_t>& stream)
+    {
+        // Written in receiver sized bursts, i.e. one epoch at a time
+        const size_t burst = 4096;
+        for (size_t i = 0; i < stream.size(); i += burst)
+            boost::asio::write(socket,
+                               boost::asio::buffer(stream.data() + i,
+                                                   std::min(burst, stream.size() - i)));
+    }
+} // namespace
+
+TEST(TelegramFramerBenchmark, handlerCallsPerTelegram)
+{
+    size_t expected;
+    const std::vector<uint8_t> stream = makeStream(500, expected);
+
+    double byteWiseCalls;
+    double byteWiseTime;
+    {
+        boost::asio::io_context ioContext;
+        boost::asio::local::stream_protocol::socket reader(ioContext);
+        boost::asio::local::stream_protocol::socket writer(ioContext);
+        boost::asio::local::connect_pair(reader, writer);
+
+        ByteWiseReader byteWise(reader, expected);
+        byteWise.start();
+        auto start = std::chrono::steady_clock::now();
+        std::thread writerThread([&] { writeStream(writer, stream); });
+        ioContext.run();
+        writerThread.join();
+        byteWiseTime = std::chrono::duration<double, std::micro>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        ASSERT_EQ(byteWise.telegrams, expected);
+        byteWiseCalls = static_cast<double>(byteWise.handlerCalls);
+    }
+
+    double framerCalls = 0;
+    double framerTime;
+    {
+        boost::asio::io_context ioContext;
+        boost::asio::local::stream_protocol::socket reader(ioContext);
+        boost::asio::local::stream_protocol::socket writer(ioContext);
+        boost::asio::local::connect_pair(reader, writer);
+
+        Collector collector;
+        io::TelegramFramer framer = collector.framer();
+        std::array<uint8_t, 16384> buf;
+        std::function<void()> read = [&]() {
+            reader.async_read_some(
+                boost::asio::buffer(buf),
+                [&](boost::system::error_code ec, std::size_t numBytes) {
+                    ++framerCalls;
+                    framer.feed(buf.data(), numBytes, 0);
+                    if (!ec && collector.telegrams.size() < expected)
+                        read();
+                });
+        };
+        read();
+        auto start = std::chrono::steady_clock::now();
+        std::thread writerThread([&] { writeStream(writer, stream); });
+        ioContext.run();
+        writerThread.join();
+        framerTime = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+        ASSERT_EQ(collector.telegrams.size(), expected);
+    }
+
+    std::cout << "[ BENCHMARK] " << expected << " telegrams, "
+              << stream.size() << " bytes" << std::endl;
+    std::cout << "[ BENCHMARK] byte-wise reads: " << byteWiseCalls / expected
+              << " handler calls per telegram, " << byteWiseTime / expected
+              << " us per telegram" << std::endl;
+    std::cout << "[ BENCHMARK] framer:          " << framerCalls / expected
+              << " handler calls per telegram, " << framerTime / expected
+              << " us per telegram" << std::endl;
+
+    EXPECT_LT(framerCalls, byteWiseCalls);
+    EXPECT_LT(framerCalls / expected, 1.0);
+}
@@ -0,0 +1,197 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <septentrio_gnss_driver/communication/telegram_queue.hpp>
+
+namespace {
+    std::shared_ptr<Telegram> makeTelegram(telegram_type::TelegramType type,
+                                           uint16_t id = 0, uint8_t tag = 0)
+    {
+        auto telegram = std::make_shared<Telegram>();
+        telegram->type = type;
+        // Sync bytes, CRC, ID and a tag to tell telegrams apart
+        telegram->message = {SYNC_BYTE_1,
+                             SBF_SYNC_BYTE_2,
+                             0,
+                             0,
+                             static_cast<uint8_t>(id & 0xFF),
+                             static_cast<uint8_t>(id >> 8),
+                             tag};
+        return telegram;
+    }
+
+    uint8_t tagOf(const std::shared_ptr<Telegram>& telegram)
+    {
+        return telegram->message[6];
+    }
+
+    typedef std::chrono::steady_clock Clock;
+
+    struct Item
+    {
+        Clock::time_point stamp;
+    };
+
+    struct Result
+    {
+        double throughput;
+        double medianLatency;
+        double p99Latency;
+    };
+
+    template <typename Queue>
+    Result run(Queue& queue, int producers, int perProducer,
+               std::chrono::microseconds period)
+    {
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back([&queue, perProducer, period]() {
+                for (int i = 0; i < perProducer; ++i)
+                {
+                    if (period.count() > 0)
+                        std::this_thread::sleep_for(period);
+                    queue.push(Item{Clock::now()});
+                }
+            });
+
+        std::vector<double> latencies;
+        latencies.reserve(producers * perProducer);
+        auto start = Clock::now();
+        for (int n = 0; n < producers * perProducer; ++n)
+        {
+            Item item;
+            queue.pop(item);
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(Clock::now() - item.stamp)
+                    .count());
+        }
+        double duration =
+            std::chrono::duration<double>(Clock::now() - start).count();
+        for (auto& thread : threads)
+            thread.join();
+
+        std::sort(latencies.begin(), latencies.end());
+        return Result{latencies.size() / duration,
+                      latencies[latencies.size() / 2],
+                      latencies[latencies.size() * 99 / 100]};
+    }
+
+    void print(const std::string& name, const Result& result)
+    {
+        std::cout << "[ BENCHMARK] " << name << ": " << result.throughput / 1e6
+                  << " M items/s, latency median " << result.medianLatency
+                  << " us, p99 " << result.p99Latency << " us" << std::endl;
+    }
+} // namespace
+
+TEST(TelegramQueueBenchmark, throughput)
+{
+    for (int producers : {1, 4})
+    {
+        const int perProducer = 500000 / producers;
+        ConcurrentQueue<Item> mutexQueue;
+        LockFreeQueue<Item> lockFreeQueue(4096);
+        print("ConcurrentQueue, " + std::to_string(producers) + " producer(s)",
+              run(mutexQueue, producers, perProducer, std::chrono::microseconds(0)));
+        print("LockFreeQueue,   " + std::to_string(producers) + " producer(s)",
+              run(lockFreeQueue, producers, perProducer,
+                  std::chrono::microseconds(0)));
+    }
+}
+
+TEST(TelegramQueueBenchmark, latency)
+{
+    // Paced like a receiver stream, so the consumer waits for every element
+    for (int producers : {1, 4})
+    {
+        const int perProducer = 5000 / producers;
+        ConcurrentQueue<Item> mutexQueue;
+        LockFreeQueue<Item> lockFreeQueue(4096);
+        print("ConcurrentQueue, " + std::to_string(producers) + " producer(s)",
+              run(mutexQueue, producers, perProducer,
+                  std::chrono::microseconds(50)));
+        print("LockFreeQueue,   " + std::to_string(producers) + " producer(s)",
+              run(lockFreeQueue, producers, perProducer,
+                  std::chrono::microseconds(50)));
+    }
+}
+
+TEST(TelegramQueueBenchmark, priorityLanes)
+{
+    // Per epoch a MeasEpoch and a ChannelStatus block, which take long to handle,
+    // are followed by an INSNavGeod block
+    const int epochs = 50;
+    for (bool lanes : {false, true})
+    {
+        TelegramQueue queue(64);
+        if (lanes)
+        {
+            queue.setPriority(4226, telegram_priority::HIGH);
+            queue.setPriority(4027, telegram_priority::LOW);
+            queue.setPriority(4013, telegram_priority::LOW);
+        }
+        std::vector<Clock::time_point> pushed(epochs);
+        std::thread producer([&queue, &pushed]() {
+            for (int i = 0; i < epochs; ++i)
+            {
+                queue.push(makeTelegram(telegram_type::SBF, 4027));
+                queue.push(makeTelegram(telegram_type::SBF, 4013));
+                pushed[i] = Clock::now();
+                queue.push(makeTelegram(telegram_type::SBF, 4226, i));
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        });
+
+        LatencyHistogram insLatency;
+        for (int n = 0; n < 3 * epochs; ++n)
+        {
+            std::shared_ptr<Telegram> telegram;
+            queue.pop(telegram);
+            if (parsing_utilities::getId(telegram->message) == 4226)
+                insLatency.add(Clock::now() - pushed[tagOf(telegram)]);
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        producer.join();
+
+        std::cout << "[ BENCHMARK] " << (lanes ? "priority lanes" : "single lane")
+                  << ", INSNavGeod latency p50 < " << insLatency.percentile(0.5)
+                  << " us, p99 < " << insLatency.percentile(0.99)
+                  << " us: " << insLatency.toString() << std::endl;
+    }
+}
@@ -0,0 +1,123 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <thread>
+
+#include <septentrio_gnss_driver/communication/command_pipeline.hpp>
+
+using namespace std::chrono_literals;
+
+TEST(CommandPipelineTest, depth)
+{
+    io::CommandPipeline pipeline(2);
+    EXPECT_TRUE(pipeline.admit("sso, all, none, none, off \x0D"));
+    EXPECT_TRUE(pipeline.admit("sno, all, none, none, off \x0D"));
+
+    std::atomic<bool> admitted = false;
+    std::thread sender([&]() {
+        EXPECT_TRUE(pipeline.admit("grc \x0D"));
+        admitted = true;
+    });
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(admitted);
+
+    pipeline.respond("$R: sso, all, none, none, off\r\n  SBFOutput\r\n", false);
+    sender.join();
+    EXPECT_TRUE(admitted);
+    EXPECT_EQ(pipeline.commands(), 3u);
+}
+
+TEST(CommandPipelineTest, matching)
+{
+    io::CommandPipeline pipeline;
+    EXPECT_TRUE(pipeline.admit("sso, all, none, none, off \x0D"));
+    EXPECT_TRUE(pipeline.admit("sga, MultiAntenna \x0D"));
+    EXPECT_TRUE(pipeline.admit("sgd, WGS84\x0D"));
+
+    // Echo of the third command
+    pipeline.respond("$R: sgd, WGS84\r\n  GeodeticDatum, WGS84\r\n", false);
+    // No echo matches, answers the oldest command
+    pipeline.respond("$R: setSBFOutput, all\r\n", false);
+    EXPECT_FALSE(pipeline.failed());
+
+    std::thread responder([&]() {
+        std::this_thread::sleep_for(10ms);
+        pipeline.respond("$R: sga, MultiAntenna\r\n", false);
+    });
+    EXPECT_TRUE(pipeline.flush());
+    responder.join();
+
+    // Unsolicited responses are ignored
+    pipeline.respond("$R: grc\r\n", false);
+    EXPECT_TRUE(pipeline.flush());
+}
+
+TEST(CommandPipelineTest, failFast)
+{
+    io::CommandPipeline pipeline;
+    EXPECT_TRUE(pipeline.admit("sptp, on \x0D"));
+    EXPECT_TRUE(pipeline.admit("sgd, WGS84\x0D"));
+    pipeline.respond("$R? sptp, on : Invalid command!\r\n", true);
+
+    EXPECT_TRUE(pipeline.failed());
+    EXPECT_EQ(pipeline.failure(), "$R? sptp, on : Invalid command!");
+    EXPECT_FALSE(pipeline.admit("sno, all, none, none, off \x0D"));
+    EXPECT_FALSE(pipeline.flush());
+    EXPECT_EQ(pipeline.commands(), 2u);
+
+    pipeline.reset();
+    EXPECT_FALSE(pipeline.failed());
+    EXPECT_TRUE(pipeline.admit("sgd, WGS84\x0D"));
+}
+
+TEST(CommandPipelineTest, timeout)
+{
+    io::CommandPipeline pipeline(8, 50ms);
+    EXPECT_TRUE(pipeline.admit("login, user, secret \x0D"));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(pipeline.flush());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 50ms);
+    EXPECT_EQ(pipeline.failure(), "no response to login");
+}
+
+TEST(CommandPipelineTest, cancel)
+{
+    io::CommandPipeline pipeline(1);
+    EXPECT_TRUE(pipeline.admit("grc \x0D"));
+
+    std::thread sender([&]() { EXPECT_FALSE(pipeline.admit("sgd, WGS84\x0D")); });
+    std::this_thread::sleep_for(10ms);
+    pipeline.cancel();
+    sender.join();
+    EXPECT_FALSE(pipeline.flush());
+}
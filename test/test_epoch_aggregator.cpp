@@ -0,0 +1,249 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <septentrio_gnss_driver/communication/epoch_aggregator.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+    typedef io::EpochAggregator Aggregator;
+
+    const uint16_t WNC = 2300;
+    const uint32_t TOW = 345600000;
+    const uint64_t MS = 1000000ull;
+
+    const Aggregator::Outputs NAVSATFIX = Aggregator::bit(Aggregator::NAVSATFIX);
+    const Aggregator::Outputs POSE = Aggregator::bit(Aggregator::POSE);
+    const Aggregator::Outputs TWIST = Aggregator::bit(Aggregator::TWIST);
+    const Aggregator::Outputs GPSFIX = Aggregator::bit(Aggregator::GPSFIX);
+} // namespace
+
+TEST(EpochAggregatorTest, reportsOncePerEpoch)
+{
+    Aggregator aggregator;
+    const Aggregator::Outputs enabled = NAVSATFIX | POSE | TWIST;
+
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, enabled), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 1, enabled),
+              NAVSATFIX);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::VEL_COV_GEODETIC, 2, enabled),
+              TWIST);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::ATT_EULER, 3, enabled), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::ATT_COV_EULER, 4, enabled),
+              POSE);
+    EXPECT_EQ(aggregator.completeEpochs(), 1u);
+
+    // Blocks not needed by the enabled messages do not report again
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::DOP, 5, enabled), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 6, enabled),
+              0);
+    EXPECT_EQ(aggregator.completeEpochs(), 1u);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+}
+
+TEST(EpochAggregatorTest, blockOrder)
+{
+    Aggregator aggregator;
+
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::DOP, 0, GPSFIX), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::MEAS_EPOCH, 0, GPSFIX), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::ATT_COV_EULER, 0, GPSFIX), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::ATT_EULER, 0, GPSFIX), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::CHANNEL_STATUS, 0, GPSFIX), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::VEL_COV_GEODETIC, 0, GPSFIX),
+              0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 0, GPSFIX),
+              0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, GPSFIX),
+              GPSFIX);
+}
+
+TEST(EpochAggregatorTest, incompleteOnNextEpoch)
+{
+    Aggregator aggregator;
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, POSE);
+    aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 0, POSE);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+
+    aggregator.add(WNC, TOW + 100, Aggregator::PVT_GEODETIC, 100 * MS, POSE);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 1u);
+
+    // Blocks of the previous epoch arriving late are ignored
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::ATT_EULER, 101 * MS, POSE), 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::ATT_COV_EULER, 102 * MS, POSE),
+              0);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 1u);
+    EXPECT_EQ(aggregator.completeEpochs(), 0u);
+}
+
+TEST(EpochAggregatorTest, partialOnNextEpoch)
+{
+    Aggregator aggregator;
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, NAVSATFIX | POSE);
+    aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 1, NAVSATFIX | POSE);
+    aggregator.add(WNC, TOW, Aggregator::ATT_EULER, 2, NAVSATFIX | POSE);
+
+    // Blocks of the same epoch do not end it
+    EXPECT_EQ(aggregator.end(WNC, TOW, 3).outputs, 0);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+
+    const Aggregator::Partial partial = aggregator.end(WNC, TOW + 100, 100 * MS);
+    EXPECT_EQ(partial.outputs, POSE);
+    EXPECT_EQ(partial.received, Aggregator::PVT_GEODETIC |
+                                    Aggregator::POS_COV_GEODETIC |
+                                    Aggregator::ATT_EULER);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 1u);
+    EXPECT_EQ(aggregator.end(WNC, TOW + 100, 100 * MS).outputs, 0);
+
+    aggregator.add(WNC, TOW + 100, Aggregator::PVT_GEODETIC, 100 * MS, POSE);
+    EXPECT_EQ(aggregator.close().outputs, POSE);
+    EXPECT_EQ(aggregator.close().outputs, 0);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 2u);
+}
+
+TEST(EpochAggregatorTest, expireWithoutBlocks)
+{
+    Aggregator aggregator(50ms);
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 10 * MS, NAVSATFIX);
+    EXPECT_EQ(aggregator.expire(60 * MS).outputs, 0);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+
+    const Aggregator::Partial partial = aggregator.expire(61 * MS);
+    EXPECT_EQ(partial.outputs, NAVSATFIX);
+    EXPECT_EQ(partial.received, Aggregator::PVT_GEODETIC);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 1u);
+
+    // Late blocks of the expired epoch are ignored
+    EXPECT_EQ(
+        aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 62 * MS, NAVSATFIX),
+        0);
+    EXPECT_EQ(aggregator.expire(1000 * MS).outputs, 0);
+}
+
+TEST(EpochAggregatorTest, blocksNotOutput)
+{
+    Aggregator aggregator;
+    // E.g. a replay of a log without ChannelStatus and DOP
+    aggregator.setBlocks(Aggregator::ALL_BLOCKS & ~Aggregator::CHANNEL_STATUS &
+                         ~Aggregator::DOP);
+    EXPECT_EQ(aggregator.needs(GPSFIX),
+              Aggregator::PVT_GEODETIC | Aggregator::POS_COV_GEODETIC |
+                  Aggregator::VEL_COV_GEODETIC | Aggregator::ATT_EULER |
+                  Aggregator::ATT_COV_EULER | Aggregator::MEAS_EPOCH);
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, GPSFIX);
+    aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 0, GPSFIX);
+    aggregator.add(WNC, TOW, Aggregator::VEL_COV_GEODETIC, 0, GPSFIX);
+    aggregator.add(WNC, TOW, Aggregator::ATT_EULER, 0, GPSFIX);
+    aggregator.add(WNC, TOW, Aggregator::ATT_COV_EULER, 0, GPSFIX);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::MEAS_EPOCH, 0, GPSFIX),
+              GPSFIX);
+    EXPECT_EQ(aggregator.completeEpochs(), 1u);
+
+    // PVTGeodetic is always waited for
+    aggregator.setBlocks(Aggregator::POS_COV_GEODETIC);
+    EXPECT_EQ(aggregator.needs(NAVSATFIX | TWIST),
+              Aggregator::PVT_GEODETIC | Aggregator::POS_COV_GEODETIC);
+}
+
+TEST(EpochAggregatorTest, timeout)
+{
+    Aggregator aggregator(50ms);
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, NAVSATFIX);
+    EXPECT_EQ(
+        aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 60 * MS, NAVSATFIX),
+        0);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 1u);
+
+    aggregator.setTimeout(100ms);
+    aggregator.add(WNC, TOW + 1000, Aggregator::PVT_GEODETIC, 1000 * MS,
+                   NAVSATFIX);
+    EXPECT_EQ(aggregator.add(WNC, TOW + 1000, Aggregator::POS_COV_GEODETIC,
+                             1060 * MS, NAVSATFIX),
+              NAVSATFIX);
+    EXPECT_EQ(aggregator.completeEpochs(), 1u);
+}
+
+TEST(EpochAggregatorTest, noTimeout)
+{
+    Aggregator aggregator(0ms);
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, NAVSATFIX);
+    EXPECT_EQ(aggregator.expire(3600000 * MS).outputs, 0);
+    EXPECT_EQ(aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC,
+                             3600000 * MS, NAVSATFIX),
+              NAVSATFIX);
+    EXPECT_EQ(aggregator.completeEpochs(), 1u);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+}
+
+TEST(EpochAggregatorTest, weekRollover)
+{
+    Aggregator aggregator;
+
+    aggregator.add(WNC, 604799900, Aggregator::PVT_GEODETIC, 0, NAVSATFIX);
+    EXPECT_EQ(aggregator.add(WNC + 1, 0, Aggregator::PVT_GEODETIC, 100 * MS,
+                             NAVSATFIX),
+              0);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 1u);
+    EXPECT_EQ(aggregator.add(WNC + 1, 0, Aggregator::POS_COV_GEODETIC, 101 * MS,
+                             NAVSATFIX),
+              NAVSATFIX);
+}
+
+TEST(EpochAggregatorTest, timeJumpingBack)
+{
+    Aggregator aggregator;
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, NAVSATFIX);
+    aggregator.add(WNC, TOW, Aggregator::POS_COV_GEODETIC, 0, NAVSATFIX);
+
+    // E.g. the next of several concatenated logs
+    aggregator.add(WNC - 1, TOW, Aggregator::PVT_GEODETIC, 100 * MS, NAVSATFIX);
+    EXPECT_EQ(aggregator.add(WNC - 1, TOW, Aggregator::POS_COV_GEODETIC, 101 * MS,
+                             NAVSATFIX),
+              NAVSATFIX);
+    EXPECT_EQ(aggregator.completeEpochs(), 2u);
+}
+
+TEST(EpochAggregatorTest, nothingEnabled)
+{
+    Aggregator aggregator;
+
+    aggregator.add(WNC, TOW, Aggregator::PVT_GEODETIC, 0, 0);
+    aggregator.add(WNC, TOW + 100, Aggregator::PVT_GEODETIC, 100 * MS, 0);
+    EXPECT_EQ(aggregator.completeEpochs(), 0u);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+}
@@ -0,0 +1,152 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <set>
+
+#include <septentrio_gnss_driver/communication/io_context_pool.hpp>
+
+TEST(IoContextPoolTest, constantThreads)
+{
+    io::IoContextPool pool(2);
+    EXPECT_EQ(pool.threads(), 2u);
+
+    // The number of threads does not depend on the number of connections
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+    io::PendingOperations pending;
+    std::vector<io::Strand> strands;
+    for (int i = 0; i < 64; ++i)
+        strands.push_back(pool.makeStrand());
+    for (auto& strand : strands)
+        for (int i = 0; i < 16; ++i)
+            boost::asio::post(strand, [&, token = pending.token()]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                ids.insert(std::this_thread::get_id());
+            });
+    pending.wait();
+
+    EXPECT_LE(ids.size(), 2u);
+    EXPECT_EQ(ids.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(IoContextPoolTest, strandSerializes)
+{
+    io::IoContextPool pool(4);
+
+    struct Connection
+    {
+        Connection(io::IoContextPool& pool) : strand(pool.makeStrand()) {}
+        io::Strand strand;
+        std::atomic<int> inFlight = 0;
+        bool overlapped = false;
+        int counter = 0;
+    };
+    std::vector<std::unique_ptr<Connection>> connections;
+    for (int i = 0; i < 8; ++i)
+        connections.push_back(std::make_unique<Connection>(pool));
+
+    io::PendingOperations pending;
+    for (int i = 0; i < 2000; ++i)
+        for (auto& connection : connections)
+            boost::asio::post(connection->strand, [c = connection.get(),
+                                                   token = pending.token()]() {
+                c->overlapped |= (c->inFlight.fetch_add(1) != 0);
+                ++c->counter;
+                c->inFlight.fetch_sub(1);
+            });
+    pending.wait();
+
+    for (const auto& connection : connections)
+    {
+        EXPECT_FALSE(connection->overlapped);
+        EXPECT_EQ(connection->counter, 2000);
+    }
+}
+
+TEST(IoContextPoolTest, pendingOperations)
+{
+    io::IoContextPool pool(1);
+    io::Strand strand = pool.makeStrand();
+    io::PendingOperations pending;
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    boost::asio::post(strand,
+                      [released, token = pending.token()]() { released.wait(); });
+    EXPECT_EQ(pending.count(), 1u);
+
+    auto waiting = std::async(std::launch::async, [&pending]() { pending.wait(); });
+    EXPECT_EQ(waiting.wait_for(std::chrono::milliseconds(50)),
+              std::future_status::timeout);
+    release.set_value();
+    EXPECT_EQ(waiting.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(pending.count(), 0u);
+}
+
+TEST(IoContextPoolTest, stop)
+{
+    auto pool = std::make_unique<io::IoContextPool>(2);
+    pool->stop();
+    EXPECT_TRUE(pool->stopped());
+
+    // Handlers of a stopped pool are destroyed without being invoked, their tokens
+    // may outlive the counter
+    bool invoked = false;
+    {
+        io::Strand strand = pool->makeStrand();
+        io::PendingOperations pending;
+        boost::asio::post(strand,
+                          [&invoked, token = pending.token()]() { invoked = true; });
+        EXPECT_EQ(pending.count(), 1u);
+    }
+    pool.reset();
+    EXPECT_FALSE(invoked);
+}
+
+TEST(IoContextPoolTest, cpuAffinity)
+{
+    io::IoContextPool pool(2, {0});
+    ASSERT_TRUE(pool.affinityApplied());
+
+    io::PendingOperations pending;
+    std::atomic<bool> elsewhere = false;
+    io::Strand strand = pool.makeStrand();
+    for (int i = 0; i < 100; ++i)
+        boost::asio::post(strand, [&elsewhere, token = pending.token()]() {
+            elsewhere = elsewhere || (sched_getcpu() != 0);
+        });
+    pending.wait();
+    EXPECT_FALSE(elsewhere);
+
+    io::IoContextPool invalid(1, {CPU_SETSIZE});
+    EXPECT_FALSE(invalid.affinityApplied());
+}
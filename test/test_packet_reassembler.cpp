@@ -0,0 +1,288 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <septentrio_gnss_driver/communication/packet_reassembler.hpp>
+
+namespace {
+    const uint32_t RX_IP = 0xC0A80164; // 192.168.1.100
+    const uint32_t HOST_IP = 0xC0A80102;
+    const uint16_t RX_PORT = 28784;
+    const uint16_t HOST_PORT = 50000;
+
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint8_t fill)
+    {
+        std::vector<uint8_t> block(length, fill);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void put16(std::vector<uint8_t>& packet, size_t offset, uint16_t value)
+    {
+        packet[offset] = value >> 8;
+        packet[offset + 1] = value & 0xFF;
+    }
+
+    void put32(std::vector<uint8_t>& packet, size_t offset, uint32_t value)
+    {
+        put16(packet, offset, value >> 16);
+        put16(packet, offset + 2, value & 0xFFFF);
+    }
+
+    //! Ethernet frame with IPv4 header, optionally VLAN tagged
+    std::vector<uint8_t> makeIp(uint8_t protocol,
+                                const std::vector<uint8_t>& transport,
+                                bool vlan = false)
+    {
+        std::vector<uint8_t> packet(vlan ? 18 : 14, 0);
+        if (vlan)
+            put16(packet, 12, 0x8100);
+        put16(packet, packet.size() - 2, 0x0800);
+
+        size_t ip = packet.size();
+        packet.resize(ip + 20, 0);
+        packet[ip] = 0x45;
+        put16(packet, ip + 2, static_cast<uint16_t>(20 + transport.size()));
+        packet[ip + 8] = 64;
+        packet[ip + 9] = protocol;
+        put32(packet, ip + 12, RX_IP);
+        put32(packet, ip + 16, HOST_IP);
+        packet.insert(packet.end(), transport.begin(), transport.end());
+        return packet;
+    }
+
+    std::vector<uint8_t> makeTcp(uint32_t seq, uint8_t flags,
+                                 const std::vector<uint8_t>& payload,
+                                 uint16_t srcPort = RX_PORT)
+    {
+        std::vector<uint8_t> segment(20, 0);
+        put16(segment, 0, srcPort);
+        put16(segment, 2, HOST_PORT);
+        put32(segment, 4, seq);
+        segment[12] = 5 << 4;
+        segment[13] = flags;
+        segment.insert(segment.end(), payload.begin(), payload.end());
+        return makeIp(6, segment);
+    }
+
+    std::vector<uint8_t> makeUdp(const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> datagram(8, 0);
+        put16(datagram, 0, RX_PORT);
+        put16(datagram, 2, HOST_PORT);
+        put16(datagram, 4, static_cast<uint16_t>(8 + payload.size()));
+        datagram.insert(datagram.end(), payload.begin(), payload.end());
+        return makeIp(17, datagram);
+    }
+
+    std::vector<uint8_t> slice(const std::vector<uint8_t>& data, size_t begin,
+                               size_t end)
+    {
+        return std::vector<uint8_t>(data.begin() + begin, data.begin() + end);
+    }
+
+    struct Collector
+    {
+        std::vector<std::shared_ptr<Telegram>> telegrams;
+
+        io::PacketReassembler reassembler()
+        {
+            return io::PacketReassembler(
+                [this](const std::shared_ptr<Telegram>& telegram) {
+                    telegrams.push_back(telegram);
+                });
+        }
+    };
+} // namespace
+
+TEST(PacketReassemblerTest, tcpInOrder)
+{
+    std::vector<uint8_t> stream = makeSbf(4007, 96, 1);
+    std::vector<uint8_t> second = makeSbf(4226, 112, 2);
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    Collector collector;
+    io::PacketReassembler reassembler = collector.reassembler();
+    const uint32_t isn = 0xFFFFFF00; // sequence numbers wrap within the stream
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, makeTcp(isn, 0x02, {}).data(),
+                                    54, 100));
+    auto first = makeTcp(isn + 1, 0x10, slice(stream, 0, 150));
+    auto last = makeTcp(isn + 151, 0x18, slice(stream, 150, stream.size()));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, first.data(), first.size(), 200));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, last.data(), last.size(), 300));
+
+    ASSERT_EQ(collector.telegrams.size(), 2u);
+    EXPECT_EQ(collector.telegrams[0]->message, slice(stream, 0, 96));
+    EXPECT_EQ(collector.telegrams[0]->stamp, 200u);
+    EXPECT_EQ(collector.telegrams[1]->message, second);
+    // Stamped with the capture time of the packet of its first byte
+    EXPECT_EQ(collector.telegrams[1]->stamp, 200u);
+}
+
+TEST(PacketReassemblerTest, tcpReorderAndRetransmission)
+{
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        std::vector<uint8_t> block = makeSbf(4007, 96, i);
+        stream.insert(stream.end(), block.begin(), block.end());
+    }
+
+    std::vector<std::vector<uint8_t>> segments;
+    for (size_t offset = 0; offset < stream.size(); offset += 100)
+        segments.push_back(
+            makeTcp(1000 + static_cast<uint32_t>(offset), 0x10,
+                    slice(stream, offset, std::min(offset + 100, stream.size()))));
+
+    Collector collector;
+    io::PacketReassembler reassembler = collector.reassembler();
+    // Capture starts within the connection, no SYN
+    for (size_t i : {0, 2, 1, 1, 3, 5, 4, 6, 7, 8, 9, 8})
+        reassembler.process(DLT_EN10MB, segments[i].data(), segments[i].size(),
+                            i);
+
+    ASSERT_EQ(collector.telegrams.size(), 10u);
+    for (uint8_t i = 0; i < 10; ++i)
+        EXPECT_EQ(collector.telegrams[i]->message[20], i);
+    EXPECT_EQ(reassembler.gaps(), 0u);
+}
+
+TEST(PacketReassemblerTest, tcpGap)
+{
+    std::vector<uint8_t> stream;
+    for (uint8_t i = 0; i < 3; ++i)
+    {
+        std::vector<uint8_t> block = makeSbf(4007, 96, i);
+        stream.insert(stream.end(), block.begin(), block.end());
+    }
+
+    Collector collector;
+    io::PacketReassembler reassembler = collector.reassembler();
+    auto first = makeTcp(0, 0x10, slice(stream, 0, 96));
+    reassembler.process(DLT_EN10MB, first.data(), first.size(), 0);
+    // The second block is never captured, the third follows after plenty of data
+    auto third = makeTcp(192, 0x10, slice(stream, 192, 288));
+    reassembler.process(DLT_EN10MB, third.data(), third.size(), 0);
+    std::vector<uint8_t> filler(1400, 'x');
+    for (uint32_t seq = 288; seq < 288 + io::MAX_TCP_REORDER_BYTES; seq += 1400)
+    {
+        auto segment = makeTcp(seq, 0x10, filler);
+        reassembler.process(DLT_EN10MB, segment.data(), segment.size(), 0);
+    }
+
+    EXPECT_EQ(reassembler.gaps(), 1u);
+    ASSERT_GE(collector.telegrams.size(), 2u);
+    EXPECT_EQ(collector.telegrams[1]->message, slice(stream, 192, 288));
+}
+
+TEST(PacketReassemblerTest, udpDatagrams)
+{
+    std::vector<uint8_t> payload = makeSbf(4007, 96, 1);
+    std::vector<uint8_t> nmea = {'$', 'G', 'P', 'G', 'G', 'A', ',', '1', '*',
+                                 '4', '7', '\r', '\n'};
+    payload.insert(payload.end(), nmea.begin(), nmea.end());
+
+    Collector collector;
+    io::PacketReassembler reassembler = collector.reassembler();
+    auto packet = makeUdp(payload);
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, packet.data(), packet.size(), 5));
+    // A truncated datagram does not corrupt the next one
+    auto truncated = makeUdp(slice(payload, 0, 50));
+    EXPECT_TRUE(
+        reassembler.process(DLT_EN10MB, truncated.data(), truncated.size(), 6));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, packet.data(), packet.size(), 7));
+
+    ASSERT_EQ(collector.telegrams.size(), 4u);
+    EXPECT_EQ(collector.telegrams[0]->type, telegram_type::SBF);
+    EXPECT_EQ(collector.telegrams[1]->type, telegram_type::NMEA);
+    EXPECT_EQ(collector.telegrams[2]->stamp, 7u);
+}
+
+TEST(PacketReassemblerTest, udpSplitBlocks)
+{
+    std::vector<uint8_t> first = makeSbf(4007, 96, 1);
+    std::vector<uint8_t> second = makeSbf(4027, 200, 2);
+    std::vector<uint8_t> stream = first;
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    Collector collector;
+    io::PacketReassembler reassembler = collector.reassembler();
+    // The second block spans three datagrams
+    auto packet = makeUdp(slice(stream, 0, 150));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, packet.data(), packet.size(), 5));
+    packet = makeUdp(slice(stream, 150, 200));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, packet.data(), packet.size(), 6));
+    packet = makeUdp(slice(stream, 200, stream.size()));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, packet.data(), packet.size(), 7));
+
+    ASSERT_EQ(collector.telegrams.size(), 2u);
+    EXPECT_EQ(collector.telegrams[0]->message, first);
+    EXPECT_EQ(collector.telegrams[1]->message, second);
+    EXPECT_EQ(collector.telegrams[1]->stamp, 5u);
+}
+
+TEST(PacketReassemblerTest, linkTypes)
+{
+    std::vector<uint8_t> block = makeSbf(4007, 96, 1);
+    std::vector<uint8_t> ethernet = makeUdp(block);
+
+    std::vector<uint8_t> raw = slice(ethernet, 14, ethernet.size());
+    std::vector<uint8_t> sll(16, 0);
+    put16(sll, 14, 0x0800);
+    sll.insert(sll.end(), raw.begin(), raw.end());
+    std::vector<uint8_t> null = {2, 0, 0, 0};
+    null.insert(null.end(), raw.begin(), raw.end());
+    std::vector<uint8_t> datagram = slice(ethernet, 34, ethernet.size());
+    std::vector<uint8_t> vlan = makeIp(17, datagram, true);
+
+    Collector collector;
+    io::PacketReassembler reassembler = collector.reassembler();
+    EXPECT_TRUE(reassembler.process(DLT_RAW, raw.data(), raw.size(), 0));
+    EXPECT_TRUE(reassembler.process(DLT_LINUX_SLL, sll.data(), sll.size(), 0));
+    EXPECT_TRUE(reassembler.process(DLT_NULL, null.data(), null.size(), 0));
+    EXPECT_TRUE(reassembler.process(DLT_EN10MB, vlan.data(), vlan.size(), 0));
+    EXPECT_EQ(collector.telegrams.size(), 4u);
+
+    // ARP
+    std::vector<uint8_t> arp = ethernet;
+    put16(arp, 12, 0x0806);
+    EXPECT_FALSE(reassembler.process(DLT_EN10MB, arp.data(), arp.size(), 0));
+    // Truncated capture
+    EXPECT_FALSE(reassembler.process(DLT_EN10MB, ethernet.data(), 20, 0));
+    EXPECT_FALSE(io::PacketReassembler::supportsLinkType(105));
+}
@@ -0,0 +1,163 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <septentrio_gnss_driver/abstraction/typedefs.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+    class TestNode : public ROSaicNodeBase
+    {
+    public:
+        TestNode() : ROSaicNodeBase(rclcpp::NodeOptions())
+        {
+            settings_ = Settings{};
+            settings_.publish_pvtgeodetic = true;
+        }
+
+        using ROSaicNodeBase::publisher;
+
+        Settings& mutableSettings() { return settings_; }
+
+    private:
+        void sendVelocity(const std::string&) override {}
+    };
+
+    size_t publishers(rclcpp::Node& node, const std::string& topic)
+    {
+        // Graph updates may take a moment to arrive
+        for (int i = 0; (i < 100) && (node.count_publishers(topic) == 0); ++i)
+            std::this_thread::sleep_for(10ms);
+        return node.count_publishers(topic);
+    }
+} // namespace
+
+class PublisherTableTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite() { rclcpp::init(0, nullptr); }
+
+    static void TearDownTestSuite() { rclcpp::shutdown(); }
+};
+
+TEST_F(PublisherTableTest, advertiseEnabledTopics)
+{
+    auto node = std::make_shared<TestNode>();
+    node->advertiseTopics();
+
+    EXPECT_EQ(publishers(*node, "pvtgeodetic"), 1u);
+    EXPECT_EQ(node->count_publishers("pvtcartesian"), 0u);
+}
+
+TEST_F(PublisherTableTest, advertiseOnFirstPublish)
+{
+    auto node = std::make_shared<TestNode>();
+    node->advertiseTopics();
+
+    node->publishMessage<topic::PVT_CARTESIAN>(std::make_unique<PVTCartesianMsg>());
+    EXPECT_EQ(publishers(*node, "pvtcartesian"), 1u);
+    EXPECT_EQ(node->publisher<topic::PVT_CARTESIAN>(),
+              node->publisher<topic::PVT_CARTESIAN>());
+}
+
+TEST_F(PublisherTableTest, advertiseConcurrently)
+{
+    auto node = std::make_shared<TestNode>();
+    node->advertiseTopics();
+
+    // Processing threads of several receivers may publish a topic first at once
+    std::vector<rclcpp::Publisher<PVTCartesianMsg>*> pubs(4, nullptr);
+    std::vector<std::thread> threads;
+    for (auto& pub : pubs)
+        threads.emplace_back(
+            [&node, &pub]() { pub = node->publisher<topic::PVT_CARTESIAN>(); });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto* pub : pubs)
+        EXPECT_EQ(pub, pubs[0]);
+    EXPECT_EQ(publishers(*node, "pvtcartesian"), 1u);
+}
+
+TEST_F(PublisherTableTest, qos)
+{
+    auto node = std::make_shared<TestNode>();
+    node->mutableSettings().qos["gpgga"] = {"reliable", "transient_local", 3};
+    auto profile = [](auto* pub) {
+        return pub->get_actual_qos().get_rmw_qos_profile();
+    };
+
+    auto imu = profile(node->publisher<topic::IMU>());
+    EXPECT_EQ(imu.reliability, RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT);
+    EXPECT_EQ(imu.depth, 5u);
+
+    auto rf = profile(node->publisher<topic::RF_STATUS>());
+    EXPECT_EQ(rf.reliability, RMW_QOS_POLICY_RELIABILITY_RELIABLE);
+    EXPECT_EQ(rf.depth, 10u);
+
+    auto pvt = profile(node->publisher<topic::PVT_GEODETIC>());
+    EXPECT_EQ(pvt.reliability, RMW_QOS_POLICY_RELIABILITY_RELIABLE);
+    EXPECT_EQ(pvt.durability, RMW_QOS_POLICY_DURABILITY_VOLATILE);
+    EXPECT_EQ(pvt.depth, 1u);
+
+    auto gga = profile(node->publisher<topic::GPGGA>());
+    EXPECT_EQ(gga.durability, RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL);
+    EXPECT_EQ(gga.depth, 3u);
+}
+
+TEST_F(PublisherTableTest, lazyDecoding)
+{
+    auto node = std::make_shared<TestNode>();
+    EXPECT_TRUE(node->subscribed(topic::PVT_GEODETIC));
+
+    node->mutableSettings().lazy_decoding = true;
+    node->advertiseTopics();
+    node->watchSubscriptions();
+    EXPECT_FALSE(node->subscribed(topic::PVT_GEODETIC));
+    // Not advertised yet, created by the first message
+    EXPECT_TRUE(node->subscribed(topic::PVT_CARTESIAN));
+
+    // Refreshed on graph events, without spinning the node
+    auto sub = node->create_subscription<PVTGeodeticMsg>(
+        "pvtgeodetic", 1, [](PVTGeodeticMsg::ConstSharedPtr) {});
+    for (int i = 0; (i < 200) && !node->subscribed(topic::PVT_GEODETIC); ++i)
+        std::this_thread::sleep_for(10ms);
+    EXPECT_TRUE(node->subscribed(topic::PVT_GEODETIC));
+
+    sub.reset();
+    for (int i = 0; (i < 200) && node->subscribed(topic::PVT_GEODETIC); ++i)
+        std::this_thread::sleep_for(10ms);
+    EXPECT_FALSE(node->subscribed(topic::PVT_GEODETIC));
+}
@@ -0,0 +1,88 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <septentrio_gnss_driver/communication/reconnect_backoff.hpp>
+
+using namespace std::chrono_literals;
+
+TEST(ReconnectBackoffTest, growth)
+{
+    io::ReconnectBackoff backoff(100ms, 2000ms, 42);
+
+    // Attempt n is drawn from [d/2, d] with d = min(max, min * 2^n), but never
+    // below the minimum
+    std::vector<std::chrono::milliseconds> ceilings = {
+        100ms, 200ms, 400ms, 800ms, 1600ms, 2000ms, 2000ms, 2000ms};
+    for (auto ceiling : ceilings)
+    {
+        std::chrono::milliseconds delay = backoff.next();
+        EXPECT_GE(delay, std::max(100ms, ceiling / 2));
+        EXPECT_LE(delay, ceiling);
+    }
+    EXPECT_EQ(backoff.attempts(), ceilings.size());
+
+    backoff.reset();
+    EXPECT_EQ(backoff.attempts(), 0u);
+    EXPECT_EQ(backoff.next(), 100ms);
+}
+
+TEST(ReconnectBackoffTest, jitter)
+{
+    io::ReconnectBackoff first(100ms, 5000ms, 1);
+    io::ReconnectBackoff second(100ms, 5000ms, 2);
+
+    // Instances with different seeds do not retry in lock-step
+    bool differ = false;
+    for (int i = 0; i < 6; ++i)
+        differ |= (first.next() != second.next());
+    EXPECT_TRUE(differ);
+}
+
+TEST(ReconnectBackoffTest, bounds)
+{
+    // A maximum below the minimum is raised to the minimum
+    io::ReconnectBackoff backoff(500ms, 100ms, 7);
+    for (int i = 0; i < 40; ++i)
+        EXPECT_EQ(backoff.next(), 500ms);
+}
+
+TEST(ReconnectStatisticsTest, record)
+{
+    io::ReconnectStatistics statistics;
+    statistics.record(120ms);
+    statistics.record(3400ms);
+    statistics.record(80ms);
+
+    EXPECT_EQ(statistics.reconnects, 3u);
+    EXPECT_EQ(statistics.lastOutage, 80u);
+    EXPECT_EQ(statistics.maxOutage, 3400u);
+    EXPECT_EQ(statistics.totalOutage, 3600u);
+}
@@ -0,0 +1,138 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <septentrio_gnss_driver/communication/replay_clock.hpp>
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    const ReplayTime START = 1700000000000000000ull;
+    const ReplayTime MS = 1000000ull;
+} // namespace
+
+TEST(ReplayClockTest, unthrottled)
+{
+    // Would wait for 99 s if throttled
+    ReplayClock clock(0.0);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_TRUE(clock.advance(START + i * 1000 * MS));
+    EXPECT_EQ(clock.now(), START + 99 * 1000 * MS);
+}
+
+TEST(ReplayClockTest, rate)
+{
+    // 1 s of GNSS time at 10x real time. Waits never end early, so only the lower
+    // bound holds on a loaded machine.
+    ReplayClock clock(10.0);
+    auto start = Clock::now();
+    for (int i = 0; i <= 10; ++i)
+        clock.advance(START + i * 100 * MS);
+    EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(100));
+}
+
+TEST(ReplayClockTest, sameTimePassesImmediately)
+{
+    ReplayClock clock(1.0, true);
+    clock.step();
+    EXPECT_TRUE(clock.advance(START));
+    // Paused without steps, so any wait would last forever
+    EXPECT_FALSE(clock.advance(START));
+    EXPECT_FALSE(clock.advance(START));
+}
+
+TEST(ReplayClockTest, timeGoingBackRestartsPacing)
+{
+    ReplayClock clock(1.0);
+    clock.advance(START + 3600 * 1000 * MS);
+    EXPECT_FALSE(clock.advance(START));
+    EXPECT_EQ(clock.now(), START);
+    // The first epoch after the restart anchors the pacing instead of waiting
+    // an hour
+    EXPECT_TRUE(clock.advance(START + 20 * MS));
+    EXPECT_EQ(clock.now(), START + 20 * MS);
+}
+
+TEST(ReplayClockTest, pauseAndStep)
+{
+    ReplayClock clock(1.0, true);
+    std::atomic<int> epochs = 0;
+    std::thread consumer([&clock, &epochs]() {
+        for (int i = 0; i < 3; ++i)
+        {
+            // Several messages per epoch
+            clock.advance(START + i * 3600 * 1000 * MS);
+            clock.advance(START + i * 3600 * 1000 * MS);
+            ++epochs;
+        }
+    });
+
+    EXPECT_TRUE(clock.awaitBlocked());
+    EXPECT_EQ(epochs, 0);
+    // Stepping ignores the hour between epochs
+    clock.step();
+    EXPECT_TRUE(clock.awaitBlocked());
+    EXPECT_EQ(epochs, 1);
+    clock.step(2);
+    consumer.join();
+    EXPECT_EQ(epochs, 3);
+    EXPECT_TRUE(clock.paused());
+}
+
+TEST(ReplayClockTest, rateChangeWakesWaitingThread)
+{
+    ReplayClock clock(1.0);
+    clock.advance(START);
+    // Would wait for an hour without the rate change
+    std::thread consumer([&clock]() { clock.advance(START + 3600 * 1000 * MS); });
+    EXPECT_TRUE(clock.awaitBlocked());
+    clock.setRate(0.0);
+    consumer.join();
+    EXPECT_EQ(clock.now(), START + 3600 * 1000 * MS);
+}
+
+TEST(ReplayClockTest, stopReleasesPausedThread)
+{
+    ReplayClock clock(1.0, true);
+    std::thread consumer([&clock]() {
+        clock.advance(START);
+        clock.advance(START + MS);
+    });
+    EXPECT_TRUE(clock.awaitBlocked());
+    clock.stop();
+    consumer.join();
+    EXPECT_EQ(clock.now(), START + MS);
+    EXPECT_FALSE(clock.awaitBlocked());
+}
@@ -0,0 +1,264 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+
+#include <septentrio_gnss_driver/communication/rx_config_diff.hpp>
+
+namespace {
+    /**
+     * Minimal Rx keeping SBFOutput streams and the geodetic datum, answering set
+     * and get commands like the real one
+     */
+    class FakeRx
+    {
+    public:
+        std::string answer(const std::string& cmd)
+        {
+            std::string text = io::CommandPipeline::normalize(cmd);
+            std::string response = "$R: " + text + "\r\n";
+            if (text.rfind("sso, all", 0) == 0)
+            {
+                for (auto& [stream, line] : streams)
+                {
+                    line = "SBFOutput, " + stream + ", none, none, off";
+                    response += "  " + line + "\r\n";
+                }
+            } else if (text.rfind("sso, ", 0) == 0)
+            {
+                std::string stream = text.substr(5, text.find(',', 5) - 5);
+                streams[stream] = "SBFOutput" + text.substr(3);
+                response += "  " + streams[stream] + "\r\n";
+            } else if (text.rfind("sgd, ", 0) == 0)
+            {
+                datum = "GeodeticDatum, " + text.substr(5);
+                response += "  " + datum + "\r\n";
+            } else if (text == "getSBFOutput")
+            {
+                for (const auto& [stream, line] : streams)
+                    response += "  " + line + "\r\n";
+            } else if (text == "getGeodeticDatum")
+            {
+                response += "  " + datum + "\r\n";
+            }
+            ++commands;
+            return response;
+        }
+
+        std::map<std::string, std::string> streams = {
+            {"Stream1", "SBFOutput, Stream1, none, none, off"},
+            {"Stream2", "SBFOutput, Stream2, none, none, off"},
+            {"Stream3", "SBFOutput, Stream3, none, none, off"}};
+        std::string datum = "GeodeticDatum, WGS84";
+        std::size_t commands = 0;
+    };
+
+    class RxConfigDiffTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            path = (std::filesystem::temp_directory_path() /
+                    ("rx_config_diff_" + std::to_string(::getpid()) + ".cache"))
+                       .string();
+        }
+
+        void TearDown() override { std::remove(path.c_str()); }
+
+        void send(io::RxConfigDiff& diff, const std::string& cmd)
+        {
+            diff.respond(io::CommandPipeline::normalize(cmd), rx.answer(cmd));
+        }
+
+        //! Configures the Rx like configureRx() and returns the sent commands
+        std::vector<std::string> configure(const std::vector<std::string>& config)
+        {
+            std::vector<std::string> sent;
+            io::RxConfigDiff diff;
+            if (diff.load(path))
+            {
+                for (const auto& query : diff.queries())
+                    send(diff, query + "\x0D");
+                diff.compare();
+            }
+            for (const auto& cmd : config)
+            {
+                if (diff.skip(cmd))
+                    continue;
+                send(diff, cmd);
+                sent.push_back(cmd);
+            }
+            for (const auto& cmd : diff.finish())
+            {
+                send(diff, cmd);
+                sent.push_back(cmd);
+            }
+            unchanged = diff.unchanged();
+            if (!unchanged)
+            {
+                for (const auto& query : diff.finalQueries())
+                    send(diff, query + "\x0D");
+                EXPECT_TRUE(diff.save(path));
+            }
+            return sent;
+        }
+
+        FakeRx rx;
+        std::string path;
+        bool unchanged = false;
+    };
+
+    const std::vector<std::string> CONFIG = {
+        "login, user, secret \x0D", "sso, all, none, none, off \x0D",
+        "sso, Stream1, IP10, PVTGeodetic, msec100 \x0D",
+        "sso, Stream2, IP10, AttEuler, sec1 \x0D", "grc \x0D", "sgd, WGS84\x0D"};
+} // namespace
+
+TEST_F(RxConfigDiffTest, firstConfiguration)
+{
+    EXPECT_EQ(configure(CONFIG), CONFIG);
+    EXPECT_FALSE(unchanged);
+    EXPECT_EQ(rx.streams["Stream1"],
+              "SBFOutput, Stream1, IP10, PVTGeodetic, msec100");
+    EXPECT_TRUE(std::filesystem::exists(path));
+}
+
+TEST_F(RxConfigDiffTest, warmRestart)
+{
+    configure(CONFIG);
+    rx.commands = 0;
+
+    std::vector<std::string> sent = configure(CONFIG);
+    EXPECT_TRUE(unchanged);
+    // Only the login and the capabilities query are sent, plus the read back
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[0], CONFIG[0]);
+    EXPECT_EQ(sent[1], CONFIG[4]);
+    EXPECT_EQ(rx.commands, 4u);
+}
+
+TEST_F(RxConfigDiffTest, changedByOthers)
+{
+    configure(CONFIG);
+    rx.datum = "GeodeticDatum, ITRF";
+
+    std::vector<std::string> sent = configure(CONFIG);
+    EXPECT_FALSE(unchanged);
+    ASSERT_EQ(sent.size(), 3u);
+    EXPECT_EQ(sent[2], CONFIG[5]);
+    EXPECT_EQ(rx.datum, "GeodeticDatum, WGS84");
+}
+
+TEST_F(RxConfigDiffTest, addedCommand)
+{
+    configure(CONFIG);
+    std::vector<std::string> config = CONFIG;
+    config.insert(config.begin() + 4, "sso, Stream3, IP10, ReceiverTime, sec1 \x0D");
+
+    std::vector<std::string> sent = configure(config);
+    ASSERT_EQ(sent.size(), 3u);
+    EXPECT_EQ(sent[1], config[4]);
+    EXPECT_EQ(rx.streams["Stream2"], "SBFOutput, Stream2, IP10, AttEuler, sec1");
+    EXPECT_EQ(rx.streams["Stream3"], "SBFOutput, Stream3, IP10, ReceiverTime, sec1");
+}
+
+TEST_F(RxConfigDiffTest, removedCommand)
+{
+    configure(CONFIG);
+    std::vector<std::string> config = CONFIG;
+    config.erase(config.begin() + 3);
+
+    // Stream2 can only be switched off by configuring all streams again
+    std::vector<std::string> sent = configure(config);
+    ASSERT_EQ(sent.size(), 4u);
+    EXPECT_EQ(sent[2], config[1]);
+    EXPECT_EQ(sent[3], config[2]);
+    EXPECT_EQ(rx.streams["Stream1"],
+              "SBFOutput, Stream1, IP10, PVTGeodetic, msec100");
+    EXPECT_EQ(rx.streams["Stream2"], "SBFOutput, Stream2, none, none, off");
+
+    // The cache now holds the new configuration
+    EXPECT_EQ(configure(config).size(), 2u);
+    EXPECT_TRUE(unchanged);
+}
+
+TEST_F(RxConfigDiffTest, invalidCache)
+{
+    configure(CONFIG);
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "command\tsgd, ITRF\n";
+    }
+    io::RxConfigDiff diff;
+    EXPECT_FALSE(diff.load(path));
+    EXPECT_TRUE(diff.queries().empty());
+    EXPECT_EQ(configure(CONFIG), CONFIG);
+}
+
+TEST_F(RxConfigDiffTest, editedState)
+{
+    configure(CONFIG);
+    std::string cache;
+    {
+        std::ifstream file(path);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        cache = ss.str();
+    }
+    // Only the cached state of the datum is edited, not the command
+    std::size_t pos = cache.find("WGS84", cache.find("state\t"));
+    ASSERT_NE(pos, std::string::npos);
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << cache.replace(pos, 5, "ITRF");
+    }
+    io::RxConfigDiff diff;
+    EXPECT_FALSE(diff.load(path));
+}
+
+TEST(RxConfigDiffParsingTest, body)
+{
+    std::vector<std::string> lines = io::RxConfigDiff::body(
+        "$R: sso, all, none, none, off\r\n  SBFOutput, Stream1, none, none, "
+        "off\r\n  SBFOutput, Stream2, none, none, off\r\n");
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[1], "SBFOutput, Stream2, none, none, off");
+    EXPECT_EQ(io::RxConfigDiff::settingName(lines[0]), "SBFOutput");
+    EXPECT_EQ(io::RxConfigDiff::settingName("GeodeticDatum"), "GeodeticDatum");
+    EXPECT_TRUE(io::RxConfigDiff::isSetting("sgd, WGS84"));
+    EXPECT_FALSE(io::RxConfigDiff::isSetting("eccf, Current, Boot"));
+}
@@ -0,0 +1,189 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <septentrio_gnss_driver/communication/sbf_chunk_decoder.hpp>
+
+namespace {
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint8_t fill)
+    {
+        std::vector<uint8_t> block(length, fill);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::string& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    //! Typical log: INS at high rate, MeasEpoch with payloads containing "$@" and
+    //! interleaved NMEA
+    std::vector<uint8_t> makeLog(size_t epochs)
+    {
+        std::vector<uint8_t> log;
+        for (size_t i = 0; i < epochs; ++i)
+        {
+            for (size_t j = 0; j < 5; ++j)
+            {
+                append(log, makeSbf(4226, 112, static_cast<uint8_t>(i + j)));
+                append(log, makeSbf(4050, 56, static_cast<uint8_t>(i)));
+            }
+            std::vector<uint8_t> measEpoch = makeSbf(4027, 2096, '$');
+            measEpoch[100] = SBF_SYNC_BYTE_2;
+            measEpoch[1000] = static_cast<uint8_t>(i);
+            uint16_t crc = crc::compute16CCITT(measEpoch.data() + 4, 2096 - 4);
+            measEpoch[2] = crc & 0xFF;
+            measEpoch[3] = crc >> 8;
+            append(log, measEpoch);
+            append(log,
+                   "$GPGGA,121041.00,5050.1233,N,00441.1234,E,4,28,0.5,98.2,M,"
+                   "47.6,M,1.0,0000*47\r\n");
+        }
+        return log;
+    }
+
+    std::vector<std::shared_ptr<Telegram>> frameSequentially(
+        const std::vector<uint8_t>& log)
+    {
+        std::vector<std::shared_ptr<Telegram>> telegrams;
+        io::TelegramFramer framer([&telegrams](
+                                      const std::shared_ptr<Telegram>& telegram) {
+            telegrams.push_back(telegram);
+        });
+        framer.feed(log.data(), log.size(), 0);
+        return telegrams;
+    }
+} // namespace
+
+TEST(SbfChunkDecoderTest, findSbfBlock)
+{
+    std::vector<uint8_t> corrupted = makeSbf(4007, 96, 0x11);
+    corrupted[50] ^= 0x01;
+
+    std::vector<uint8_t> log;
+    append(log, "$$@@garbage");
+    append(log, corrupted);
+    size_t valid = log.size();
+    append(log, makeSbf(4007, 96, '$'));
+
+    EXPECT_EQ(io::findSbfBlock(log.data(), log.size(), 0), valid);
+    EXPECT_EQ(io::findSbfBlock(log.data(), log.size(), valid), valid);
+    EXPECT_EQ(io::findSbfBlock(log.data(), log.size(), valid + 1), log.size());
+    // Truncated block at the end of the log
+    EXPECT_EQ(io::findSbfBlock(log.data(), log.size() - 1, 0), log.size() - 1);
+}
+
+TEST(SbfChunkDecoderTest, matchesSequentialFraming)
+{
+    std::vector<uint8_t> log = makeLog(50);
+    std::vector<std::shared_ptr<Telegram>> reference = frameSequentially(log);
+    ASSERT_EQ(reference.size(), 50u * 12u);
+
+    for (size_t threads : {1, 2, 4})
+    {
+        for (size_t chunkSize : {8, 100, 1000, 4096, 65536, 1 << 24})
+        {
+            io::SbfChunkDecoder decoder(threads, chunkSize);
+            std::vector<std::shared_ptr<Telegram>> telegrams;
+            EXPECT_TRUE(decoder.decode(
+                log.data(), log.size(),
+                [&telegrams](const std::shared_ptr<Telegram>& telegram) {
+                    telegrams.push_back(telegram);
+                    return true;
+                }));
+
+            ASSERT_EQ(telegrams.size(), reference.size())
+                << threads << " threads, chunk size " << chunkSize;
+            for (size_t i = 0; i < reference.size(); ++i)
+            {
+                EXPECT_EQ(telegrams[i]->type, reference[i]->type);
+                EXPECT_EQ(telegrams[i]->message, reference[i]->message);
+            }
+            EXPECT_EQ(decoder.telegrams(), reference.size());
+            EXPECT_EQ(decoder.faults(), 0u);
+        }
+    }
+}
+
+TEST(SbfChunkDecoderTest, responses)
+{
+    // Chunks end before an SBF block or at the end of the log, where no further
+    // line can continue a response
+    std::vector<uint8_t> log;
+    append(log, makeSbf(4007, 96, 0x11));
+    append(log, "$R: gso\r\n  SBFOutput, Stream1, none\r\n");
+    append(log, makeSbf(4007, 96, 0x22));
+    append(log, "$R: sgd, WGS84\r\n");
+
+    for (size_t chunkSize : {8, 100, 4096})
+    {
+        io::SbfChunkDecoder decoder(2, chunkSize);
+        std::vector<std::shared_ptr<Telegram>> telegrams;
+        EXPECT_TRUE(decoder.decode(
+            log.data(), log.size(),
+            [&telegrams](const std::shared_ptr<Telegram>& telegram) {
+                telegrams.push_back(telegram);
+                return true;
+            }));
+
+        ASSERT_EQ(telegrams.size(), 4u) << "chunk size " << chunkSize;
+        EXPECT_EQ(telegrams[1]->type, telegram_type::RESPONSE);
+        EXPECT_EQ(telegrams[1]->message.size(), 37u);
+        EXPECT_EQ(telegrams[3]->type, telegram_type::RESPONSE);
+        EXPECT_EQ(telegrams[3]->message.size(), 16u);
+    }
+}
+
+TEST(SbfChunkDecoderTest, abort)
+{
+    std::vector<uint8_t> log = makeLog(200);
+
+    io::SbfChunkDecoder decoder(4, 1000);
+    size_t count = 0;
+    EXPECT_FALSE(decoder.decode(log.data(), log.size(),
+                                [&count](const std::shared_ptr<Telegram>&) {
+                                    return ++count < 100;
+                                }));
+    EXPECT_EQ(count, 100u);
+}
@@ -0,0 +1,228 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <filesystem>
+#include <fstream>
+
+// Linux
+#include <unistd.h>
+
+#include <septentrio_gnss_driver/communication/sbf_index.hpp>
+
+namespace {
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint16_t wnc,
+                                 uint32_t tow)
+    {
+        std::vector<uint8_t> block(length, 0x24);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        for (size_t i = 0; i < 4; ++i)
+            block[8 + i] = (tow >> (8 * i)) & 0xFF;
+        block[12] = wnc & 0xFF;
+        block[13] = wnc >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void append(std::vector<uint8_t>& log, const std::vector<uint8_t>& data)
+    {
+        log.insert(log.end(), data.begin(), data.end());
+    }
+
+    void append(std::vector<uint8_t>& log, const std::string& data)
+    {
+        log.insert(log.end(), data.begin(), data.end());
+    }
+
+    //! Epochs of 100 ms with PVTGeodetic and INSNavGeod each and an NMEA sentence
+    void appendEpochs(std::vector<uint8_t>& log, uint32_t first, uint32_t count)
+    {
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            append(log, makeSbf(4007, 96, 2300, i * 100));
+            append(log, makeSbf(4226 | (1 << 13), 112, 2300, i * 100));
+            append(log, "$GPGGA,1*47\r\n");
+        }
+    }
+
+    class SbfIndexTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            sidecar_ = (std::filesystem::temp_directory_path() /
+                        ("test_sbf_index_" + std::to_string(getpid()) + ".idx"))
+                           .string();
+            std::filesystem::remove(sidecar_);
+        }
+
+        void TearDown() override { std::filesystem::remove(sidecar_); }
+
+        std::string sidecar_;
+    };
+} // namespace
+
+TEST_F(SbfIndexTest, scan)
+{
+    std::vector<uint8_t> log;
+    append(log, "$@garbage");
+    size_t firstBlock = log.size();
+    appendEpochs(log, 0, 3);
+    append(log, makeSbf(5902, 8, 0, 0));
+
+    io::SbfIndex index;
+    index.scan(log.data(), log.size());
+
+    const auto& entries = index.entries();
+    ASSERT_EQ(entries.size(), 7u);
+    EXPECT_EQ(entries[0].offset, firstBlock);
+    EXPECT_EQ(entries[0].id, 4007);
+    EXPECT_EQ(entries[1].id, 4226);
+    EXPECT_EQ(entries[1].offset, firstBlock + 96);
+    EXPECT_EQ(entries[2].offset, firstBlock + 96 + 112 + 13);
+    EXPECT_EQ(entries[4].tow, 200u);
+    EXPECT_EQ(entries[4].wnc, 2300);
+    EXPECT_TRUE(entries[4].hasTime());
+    EXPECT_EQ(entries[4].time(), 2300ull * 604800000 + 200);
+    // Too short to carry a time
+    EXPECT_FALSE(entries[6].hasTime());
+    EXPECT_EQ(index.indexedSize(), log.size());
+}
+
+TEST_F(SbfIndexTest, seek)
+{
+    std::vector<uint8_t> log;
+    appendEpochs(log, 0, 10);
+
+    io::SbfIndex index;
+    index.scan(log.data(), log.size());
+
+    uint64_t week = 2300ull * 604800000;
+    EXPECT_EQ(index.seek(0), 0u);
+    EXPECT_EQ(index.seek(week + 300), 6u);
+    EXPECT_EQ(index.seek(week + 301), 8u);
+    EXPECT_EQ(index.seek(week + 1000), 20u);
+}
+
+TEST_F(SbfIndexTest, incrementalSidecar)
+{
+    std::vector<uint8_t> log;
+    appendEpochs(log, 0, 100);
+    // Block still being written
+    std::vector<uint8_t> pending = makeSbf(4007, 96, 2300, 10000);
+    log.insert(log.end(), pending.begin(), pending.begin() + 50);
+
+    {
+        io::SbfIndex index;
+        EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+        EXPECT_EQ(index.loaded(), 0u);
+        EXPECT_EQ(index.entries().size(), 200u);
+    }
+
+    log.insert(log.end(), pending.begin() + 50, pending.end());
+    appendEpochs(log, 101, 10);
+
+    io::SbfIndex index;
+    EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+    EXPECT_EQ(index.loaded(), 200u);
+    ASSERT_EQ(index.entries().size(), 221u);
+    EXPECT_EQ(index.entries()[200].tow, 10000u);
+
+    // Updating the same index again while recording continues
+    appendEpochs(log, 111, 1);
+    EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+    EXPECT_EQ(index.loaded(), 221u);
+    EXPECT_EQ(index.entries().size(), 223u);
+
+    io::SbfIndex scanned;
+    scanned.scan(log.data(), log.size());
+    io::SbfIndex cached;
+    EXPECT_TRUE(cached.update(sidecar_, log.data(), log.size()));
+    EXPECT_EQ(cached.loaded(), 223u);
+    ASSERT_EQ(cached.entries().size(), scanned.entries().size());
+    for (size_t i = 0; i < scanned.entries().size(); ++i)
+    {
+        EXPECT_EQ(cached.entries()[i].offset, scanned.entries()[i].offset);
+        EXPECT_EQ(cached.entries()[i].time(), scanned.entries()[i].time());
+        EXPECT_EQ(cached.entries()[i].id, scanned.entries()[i].id);
+    }
+}
+
+TEST_F(SbfIndexTest, rebuildForOtherLog)
+{
+    std::vector<uint8_t> log;
+    appendEpochs(log, 0, 10);
+    {
+        io::SbfIndex index;
+        EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+    }
+
+    std::vector<uint8_t> other;
+    append(other, "$GPGGA,1*47\r\n");
+    appendEpochs(other, 0, 5);
+
+    io::SbfIndex index;
+    EXPECT_TRUE(index.update(sidecar_, other.data(), other.size()));
+    EXPECT_EQ(index.loaded(), 0u);
+    ASSERT_EQ(index.entries().size(), 10u);
+    EXPECT_EQ(index.entries()[0].offset, 13u);
+}
+
+TEST_F(SbfIndexTest, rebuildForCorruptSidecar)
+{
+    std::vector<uint8_t> log;
+    appendEpochs(log, 0, 10);
+    {
+        io::SbfIndex index;
+        EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+    }
+
+    // Offset of the second entry pointing before the first one
+    {
+        std::fstream file(sidecar_, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t offset = 0;
+        file.seekp(16 + sizeof(io::SbfIndex::Entry));
+        file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+
+    io::SbfIndex index;
+    EXPECT_TRUE(index.update(sidecar_, log.data(), log.size()));
+    EXPECT_EQ(index.loaded(), 0u);
+    ASSERT_EQ(index.entries().size(), 20u);
+    EXPECT_EQ(index.entries()[1].offset, 96u);
+}
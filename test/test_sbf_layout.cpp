@@ -0,0 +1,524 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <cmath>
+
+// Boost
+#include <boost/spirit/include/qi.hpp>
+
+#include <septentrio_gnss_driver/parsers/sbf_blocks.hpp>
+
+namespace {
+    class TestNode : public ROSaicNodeBase
+    {
+    public:
+        TestNode() : ROSaicNodeBase(rclcpp::NodeOptions()) {}
+
+    private:
+        void sendVelocity(const std::string&) override {}
+    };
+
+    //! Writes little endian fields of an SBF block at given offsets
+    class BlockWriter
+    {
+    public:
+        BlockWriter(uint16_t id, uint8_t revision, uint16_t length) :
+            block_(length, 0)
+        {
+            block_[0] = SBF_SYNC_1;
+            block_[1] = SBF_SYNC_2;
+            set<uint16_t>(4, id | (revision << 13));
+            set<uint16_t>(6, length);
+            set<uint32_t>(8, 345600000);
+            set<uint16_t>(12, 2300);
+        }
+
+        template <typename Val>
+        BlockWriter& set(size_t offset, Val val)
+        {
+            std::memcpy(block_.data() + offset, &val, sizeof(Val));
+            return *this;
+        }
+
+        const std::vector<uint8_t>& block() const { return block_; }
+
+    private:
+        std::vector<uint8_t> block_;
+    };
+
+    std::vector<uint8_t> makePvtGeodetic()
+    {
+        BlockWriter w(4007, 2, 96);
+        w.set<uint8_t>(14, 4).set<uint8_t>(15, 0);
+        w.set(16, 0.8870).set(24, 0.0788).set(32, 104.5);
+        w.set(40, 47.5f).set(44, 0.1f).set(48, -0.2f).set(52, 0.05f);
+        w.set(56, 123.4f).set(60, 0.25).set(68, -2e10f);
+        w.set<uint8_t>(72, 0).set<uint8_t>(73, 0).set<uint8_t>(74, 28);
+        w.set<uint8_t>(75, 2).set<uint16_t>(76, 1234).set<uint16_t>(78, 150);
+        w.set<uint32_t>(80, 0x12345678).set<uint8_t>(84, 1).set<uint8_t>(85, 1);
+        w.set<uint16_t>(86, 300).set<uint16_t>(88, 120).set<uint16_t>(90, 3);
+        w.set<uint16_t>(92, 5).set<uint8_t>(94, 7);
+        return w.block();
+    }
+
+    std::vector<uint8_t> makeInsNavGeod(uint16_t sbList)
+    {
+        size_t groups = 0;
+        for (uint16_t i = 0; i < 8; ++i)
+            groups += (sbList >> i) & 1;
+        BlockWriter w(4226, 0, static_cast<uint16_t>(56 + 12 * groups));
+        w.set<uint8_t>(14, 1).set<uint8_t>(15, 0).set<uint16_t>(16, 0x2f);
+        w.set<uint16_t>(18, 10).set(20, 0.8870).set(28, 0.0788).set(36, 104.5);
+        w.set(44, 47.5f).set<uint16_t>(48, 4).set<uint16_t>(50, 100);
+        w.set<uint8_t>(52, 0).set<uint16_t>(54, sbList);
+        for (size_t i = 0; i < 3 * groups; ++i)
+            w.set(56 + 4 * i, 0.5f + i);
+        return w.block();
+    }
+
+    std::vector<uint8_t> makeMeasEpoch(uint8_t n, uint8_t n2)
+    {
+        const uint8_t sb1Length = 20;
+        const uint8_t sb2Length = 12;
+        BlockWriter w(4027, 1, 20 + n * (sb1Length + n2 * sb2Length));
+        w.set<uint8_t>(14, n).set<uint8_t>(15, sb1Length);
+        w.set<uint8_t>(16, sb2Length).set<uint8_t>(17, 1).set<uint8_t>(18, 2);
+        size_t offset = 20;
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            w.set<uint8_t>(offset, i).set<uint8_t>(offset + 1, 0x20);
+            w.set<uint8_t>(offset + 2, i + 1).set<uint8_t>(offset + 3, 0x11);
+            w.set<uint32_t>(offset + 4, 1000000 + i).set<int32_t>(offset + 8, -5000);
+            w.set<uint16_t>(offset + 12, 777).set<int8_t>(offset + 14, -3);
+            w.set<uint8_t>(offset + 15, 180).set<uint16_t>(offset + 16, 600);
+            w.set<uint8_t>(offset + 18, 4).set<uint8_t>(offset + 19, n2);
+            offset += sb1Length;
+            for (uint8_t j = 0; j < n2; ++j)
+            {
+                w.set<uint8_t>(offset, j).set<uint8_t>(offset + 1, 60);
+                w.set<uint8_t>(offset + 2, 170).set<uint8_t>(offset + 3, 0x12);
+                w.set<int8_t>(offset + 4, -1).set<uint8_t>(offset + 5, 8);
+                w.set<uint16_t>(offset + 6, 1500).set<uint16_t>(offset + 8, 2500);
+                w.set<uint16_t>(offset + 10, 3500);
+                offset += sb2Length;
+            }
+        }
+        return w.block();
+    }
+
+    //! Per-field qi parsing as done before the layout tables, for comparison
+    namespace qi_reference {
+        namespace qi = boost::spirit::qi;
+
+        template <typename It, typename Val>
+        void parse(It& it, Val& val)
+        {
+            if constexpr (std::is_same<int8_t, Val>::value)
+                qi::parse(it, it + 1, qi::char_, val);
+            else if constexpr (std::is_same<uint8_t, Val>::value)
+                qi::parse(it, it + 1, qi::byte_, val);
+            else if constexpr (sizeof(Val) == 2)
+                qi::parse(it, it + 2, qi::little_word, val);
+            else if constexpr (std::is_same<float, Val>::value)
+            {
+                qi::parse(it, it + 4, qi::little_bin_float, val);
+                if (val == -2e10f)
+                    val = std::numeric_limits<float>::quiet_NaN();
+            } else if constexpr (std::is_same<double, Val>::value)
+            {
+                qi::parse(it, it + 8, qi::little_bin_double, val);
+                if (val == -2e10)
+                    val = std::numeric_limits<double>::quiet_NaN();
+            } else if constexpr (sizeof(Val) == 4)
+                qi::parse(it, it + 4, qi::little_dword, val);
+        }
+
+        template <typename It>
+        void header(It& it, BlockHeaderMsg& hdr)
+        {
+            parse(it, hdr.sync_1);
+            parse(it, hdr.sync_2);
+            parse(it, hdr.crc);
+            uint16_t ID;
+            parse(it, ID);
+            hdr.id = ID & 8191;
+            hdr.revision = ID >> 13;
+            parse(it, hdr.length);
+            parse(it, hdr.tow);
+            parse(it, hdr.wnc);
+        }
+
+        template <typename It>
+        bool PVTGeodeticParser(It it, It itEnd, PVTGeodeticMsg& msg)
+        {
+            header(it, msg.block_header);
+            parse(it, msg.mode);
+            parse(it, msg.error);
+            parse(it, msg.latitude);
+            parse(it, msg.longitude);
+            parse(it, msg.height);
+            parse(it, msg.undulation);
+            parse(it, msg.vn);
+            parse(it, msg.ve);
+            parse(it, msg.vu);
+            parse(it, msg.cog);
+            parse(it, msg.rx_clk_bias);
+            parse(it, msg.rx_clk_drift);
+            parse(it, msg.time_system);
+            parse(it, msg.datum);
+            parse(it, msg.nr_sv);
+            parse(it, msg.wa_corr_info);
+            parse(it, msg.reference_id);
+            parse(it, msg.mean_corr_age);
+            parse(it, msg.signal_info);
+            parse(it, msg.alert_flag);
+            parse(it, msg.nr_bases);
+            parse(it, msg.ppp_info);
+            parse(it, msg.latency);
+            parse(it, msg.h_accuracy);
+            parse(it, msg.v_accuracy);
+            parse(it, msg.misc);
+            return it <= itEnd;
+        }
+
+        template <typename It>
+        bool INSNavGeodParser(It it, It itEnd, INSNavGeodMsg& msg)
+        {
+            header(it, msg.block_header);
+            parse(it, msg.gnss_mode);
+            parse(it, msg.error);
+            parse(it, msg.info);
+            parse(it, msg.gnss_age);
+            parse(it, msg.latitude);
+            parse(it, msg.longitude);
+            parse(it, msg.height);
+            parse(it, msg.undulation);
+            parse(it, msg.accuracy);
+            parse(it, msg.latency);
+            parse(it, msg.datum);
+            ++it; // reserved
+            parse(it, msg.sb_list);
+            auto group = [&](uint16_t bit, float& a, float& b, float& c) {
+                if ((msg.sb_list & bit) != 0)
+                {
+                    parse(it, a);
+                    parse(it, b);
+                    parse(it, c);
+                } else
+                {
+                    a = b = c = std::numeric_limits<float>::quiet_NaN();
+                }
+            };
+            group(1, msg.latitude_std_dev, msg.longitude_std_dev,
+                  msg.height_std_dev);
+            group(2, msg.heading, msg.pitch, msg.roll);
+            group(4, msg.heading_std_dev, msg.pitch_std_dev, msg.roll_std_dev);
+            group(8, msg.ve, msg.vn, msg.vu);
+            group(16, msg.ve_std_dev, msg.vn_std_dev, msg.vu_std_dev);
+            group(32, msg.latitude_longitude_cov, msg.latitude_height_cov,
+                  msg.longitude_height_cov);
+            group(64, msg.heading_pitch_cov, msg.heading_roll_cov,
+                  msg.pitch_roll_cov);
+            group(128, msg.ve_vn_cov, msg.ve_vu_cov, msg.vn_vu_cov);
+            return it <= itEnd;
+        }
+
+        template <typename It>
+        bool MeasEpochParser(It it, It itEnd, MeasEpochMsg& msg)
+        {
+            header(it, msg.block_header);
+            parse(it, msg.n);
+            parse(it, msg.sb1_length);
+            parse(it, msg.sb2_length);
+            parse(it, msg.common_flags);
+            parse(it, msg.cum_clk_jumps);
+            ++it; // reserved
+            msg.type1.resize(msg.n);
+            for (auto& type1 : msg.type1)
+            {
+                parse(it, type1.rx_channel);
+                parse(it, type1.type);
+                parse(it, type1.sv_id);
+                parse(it, type1.misc);
+                parse(it, type1.code_lsb);
+                parse(it, type1.doppler);
+                parse(it, type1.carrier_lsb);
+                parse(it, type1.carrier_msb);
+                parse(it, type1.cn0);
+                parse(it, type1.lock_time);
+                parse(it, type1.obs_info);
+                parse(it, type1.n2);
+                std::advance(it, msg.sb1_length - 20);
+                type1.type2.resize(type1.n2);
+                for (auto& type2 : type1.type2)
+                {
+                    parse(it, type2.type);
+                    parse(it, type2.lock_time);
+                    parse(it, type2.cn0);
+                    parse(it, type2.offsets_msb);
+                    parse(it, type2.carrier_msb);
+                    parse(it, type2.obs_info);
+                    parse(it, type2.code_offset_lsb);
+                    parse(it, type2.carrier_lsb);
+                    parse(it, type2.doppler_offset_lsb);
+                    std::advance(it, msg.sb2_length - 12);
+                }
+            }
+            return it <= itEnd;
+        }
+    } // namespace qi_reference
+} // namespace
+
+class SbfLayoutTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite() { rclcpp::init(0, nullptr); }
+
+    static void TearDownTestSuite() { rclcpp::shutdown(); }
+};
+
+TEST_F(SbfLayoutTest, loadUnaligned)
+{
+    std::vector<uint8_t> data = {0xFF, 0x78, 0x56, 0x34, 0x12, 0, 0, 0, 0, 0};
+    EXPECT_EQ(sbf_layout::load<uint32_t>(data.data() + 1), 0x12345678u);
+    EXPECT_EQ(sbf_layout::load<int16_t>(data.data() + 3), 0x1234);
+
+    double val = -1.25;
+    std::memcpy(data.data() + 1, &val, sizeof(val));
+    EXPECT_EQ(sbf_layout::load<double>(data.data() + 1), val);
+}
+
+TEST_F(SbfLayoutTest, layoutSize)
+{
+    EXPECT_EQ(BlockHeaderLayout::size, 14u);
+    EXPECT_EQ(PVTGeodeticLayout::size, 85u);
+    EXPECT_EQ(PVTGeodeticRev2Layout::size, 95u);
+    EXPECT_EQ(INSNavGeodLayout::size, 56u);
+    EXPECT_EQ(INSNavGeodAttLayout::size, 12u);
+    EXPECT_EQ(MeasEpochChannelType1Layout::size, 20u);
+    EXPECT_EQ(MeasEpochChannelType2Layout::size, 12u);
+}
+
+TEST_F(SbfLayoutTest, pvtGeodetic)
+{
+    TestNode node;
+    std::vector<uint8_t> block = makePvtGeodetic();
+
+    PVTGeodeticMsg msg;
+    ASSERT_TRUE(PVTGeodeticParser(&node, block.begin(), block.end(), msg));
+    EXPECT_EQ(msg.block_header.id, 4007);
+    EXPECT_EQ(msg.block_header.revision, 2);
+    EXPECT_EQ(msg.block_header.tow, 345600000u);
+    EXPECT_EQ(msg.block_header.wnc, 2300);
+    EXPECT_EQ(msg.latitude, 0.8870);
+    EXPECT_EQ(msg.cog, 123.4f);
+    EXPECT_TRUE(std::isnan(msg.rx_clk_drift));
+    EXPECT_EQ(msg.signal_info, 0x12345678u);
+    EXPECT_EQ(msg.misc, 7);
+
+    PVTGeodeticMsg ref;
+    ASSERT_TRUE(qi_reference::PVTGeodeticParser(block.begin(), block.end(), ref));
+    ref.rx_clk_drift = msg.rx_clk_drift = 0.0f;
+    EXPECT_TRUE(msg == ref);
+
+    block[5] &= 0x1F; // revision 0
+    ASSERT_TRUE(PVTGeodeticParser(&node, block.begin(), block.begin() + 85, msg));
+    EXPECT_FALSE(PVTGeodeticParser(&node, block.begin(), block.begin() + 84, msg));
+}
+
+TEST_F(SbfLayoutTest, insNavGeod)
+{
+    TestNode node;
+    for (uint16_t sbList : {0x00, 0x01, 0x0A, 0x45, 0xFF})
+    {
+        std::vector<uint8_t> block = makeInsNavGeod(sbList);
+        INSNavGeodMsg msg;
+        INSNavGeodMsg ref;
+        ASSERT_TRUE(
+            INSNavGeodParser(&node, block.begin(), block.end(), msg, false));
+        ASSERT_TRUE(
+            qi_reference::INSNavGeodParser(block.begin(), block.end(), ref));
+        EXPECT_EQ(msg.sb_list, sbList);
+        EXPECT_EQ(std::isnan(msg.heading), (sbList & 2) == 0);
+        EXPECT_EQ(std::isnan(msg.ve_vn_cov), (sbList & 128) == 0);
+        // NaN of absent sub-blocks does not compare equal
+        if (sbList == 0xFF)
+            EXPECT_TRUE(msg == ref);
+        else
+            EXPECT_EQ(msg.latitude_std_dev == ref.latitude_std_dev,
+                      (sbList & 1) != 0);
+    }
+
+    std::vector<uint8_t> block = makeInsNavGeod(0x03);
+    INSNavGeodMsg msg;
+    ASSERT_TRUE(INSNavGeodParser(&node, block.begin(), block.end(), msg, true));
+    EXPECT_EQ(msg.heading, -3.5f + 90);
+    EXPECT_EQ(msg.pitch, -4.5f);
+}
+
+TEST_F(SbfLayoutTest, measEpoch)
+{
+    TestNode node;
+    std::vector<uint8_t> block = makeMeasEpoch(30, 2);
+
+    MeasEpoch meas;
+    MeasEpochMsg msg;
+    MeasEpochMsg ref;
+    ASSERT_TRUE(MeasEpochParser(&node, block.begin(), block.end(), meas));
+    measEpochToMsg(meas, msg);
+    ASSERT_TRUE(qi_reference::MeasEpochParser(block.begin(), block.end(), ref));
+    ASSERT_EQ(msg.type1.size(), 30u);
+    ASSERT_EQ(msg.type1[29].type2.size(), 2u);
+    EXPECT_EQ(msg.cum_clk_jumps, 2);
+    EXPECT_EQ(msg.type1[29].code_lsb, 1000029u);
+    EXPECT_EQ(msg.type1[29].carrier_msb, -3);
+    EXPECT_EQ(msg.type1[29].type2[1].doppler_offset_lsb, 3500);
+    EXPECT_TRUE(msg == ref);
+
+    EXPECT_FALSE(MeasEpochParser(&node, block.begin(), block.end() - 1, meas));
+}
+
+TEST_F(SbfLayoutTest, flatStorage)
+{
+    TestNode node;
+    std::vector<uint8_t> large = makeMeasEpoch(40, 3);
+    std::vector<uint8_t> small = makeMeasEpoch(20, 1);
+
+    MeasEpoch meas;
+    ASSERT_TRUE(MeasEpochParser(&node, large.begin(), large.end(), meas));
+    const uint32_t* codeLsb = meas.type1.code_lsb.data();
+    const uint16_t* carrierLsb = meas.type2.carrier_lsb.data();
+    ASSERT_TRUE(MeasEpochParser(&node, small.begin(), small.end(), meas));
+    EXPECT_EQ(meas.type1.code_lsb.size(), 20u);
+    EXPECT_EQ(meas.type2.carrier_lsb.size(), 20u);
+    ASSERT_TRUE(MeasEpochParser(&node, large.begin(), large.end(), meas));
+    // Capacity is kept from block to block
+    EXPECT_EQ(meas.type1.code_lsb.data(), codeLsb);
+    EXPECT_EQ(meas.type2.carrier_lsb.data(), carrierLsb);
+
+    ASSERT_EQ(meas.type2.type.size(), 120u);
+    for (size_t i = 0; i < meas.n; ++i)
+    {
+        EXPECT_EQ(meas.type1.type2_begin[i], 3 * i);
+        EXPECT_EQ(meas.type1.n2[i], 3);
+        EXPECT_EQ(meas.type2.type[meas.type1.type2_begin[i] + 2], 2);
+    }
+
+    BlockWriter channels(4013, 0, 20 + 2 * 12 + 3 * 8);
+    channels.set<uint8_t>(14, 2).set<uint8_t>(15, 12).set<uint8_t>(16, 8);
+    channels.set<uint8_t>(20, 5).set<uint8_t>(20 + 9, 1);
+    channels.set<uint16_t>(32 + 4, 0x80);
+    channels.set<uint8_t>(40, 7).set<uint8_t>(40 + 9, 2);
+    channels.set<uint16_t>(52 + 4, 0x40).set<uint16_t>(60 + 4, 0x20);
+    ChannelStatus status;
+    ASSERT_TRUE(ChannelStatusParser(&node, channels.block().begin(),
+                                    channels.block().end(), status));
+    EXPECT_EQ(status.satInfo.sv_id[1], 7);
+    EXPECT_EQ(status.satInfo.state_info_begin[1], 1);
+    ASSERT_EQ(status.stateInfo.pvt_status.size(), 3u);
+    EXPECT_EQ(status.stateInfo.pvt_status[0], 0x80);
+    EXPECT_EQ(status.stateInfo.pvt_status[1], 0x40);
+    EXPECT_EQ(status.stateInfo.pvt_status[2], 0x20);
+}
+
+TEST_F(SbfLayoutTest, truncatedBlocks)
+{
+    TestNode node;
+    std::vector<uint8_t> header = makePvtGeodetic();
+    header.resize(10);
+    PVTGeodeticMsg pvt;
+    EXPECT_FALSE(PVTGeodeticParser(&node, header.begin(), header.end(), pvt));
+
+    // More sub-blocks than the block holds
+    std::vector<uint8_t> ins = makeInsNavGeod(0x01);
+    ins[54] = 0xFF;
+    INSNavGeodMsg insMsg;
+    EXPECT_FALSE(INSNavGeodParser(&node, ins.begin(), ins.end(), insMsg, false));
+
+    MeasEpoch meas;
+    std::vector<uint8_t> block = makeMeasEpoch(10, 2);
+    block[20 + 9 * 44 + 19] = 3; // n2 of last channel
+    EXPECT_FALSE(MeasEpochParser(&node, block.begin(), block.end(), meas));
+    block[20 + 9 * 44 + 19] = 2;
+    ASSERT_TRUE(MeasEpochParser(&node, block.begin(), block.end(), meas));
+    block[14] = 11; // n
+    EXPECT_FALSE(MeasEpochParser(&node, block.begin(), block.end(), meas));
+    block[14] = 10;
+    block[15] = 19; // sb1_length shorter than its fields
+    EXPECT_FALSE(MeasEpochParser(&node, block.begin(), block.end(), meas));
+
+    BlockWriter channels(4013, 0, 20 + 2 * (12 + 8));
+    channels.set<uint8_t>(14, 2).set<uint8_t>(15, 12).set<uint8_t>(16, 8);
+    channels.set<uint8_t>(20 + 9, 1).set<uint8_t>(40 + 9, 1);
+    ChannelStatus status;
+    ASSERT_TRUE(ChannelStatusParser(&node, channels.block().begin(),
+                                    channels.block().end(), status));
+    EXPECT_EQ(status.satInfo.n2[1], 1u);
+    EXPECT_EQ(status.stateInfo.antenna.size(), 2u);
+    channels.set<uint8_t>(40 + 9, 2);
+    EXPECT_FALSE(ChannelStatusParser(&node, channels.block().begin(),
+                                     channels.block().end(), status));
+}
+
+TEST_F(SbfLayoutTest, scaledAndDoNotUse)
+{
+    TestNode node;
+    BlockWriter dop(4001, 0, 32);
+    dop.set<uint8_t>(14, 12).set<uint16_t>(16, 150).set<uint16_t>(22, 325);
+    dop.set(24, -2e10f).set(28, 3.5f);
+    Dop dopMsg;
+    ASSERT_TRUE(DOPParser(&node, dop.block().begin(), dop.block().end(), dopMsg));
+    EXPECT_EQ(dopMsg.nr_sv, 12);
+    EXPECT_EQ(dopMsg.pdop, 150 / 100.0);
+    EXPECT_EQ(dopMsg.vdop, 325 / 100.0);
+    EXPECT_TRUE(std::isnan(dopMsg.hpl));
+    EXPECT_EQ(dopMsg.vpl, 3.5f);
+
+    BlockWriter ext(4050, 0, 16 + 2 * 28);
+    ext.set<uint8_t>(14, 2).set<uint8_t>(15, 28);
+    ext.set<uint8_t>(16 + 2, 3).set<int16_t>(16 + 4, 2512);
+    ext.set<uint8_t>(44 + 2, 0).set(44 + 4, 0.5).set(44 + 12, -0.5);
+    ext.set(44 + 20, 9.81);
+    ExtSensorMeasMsg extMsg;
+    bool hasImuMeas = true;
+    ASSERT_TRUE(ExtSensorMeasParser(&node, ext.block().begin(), ext.block().end(),
+                                    extMsg, true, hasImuMeas));
+    EXPECT_FALSE(hasImuMeas);
+    EXPECT_EQ(extMsg.sensor_temperature, 2512 / 100.0f);
+    EXPECT_EQ(extMsg.acceleration_z, 9.81);
+    EXPECT_TRUE(std::isnan(extMsg.angular_rate_x));
+
+    ext.set<int16_t>(16 + 4, -32768);
+    ASSERT_TRUE(ExtSensorMeasParser(&node, ext.block().begin(), ext.block().end(),
+                                    extMsg, true, hasImuMeas));
+    EXPECT_TRUE(std::isnan(extMsg.sensor_temperature));
+}
@@ -0,0 +1,355 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <gtest/gtest.h>
+
+// C++
+#include <cmath>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include <septentrio_gnss_driver/parsers/sbf_schema.hpp>
+
+namespace {
+    //! Writes little endian fields of an SBF block at given offsets
+    class BlockWriter
+    {
+    public:
+        BlockWriter(uint16_t id, uint8_t revision, uint16_t length) :
+            block_(length, 0)
+        {
+            block_[0] = '$';
+            block_[1] = '@';
+            set<uint16_t>(4, id | (revision << 13));
+            set<uint16_t>(6, length);
+            set<uint32_t>(8, 345600000);
+            set<uint16_t>(12, 2300);
+        }
+
+        template <typename Val>
+        BlockWriter& set(size_t offset, Val val)
+        {
+            std::memcpy(block_.data() + offset, &val, sizeof(Val));
+            return *this;
+        }
+
+        const std::vector<uint8_t>& block() const { return block_; }
+
+    private:
+        std::vector<uint8_t> block_;
+    };
+
+    sbf_schema::BlockView parse(const std::vector<uint8_t>& block)
+    {
+        uint16_t id = (block[4] | (block[5] << 8)) & 0x1FFF;
+        const sbf_schema::Block* schema = sbf_schema::find(id);
+        EXPECT_NE(schema, nullptr);
+        sbf_schema::BlockView view;
+        EXPECT_TRUE(view.parse(*schema, block.data(), block.size()));
+        return view;
+    }
+
+    double value(const sbf_schema::BlockView& view, std::string_view name)
+    {
+        auto field = view.field(name);
+        EXPECT_TRUE(field.has_value()) << name;
+        return field ? field->value() : 0.0;
+    }
+
+    double value(const sbf_schema::BlockView& view, size_t sb,
+                 std::string_view name)
+    {
+        auto field = view.subBlockField(sb, name);
+        EXPECT_TRUE(field.has_value()) << name;
+        return field ? field->value() : 0.0;
+    }
+
+    std::vector<uint8_t> makeSatVisibility(uint8_t n)
+    {
+        BlockWriter w(4012, 0, static_cast<uint16_t>(16 + 8 * n));
+        w.set<uint8_t>(14, n).set<uint8_t>(15, 8);
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            size_t sb = 16 + 8 * i;
+            w.set<uint8_t>(sb, i + 1).set<uint8_t>(sb + 1, 0);
+            w.set<uint16_t>(sb + 2, 100 * i + 12345).set<int16_t>(sb + 4, 4500);
+            w.set<uint8_t>(sb + 6, 1).set<uint8_t>(sb + 7, 3);
+        }
+        return w.block();
+    }
+} // namespace
+
+TEST(SbfSchemaTest, schema)
+{
+    std::set<std::string_view> names;
+    for (const sbf_schema::Block& block : sbf_schema::SCHEMA)
+    {
+        EXPECT_EQ(sbf_schema::find(block.id), &block);
+        EXPECT_TRUE(names.insert(block.name).second) << block.name;
+    }
+    // Blocks with dedicated parsers
+    EXPECT_EQ(sbf_schema::find(4007), nullptr);
+    EXPECT_EQ(sbf_schema::find(4027), nullptr);
+
+    static_assert(sbf_schema::fieldIndex(sbf_schema::SAT_INFO_FIELDS,
+                                         "Elevation") == 3);
+}
+
+TEST(SbfSchemaTest, pvtSatCartesian)
+{
+    BlockWriter w(4008, 1, 16 + 2 * 56);
+    w.set<uint8_t>(14, 2).set<uint8_t>(15, 56);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        size_t sb = 16 + 56 * i;
+        w.set<uint8_t>(sb, 5 + i).set<uint8_t>(sb + 1, 0).set<uint16_t>(sb + 2, 77);
+        w.set(sb + 4, 1.5e7 + i).set(sb + 12, -2.1e7).set(sb + 20, 3.3e6);
+        w.set(sb + 28, 100.5f).set(sb + 32, -2e10f).set(sb + 36, 2.25f);
+        w.set<int16_t>(sb + 40, 3).set<int16_t>(sb + 42, -32768);
+        w.set(sb + 44, 0.5f).set(sb + 48, 0.25f);
+        w.set<uint8_t>(sb + 52, 2).set<uint8_t>(sb + 53, 1);
+    }
+    auto view = parse(w.block());
+
+    EXPECT_EQ(view.revision(), 1);
+    EXPECT_EQ(view.tow(), 345600000u);
+    EXPECT_EQ(view.wnc(), 2300u);
+    ASSERT_EQ(view.subBlockCount(), 2u);
+    EXPECT_EQ(view.subBlockFieldCount(), 15u);
+    EXPECT_DOUBLE_EQ(value(view, 1, "SVID"), 6.0);
+    EXPECT_DOUBLE_EQ(value(view, 1, "IODE"), 77.0);
+    EXPECT_DOUBLE_EQ(value(view, 1, "X"), 1.5e7 + 1);
+    EXPECT_DOUBLE_EQ(value(view, 0, "Y"), -2.1e7);
+    EXPECT_DOUBLE_EQ(value(view, 0, "Vx"), 100.5);
+    EXPECT_TRUE(std::isnan(value(view, 0, "Vy")));
+    EXPECT_DOUBLE_EQ(value(view, 0, "IonoMSB"), 3.0);
+    EXPECT_TRUE(std::isnan(value(view, 0, "TropoMSB")));
+    EXPECT_DOUBLE_EQ(value(view, 0, "TropoLSB"), 0.25);
+    EXPECT_DOUBLE_EQ(value(view, 0, "TropoModel"), 1.0);
+}
+
+TEST(SbfSchemaTest, pvtSatCartesianRev0)
+{
+    // Revision 0 sub-blocks end before the model fields
+    BlockWriter w(4008, 0, 16 + 52);
+    w.set<uint8_t>(14, 1).set<uint8_t>(15, 52).set<uint8_t>(16, 9);
+    auto view = parse(w.block());
+
+    EXPECT_EQ(view.subBlockFieldCount(), 13u);
+    EXPECT_DOUBLE_EQ(value(view, 0, "SVID"), 9.0);
+    EXPECT_FALSE(view.subBlockField(0, "IonoModel").has_value());
+}
+
+TEST(SbfSchemaTest, satVisibility)
+{
+    auto block = makeSatVisibility(3);
+    auto view = parse(block);
+
+    ASSERT_EQ(view.subBlockCount(), 3u);
+    EXPECT_DOUBLE_EQ(value(view, "N"), 3.0);
+    EXPECT_DOUBLE_EQ(value(view, 2, "SVID"), 3.0);
+    EXPECT_DOUBLE_EQ(value(view, 2, "Azimuth"), 125.45);
+    EXPECT_DOUBLE_EQ(value(view, 0, "Elevation"), 45.0);
+    EXPECT_DOUBLE_EQ(value(view, 1, "RiseSet"), 1.0);
+    EXPECT_DOUBLE_EQ(value(view, 1, "SatelliteInfo"), 3.0);
+
+    BlockWriter w(4012, 0, 24);
+    w.set<uint8_t>(14, 1).set<uint8_t>(15, 8);
+    w.set<uint16_t>(18, 65535).set<int16_t>(20, -32768);
+    auto dnu = parse(w.block());
+    EXPECT_TRUE(std::isnan(value(dnu, 0, "Azimuth")));
+    EXPECT_TRUE(std::isnan(value(dnu, 0, "Elevation")));
+}
+
+TEST(SbfSchemaTest, extEventPvtCartesian)
+{
+    BlockWriter w(4037, 2, 96);
+    w.set<uint8_t>(14, 4).set(16, 4.0e6).set(24, 3.0e5).set(32, 4.9e6);
+    w.set(44, 0.5f).set<uint8_t>(74, 255).set<uint16_t>(78, 150);
+    w.set<uint16_t>(90, 3).set<uint16_t>(92, 65535).set<uint8_t>(94, 7);
+    auto view = parse(w.block());
+
+    EXPECT_EQ(view.fieldCount(), 26u);
+    EXPECT_DOUBLE_EQ(value(view, "Mode"), 4.0);
+    EXPECT_DOUBLE_EQ(value(view, "X"), 4.0e6);
+    EXPECT_DOUBLE_EQ(value(view, "Z"), 4.9e6);
+    EXPECT_DOUBLE_EQ(value(view, "Vx"), 0.5);
+    EXPECT_TRUE(std::isnan(value(view, "NrSV")));
+    EXPECT_DOUBLE_EQ(value(view, "MeanCorrAge"), 1.5);
+    EXPECT_DOUBLE_EQ(value(view, "HAccuracy"), 0.03);
+    EXPECT_TRUE(std::isnan(value(view, "VAccuracy")));
+    EXPECT_DOUBLE_EQ(value(view, "Misc"), 7.0);
+}
+
+TEST(SbfSchemaTest, extEventPvtGeodetic)
+{
+    // Revision 1 blocks end before the fields added by revision 2
+    BlockWriter w(4038, 1, 88);
+    w.set(16, 0.8870).set(24, 0.0788).set(32, 104.5).set(56, -2e10f);
+    w.set<uint8_t>(85, 2).set<uint16_t>(86, 300);
+    auto view = parse(w.block());
+
+    EXPECT_EQ(view.fieldCount(), 22u);
+    EXPECT_DOUBLE_EQ(value(view, "Latitude"), 0.8870);
+    EXPECT_DOUBLE_EQ(value(view, "Longitude"), 0.0788);
+    EXPECT_DOUBLE_EQ(value(view, "Height"), 104.5);
+    EXPECT_TRUE(std::isnan(value(view, "COG")));
+    EXPECT_DOUBLE_EQ(value(view, "NrBases"), 2.0);
+    EXPECT_DOUBLE_EQ(value(view, "PPPInfo"), 300.0);
+    EXPECT_FALSE(view.field("Latency").has_value());
+}
+
+TEST(SbfSchemaTest, bbSamples)
+{
+    BlockWriter w(4040, 0, 28 + 2 * 3);
+    w.set<uint16_t>(14, 3).set<uint8_t>(16, 1);
+    w.set<uint32_t>(20, 80000000).set<uint32_t>(24, 1575420000);
+    w.set<int8_t>(28, -3).set<int8_t>(29, 4);
+    w.set<int8_t>(32, 127).set<int8_t>(33, -128);
+    auto view = parse(w.block());
+
+    ASSERT_EQ(view.subBlockCount(), 3u);
+    EXPECT_DOUBLE_EQ(value(view, "Info"), 1.0);
+    EXPECT_DOUBLE_EQ(value(view, "SampleFreq"), 8.0e7);
+    EXPECT_DOUBLE_EQ(value(view, "LOFreq"), 1575420000.0);
+    EXPECT_DOUBLE_EQ(value(view, 0, "Q"), -3.0);
+    EXPECT_DOUBLE_EQ(value(view, 0, "I"), 4.0);
+    EXPECT_DOUBLE_EQ(value(view, 1, "I"), 0.0);
+    EXPECT_DOUBLE_EQ(value(view, 2, "Q"), 127.0);
+    EXPECT_DOUBLE_EQ(value(view, 2, "I"), -128.0);
+}
+
+TEST(SbfSchemaTest, posLocal)
+{
+    BlockWriter w(4052, 0, 44);
+    w.set<uint8_t>(14, 1).set(16, 0.5).set(24, -0.25).set(32, -2e10);
+    w.set<uint8_t>(40, 30);
+    auto view = parse(w.block());
+
+    EXPECT_DOUBLE_EQ(value(view, "Mode"), 1.0);
+    EXPECT_DOUBLE_EQ(value(view, "Lat"), 0.5);
+    EXPECT_DOUBLE_EQ(value(view, "Lon"), -0.25);
+    EXPECT_TRUE(std::isnan(value(view, "Alt")));
+    EXPECT_DOUBLE_EQ(value(view, "Datum"), 30.0);
+}
+
+TEST(SbfSchemaTest, xPpsOffset)
+{
+    BlockWriter w(5911, 0, 20);
+    w.set<uint8_t>(14, 12).set<uint8_t>(15, 1).set(16, 3.75f);
+    auto view = parse(w.block());
+
+    EXPECT_DOUBLE_EQ(value(view, "SyncAge"), 12.0);
+    EXPECT_DOUBLE_EQ(value(view, "TimeScale"), 1.0);
+    EXPECT_DOUBLE_EQ(value(view, "Offset"), 3.75);
+}
+
+TEST(SbfSchemaTest, endOfBlocks)
+{
+    for (uint16_t id : {5921, 5922, 5943})
+    {
+        BlockWriter w(id, 0, 16);
+        auto view = parse(w.block());
+
+        EXPECT_EQ(view.block().id, id);
+        EXPECT_EQ(view.fieldCount(), 0u);
+        EXPECT_EQ(view.subBlockCount(), 0u);
+        EXPECT_EQ(view.tow(), 345600000u);
+    }
+    EXPECT_EQ(sbf_schema::find(5921)->name, "EndOfPVT");
+    EXPECT_EQ(sbf_schema::find(5922)->name, "EndOfMeas");
+    EXPECT_EQ(sbf_schema::find(5943)->name, "EndOfAtt");
+}
+
+TEST(SbfSchemaTest, extEvent)
+{
+    BlockWriter w(5924, 1, 32);
+    w.set<uint8_t>(14, 2).set<uint8_t>(15, 1).set(16, 1.5e-7f);
+    w.set(20, 0.125).set<uint16_t>(28, 65535);
+    auto view = parse(w.block());
+
+    EXPECT_EQ(view.fieldCount(), 5u);
+    EXPECT_DOUBLE_EQ(value(view, "Source"), 2.0);
+    EXPECT_DOUBLE_EQ(value(view, "Polarity"), 1.0);
+    EXPECT_DOUBLE_EQ(value(view, "Offset"), static_cast<double>(1.5e-7f));
+    EXPECT_DOUBLE_EQ(value(view, "RxClkBias"), 0.125);
+    EXPECT_TRUE(std::isnan(value(view, "PVTAge")));
+
+    BlockWriter rev0(5924, 0, 28);
+    EXPECT_EQ(parse(rev0.block()).fieldCount(), 4u);
+}
+
+TEST(SbfSchemaTest, auxAntPositions)
+{
+    BlockWriter w(5942, 0, 16 + 2 * 52);
+    w.set<uint8_t>(14, 2).set<uint8_t>(15, 52);
+    w.set<uint8_t>(16, 12).set<uint8_t>(19, 1).set(20, 1.25).set(28, -0.5);
+    w.set<uint8_t>(68, 255).set<uint8_t>(71, 2).set(96, 0.01).set(112, -2e10);
+    auto view = parse(w.block());
+
+    ASSERT_EQ(view.subBlockCount(), 2u);
+    EXPECT_DOUBLE_EQ(value(view, 0, "NrSV"), 12.0);
+    EXPECT_DOUBLE_EQ(value(view, 0, "AuxAntID"), 1.0);
+    EXPECT_DOUBLE_EQ(value(view, 0, "DeltaEast"), 1.25);
+    EXPECT_DOUBLE_EQ(value(view, 0, "DeltaNorth"), -0.5);
+    EXPECT_TRUE(std::isnan(value(view, 1, "NrSV")));
+    EXPECT_DOUBLE_EQ(value(view, 1, "AuxAntID"), 2.0);
+    EXPECT_DOUBLE_EQ(value(view, 1, "EastVel"), 0.01);
+    EXPECT_TRUE(std::isnan(value(view, 1, "UpVel")));
+}
+
+TEST(SbfSchemaTest, truncatedBlocks)
+{
+    sbf_schema::BlockView view;
+    const sbf_schema::Block& extEvent = *sbf_schema::find(5924);
+    BlockWriter rev1(5924, 1, 30);
+    EXPECT_FALSE(view.parse(extEvent, rev1.block().data(), 29));
+    EXPECT_FALSE(view.parse(extEvent, rev1.block().data(), 12));
+
+    // Sub-blocks past the end of the block
+    auto block = makeSatVisibility(3);
+    const sbf_schema::Block& satVisibility = *sbf_schema::find(4012);
+    EXPECT_TRUE(view.parse(satVisibility, block.data(), block.size()));
+    EXPECT_FALSE(view.parse(satVisibility, block.data(), block.size() - 1));
+
+    // Sub-blocks shorter than their fields
+    block[15] = 7;
+    EXPECT_FALSE(view.parse(satVisibility, block.data(), block.size()));
+}
+
+TEST(SbfSchemaTest, toString)
+{
+    auto block = makeSatVisibility(1);
+    auto view = parse(block);
+
+    EXPECT_EQ(view.toString(),
+              "SatVisibility TOW 345600000 WNc 2300: N=1, SBLength=8; "
+              "SatInfo[0] SVID=1, FreqNr=0, Azimuth=123.45, Elevation=45, "
+              "RiseSet=1, SatelliteInfo=3");
+}
@@ -0,0 +1,258 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+
+namespace {
+    std::vector<uint8_t> makeSbf(uint16_t id, uint16_t length, uint8_t fill)
+    {
+        std::vector<uint8_t> block(length, fill);
+        block[0] = SYNC_BYTE_1;
+        block[1] = SBF_SYNC_BYTE_2;
+        block[4] = id & 0xFF;
+        block[5] = id >> 8;
+        block[6] = length & 0xFF;
+        block[7] = length >> 8;
+        uint16_t crc = crc::compute16CCITT(block.data() + 4, length - 4);
+        block[2] = crc & 0xFF;
+        block[3] = crc >> 8;
+        return block;
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    void append(std::vector<uint8_t>& stream, const std::string& data)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+
+    //! Typical mix of a live stream: INS at high rate, MeasEpoch, NMEA and a
+    //! command response terminated by the connection descriptor prompt
+    std::vector<uint8_t> makeStream(size_t epochs, size_t& telegrams)
+    {
+        std::vector<uint8_t> stream;
+        telegrams = 0;
+        for (size_t i = 0; i < epochs; ++i)
+        {
+            for (size_t j = 0; j < 5; ++j)
+            {
+                append(stream, makeSbf(4226, 112, static_cast<uint8_t>(i + j)));
+                append(stream, makeSbf(4050, 56, static_cast<uint8_t>(i)));
+                telegrams += 2;
+            }
+            append(stream, makeSbf(4027, 2096, static_cast<uint8_t>(i)));
+            append(stream,
+                   "$GPGGA,121041.00,5050.1233,N,00441.1234,E,4,28,0.5,98.2,M,"
+                   "47.6,M,1.0,0000*47\r\n");
+            append(stream,
+                   "$INGGA,121041.00,5050.1233,N,00441.1234,E,4,28,0.5,98.2,M,"
+                   "47.6,M,1.0,0000*47\r\n");
+            // The indented line continues the response
+            append(stream, "$R: grc\r\n  ReceiverCapabilities, ...\r\n");
+            append(stream, "IP10>");
+            telegrams += 5;
+        }
+        return stream;
+    }
+
+    struct Collector
+    {
+        std::vector<std::shared_ptr<Telegram>> telegrams;
+        size_t faults = 0;
+
+        io::TelegramFramer framer()
+        {
+            return io::TelegramFramer(
+                [this](const std::shared_ptr<Telegram>& telegram) {
+                    telegrams.push_back(telegram);
+                },
+                [this](const std::string&) { ++faults; });
+        }
+    };
+} // namespace
+
+TEST(TelegramFramerTest, classification)
+{
+    std::vector<uint8_t> stream;
+    append(stream, makeSbf(4007, 96, 0x11));
+    append(stream, "$GPGGA,1*47\r\n");
+    append(stream, "$INGGA,1*47\r\n");
+    append(stream, "$R: setDataInOut\r\n");
+    append(stream, "$R? unknown command\r\n");
+    append(stream, "IP10>");
+    append(stream, "  ReceiverCapabilities, GNSS\r\n");
+
+    Collector collector;
+    io::TelegramFramer framer = collector.framer();
+    framer.feed(stream.data(), stream.size(), 42);
+
+    ASSERT_EQ(collector.telegrams.size(), 7u);
+    EXPECT_EQ(collector.telegrams[0]->type, telegram_type::SBF);
+    EXPECT_EQ(collector.telegrams[0]->message.size(), 96u);
+    EXPECT_EQ(collector.telegrams[1]->type, telegram_type::NMEA);
+    EXPECT_EQ(collector.telegrams[2]->type, telegram_type::NMEA_INS);
+    EXPECT_EQ(collector.telegrams[3]->type, telegram_type::RESPONSE);
+    EXPECT_EQ(collector.telegrams[4]->type, telegram_type::ERROR_RESPONSE);
+    EXPECT_EQ(collector.telegrams[5]->type, telegram_type::CONNECTION_DESCRIPTOR);
+    EXPECT_EQ(std::string(collector.telegrams[5]->message.begin(),
+                          collector.telegrams[5]->message.end()),
+              "IP10>");
+    EXPECT_EQ(collector.telegrams[6]->type, telegram_type::UNKNOWN);
+    EXPECT_EQ(collector.telegrams[1]->stamp, 42u);
+    EXPECT_EQ(collector.faults, 0u);
+}
+
+TEST(TelegramFramerTest, multiLineResponse)
+{
+    std::vector<uint8_t> stream;
+    append(stream, "$R: gso\r\n  SBFOutput, Stream1, IP10, PVTGeodetic, sec1\r\n");
+    append(stream, "  SBFOutput, Stream2, none, none, off\r\nIP10>");
+    append(stream, "$R: sgd, WGS84\r\n");
+    append(stream, makeSbf(4007, 96, 0x11));
+
+    Collector collector;
+    io::TelegramFramer framer = collector.framer();
+    framer.feed(stream.data(), stream.size(), 0);
+
+    ASSERT_EQ(collector.telegrams.size(), 4u);
+    EXPECT_EQ(collector.telegrams[0]->type, telegram_type::RESPONSE);
+    EXPECT_EQ(std::string(collector.telegrams[0]->message.begin(),
+                          collector.telegrams[0]->message.end()),
+              "$R: gso\r\n  SBFOutput, Stream1, IP10, PVTGeodetic, sec1\r\n"
+              "  SBFOutput, Stream2, none, none, off\r\n");
+    EXPECT_EQ(collector.telegrams[1]->type, telegram_type::CONNECTION_DESCRIPTOR);
+    EXPECT_EQ(collector.telegrams[2]->type, telegram_type::RESPONSE);
+    EXPECT_EQ(collector.telegrams[2]->message.size(), 16u);
+    EXPECT_EQ(collector.telegrams[3]->type, telegram_type::SBF);
+    EXPECT_EQ(collector.faults, 0u);
+}
+
+TEST(TelegramFramerTest, responseAtEndOfStream)
+{
+    const std::string response = "$R: gso\r\n  SBFOutput, Stream1, none\r\n";
+    std::vector<uint8_t> stream;
+    append(stream, response);
+
+    Collector collector;
+    io::TelegramFramer framer = collector.framer();
+    framer.feed(stream.data(), stream.size(), 0);
+    // Held back, as a further indented line could follow
+    EXPECT_TRUE(collector.telegrams.empty());
+    EXPECT_TRUE(framer.responsePending());
+
+    framer.flush();
+    ASSERT_EQ(collector.telegrams.size(), 1u);
+    EXPECT_EQ(collector.telegrams[0]->type, telegram_type::RESPONSE);
+    EXPECT_EQ(std::string(collector.telegrams[0]->message.begin(),
+                          collector.telegrams[0]->message.end()),
+              response);
+    EXPECT_FALSE(framer.responsePending());
+
+    // Incomplete telegrams are not flushed, but a complete response is emitted
+    // on reset
+    framer.feed(stream.data(), 5, 0);
+    framer.flush();
+    EXPECT_EQ(collector.telegrams.size(), 1u);
+    framer.feed(stream.data() + 5, stream.size() - 5, 0);
+    framer.reset();
+    ASSERT_EQ(collector.telegrams.size(), 2u);
+    EXPECT_EQ(collector.telegrams[1]->message, collector.telegrams[0]->message);
+    EXPECT_EQ(collector.faults, 0u);
+}
+
+TEST(TelegramFramerTest, crc)
+{
+    std::vector<uint8_t> corrupted = makeSbf(4007, 96, 0x11);
+    corrupted[50] ^= 0x01;
+
+    std::vector<uint8_t> stream;
+    append(stream, corrupted);
+    append(stream, makeSbf(4007, 96, 0x22));
+
+    Collector collector;
+    io::TelegramFramer framer = collector.framer();
+    framer.feed(stream.data(), stream.size(), 0);
+
+    ASSERT_EQ(collector.telegrams.size(), 1u);
+    EXPECT_EQ(collector.telegrams[0]->message[20], 0x22);
+    EXPECT_EQ(framer.sbfFaults(), 1u);
+}
+
+TEST(TelegramFramerTest, resyncOnGarbage)
+{
+    std::vector<uint8_t> stream;
+    append(stream, "$$$X");
+    append(stream, "$GPGGA,1*47\r\n");
+    append(stream, "$GPGGA,2*47$GPGGA,3*47\r\n");
+    append(stream, makeSbf(4007, 96, 0x33));
+
+    Collector collector;
+    io::TelegramFramer framer = collector.framer();
+    framer.feed(stream.data(), stream.size(), 0);
+
+    ASSERT_EQ(collector.telegrams.size(), 3u);
+    EXPECT_EQ(collector.faults, 2u);
+    EXPECT_EQ(std::string(collector.telegrams[1]->message.begin(),
+                          collector.telegrams[1]->message.end()),
+              "$GPGGA,3*47\r\n");
+    EXPECT_EQ(collector.telegrams[2]->type, telegram_type::SBF);
+}
+
+TEST(TelegramFramerTest, arbitraryChunking)
+{
+    size_t expected;
+    std::vector<uint8_t> stream = makeStream(3, expected);
+
+    Collector reference;
+    io::TelegramFramer referenceFramer = reference.framer();
+    referenceFramer.feed(stream.data(), stream.size(), 0);
+    ASSERT_EQ(reference.telegrams.size(), expected);
+    EXPECT_EQ(reference.faults, 0u);
+
+    for (size_t chunk : {1, 2, 3, 7, 8, 9, 64, 1000, 4096})
+    {
+        Collector collector;
+        io::TelegramFramer framer = collector.framer();
+        for (size_t i = 0; i < stream.size(); i += chunk)
+            framer.feed(stream.data() + i, std::min(chunk, stream.size() - i), 0);
+
+        ASSERT_EQ(collector.telegrams.size(), expected) << "chunk size " << chunk;
+        for (size_t i = 0; i < expected; ++i)
+        {
+            EXPECT_EQ(collector.telegrams[i]->type, reference.telegrams[i]->type);
+            EXPECT_EQ(collector.telegrams[i]->message,
+                      reference.telegrams[i]->message);
+        }
+    }
+}
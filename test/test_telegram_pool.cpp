@@ -0,0 +1,163 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <septentrio_gnss_driver/communication/telegram_framer.hpp>
+#include <septentrio_gnss_driver/communication/telegram_pool.hpp>
+
+namespace {
+    std::atomic<size_t> allocations = 0;
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+TEST(TelegramPoolTest, recycling)
+{
+    auto pool = std::make_shared<TelegramPool>();
+
+    Telegram* raw;
+    {
+        auto telegram = pool->acquire(100);
+        raw = telegram.get();
+        EXPECT_GE(telegram->message.capacity(), 100u);
+        telegram->type = telegram_type::SBF;
+        telegram->stamp = 1;
+        telegram->message.assign(100, 0xAA);
+        EXPECT_EQ(pool->cached(), 0u);
+    }
+    EXPECT_EQ(pool->cached(), 1u);
+
+    auto telegram = pool->acquire(200);
+    EXPECT_EQ(telegram.get(), raw);
+    EXPECT_EQ(telegram->type, telegram_type::EMPTY);
+    EXPECT_EQ(telegram->stamp, 0u);
+    EXPECT_TRUE(telegram->message.empty());
+    EXPECT_EQ(pool->hits(), 1u);
+    EXPECT_EQ(pool->misses(), 1u);
+}
+
+TEST(TelegramPoolTest, sizeClasses)
+{
+    auto pool = std::make_shared<TelegramPool>();
+
+    for (size_t size : {0, 256, 257, 1024, 5000, 16384, 40000, 65535})
+    {
+        auto telegram = pool->acquire(size);
+        EXPECT_GE(telegram->message.capacity(), size);
+    }
+    // A small request must not be served with a large telegram
+    auto small = pool->acquire(10);
+    EXPECT_LT(small->message.capacity(), 1024u);
+    // Large request served from the largest class
+    auto large = pool->acquire(MAX_SBF_SIZE);
+    EXPECT_GE(large->message.capacity(), MAX_SBF_SIZE);
+}
+
+TEST(TelegramPoolTest, outlivedByTelegrams)
+{
+    std::shared_ptr<Telegram> telegram;
+    {
+        auto pool = std::make_shared<TelegramPool>();
+        telegram = pool->acquire(10);
+    }
+    telegram->message.push_back(1);
+    telegram.reset();
+}
+
+TEST(TelegramPoolTest, steadyStateWithoutAllocation)
+{
+    auto pool = std::make_shared<TelegramPool>();
+    std::vector<std::shared_ptr<Telegram>> inFlight;
+    inFlight.reserve(16);
+
+    auto cycle = [&]() {
+        for (size_t i = 0; i < 16; ++i)
+        {
+            auto telegram = pool->acquire((i % 2) ? 100 : 3000);
+            telegram->message.resize((i % 2) ? 100 : 3000);
+            inFlight.push_back(telegram);
+        }
+        inFlight.clear();
+    };
+
+    // Warm up
+    cycle();
+    const uint64_t misses = pool->misses();
+
+    const size_t before = allocations;
+    for (size_t i = 0; i < 100; ++i)
+        cycle();
+    EXPECT_EQ(allocations - before, 0u);
+    EXPECT_EQ(pool->misses(), misses);
+    EXPECT_EQ(pool->hits(), 1600u);
+}
+
+TEST(TelegramPoolTest, framerSteadyState)
+{
+    std::vector<uint8_t> block(2096, 0x11);
+    block[0] = SYNC_BYTE_1;
+    block[1] = SBF_SYNC_BYTE_2;
+    block[4] = 4027 & 0xFF;
+    block[5] = 4027 >> 8;
+    block[6] = block.size() & 0xFF;
+    block[7] = block.size() >> 8;
+    uint16_t crc = crc::compute16CCITT(block.data() + 4, block.size() - 4);
+    block[2] = crc & 0xFF;
+    block[3] = crc >> 8;
+    const std::string nmea = "$GPGGA,1*47\r\n";
+    block.insert(block.end(), nmea.begin(), nmea.end());
+
+    auto pool = std::make_shared<TelegramPool>();
+    size_t count = 0;
+    io::TelegramFramer framer(
+        [&count](const std::shared_ptr<Telegram>&) { ++count; }, nullptr, pool);
+
+    framer.feed(block.data(), block.size(), 0);
+    const size_t before = allocations;
+    for (size_t i = 0; i < 100; ++i)
+        framer.feed(block.data(), block.size(), 0);
+    EXPECT_EQ(allocations - before, 0u);
+    EXPECT_EQ(count, 202u);
+}
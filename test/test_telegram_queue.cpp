@@ -0,0 +1,483 @@
+// *****************************************************************************
+//
+// © Copyright 2020, Septentrio NV/SA.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//    1. Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//    2. Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//    3. Neither the name of the copyright holder nor the names of its
+//       contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <gtest/gtest.h>
+
+// C++
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <septentrio_gnss_driver/communication/epoch_aggregator.hpp>
+#include <septentrio_gnss_driver/communication/telegram_queue.hpp>
+
+TEST(LockFreeQueueTest, fifo)
+{
+    LockFreeQueue<int> queue(8);
+    EXPECT_EQ(queue.capacity(), 8u);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(8));
+    EXPECT_EQ(queue.size(), 8u);
+
+    for (int i = 0; i < 8; ++i)
+    {
+        int value;
+        queue.pop(value);
+        EXPECT_EQ(value, i);
+    }
+    int value;
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(LockFreeQueueTest, releasesPoppedElements)
+{
+    TelegramQueue queue(4);
+    auto telegram = std::make_shared<Telegram>();
+    queue.push(telegram);
+    EXPECT_EQ(telegram.use_count(), 2);
+
+    std::shared_ptr<Telegram> popped;
+    queue.pop(popped);
+    popped.reset();
+    EXPECT_EQ(telegram.use_count(), 1);
+}
+
+TEST(LockFreeQueueTest, multipleProducers)
+{
+    const int producers = 4;
+    const int perProducer = 100000;
+    LockFreeQueue<int> queue(64);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < perProducer; ++i)
+                queue.push(p * perProducer + i);
+        });
+
+    // Elements of each producer must arrive in order and completely
+    std::vector<int> last(producers, -1);
+    for (int n = 0; n < producers * perProducer; ++n)
+    {
+        int value;
+        queue.pop(value);
+        int p = value / perProducer;
+        ASSERT_GT(value % perProducer, last[p]);
+        last[p] = value % perProducer;
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, wakesParkedConsumer)
+{
+    LockFreeQueue<int, false> queue(16);
+    std::thread producer([&queue]() {
+        for (int i = 0; i < 20; ++i)
+        {
+            // Long enough for the consumer to park
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            queue.push(i);
+        }
+    });
+    for (int i = 0; i < 20; ++i)
+    {
+        int value;
+        queue.pop(value);
+        EXPECT_EQ(value, i);
+    }
+    producer.join();
+}
+
+namespace {
+    std::shared_ptr<Telegram> makeTelegram(telegram_type::TelegramType type,
+                                           uint16_t id = 0, uint8_t tag = 0)
+    {
+        auto telegram = std::make_shared<Telegram>();
+        telegram->type = type;
+        // Sync bytes, CRC, ID and a tag to tell telegrams apart
+        telegram->message = {SYNC_BYTE_1,
+                             SBF_SYNC_BYTE_2,
+                             0,
+                             0,
+                             static_cast<uint8_t>(id & 0xFF),
+                             static_cast<uint8_t>(id >> 8),
+                             tag};
+        return telegram;
+    }
+
+    uint8_t tagOf(const std::shared_ptr<Telegram>& telegram)
+    {
+        return telegram->message[6];
+    }
+} // namespace
+
+TEST(TelegramQueueTest, dropNewest)
+{
+    TelegramQueue queue(4);
+    queue.setPolicy(telegram_type::UNKNOWN, overflow_policy::DROP_NEWEST);
+    for (uint8_t i = 0; i < 6; ++i)
+        queue.push(makeTelegram(telegram_type::UNKNOWN, 0, i));
+
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.drops(telegram_type::UNKNOWN), 2u);
+    EXPECT_EQ(queue.highWaterMark(), 4u);
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(tagOf(telegram), i);
+    }
+}
+
+TEST(TelegramQueueTest, dropOldest)
+{
+    TelegramQueue queue(4);
+    queue.setPolicy(telegram_type::NMEA, overflow_policy::DROP_OLDEST);
+    for (uint8_t i = 0; i < 6; ++i)
+        queue.push(makeTelegram(telegram_type::NMEA, 0, i));
+
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.drops(telegram_type::NMEA), 2u);
+    for (uint8_t i = 2; i < 6; ++i)
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(tagOf(telegram), i);
+    }
+}
+
+TEST(TelegramQueueTest, responsesAreNeverDropped)
+{
+    TelegramQueue queue(4);
+    queue.setPolicy(telegram_type::NMEA, overflow_policy::DROP_OLDEST);
+    queue.setPolicy(telegram_type::RESPONSE, overflow_policy::DROP_NEWEST);
+    EXPECT_EQ(queue.policy(telegram_type::RESPONSE), overflow_policy::BLOCK);
+
+    for (uint8_t i = 0; i < 4; ++i)
+        queue.push(makeTelegram(telegram_type::RESPONSE, 0, i));
+    for (uint8_t i = 0; i < 5; ++i)
+        queue.push(makeTelegram(telegram_type::NMEA, 0, i));
+
+    // Responses jump the queue and are never dropped
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(telegram->type, telegram_type::RESPONSE);
+        EXPECT_EQ(tagOf(telegram), i);
+    }
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.drops(telegram_type::NMEA), 1u);
+}
+
+TEST(TelegramQueueTest, priorityLanes)
+{
+    TelegramQueue queue(16);
+    queue.setPriority(4226, telegram_priority::HIGH);
+    queue.setPriority(4027, telegram_priority::LOW);
+
+    queue.push(makeTelegram(telegram_type::SBF, 4027, 0));
+    queue.push(makeTelegram(telegram_type::UNKNOWN, 0, 1));
+    queue.push(makeTelegram(telegram_type::NMEA, 0, 2));
+    queue.push(makeTelegram(telegram_type::SBF, 4001, 3));
+    queue.push(makeTelegram(telegram_type::SBF, 4226, 4));
+    queue.push(makeTelegram(telegram_type::SBF, 4027, 5));
+    queue.push(makeTelegram(telegram_type::SBF, 4226, 6));
+    EXPECT_EQ(queue.size(telegram_priority::HIGH), 2u);
+    EXPECT_EQ(queue.size(telegram_priority::NORMAL), 2u);
+    EXPECT_EQ(queue.size(telegram_priority::LOW), 3u);
+
+    // Higher lanes first, FIFO within a lane
+    for (uint8_t expected : {4, 6, 2, 3, 0, 1, 5})
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(tagOf(telegram), expected);
+    }
+    EXPECT_EQ(queue.latency(telegram_priority::HIGH).total(), 2u);
+    EXPECT_EQ(queue.latency(telegram_priority::NORMAL).total(), 2u);
+    EXPECT_EQ(queue.latency(telegram_priority::LOW).total(), 3u);
+}
+
+TEST(TelegramQueueTest, epochBlocksShareLane)
+{
+    typedef io::EpochAggregator Aggregator;
+    // SBF IDs of the blocks GPSFix needs
+    const std::vector<std::pair<uint16_t, Aggregator::Block>> blocks = {
+        {4007, Aggregator::PVT_GEODETIC},  {5906, Aggregator::POS_COV_GEODETIC},
+        {5938, Aggregator::ATT_EULER},     {5939, Aggregator::ATT_COV_EULER},
+        {4001, Aggregator::DOP},           {4027, Aggregator::MEAS_EPOCH},
+        {4013, Aggregator::CHANNEL_STATUS}, {5908, Aggregator::VEL_COV_GEODETIC}};
+    TelegramQueue queue(16);
+    queue.setPriority(4007, telegram_priority::HIGH);
+    queue.setPriority(4027, telegram_priority::LOW);
+    queue.setPriority(4013, telegram_priority::LOW);
+    std::vector<uint16_t> ids;
+    for (const auto& [id, block] : blocks)
+        ids.push_back(id);
+    queue.shareLane(ids);
+    EXPECT_EQ(queue.priority(*makeTelegram(telegram_type::SBF, 4027)),
+              telegram_priority::HIGH);
+
+    // Epoch n in the order of the Rx, followed by PVTGeodetic of epoch n + 1
+    for (const auto& [id, block] : blocks)
+        queue.push(makeTelegram(telegram_type::SBF, id, 0));
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 1));
+
+    // MeasEpoch and ChannelStatus of epoch n are not overtaken, so GPSFix of
+    // epoch n is complete before epoch n + 1 starts
+    Aggregator aggregator;
+    Aggregator::Outputs complete = 0;
+    for (std::size_t i = 0; i <= blocks.size(); ++i)
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        const uint16_t id = parsing_utilities::getId(telegram->message);
+        const uint32_t tow = tagOf(telegram) * 100;
+        EXPECT_EQ(complete, (tow == 0) ? 0 : Aggregator::bit(Aggregator::GPSFIX));
+        for (const auto& [blockId, block] : blocks)
+        {
+            if (blockId == id)
+                complete |= aggregator.add(2300, tow, block, 0,
+                                           Aggregator::bit(Aggregator::GPSFIX));
+        }
+    }
+    EXPECT_EQ(complete, Aggregator::bit(Aggregator::GPSFIX));
+    EXPECT_EQ(aggregator.completeEpochs(), 1u);
+    EXPECT_EQ(aggregator.incompleteEpochs(), 0u);
+}
+
+TEST(TelegramQueueTest, wakesConsumerFromAnyLane)
+{
+    TelegramQueue queue(16);
+    queue.setPriority(4027, telegram_priority::LOW);
+    std::thread producer([&queue]() {
+        for (uint8_t i = 0; i < 10; ++i)
+        {
+            // Long enough for the consumer to park
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            queue.push(makeTelegram(telegram_type::SBF, (i % 2) ? 4027 : 4001, i));
+        }
+    });
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(tagOf(telegram), i);
+    }
+    producer.join();
+}
+
+TEST(TelegramQueueTest, popTimeout)
+{
+    TelegramQueue queue(16);
+    std::shared_ptr<Telegram> telegram;
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.pop(telegram, std::chrono::milliseconds(20)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(20));
+    EXPECT_FALSE(telegram);
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        queue.push(makeTelegram(telegram_type::SBF, 4007, 1));
+    });
+    EXPECT_TRUE(queue.pop(telegram, std::chrono::seconds(10)));
+    EXPECT_EQ(tagOf(telegram), 1);
+    producer.join();
+}
+
+TEST(TelegramQueueTest, waitBelow)
+{
+    TelegramQueue queue(16);
+    std::atomic<bool> running = true;
+    EXPECT_TRUE(queue.waitBelow(1, running));
+
+    // A producer reading ahead by two telegrams is woken by every pop
+    std::vector<int> popped;
+    std::thread producer([&queue, &running]() {
+        for (uint8_t i = 0; i < 100; ++i)
+        {
+            ASSERT_TRUE(queue.waitBelow(2, running));
+            EXPECT_LT(queue.size(), 2u);
+            queue.push(makeTelegram(telegram_type::SBF, 4007, i));
+        }
+    });
+    std::shared_ptr<Telegram> telegram;
+    for (int i = 0; i < 100; ++i)
+    {
+        queue.pop(telegram);
+        popped.push_back(tagOf(telegram));
+    }
+    producer.join();
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(popped[i], i);
+
+    // A waiting producer gives up once its flag is cleared
+    queue.push(makeTelegram(telegram_type::SBF, 4007));
+    std::thread stopped([&queue, &running]() {
+        EXPECT_FALSE(queue.waitBelow(1, running));
+    });
+    running = false;
+    queue.wakeProducers();
+    stopped.join();
+}
+
+TEST(LatencyHistogramTest, buckets)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    for (int i = 0; i < 98; ++i)
+        histogram.add(std::chrono::microseconds(50));
+    histogram.add(std::chrono::microseconds(300));
+    histogram.add(std::chrono::seconds(1));
+
+    EXPECT_EQ(histogram.total(), 100u);
+    EXPECT_EQ(histogram.count(0), 98u);
+    EXPECT_EQ(histogram.count(2), 1u);
+    EXPECT_EQ(histogram.count(LatencyHistogram::NUMBER_OF_BUCKETS - 1), 1u);
+    EXPECT_EQ(histogram.percentile(0.5), 100u);
+    EXPECT_EQ(histogram.percentile(0.99), 500u);
+    EXPECT_EQ(histogram.percentile(1.0), UINT32_MAX);
+    EXPECT_EQ(histogram.toString(), "<100us: 98, <500us: 1, >=100000us: 1");
+}
+
+TEST(TelegramQueueTest, keepLatest)
+{
+    TelegramQueue queue(4);
+    queue.setPolicy(telegram_type::SBF, overflow_policy::KEEP_LATEST);
+    for (uint8_t i = 0; i < 4; ++i)
+        queue.push(makeTelegram(telegram_type::SBF, 4007, i));
+
+    // No conflation as long as the lane has not overflowed
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(tagOf(telegram), i);
+    }
+    EXPECT_EQ(queue.drops(telegram_type::SBF), 0u);
+}
+
+TEST(TelegramQueueTest, keepLatestOnOverflow)
+{
+    TelegramQueue queue(4);
+    queue.setPolicy(telegram_type::SBF, overflow_policy::KEEP_LATEST);
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 0));
+    queue.push(makeTelegram(telegram_type::SBF, 4006, 1));
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 2));
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 3));
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 4));
+
+    // The oldest block is evicted and superseded PVTGeodetic blocks are skipped
+    std::shared_ptr<Telegram> telegram;
+    queue.pop(telegram);
+    EXPECT_EQ(tagOf(telegram), 1);
+    queue.pop(telegram);
+    EXPECT_EQ(tagOf(telegram), 4);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.drops(telegram_type::SBF), 3u);
+
+    // Once drained, blocks are no longer conflated
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 5));
+    queue.push(makeTelegram(telegram_type::SBF, 4007, 6));
+    queue.pop(telegram);
+    EXPECT_EQ(tagOf(telegram), 5);
+    queue.pop(telegram);
+    EXPECT_EQ(tagOf(telegram), 6);
+    EXPECT_EQ(queue.drops(telegram_type::SBF), 3u);
+}
+
+TEST(TelegramQueueTest, responsesKeepOrderOnOverflow)
+{
+    TelegramQueue queue(4);
+    queue.setPriority(4007, telegram_priority::HIGH);
+    queue.setPriority(4007, telegram_priority::CONTROL);
+    queue.setPolicy(telegram_type::SBF, overflow_policy::DROP_OLDEST);
+    EXPECT_EQ(queue.priority(*makeTelegram(telegram_type::SBF, 4007)),
+              telegram_priority::HIGH);
+
+    uint8_t tag = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        queue.push(makeTelegram(telegram_type::RESPONSE, 0, tag++));
+        for (int j = 0; j < 3; ++j)
+            queue.push(makeTelegram(telegram_type::SBF, 4007, tag++));
+    }
+
+    // Evicting blocks never touches the responses
+    for (uint8_t expected : {0, 4, 8, 7, 9, 10, 11})
+    {
+        std::shared_ptr<Telegram> telegram;
+        queue.pop(telegram);
+        EXPECT_EQ(tagOf(telegram), expected);
+    }
+    EXPECT_EQ(queue.drops(telegram_type::SBF), 5u);
+}
+
+TEST(TelegramQueueTest, dropOldestUnderContention)
+{
+    const int producers = 4;
+    const int perProducer = 20000;
+    TelegramQueue queue(16);
+    queue.setPolicy(telegram_type::NMEA, overflow_policy::DROP_OLDEST);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&queue]() {
+            for (int i = 0; i < perProducer; ++i)
+                queue.push(makeTelegram(telegram_type::NMEA));
+        });
+    uint64_t popped = 0;
+    std::thread consumer([&queue, &popped]() {
+        std::shared_ptr<Telegram> telegram;
+        while (true)
+        {
+            queue.pop(telegram);
+            if (telegram->type == telegram_type::EMPTY)
+                break;
+            ++popped;
+        }
+    });
+    for (auto& thread : threads)
+        thread.join();
+    // Shutdown telegrams overtake the remaining NMEA sentences
+    queue.push(std::make_shared<Telegram>());
+    consumer.join();
+
+    // Every telegram is either processed, still queued or counted as dropped
+    EXPECT_EQ(popped + queue.size() + queue.drops(telegram_type::NMEA),
+              static_cast<uint64_t>(producers * perProducer));
+    EXPECT_LE(queue.size(telegram_priority::NORMAL), queue.capacity());
+}